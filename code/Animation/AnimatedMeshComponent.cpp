@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2025 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -13,8 +13,8 @@
 #include "Animation/Skeleton.h"
 #include "Animation/SkeletonComponent.h"
 #include "Animation/SkeletonUtils.h"
+#include "Core/Math/Matrix44.h"
 #include "Core/Misc/SafeDestroy.h"
-#include "Core/Thread/JobManager.h"
 #include "Mesh/Skinned/SkinnedMesh.h"
 #include "Render/Buffer.h"
 #include "Render/Context/RenderBlock.h"
@@ -41,6 +41,105 @@ const render::Handle s_handleWorld_ShadowWrite(L"World_ShadowWrite");
 
 const int32_t c_maxRtUpdatesBeforeBuild = 800;
 
+/*! Transpose four vectors. */
+T_FORCE_INLINE void transpose(const Vector4& a, const Vector4& b, const Vector4& c, const Vector4& d, Vector4 out[4])
+{
+	const Matrix44 m = Matrix44(a, b, c, d).transpose();
+	out[0] = m.axisX();
+	out[1] = m.axisY();
+	out[2] = m.axisZ();
+	out[3] = m.translation();
+}
+
+/*! Load four transforms into SoA form. */
+T_FORCE_INLINE void loadTransforms(const Transform* tf, Vector4 outT[4], Vector4 outR[4])
+{
+	transpose(tf[0].translation(), tf[1].translation(), tf[2].translation(), tf[3].translation(), outT);
+	transpose(tf[0].rotation().e, tf[1].rotation().e, tf[2].rotation().e, tf[3].rotation().e, outR);
+}
+
+/*! Calculate skin palette.
+ *
+ * Pose transforms are interpolated between last and current update
+ * and concatenated with inverse bind transforms, four joints at a time
+ * in SoA form, and written directly into joint buffer. Rotations are
+ * interpolated with normalized lerp which, over a single update, is
+ * close enough to slerp.
+ */
+void calculateSkinPalette(
+	const Transform* last,
+	const Transform* current,
+	const Transform* inverseBind,
+	const Scalar& interval,
+	uint32_t count,
+	mesh::SkinnedMesh::JointData* outJointData
+)
+{
+	const Scalar c_half(0.5f);
+	const Scalar c_threeHalves(1.5f);
+
+	uint32_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		Vector4 t0[4], r0[4], t1[4], r1[4], tb[4], rb[4];
+		loadTransforms(last + i, t0, r0);
+		loadTransforms(current + i, t1, r1);
+		loadTransforms(inverseBind + i, tb, rb);
+
+		// Interpolate pose, flip current rotations into same hemisphere as last.
+		const Vector4 d = r0[0] * r1[0] + r0[1] * r1[1] + r0[2] * r1[2] + r0[3] * r1[3];
+		const Vector4 flip = select(d, -Vector4::one(), Vector4::one());
+
+		Vector4 t[3], r[4];
+		for (int32_t c = 0; c < 3; ++c)
+			t[c] = t0[c] + (t1[c] - t0[c]) * interval;
+		for (int32_t c = 0; c < 4; ++c)
+			r[c] = r0[c] + (r1[c] * flip - r0[c]) * interval;
+
+		// Normalize rotations; squared length is in [0.5, 1] since rotations are
+		// in same hemisphere thus a few Newton-Raphson iterations are sufficient.
+		const Vector4 ln2 = r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3];
+		Vector4 il = c_threeHalves - c_half * ln2;
+		il = il * (c_threeHalves - c_half * ln2 * il * il);
+		il = il * (c_threeHalves - c_half * ln2 * il * il);
+		il = il * (c_threeHalves - c_half * ln2 * il * il);
+		for (int32_t c = 0; c < 4; ++c)
+			r[c] *= il;
+
+		// Skin rotation, r * rb.
+		Vector4 sr[4];
+		sr[0] = r[3] * rb[0] + r[0] * rb[3] + r[1] * rb[2] - r[2] * rb[1];
+		sr[1] = r[3] * rb[1] + r[1] * rb[3] + r[2] * rb[0] - r[0] * rb[2];
+		sr[2] = r[3] * rb[2] + r[2] * rb[3] + r[0] * rb[1] - r[1] * rb[0];
+		sr[3] = r[3] * rb[3] - r[0] * rb[0] - r[1] * rb[1] - r[2] * rb[2];
+
+		// Skin translation, t + r * tb * r^-1.
+		const Vector4 cx = r[1] * tb[2] - r[2] * tb[1];
+		const Vector4 cy = r[2] * tb[0] - r[0] * tb[2];
+		const Vector4 cz = r[0] * tb[1] - r[1] * tb[0];
+		const Vector4 st0 = t[0] + tb[0] + 2.0_simd * (r[3] * cx + r[1] * cz - r[2] * cy);
+		const Vector4 st1 = t[1] + tb[1] + 2.0_simd * (r[3] * cy + r[2] * cx - r[0] * cz);
+		const Vector4 st2 = t[2] + tb[2] + 2.0_simd * (r[3] * cz + r[0] * cy - r[1] * cx);
+
+		Vector4 ot[4], orr[4];
+		transpose(st0, st1, st2, Vector4::zero(), ot);
+		transpose(sr[0], sr[1], sr[2], sr[3], orr);
+		for (int32_t j = 0; j < 4; ++j)
+		{
+			ot[j].storeAligned(outJointData[i + j].translation);
+			orr[j].storeAligned(outJointData[i + j].rotation);
+		}
+	}
+
+	for (; i < count; ++i)
+	{
+		const Transform poseTransform = lerp(last[i], current[i], interval);
+		const Transform skinTransform = poseTransform * inverseBind[i];
+		skinTransform.translation().storeAligned(outJointData[i].translation);
+		skinTransform.rotation().e.storeAligned(outJointData[i].rotation);
+	}
+}
+
 }
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.animation.AnimatedMeshComponent", AnimatedMeshComponent, mesh::MeshComponent)
@@ -122,6 +221,7 @@ void AnimatedMeshComponent::setWorld(world::World* world)
 {
 	safeDestroy(m_rtwInstance);
 	m_world = world;
+	mesh::MeshComponent::setWorld(world);
 }
 
 void AnimatedMeshComponent::setState(const world::EntityState& state, const world::EntityState& mask, bool includeChildren)
@@ -135,7 +235,7 @@ void AnimatedMeshComponent::setState(const world::EntityState& state, const worl
 			if (rtw != nullptr)
 			{
 				m_rtwInstance = rtw->createInstance(m_rtAccelerationStructure, m_mesh->getRTVertexAttributes());
-				m_rtwInstance->setTransform(m_transform.get0());
+				m_rtwInstance->setTransform(getTransform().get0());
 			}
 		}
 	}
@@ -168,9 +268,6 @@ void AnimatedMeshComponent::update(const world::UpdateParams& update)
 	auto skeletonComponent = m_owner->getComponent< SkeletonComponent >();
 	if (skeletonComponent && skeletonComponent->getSkeleton() && skeletonComponent->getRevision() != m_revision)
 	{
-		// Ensure all transforms are calculated.
-		skeletonComponent->synchronize();
-
 		const auto& jointTransforms = skeletonComponent->getJointTransforms();
 		const auto& poseTransforms = skeletonComponent->getPoseTransforms();
 
@@ -197,7 +294,7 @@ void AnimatedMeshComponent::update(const world::UpdateParams& update)
 void AnimatedMeshComponent::build(const world::WorldBuildContext& context, const world::WorldRenderView& worldRenderView, const world::IWorldRenderPass& worldRenderPass)
 {
 	const Scalar interval(worldRenderView.getInterval());
-	const Transform worldTransform = m_transform.get(interval);
+	const Transform worldTransform = getTransform().get(interval);
 
 	const bool firstInFrame = ((worldRenderPass.getPassFlags() & world::IWorldRenderPass::First) != 0 && worldRenderView.getIndex() == 0);
 	const bool supportTechnique = (m_mesh->supportTechnique(worldRenderPass.getTechnique()));
@@ -225,14 +322,14 @@ void AnimatedMeshComponent::build(const world::WorldBuildContext& context, const
 			if (poseTransformsCurrentUpdate.size() > 0)
 			{
 				mesh::SkinnedMesh::JointData* jointData = (mesh::SkinnedMesh::JointData*)m_jointBuffer->lock();
-				for (uint32_t i = 0; i < poseTransformsCurrentUpdate.size(); ++i)
-				{
-					const Transform poseTransform = lerp(poseTransformsLastUpdate[i], poseTransformsCurrentUpdate[i], interval);
-					const Transform skinTransform = poseTransform * m_jointInverseTransforms[i];
-					skinTransform.translation().storeAligned(jointData->translation);
-					skinTransform.rotation().e.storeAligned(jointData->rotation);
-					jointData++;
-				}
+				calculateSkinPalette(
+					poseTransformsLastUpdate.c_ptr(),
+					poseTransformsCurrentUpdate.c_ptr(),
+					m_jointInverseTransforms.c_ptr(),
+					interval,
+					uint32_t(poseTransformsCurrentUpdate.size()),
+					jointData
+				);
 				m_jointBuffer->unlock();
 			}
 
@@ -1,23 +1,25 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2025 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 #include "Animation/Animation/Animation.h"
+#include "Animation/Animation/CompressedAnimation.h"
 #include "Animation/SkeletonUtils.h"
 #include "Core/Math/Hermite.h"
 #include "Core/Serialization/AttributeRange.h"
 #include "Core/Serialization/ISerializer.h"
 #include "Core/Serialization/MemberAlignedVector.h"
 #include "Core/Serialization/MemberComposite.h"
+#include "Core/Serialization/MemberRef.h"
 
 namespace traktor::animation
 {
 
-T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.animation.Animation", 0, Animation, ISerializable)
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.animation.Animation", 1, Animation, ISerializable)
 
 uint32_t Animation::addKeyPose(const KeyPose& pose)
 {
@@ -43,7 +45,7 @@ void Animation::removeKeyPose(uint32_t poseIndex)
 
 bool Animation::empty() const
 {
-	return m_poses.empty();
+	return m_poses.empty() && !m_compressed;
 }
 
 uint32_t Animation::getKeyPoseCount() const
@@ -71,6 +73,12 @@ const Animation::KeyPose& Animation::getLastKeyPose() const
 
 bool Animation::getPose(float at, Pose& outPose) const
 {
+	if (m_compressed)
+	{
+		m_compressed->sample(at, outPose);
+		return true;
+	}
+
 	const size_t nposes = m_poses.size();
 	if (nposes > 2)
 	{
@@ -135,9 +143,50 @@ bool Animation::getPose(float at, Pose& outPose) const
 		return false;
 }
 
+float Animation::getStartTime() const
+{
+	if (m_compressed)
+		return m_compressed->getStartTime();
+	else
+		return !m_poses.empty() ? m_poses.front().at : 0.0f;
+}
+
+float Animation::getEndTime() const
+{
+	if (m_compressed)
+		return m_compressed->getEndTime();
+	else
+		return !m_poses.empty() ? m_poses.back().at : 0.0f;
+}
+
+bool Animation::compress(float rotationTolerance, float translationTolerance)
+{
+	if (m_poses.empty())
+		return false;
+
+	AlignedVector< float > times(m_poses.size());
+	AlignedVector< const Pose* > poses(m_poses.size());
+	for (size_t i = 0; i < m_poses.size(); ++i)
+	{
+		times[i] = m_poses[i].at;
+		poses[i] = &m_poses[i].pose;
+	}
+
+	m_compressed = CompressedAnimation::compress(times.c_ptr(), poses.c_ptr(), uint32_t(m_poses.size()), rotationTolerance, translationTolerance);
+	if (!m_compressed)
+		return false;
+
+	m_poses.clear();
+	return true;
+}
+
 void Animation::serialize(ISerializer& s)
 {
 	s >> MemberAlignedVector< KeyPose, MemberComposite< KeyPose > >(L"poses", m_poses);
+
+	if (s.getVersion< Animation >() >= 1)
+		s >> MemberRef< CompressedAnimation >(L"compressed", m_compressed);
+
 	s >> Member< float >(L"timePerDistance", m_timePerDistance);
 	s >> Member< Vector4 >(L"totalLocomotion", m_totalLocomotion);
 }
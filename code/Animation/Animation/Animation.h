@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Animation/Pose.h"
+#include "Core/Ref.h"
 #include "Core/Containers/AlignedVector.h"
 #include "Core/Serialization/ISerializable.h"
 
@@ -23,8 +24,15 @@
 namespace traktor::animation
 {
 
+class CompressedAnimation;
+
 /*! Key framed animation poses.
  * \ingroup Animation
+ *
+ * Key poses are replaced with a compressed representation
+ * when animation is compressed, which is done by pipeline;
+ * thus runtime should not rely on key poses but use
+ * getPose and start/end time.
  */
 class T_DLLCLASS Animation : public ISerializable
 {
@@ -92,6 +100,31 @@ public:
 	 */
 	bool getPose(float at, Pose& outPose) const;
 
+	/*! Get time of first key pose.
+	 *
+	 * \return Start time.
+	 */
+	float getStartTime() const;
+
+	/*! Get time of last key pose.
+	 *
+	 * \return End time.
+	 */
+	float getEndTime() const;
+
+	/*! Compress animation.
+	 *
+	 * Key poses are replaced with compressed tracks.
+	 *
+	 * \param rotationTolerance Max rotation error, in radians.
+	 * \param translationTolerance Max translation error.
+	 * \return True if compressed successfully.
+	 */
+	bool compress(float rotationTolerance, float translationTolerance);
+
+	/*! Get compressed animation, null if not compressed. */
+	const CompressedAnimation* getCompressed() const { return m_compressed; }
+
 	/*!
 	 */
 	void setTimePerDistance(float timePerDistance) { m_timePerDistance = timePerDistance; }
@@ -113,6 +146,7 @@ public:
 
 private:
 	AlignedVector< KeyPose > m_poses;
+	Ref< CompressedAnimation > m_compressed;
 	float m_timePerDistance = 0.0f;
 	Vector4 m_totalLocomotion = Vector4::zero();
 };
@@ -0,0 +1,432 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include <algorithm>
+#include <cmath>
+#include "Animation/BitSet.h"
+#include "Animation/Pose.h"
+#include "Animation/Animation/CompressedAnimation.h"
+#include "Core/Math/Matrix44.h"
+#include "Core/Serialization/ISerializer.h"
+#include "Core/Serialization/MemberAlignedVector.h"
+#include "Core/Serialization/MemberComposite.h"
+#include "Core/Serialization/MemberStaticArray.h"
+
+namespace traktor::animation
+{
+	namespace
+	{
+
+const float c_quantizeRange = 32767.0f;
+
+/*! Load four 16-bit integers into float vector. */
+T_FORCE_INLINE Vector4 load4(const int16_t* p)
+{
+#if defined(T_MATH_USE_SSE2)
+	const __m128i i16 = _mm_loadl_epi64((const __m128i*)p);
+	const __m128i i32 = _mm_srai_epi32(_mm_unpacklo_epi16(i16, i16), 16);
+	return Vector4(_mm_cvtepi32_ps(i32));
+#elif defined(T_MATH_USE_NEON)
+	return Vector4(vcvtq_f32_s32(vmovl_s16(vld1_s16(p))));
+#else
+	return Vector4(float(p[0]), float(p[1]), float(p[2]), float(p[3]));
+#endif
+}
+
+/*! Reciprocal square root of each element. */
+T_FORCE_INLINE Vector4 reciprocalSqrt4(const Vector4& v)
+{
+#if defined(T_MATH_USE_SSE2)
+	return Vector4(_mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(v.m_data)));
+#elif defined(T_MATH_USE_NEON)
+	float32x4_t e = vrsqrteq_f32(v.m_data);
+	e = vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(v.m_data, e), e));
+	e = vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(v.m_data, e), e));
+	return Vector4(e);
+#else
+	return Vector4(
+		1.0f / std::sqrt(v.x()),
+		1.0f / std::sqrt(v.y()),
+		1.0f / std::sqrt(v.z()),
+		1.0f / std::sqrt(v.w())
+	);
+#endif
+}
+
+int16_t quantize(float v)
+{
+	return int16_t(std::clamp(std::round(v), -c_quantizeRange, c_quantizeRange));
+}
+
+/*! Greedy key reduction.
+ *
+ * Extend each segment as long as all intermediate
+ * keys can be reconstructed from the segment's end points.
+ */
+template < typename FitFunction >
+void reduceKeys(uint32_t keyCount, const FitFunction& fits, AlignedVector< uint32_t >& outKeys)
+{
+	outKeys.resize(0);
+	outKeys.push_back(0);
+
+	uint32_t a = 0;
+	while (a < keyCount - 1)
+	{
+		uint32_t b = a + 1;
+		while (b + 1 < keyCount && fits(a, b + 1))
+			++b;
+		outKeys.push_back(b);
+		a = b;
+	}
+}
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.animation.CompressedAnimation", 0, CompressedAnimation, ISerializable)
+
+Ref< CompressedAnimation > CompressedAnimation::compress(
+	const float* times,
+	const Pose* const* poses,
+	uint32_t keyCount,
+	float rotationTolerance,
+	float translationTolerance
+)
+{
+	if (keyCount == 0)
+		return nullptr;
+
+	BitSet indices;
+	for (uint32_t i = 0; i < keyCount; ++i)
+		poses[i]->getIndexMask(indices);
+
+	int32_t minRange, maxRange;
+	indices.range(minRange, maxRange);
+
+	Ref< CompressedAnimation > ca = new CompressedAnimation();
+	ca->m_startTime = times[0];
+	ca->m_endTime = times[keyCount - 1];
+
+	for (int32_t i = 0; i < maxRange; ++i)
+	{
+		if (!indices(i))
+			continue;
+		ca->m_jointCount = uint32_t(i + 1);
+		if (ca->m_jointMask.size() <= size_t(i / 32))
+			ca->m_jointMask.resize(i / 32 + 1, 0);
+		ca->m_jointMask[i / 32] |= 1U << (i & 31);
+	}
+
+	const uint32_t groupCount = (ca->m_jointCount + 3) / 4;
+	ca->m_groups.resize(groupCount);
+
+	// Compare cosine of half angle since quaternions are unit length.
+	const Scalar cosHalfTolerance(std::cos(rotationTolerance * 0.5f));
+	const Scalar translationTolerance2(translationTolerance * translationTolerance);
+
+	AlignedVector< Quaternion > rotations(keyCount * 4);
+	AlignedVector< Vector4 > translations(keyCount * 4);
+	AlignedVector< int16_t > qr(keyCount * 16);
+	AlignedVector< int16_t > qt(keyCount * 12);
+	AlignedVector< uint32_t > keys;
+
+	for (uint32_t g = 0; g < groupCount; ++g)
+	{
+		Group& group = ca->m_groups[g];
+
+		for (uint32_t k = 0; k < keyCount; ++k)
+		{
+			for (uint32_t lane = 0; lane < 4; ++lane)
+			{
+				const uint32_t jointIndex = g * 4 + lane;
+				const Transform transform = jointIndex < ca->m_jointCount ? poses[k]->getJointTransform(jointIndex) : Transform::identity();
+
+				// Keep rotations in same hemisphere as previous key so interpolation take shortest path.
+				Quaternion rotation = transform.rotation().normalized();
+				if (k > 0)
+					rotation = rotations[(k - 1) * 4 + lane].nearest(rotation);
+
+				rotations[k * 4 + lane] = rotation;
+				translations[k * 4 + lane] = transform.translation().xyz0();
+			}
+		}
+
+		// Quantize rotations; reconstructed rotations are normalized thus no need to scale.
+		for (uint32_t k = 0; k < keyCount; ++k)
+		{
+			for (uint32_t lane = 0; lane < 4; ++lane)
+			{
+				const Quaternion& q = rotations[k * 4 + lane];
+				for (uint32_t c = 0; c < 4; ++c)
+					qr[k * 16 + c * 4 + lane] = quantize(float(q.e[c]) * c_quantizeRange);
+			}
+		}
+
+		// Quantize translations relative to each joint's range.
+		float center[3][4], scale[3][4];
+		for (uint32_t lane = 0; lane < 4; ++lane)
+		{
+			Vector4 mn = translations[lane], mx = translations[lane];
+			for (uint32_t k = 1; k < keyCount; ++k)
+			{
+				mn = min(mn, translations[k * 4 + lane]);
+				mx = max(mx, translations[k * 4 + lane]);
+			}
+			for (uint32_t c = 0; c < 3; ++c)
+			{
+				center[c][lane] = float(mn[c] + mx[c]) * 0.5f;
+				scale[c][lane] = float(mx[c] - mn[c]) * 0.5f / c_quantizeRange;
+			}
+		}
+		for (uint32_t k = 0; k < keyCount; ++k)
+		{
+			for (uint32_t lane = 0; lane < 4; ++lane)
+			{
+				const Vector4& t = translations[k * 4 + lane];
+				for (uint32_t c = 0; c < 3; ++c)
+					qt[k * 12 + c * 4 + lane] = scale[c][lane] > 0.0f ? quantize((float(t[c]) - center[c][lane]) / scale[c][lane]) : 0;
+			}
+		}
+		for (uint32_t c = 0; c < 3; ++c)
+		{
+			group.translationCenter[c] = Vector4::loadUnaligned(center[c]);
+			group.translationScale[c] = Vector4::loadUnaligned(scale[c]);
+		}
+
+		// Reconstruct as sampling does, so error include quantization.
+		auto dequantizeRotation = [&](uint32_t k, uint32_t lane) {
+			const int16_t* p = &qr[k * 16 + lane];
+			return Vector4(p[0], p[4], p[8], p[12]);
+		};
+		auto dequantizeTranslation = [&](uint32_t k, uint32_t lane) {
+			const int16_t* p = &qt[k * 12 + lane];
+			return Vector4(
+				center[0][lane] + p[0] * scale[0][lane],
+				center[1][lane] + p[4] * scale[1][lane],
+				center[2][lane] + p[8] * scale[2][lane],
+				0.0f
+			);
+		};
+		auto fitsRotation = [&](const Vector4& r, uint32_t k, uint32_t lane) {
+			return abs(dot4(r.normalized(), rotations[k * 4 + lane].e)) >= cosHalfTolerance;
+		};
+		auto fitsTranslation = [&](const Vector4& t, uint32_t k, uint32_t lane) {
+			return (t - translations[k * 4 + lane]).length2() <= translationTolerance2;
+		};
+
+		// Rotation track.
+		bool constant = true;
+		for (uint32_t k = 1; k < keyCount && constant; ++k)
+		{
+			for (uint32_t lane = 0; lane < 4 && constant; ++lane)
+				constant = fitsRotation(dequantizeRotation(0, lane), k, lane);
+		}
+		if (!constant)
+		{
+			reduceKeys(keyCount, [&](uint32_t a, uint32_t c) {
+				for (uint32_t k = a + 1; k < c; ++k)
+				{
+					const Scalar f((times[k] - times[a]) / (times[c] - times[a]));
+					for (uint32_t lane = 0; lane < 4; ++lane)
+					{
+						if (!fitsRotation(lerp(dequantizeRotation(a, lane), dequantizeRotation(c, lane), f), k, lane))
+							return false;
+					}
+				}
+				return true;
+			}, keys);
+		}
+		else
+		{
+			keys.resize(0);
+			keys.push_back(0);
+		}
+
+		group.rotation.keyOffset = uint32_t(ca->m_times.size());
+		group.rotation.keyCount = uint32_t(keys.size());
+		group.rotation.dataOffset = uint32_t(ca->m_data.size());
+		for (auto key : keys)
+		{
+			ca->m_times.push_back(times[key]);
+			ca->m_data.insert(ca->m_data.end(), &qr[key * 16], &qr[key * 16] + 16);
+		}
+
+		// Translation track.
+		constant = true;
+		for (uint32_t k = 1; k < keyCount && constant; ++k)
+		{
+			for (uint32_t lane = 0; lane < 4 && constant; ++lane)
+				constant = fitsTranslation(dequantizeTranslation(0, lane), k, lane);
+		}
+		if (!constant)
+		{
+			reduceKeys(keyCount, [&](uint32_t a, uint32_t c) {
+				for (uint32_t k = a + 1; k < c; ++k)
+				{
+					const Scalar f((times[k] - times[a]) / (times[c] - times[a]));
+					for (uint32_t lane = 0; lane < 4; ++lane)
+					{
+						if (!fitsTranslation(lerp(dequantizeTranslation(a, lane), dequantizeTranslation(c, lane), f), k, lane))
+							return false;
+					}
+				}
+				return true;
+			}, keys);
+		}
+		else
+		{
+			keys.resize(0);
+			keys.push_back(0);
+		}
+
+		group.translation.keyOffset = uint32_t(ca->m_times.size());
+		group.translation.keyCount = uint32_t(keys.size());
+		group.translation.dataOffset = uint32_t(ca->m_data.size());
+		for (auto key : keys)
+		{
+			ca->m_times.push_back(times[key]);
+			ca->m_data.insert(ca->m_data.end(), &qt[key * 12], &qt[key * 12] + 12);
+		}
+	}
+
+	return ca;
+}
+
+void CompressedAnimation::sample(float at, Transform* outTransforms) const
+{
+	T_MATH_ALIGN16 float er[16];
+	T_MATH_ALIGN16 float et[16];
+
+	for (uint32_t g = 0; g < uint32_t(m_groups.size()); ++g)
+	{
+		const Group& group = m_groups[g];
+		Scalar k;
+
+		// Rotations; normalized linear interpolation of all four joints.
+		{
+			const uint32_t key = findKey(group.rotation, at, k);
+			const int16_t* d0 = &m_data[group.rotation.dataOffset + key * 16];
+
+			Vector4 x = load4(d0);
+			Vector4 y = load4(d0 + 4);
+			Vector4 z = load4(d0 + 8);
+			Vector4 w = load4(d0 + 12);
+
+			if (group.rotation.keyCount > 1)
+			{
+				const int16_t* d1 = d0 + 16;
+				x += (load4(d1) - x) * k;
+				y += (load4(d1 + 4) - y) * k;
+				z += (load4(d1 + 8) - z) * k;
+				w += (load4(d1 + 12) - w) * k;
+			}
+
+			const Vector4 il = reciprocalSqrt4(x * x + y * y + z * z + w * w);
+			Matrix44(x * il, y * il, z * il, w * il).transpose().storeAligned(er);
+		}
+
+		// Translations.
+		{
+			const uint32_t key = findKey(group.translation, at, k);
+			const int16_t* d0 = &m_data[group.translation.dataOffset + key * 12];
+
+			Vector4 x = load4(d0);
+			Vector4 y = load4(d0 + 4);
+			Vector4 z = load4(d0 + 8);
+
+			if (group.translation.keyCount > 1)
+			{
+				const int16_t* d1 = d0 + 12;
+				x += (load4(d1) - x) * k;
+				y += (load4(d1 + 4) - y) * k;
+				z += (load4(d1 + 8) - z) * k;
+			}
+
+			x = group.translationCenter[0] + x * group.translationScale[0];
+			y = group.translationCenter[1] + y * group.translationScale[1];
+			z = group.translationCenter[2] + z * group.translationScale[2];
+			Matrix44(x, y, z, Vector4::zero()).transpose().storeAligned(et);
+		}
+
+		for (uint32_t lane = 0; lane < 4; ++lane)
+		{
+			outTransforms[g * 4 + lane] = Transform(
+				Vector4::loadAligned(&et[lane * 4]),
+				Quaternion(Vector4::loadAligned(&er[lane * 4]))
+			);
+		}
+	}
+}
+
+void CompressedAnimation::sample(float at, Pose& outPose) const
+{
+	static thread_local AlignedVector< Transform > s_transforms;
+
+	s_transforms.resize(getPaddedJointCount());
+	sample(at, s_transforms.ptr());
+
+	outPose.reset();
+	outPose.reserve(m_jointCount);
+	for (uint32_t i = 0; i < m_jointCount; ++i)
+	{
+		if ((m_jointMask[i / 32] & (1U << (i & 31))) != 0)
+			outPose.setJointTransform(i, s_transforms[i]);
+	}
+}
+
+size_t CompressedAnimation::getDataSize() const
+{
+	return
+		m_jointMask.size() * sizeof(uint32_t) +
+		m_groups.size() * sizeof(Group) +
+		m_times.size() * sizeof(float) +
+		m_data.size() * sizeof(int16_t);
+}
+
+void CompressedAnimation::serialize(ISerializer& s)
+{
+	s >> Member< uint32_t >(L"jointCount", m_jointCount);
+	s >> Member< float >(L"startTime", m_startTime);
+	s >> Member< float >(L"endTime", m_endTime);
+	s >> MemberAlignedVector< uint32_t >(L"jointMask", m_jointMask);
+	s >> MemberAlignedVector< Group, MemberComposite< Group > >(L"groups", m_groups);
+	s >> MemberAlignedVector< float >(L"times", m_times);
+	s >> MemberAlignedVector< int16_t >(L"data", m_data);
+}
+
+uint32_t CompressedAnimation::findKey(const Track& track, float at, Scalar& outK) const
+{
+	if (track.keyCount <= 1)
+	{
+		outK = 0.0_simd;
+		return 0;
+	}
+
+	const float* times = &m_times[track.keyOffset];
+	const uint32_t key = uint32_t(std::upper_bound(times + 1, times + track.keyCount - 1, at) - times) - 1;
+
+	const float k = (at - times[key]) / (times[key + 1] - times[key]);
+	outK = Scalar(std::clamp(k, 0.0f, 1.0f));
+	return key;
+}
+
+void CompressedAnimation::Track::serialize(ISerializer& s)
+{
+	s >> Member< uint32_t >(L"keyOffset", keyOffset);
+	s >> Member< uint32_t >(L"keyCount", keyCount);
+	s >> Member< uint32_t >(L"dataOffset", dataOffset);
+}
+
+void CompressedAnimation::Group::serialize(ISerializer& s)
+{
+	s >> MemberComposite< Track >(L"rotation", rotation);
+	s >> MemberComposite< Track >(L"translation", translation);
+	s >> MemberStaticArray< Vector4, 3 >(L"translationCenter", translationCenter);
+	s >> MemberStaticArray< Vector4, 3 >(L"translationScale", translationScale);
+}
+
+}
@@ -0,0 +1,131 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "Core/Ref.h"
+#include "Core/Containers/AlignedVector.h"
+#include "Core/Math/Transform.h"
+#include "Core/Serialization/ISerializable.h"
+
+// import/export mechanism.
+#undef T_DLLCLASS
+#if defined(T_ANIMATION_EXPORT)
+#	define T_DLLCLASS T_DLLEXPORT
+#else
+#	define T_DLLCLASS T_DLLIMPORT
+#endif
+
+namespace traktor::animation
+{
+
+class Pose;
+
+/*! Compressed key framed animation.
+ * \ingroup Animation
+ *
+ * Joints are packed into groups of four and each group
+ * has one rotation and one translation track, stored as
+ * structure of arrays with 16-bit quantized components.
+ * Tracks which doesn't change are reduced to a single key
+ * and keys which can be reconstructed, within tolerance, by
+ * interpolating their neighbours are discarded thus each
+ * track has it's own set of key times.
+ *
+ * Sampling decompress and interpolate all four joints
+ * of a group at once.
+ */
+class T_DLLCLASS CompressedAnimation : public ISerializable
+{
+	T_RTTI_CLASS;
+
+public:
+	/*! Compress key poses.
+	 *
+	 * \param times Key times, sorted.
+	 * \param poses Key poses, one for each key time.
+	 * \param keyCount Number of keys.
+	 * \param rotationTolerance Max rotation error, in radians.
+	 * \param translationTolerance Max translation error.
+	 * \return Compressed animation.
+	 */
+	static Ref< CompressedAnimation > compress(
+		const float* times,
+		const Pose* const* poses,
+		uint32_t keyCount,
+		float rotationTolerance,
+		float translationTolerance
+	);
+
+	/*! Sample local joint transforms.
+	 *
+	 * \param at Time.
+	 * \param outTransforms Output transforms, must have room for padded joint count.
+	 */
+	void sample(float at, Transform* outTransforms) const;
+
+	/*! Sample pose.
+	 *
+	 * Only joints which are present in source
+	 * key poses are set in output pose.
+	 *
+	 * \param at Time.
+	 * \param outPose Output pose.
+	 */
+	void sample(float at, Pose& outPose) const;
+
+	/*! Number of joints, including unused. */
+	uint32_t getJointCount() const { return m_jointCount; }
+
+	/*! Number of joints rounded up to group size. */
+	uint32_t getPaddedJointCount() const { return uint32_t(m_groups.size() * 4); }
+
+	float getStartTime() const { return m_startTime; }
+
+	float getEndTime() const { return m_endTime; }
+
+	/*! Number of keys in all tracks. */
+	uint32_t getTrackKeyCount() const { return uint32_t(m_times.size()); }
+
+	/*! Size of compressed data in bytes. */
+	size_t getDataSize() const;
+
+	virtual void serialize(ISerializer& s) override final;
+
+private:
+	struct Track
+	{
+		uint32_t keyOffset = 0;	//!< Offset into key times.
+		uint32_t keyCount = 0;
+		uint32_t dataOffset = 0;	//!< Offset into quantized data.
+
+		void serialize(ISerializer& s);
+	};
+
+	struct Group
+	{
+		Track rotation;
+		Track translation;
+		Vector4 translationCenter[3];	//!< Dequantization center, xxxx yyyy zzzz.
+		Vector4 translationScale[3];	//!< Dequantization scale, xxxx yyyy zzzz.
+
+		void serialize(ISerializer& s);
+	};
+
+	uint32_t m_jointCount = 0;
+	float m_startTime = 0.0f;
+	float m_endTime = 0.0f;
+	AlignedVector< uint32_t > m_jointMask;
+	AlignedVector< Group > m_groups;
+	AlignedVector< float > m_times;
+	AlignedVector< int16_t > m_data;
+
+	uint32_t findKey(const Track& track, float at, Scalar& outK) const;
+};
+
+}
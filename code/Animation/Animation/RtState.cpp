@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2025 Anders Pistol.
+ * Copyright (c) 2025-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -25,11 +25,10 @@ bool RtState::prepare(StateContext& outContext) const
 {
 	if (m_animation)
 	{
-		const uint32_t poseCount = m_animation->getKeyPoseCount();
-		if (poseCount < 1)
+		if (m_animation->empty())
 			return false;
 
-		const float duration = m_animation->getKeyPose(poseCount - 1).at;
+		const float duration = m_animation->getEndTime();
 
 		outContext.setTime(0.0f);
 		outContext.setDuration(duration);
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2023 Anders Pistol.
+ * Copyright (c) 2023-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -31,7 +31,7 @@ void TimeFromLocomotion::calculateTime(const Animation* animation, const Transfo
 	m_time += outDeltaTime;
 
 	// Ensure time is always positive.
-	const float duration = animation->getLastKeyPose().at - animation->getKeyPose(0).at;
+	const float duration = animation->getEndTime() - animation->getStartTime();
 	while (m_time < 0.0f)
 		m_time += duration;
 
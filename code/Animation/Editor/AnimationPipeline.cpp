@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2025 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -11,6 +11,7 @@
 #include "Animation/Skeleton.h"
 #include "Animation/SkeletonUtils.h"
 #include "Animation/Animation/Animation.h"
+#include "Animation/Animation/CompressedAnimation.h"
 #include "Animation/Editor/AnimationAsset.h"
 #include "Animation/Editor/AnimationPipeline.h"
 #include "Animation/Editor/SkeletonAsset.h"
@@ -20,6 +21,8 @@
 #include "Core/Math/Format.h"
 #include "Core/Misc/String.h"
 #include "Core/Serialization/DeepHash.h"
+#include "Core/Settings/PropertyBoolean.h"
+#include "Core/Settings/PropertyFloat.h"
 #include "Core/Settings/PropertyString.h"
 #include "Database/Instance.h"
 #include "Editor/IPipelineBuilder.h"
@@ -34,12 +37,15 @@
 namespace traktor::animation
 {
 
-T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.animation.AnimationPipeline", 16, AnimationPipeline, editor::IPipeline)
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.animation.AnimationPipeline", 17, AnimationPipeline, editor::IPipeline)
 
 bool AnimationPipeline::create(const editor::IPipelineSettings* settings, db::Database* database)
 {
 	m_assetPath = settings->getPropertyExcludeHash< std::wstring >(L"Pipeline.AssetPath", L"");
 	m_modelCachePath = settings->getPropertyExcludeHash< std::wstring >(L"Pipeline.ModelCache.Path");
+	m_compress = settings->getPropertyIncludeHash< bool >(L"AnimationPipeline.Compress", true);
+	m_rotationTolerance = settings->getPropertyIncludeHash< float >(L"AnimationPipeline.RotationTolerance", 0.001f);
+	m_translationTolerance = settings->getPropertyIncludeHash< float >(L"AnimationPipeline.TranslationTolerance", 0.0005f);
 	return true;
 }
 
@@ -353,6 +359,23 @@ bool AnimationPipeline::buildOutput(
 		log::info << L"Removed " << (uncompressedCount - anim->getKeyPoseCount()) << L" redundant key poses in animation; was " << uncompressedCount << L", now " << anim->getKeyPoseCount() << Endl;
 	*/
 
+	// Compress key poses into quantized, key reduced, tracks.
+	if (m_compress && !anim->empty())
+	{
+		const uint32_t keyPoseCount = anim->getKeyPoseCount();
+		const uint32_t jointCount = anim->getKeyPose(0).pose.getMaxIndex() + 1;
+		const size_t uncompressedSize = keyPoseCount * jointCount * sizeof(Transform);
+
+		if (!anim->compress(m_rotationTolerance, m_translationTolerance))
+		{
+			log::error << L"Unable to build animation; failed to compress animation." << Endl;
+			return false;
+		}
+
+		const CompressedAnimation* compressed = anim->getCompressed();
+		log::info << L"Compressed animation " << keyPoseCount << L" key pose(s), " << jointCount << L" joint(s); " << compressed->getTrackKeyCount() << L" track key(s), " << uncompressedSize << L" -> " << compressed->getDataSize() << L" byte(s)." << Endl;
+	}
+
 	Ref< db::Instance > instance = pipelineBuilder->createOutputInstance(outputPath, outputGuid);
 	if (!instance)
 	{
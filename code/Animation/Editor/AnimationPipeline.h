@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -69,6 +69,9 @@ public:
 private:
 	std::wstring m_assetPath;
 	std::wstring m_modelCachePath;
+	bool m_compress = true;
+	float m_rotationTolerance = 0.001f;
+	float m_translationTolerance = 0.0005f;
 };
 
 }
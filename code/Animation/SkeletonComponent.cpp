@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2025 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -13,15 +13,20 @@
 #include "Animation/Skeleton.h"
 #include "Animation/SkeletonUtils.h"
 #include "Core/Misc/SafeDestroy.h"
-#include "Core/Thread/JobManager.h"
 #include "World/Entity.h"
+#include "World/World.h"
 
 #include <cmath>
 
-//#define T_USE_UPDATE_JOBS
-
 namespace traktor::animation
 {
+namespace
+{
+
+/*! Number of skeletons evaluated in each batch, evaluating a pose is fairly expensive. */
+const size_t c_skeletonBatchSize = 4;
+
+}
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.animation.SkeletonComponent", SkeletonComponent, world::IEntityComponent)
 
@@ -46,7 +51,7 @@ SkeletonComponent::SkeletonComponent(
 
 void SkeletonComponent::destroy()
 {
-	synchronize();
+	setWorld(nullptr);
 	safeDestroy(m_poseController);
 }
 
@@ -54,6 +59,33 @@ void SkeletonComponent::setOwner(world::Entity* owner)
 {
 }
 
+void SkeletonComponent::setWorld(world::World* world)
+{
+	if (m_evaluateArray)
+	{
+		m_evaluateArray->release(m_evaluateHandle);
+		m_evaluateArray = nullptr;
+	}
+
+	world::WorldComponentStorage* storage = (world != nullptr) ? world->getComponentStorage() : nullptr;
+	if (storage)
+	{
+		m_evaluateArray = storage->getArray< SkeletonComponent* >(
+			type_of< SkeletonComponent >(),
+			[](SkeletonComponent** skeletons, size_t count, const world::UpdateParams& update) {
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (skeletons[i] != nullptr)
+						skeletons[i]->updatePoseController(update.alternateTime, update.deltaTime);
+				}
+			},
+			world::WorldComponentStorage::Stage::BeforeEntities
+		);
+		m_evaluateArray->setBatchSize(c_skeletonBatchSize);
+		m_evaluateHandle = m_evaluateArray->allocate(this);
+	}
+}
+
 void SkeletonComponent::setTransform(const Transform& transform)
 {
 	m_transform = transform;
@@ -65,8 +97,6 @@ void SkeletonComponent::setTransform(const Transform& transform)
 
 Aabb3 SkeletonComponent::getBoundingBox() const
 {
-	synchronize();
-
 	Aabb3 boundingBox;
 	if (!m_poseTransforms.empty())
 	{
@@ -83,42 +113,9 @@ Aabb3 SkeletonComponent::getBoundingBox() const
 
 void SkeletonComponent::update(const world::UpdateParams& update)
 {
-	synchronize();
-
-	// Calculate original bone transforms in object space.
-	if (m_skeleton.changed())
-	{
-		m_jointTransforms.resize(0);
-		m_poseTransforms.resize(0);
-
-		if (m_skeleton)
-			calculateJointTransforms(
-				m_skeleton,
-				m_jointTransforms);
-
-		m_poseTransforms.reserve(m_jointTransforms.size());
-		m_skeleton.consume();
-		m_revision++;
-	}
-
-#if defined(T_USE_UPDATE_JOBS)
-	m_updatePoseControllerJob = JobManager::getInstance().add([=, this]() {
+	// Pose already evaluated by world, in batch with other skeletons.
+	if (!m_evaluateArray)
 		updatePoseController(update.alternateTime, update.deltaTime);
-	});
-#else
-	updatePoseController(update.alternateTime, update.deltaTime);
-#endif
-}
-
-void SkeletonComponent::synchronize() const
-{
-#if defined(T_USE_UPDATE_JOBS)
-	if (m_updatePoseControllerJob)
-	{
-		m_updatePoseControllerJob->wait();
-		m_updatePoseControllerJob = nullptr;
-	}
-#endif
 }
 
 bool SkeletonComponent::getJointTransform(render::handle_t jointName, Transform& outTransform) const
@@ -140,8 +137,6 @@ bool SkeletonComponent::getPoseTransform(render::handle_t jointName, Transform&
 	if (!m_skeleton->findJoint(jointName, index))
 		return false;
 
-	synchronize();
-
 	if (index >= m_poseTransforms.size())
 		return false;
 
@@ -155,8 +150,6 @@ bool SkeletonComponent::setPoseTransform(render::handle_t jointName, const Trans
 	if (!m_skeleton->findJoint(jointName, index))
 		return false;
 
-	synchronize();
-
 	if (index >= m_jointTransforms.size())
 		return false;
 
@@ -183,8 +176,6 @@ bool SkeletonComponent::concatenatePoseTransform(render::handle_t jointName, con
 	if (!m_skeleton->findJoint(jointName, index))
 		return false;
 
-	synchronize();
-
 	if (index >= m_jointTransforms.size())
 		return false;
 
@@ -204,8 +195,29 @@ bool SkeletonComponent::concatenatePoseTransform(render::handle_t jointName, con
 	return true;
 }
 
+void SkeletonComponent::updateSkeleton()
+{
+	// Calculate original bone transforms in object space.
+	if (m_skeleton.changed())
+	{
+		m_jointTransforms.resize(0);
+		m_poseTransforms.resize(0);
+
+		if (m_skeleton)
+			calculateJointTransforms(
+				m_skeleton,
+				m_jointTransforms);
+
+		m_poseTransforms.reserve(m_jointTransforms.size());
+		m_skeleton.consume();
+		m_revision++;
+	}
+}
+
 void SkeletonComponent::updatePoseController(double time, double deltaTime)
 {
+	updateSkeleton();
+
 	// Calculate pose transforms and skinning transforms.
 	if (m_skeleton && m_poseController)
 	{
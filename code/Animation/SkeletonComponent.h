@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -10,10 +10,10 @@
 
 #include "Animation/Pose.h"
 #include "Core/Containers/AlignedVector.h"
-#include "Core/Thread/Job.h"
 #include "Render/Types.h"
 #include "Resource/Proxy.h"
 #include "World/IEntityComponent.h"
+#include "World/WorldComponentStorage.h"
 
 // import/export mechanism.
 #undef T_DLLCLASS
@@ -31,6 +31,11 @@ class IPoseController;
 
 /*! Skeleton entity component.
  * \ingroup Animation
+ *
+ * When world has component storage, pose controllers
+ * of all skeletons are evaluated in parallel batches
+ * before entities are updated; otherwise pose is evaluated
+ * when component is updated.
  */
 class T_DLLCLASS SkeletonComponent : public world::IEntityComponent
 {
@@ -46,14 +51,14 @@ public:
 
 	virtual void setOwner(world::Entity* owner) override final;
 
+	virtual void setWorld(world::World* world) override final;
+
 	virtual void setTransform(const Transform& transform) override final;
 
 	virtual Aabb3 getBoundingBox() const override final;
 
 	virtual void update(const world::UpdateParams& update) override final;
 
-	void synchronize() const;
-
 	/*! Get base transform of joint. */
 	bool getJointTransform(render::handle_t jointName, Transform& outTransform) const;
 
@@ -93,9 +98,12 @@ private:
 	Ref< IPoseController > m_poseController;
 	AlignedVector< Transform > m_jointTransforms;
 	AlignedVector< Transform > m_poseTransforms;
-	mutable Ref< Job > m_updatePoseControllerJob;
+	world::WorldComponentArray< SkeletonComponent* >* m_evaluateArray = nullptr;
+	uint32_t m_evaluateHandle = 0;
 	std::atomic< int32_t > m_revision;
 
+	void updateSkeleton();
+
 	void updatePoseController(double time, double deltaTime);
 };
 
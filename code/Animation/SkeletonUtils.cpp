@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -68,15 +68,27 @@ void calculatePoseTransforms(
 	T_ASSERT(skeleton);
 	T_ASSERT(pose);
 
-	AlignedVector< Transform > localPoseTransforms;
-	calculatePoseLocalTransforms(skeleton, pose, localPoseTransforms);
+	static thread_local AlignedVector< Transform > s_localPoseTransforms;
+	calculatePoseLocalTransforms(skeleton, pose, s_localPoseTransforms);
 
-	outJointTransforms.resize(skeleton->getJointCount());
-	for (uint32_t i = 0; i < skeleton->getJointCount(); ++i)
+	// Skeletons are normally ordered with parents before their children thus
+	// concatenate with parent's already calculated transform; walk parent chain
+	// only for joints which are ordered before their parent.
+	const uint32_t jointCount = skeleton->getJointCount();
+	outJointTransforms.resize(jointCount);
+	for (uint32_t i = 0; i < jointCount; ++i)
 	{
-		outJointTransforms[i] = localPoseTransforms[i];
-		for (int32_t parentIndex = skeleton->getJoint(i)->getParent(); parentIndex >= 0; parentIndex = skeleton->getJoint(parentIndex)->getParent())
-			outJointTransforms[i] = localPoseTransforms[parentIndex] * outJointTransforms[i];
+		const int32_t parentIndex = skeleton->getJoint(i)->getParent();
+		if (parentIndex < 0)
+			outJointTransforms[i] = s_localPoseTransforms[i];
+		else if (parentIndex < int32_t(i))
+			outJointTransforms[i] = outJointTransforms[parentIndex] * s_localPoseTransforms[i];
+		else
+		{
+			outJointTransforms[i] = s_localPoseTransforms[i];
+			for (int32_t index = parentIndex; index >= 0; index = skeleton->getJoint(index)->getParent())
+				outJointTransforms[i] = s_localPoseTransforms[index] * outJointTransforms[i];
+		}
 	}
 }
 
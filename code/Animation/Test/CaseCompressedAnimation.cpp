@@ -0,0 +1,151 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "Animation/Test/CaseCompressedAnimation.h"
+
+#include "Animation/BitSet.h"
+#include "Animation/Pose.h"
+#include "Animation/Animation/CompressedAnimation.h"
+#include "Core/RefArray.h"
+#include "Core/Io/DynamicMemoryStream.h"
+#include "Core/Io/StringOutputStream.h"
+#include "Core/Math/Const.h"
+#include "Core/Serialization/BinarySerializer.h"
+#include "Core/Timer/Timer.h"
+
+#include <cmath>
+
+namespace traktor::animation::test
+{
+namespace
+{
+
+const uint32_t c_jointCount = 40;
+const uint32_t c_keyCount = 120;
+const float c_keyInterval = 1.0f / 30.0f;
+const float c_rotationTolerance = 0.01f;
+const float c_translationTolerance = 0.001f;
+const int32_t c_sampleIterations = 1000;
+
+/*! Joints present in poses; gaps and joint 31 exercise joint mask. */
+bool havePoseJoint(uint32_t joint)
+{
+	return joint != 5 && joint != 30 && joint != 32;
+}
+
+/*! Smooth motion, some joints are constant. */
+Transform poseJointTransform(uint32_t joint, float time)
+{
+	if ((joint % 7) == 3)
+		return Transform(Vector4(float(joint), 0.0f, 0.0f), Quaternion::fromEulerAngles(0.1f * joint, 0.0f, 0.0f));
+
+	const float phase = joint * 0.37f;
+	return Transform(
+		Vector4(std::sin(time * 2.0f + phase) * 0.5f, float(joint), std::cos(time * 3.0f + phase) * 0.25f),
+		Quaternion::fromEulerAngles(std::sin(time + phase) * PI, std::cos(time * 2.0f + phase) * HALF_PI * 0.5f, time * 0.5f)
+	);
+}
+
+/*! Angle between rotations. */
+float rotationError(const Quaternion& a, const Quaternion& b)
+{
+	const float d = std::min(std::abs(float(dot4(a.normalized().e, b.normalized().e))), 1.0f);
+	return 2.0f * std::acos(d);
+}
+
+}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.animation.test.CaseCompressedAnimation", 0, CaseCompressedAnimation, traktor::test::Case)
+
+void CaseCompressedAnimation::run()
+{
+	AlignedVector< float > times(c_keyCount);
+	RefArray< Pose > poses;
+	AlignedVector< const Pose* > posePtrs;
+	for (uint32_t k = 0; k < c_keyCount; ++k)
+	{
+		times[k] = k * c_keyInterval;
+
+		Ref< Pose > pose = new Pose();
+		for (uint32_t j = 0; j < c_jointCount; ++j)
+		{
+			if (havePoseJoint(j))
+				pose->setJointTransform(j, poseJointTransform(j, times[k]));
+		}
+		poses.push_back(pose);
+		posePtrs.push_back(pose);
+	}
+
+	Ref< CompressedAnimation > ca = CompressedAnimation::compress(times.c_ptr(), posePtrs.c_ptr(), c_keyCount, c_rotationTolerance, c_translationTolerance);
+	CASE_ASSERT_NOT_EQUAL(ca, nullptr);
+	if (!ca)
+		return;
+
+	CASE_ASSERT_EQUAL(ca->getJointCount(), c_jointCount);
+	CASE_ASSERT_EQUAL(ca->getPaddedJointCount(), c_jointCount);
+	CASE_ASSERT_EQUAL(ca->getStartTime(), times.front());
+	CASE_ASSERT_EQUAL(ca->getEndTime(), times.back());
+
+	// Constant and smooth tracks must be reduced.
+	const uint32_t groupCount = (c_jointCount + 3) / 4;
+	CASE_ASSERT(ca->getTrackKeyCount() < groupCount * 2 * c_keyCount);
+
+	// Round trip through serialization.
+	DynamicMemoryStream wms(false, true);
+	CASE_ASSERT(BinarySerializer(&wms).writeObject(ca));
+	DynamicMemoryStream rms(wms.getBuffer(), true, false);
+	Ref< CompressedAnimation > rca = BinarySerializer(&rms).readObject< CompressedAnimation >();
+	CASE_ASSERT_NOT_EQUAL(rca, nullptr);
+	if (!rca)
+		return;
+
+	// Sampled key poses must be within tolerance, with some slack for quantization of end points.
+	float maxRotationError = 0.0f;
+	float maxTranslationError = 0.0f;
+	bool jointsMasked = true;
+	Pose pose;
+	for (uint32_t k = 0; k < c_keyCount; ++k)
+	{
+		rca->sample(times[k], pose);
+
+		BitSet indices;
+		pose.getIndexMask(indices);
+
+		for (uint32_t j = 0; j < c_jointCount; ++j)
+		{
+			jointsMasked &= (indices(j) == havePoseJoint(j));
+			if (!havePoseJoint(j))
+				continue;
+
+			const Transform sampled = pose.getJointTransform(j);
+			const Transform expected = poseJointTransform(j, times[k]);
+			maxRotationError = std::max(maxRotationError, rotationError(sampled.rotation(), expected.rotation()));
+			maxTranslationError = std::max(maxTranslationError, float((sampled.translation() - expected.translation()).xyz0().length()));
+		}
+	}
+	CASE_ASSERT(jointsMasked);
+	CASE_ASSERT(maxRotationError <= c_rotationTolerance * 1.1f);
+	CASE_ASSERT(maxTranslationError <= c_translationTolerance * 1.1f);
+
+	// Sampling outside of range clamps to first and last key.
+	rca->sample(times.back() + 10.0f, pose);
+	CASE_ASSERT(rotationError(pose.getJointTransform(1).rotation(), poseJointTransform(1, times.back()).rotation()) <= c_rotationTolerance * 1.1f);
+
+	// Measure sampling of all joints.
+	AlignedVector< Transform > transforms(rca->getPaddedJointCount());
+	Timer timer;
+	for (int32_t i = 0; i < c_sampleIterations; ++i)
+		rca->sample(times.back() * i / c_sampleIterations, transforms.ptr());
+	const double sampleTime = timer.getElapsedTime();
+
+	StringOutputStream ss;
+	ss << L"Compressed " << c_keyCount << L" keys of " << c_jointCount << L" joints into " << uint32_t(rca->getDataSize()) << L" bytes, " << rca->getTrackKeyCount() << L" track keys; sample " << int32_t(sampleTime * 1000000000.0 / c_sampleIterations) << L" ns";
+	succeeded(ss.str());
+}
+
+}
@@ -0,0 +1,191 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "Animation/Test/CaseSkeletonComponent.h"
+
+#include "Animation/IPoseController.h"
+#include "Animation/Joint.h"
+#include "Animation/Skeleton.h"
+#include "Animation/SkeletonComponent.h"
+#include "Core/RefArray.h"
+#include "Core/Thread/Atomic.h"
+#include "Resource/IResourceManager.h"
+#include "Resource/ResourceHandle.h"
+#include "World/Entity.h"
+#include "World/World.h"
+#include "World/WorldComponentStorage.h"
+
+namespace traktor::animation::test
+{
+namespace
+{
+
+const uint32_t c_skeletonCount = 100;
+const int32_t c_updateCount = 4;
+
+/*! Resource manager which doesn't have any resources, world only bind optional resources. */
+class EmptyResourceManager : public resource::IResourceManager
+{
+public:
+	virtual void destroy() override final {}
+
+	virtual void addFactory(const resource::IResourceFactory* factory) override final {}
+
+	virtual void removeFactory(const resource::IResourceFactory* factory) override final {}
+
+	virtual void removeAllFactories() override final {}
+
+	virtual bool load(const resource::ResourceBundle* bundle) override final { return false; }
+
+	virtual Ref< resource::ResourceHandle > bind(const TypeInfo& productType, const Guid& guid) override final { return nullptr; }
+
+	virtual Ref< resource::ResourceHandle > bindAsync(const TypeInfo& productType, const Guid& guid, float priority) override final { return nullptr; }
+
+	virtual void setPlaceholder(const TypeInfo& productType, Object* placeholder) override final {}
+
+	virtual bool wait(float minimumPriority, int32_t timeout) override final { return true; }
+
+	virtual bool reload(const Guid& guid, bool flushedOnly) override final { return false; }
+
+	virtual void reload(const TypeInfo& productType, bool flushedOnly) override final {}
+
+	virtual void unload(const TypeInfo& productType) override final {}
+
+	virtual void unloadUnusedResident() override final {}
+
+	virtual void setBudget(const TypeInfo& productType, uint64_t budget) override final {}
+
+	virtual void update() override final {}
+
+	virtual void getStatistics(resource::ResourceManagerStatistics& outStatistics) const override final {}
+};
+
+/*! Pose controller which count number of evaluations. */
+class CountingPoseController : public IPoseController
+{
+public:
+	int32_t evaluated = 0;
+
+	virtual void destroy() override final {}
+
+	virtual void setTransform(const Transform& transform) override final {}
+
+	virtual bool evaluate(
+		float time,
+		float deltaTime,
+		const Transform& worldTransform,
+		const Skeleton* skeleton,
+		const AlignedVector< Transform >& jointTransforms,
+		AlignedVector< Transform >& outPoseTransforms
+	) override final
+	{
+		Atomic::increment(evaluated);
+		outPoseTransforms = jointTransforms;
+		return true;
+	}
+};
+
+}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.animation.test.CaseSkeletonComponent", 0, CaseSkeletonComponent, traktor::test::Case)
+
+void CaseSkeletonComponent::run()
+{
+	Ref< Skeleton > skeleton = new Skeleton();
+	for (int32_t i = 0; i < 8; ++i)
+	{
+		Ref< Joint > joint = new Joint();
+		joint->setParent(i - 1);
+		joint->setTransform(Transform(Vector4(0.0f, 1.0f, 0.0f)));
+		skeleton->addJoint(joint);
+	}
+
+	EmptyResourceManager resourceManager;
+
+	for (int32_t storage = 0; storage < 2; ++storage)
+	{
+		Ref< world::World > world = new world::World(&resourceManager, nullptr, storage != 0);
+		CASE_ASSERT_EQUAL(world->getComponentStorage() != nullptr, storage != 0);
+
+		RefArray< world::Entity > entities;
+		RefArray< CountingPoseController > poseControllers;
+		for (uint32_t i = 0; i < c_skeletonCount; ++i)
+		{
+			Ref< CountingPoseController > poseController = new CountingPoseController();
+			Ref< world::Entity > entity = new world::Entity(Guid(), L"", Transform::identity());
+			entity->setComponent(new SkeletonComponent(Transform::identity(), resource::Proxy< Skeleton >(skeleton), poseController));
+			world->addEntity(entity);
+			entities.push_back(entity);
+			poseControllers.push_back(poseController);
+		}
+
+		world::WorldComponentArray< SkeletonComponent* >* evaluateArray = nullptr;
+		if (world->getComponentStorage())
+		{
+			evaluateArray = world->getComponentStorage()->getArray< SkeletonComponent* >(type_of< SkeletonComponent >());
+			CASE_ASSERT_EQUAL(evaluateArray->size(), c_skeletonCount);
+		}
+
+		// Each skeleton must be evaluated exactly once per update, either in batch or from entity.
+		world::UpdateParams update;
+		for (uint32_t i = 0; i < c_updateCount; ++i)
+		{
+			update.totalTime = update.alternateTime = i / 60.0;
+			update.deltaTime = 1.0 / 60.0;
+			world->update(update);
+		}
+
+		bool evaluatedOnce = true;
+		for (auto poseController : poseControllers)
+			evaluatedOnce &= (poseController->evaluated == 1 + c_updateCount);	// Pose is also evaluated when component is created.
+		CASE_ASSERT(evaluatedOnce);
+
+		// Pose must be available after update.
+		CASE_ASSERT_EQUAL(entities.back()->getComponent< SkeletonComponent >()->getPoseTransforms().size(), 8);
+
+		// Removed entities must release their slots and no longer be evaluated.
+		for (uint32_t i = 0; i < c_skeletonCount / 2; ++i)
+			world->removeEntity(entities[i]);
+		if (evaluateArray)
+			CASE_ASSERT_EQUAL(evaluateArray->size(), c_skeletonCount / 2);
+
+		world->update(update);
+
+		bool removedSkipped = true, remainingEvaluated = true;
+		for (uint32_t i = 0; i < c_skeletonCount; ++i)
+		{
+			if (i < c_skeletonCount / 2)
+				removedSkipped &= (poseControllers[i]->evaluated == 1 + c_updateCount);
+			else
+				remainingEvaluated &= (poseControllers[i]->evaluated == 2 + c_updateCount);
+		}
+		CASE_ASSERT(removedSkipped);
+		CASE_ASSERT(remainingEvaluated);
+
+		// Replaced component must release its slot to the new component.
+		Ref< CountingPoseController > replacedPoseController = new CountingPoseController();
+		entities.back()->setComponent(new SkeletonComponent(Transform::identity(), resource::Proxy< Skeleton >(skeleton), replacedPoseController));
+		if (evaluateArray)
+			CASE_ASSERT_EQUAL(evaluateArray->size(), c_skeletonCount / 2);
+
+		world->update(update);
+		CASE_ASSERT_EQUAL(poseControllers.back()->evaluated, 2 + c_updateCount);
+		CASE_ASSERT_EQUAL(replacedPoseController->evaluated, 2);
+
+		for (uint32_t i = c_skeletonCount / 2; i < c_skeletonCount; ++i)
+			world->removeEntity(entities[i]);
+		if (evaluateArray)
+			CASE_ASSERT_EQUAL(evaluateArray->size(), 0);
+
+		for (auto entity : entities)
+			entity->destroy();
+		world->destroy();
+	}
+}
+
+}
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -45,6 +45,8 @@ public:
 
 	virtual DateTime lastAccessed() const override final;
 
+	const Path& getPath() const { return m_path; }
+
 private:
     Path m_path;
 	int64_t m_size;
@@ -1,11 +1,14 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
+#include <algorithm>
+#include "Core/Io/DynamicMemoryStream.h"
+#include "Core/Io/MemoryStream.h"
 #include "Core/Log/Log.h"
 #include "Core/Thread/Acquire.h"
 #include "Avalanche/Protocol.h"
@@ -206,6 +209,52 @@ Ref< IStream > Client::get(const Key& key)
 	return new ClientGetStream(this, stream, blobSize);
 }
 
+bool Client::have(const AlignedVector< Key >& keys, AlignedVector< int64_t >& outSizes)
+{
+	outSizes.resize(keys.size());
+
+	// Split into several requests if there are more keys than server accept in a single batch.
+	for (size_t offset = 0; offset < keys.size(); offset += c_maxBatchKeys)
+	{
+		const size_t count = std::min< size_t >(keys.size() - offset, c_maxBatchKeys);
+		if (!haveBatch(keys, offset, count, outSizes))
+			return false;
+	}
+	return true;
+}
+
+bool Client::get(const AlignedVector< Key >& keys, const std::function< void (size_t index, IStream* stream) >& receiver)
+{
+	for (size_t offset = 0; offset < keys.size(); offset += c_maxBatchKeys)
+	{
+		const size_t count = std::min< size_t >(keys.size() - offset, c_maxBatchKeys);
+		if (!getBatch(keys, offset, count, receiver))
+			return false;
+	}
+	return true;
+}
+
+bool Client::version(int32_t& outMajor, int32_t& outMinor)
+{
+	Ref< net::SocketStream > stream = establish(c_commandVersion);
+	if (!stream)
+		return false;
+
+	// Servers prior to batch commands doesn't recognize command and terminate connection.
+	int32_t version[2];
+	if (stream->read(version, sizeof(version)) != sizeof(version))
+		return false;
+
+	outMajor = version[0];
+	outMinor = version[1];
+
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+		m_streams.push_back(stream);
+	}
+	return true;
+}
+
 Ref< IStream > Client::put(const Key& key)
 {
 	Ref< net::SocketStream > stream = establish(c_commandPut);
@@ -306,6 +355,10 @@ Ref< net::SocketStream > Client::establish(uint8_t command)
 		return nullptr;
 	}
 
+	// Requests are written in several small chunks; disable Nagle
+	// so they aren't held back waiting for acknowledgement.
+	socket->setNoDelay(true);
+
 	Ref< net::SocketStream > stream = new net::SocketStream(socket, true, true, 5000);
 	if (stream->write(&command, sizeof(uint8_t)) != sizeof(uint8_t))
 	{
@@ -316,4 +369,120 @@ Ref< net::SocketStream > Client::establish(uint8_t command)
 	return stream;
 }
 
+bool Client::haveBatch(const AlignedVector< Key >& keys, size_t offset, size_t count, AlignedVector< int64_t >& outSizes)
+{
+	Ref< net::SocketStream > stream = establish(c_commandStatBatch);
+	if (!stream)
+		return false;
+
+	if (!writeKeys(stream, keys, offset, count))
+	{
+		log::error << L"Unable to write keys to server (have)." << Endl;
+		return false;
+	}
+
+	for (size_t i = offset; i < offset + count; ++i)
+	{
+		uint8_t reply = 0;
+		if (stream->read(&reply, sizeof(uint8_t)) != sizeof(uint8_t))
+		{
+			log::error << L"Unable to read reply from server (have)." << Endl;
+			return false;
+		}
+
+		if (reply == c_replyOk)
+		{
+			if (stream->read(&outSizes[i], sizeof(int64_t)) != sizeof(int64_t))
+			{
+				log::error << L"Unable to read blob size from server (have)." << Endl;
+				return false;
+			}
+		}
+		else if (reply == c_replyFailure)
+			outSizes[i] = -1;
+		else
+			return false;
+	}
+
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+		m_streams.push_back(stream);
+	}
+	return true;
+}
+
+bool Client::getBatch(const AlignedVector< Key >& keys, size_t offset, size_t count, const std::function< void (size_t index, IStream* stream) >& receiver)
+{
+	Ref< net::SocketStream > stream = establish(c_commandGetBatch);
+	if (!stream)
+		return false;
+
+	if (!writeKeys(stream, keys, offset, count))
+	{
+		log::error << L"Unable to write keys to server (get)." << Endl;
+		return false;
+	}
+
+	AlignedVector< uint8_t > blob;
+	for (size_t i = offset; i < offset + count; ++i)
+	{
+		uint8_t reply = 0;
+		if (stream->read(&reply, sizeof(uint8_t)) != sizeof(uint8_t))
+		{
+			log::error << L"Unable to read reply from server (get)." << Endl;
+			return false;
+		}
+
+		if (reply != c_replyOk)
+		{
+			if (reply != c_replyFailure)
+				return false;
+			receiver(i, nullptr);
+			continue;
+		}
+
+		int64_t blobSize = 0;
+		if (stream->read(&blobSize, sizeof(int64_t)) != sizeof(int64_t) || blobSize < 0)
+		{
+			log::error << L"Unable to read blob size from server (get)." << Endl;
+			return false;
+		}
+
+		blob.resize((size_t)blobSize);
+		if (blobSize > 0 && stream->read(blob.ptr(), blobSize) != blobSize)
+		{
+			log::error << L"Unable to read blob from server (get)." << Endl;
+			return false;
+		}
+
+		MemoryStream ms(blob.c_ptr(), blobSize);
+		receiver(i, &ms);
+	}
+
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+		m_streams.push_back(stream);
+	}
+	return true;
+}
+
+bool Client::writeKeys(net::SocketStream* stream, const AlignedVector< Key >& keys, size_t offset, size_t count) const
+{
+	// Serialize all keys into a single write.
+	AlignedVector< uint8_t > request;
+	DynamicMemoryStream ms(request, false, true);
+
+	const uint32_t nkeys = (uint32_t)count;
+	if (ms.write(&nkeys, sizeof(uint32_t)) != sizeof(uint32_t))
+		return false;
+
+	for (size_t i = offset; i < offset + count; ++i)
+	{
+		if (!keys[i].write(&ms))
+			return false;
+	}
+
+	return stream->write(request.c_ptr(), (int64_t)request.size()) == (int64_t)request.size();
+}
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,7 @@
  */
 #pragma once
 
+#include <functional>
 #include "Avalanche/Dictionary.h"
 #include "Core/Object.h"
 #include "Core/Ref.h"
@@ -52,6 +53,20 @@ public:
 
 	Ref< IStream > get(const Key& key);
 
+	/*! Query multiple blobs in a single request, size is -1 if blob doesn't exist. */
+	bool have(const AlignedVector< Key >& keys, AlignedVector< int64_t >& outSizes);
+
+	/*! Get multiple blobs in a single request.
+	 *
+	 * Blobs are received back to back and passed to receiver
+	 * in the same order as keys; stream is null if blob
+	 * doesn't exist.
+	 */
+	bool get(const AlignedVector< Key >& keys, const std::function< void (size_t index, IStream* stream) >& receiver);
+
+	/*! Get protocol version of server; fails if server predates batch commands. */
+	bool version(int32_t& outMajor, int32_t& outMinor);
+
 	Ref< IStream > put(const Key& key);
 
 	bool stats(Dictionary::Stats& outStats);
@@ -69,6 +84,12 @@ private:
 	Semaphore m_lock;
 
 	Ref< net::SocketStream > establish(uint8_t command);
+
+	bool haveBatch(const AlignedVector< Key >& keys, size_t offset, size_t count, AlignedVector< int64_t >& outSizes);
+
+	bool getBatch(const AlignedVector< Key >& keys, size_t offset, size_t count, const std::function< void (size_t index, IStream* stream) >& receiver);
+
+	bool writeKeys(net::SocketStream* stream, const AlignedVector< Key >& keys, size_t offset, size_t count) const;
 };
 
 }
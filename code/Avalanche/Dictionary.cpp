@@ -1,12 +1,13 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 #include <algorithm>
+#include <atomic>
 #include "Avalanche/BlobFile.h"
 #include "Avalanche/BlobMemory.h"
 #include "Avalanche/Dictionary.h"
@@ -30,6 +31,12 @@ bool Dictionary::create(const Path& blobsPath)
 
 		RefArray< File > blobFiles = FileSystem::getInstance().find(blobsPath.getPathName() + L"/*.blob");
 
+		// Insert blobs in order of last access, least recently accessed
+		// first, so eviction initially picks the oldest blobs.
+		blobFiles.sort([](const File* lh, const File* rh) {
+			return lh->getLastAccessTime() < rh->getLastAccessTime();
+		});
+
 		log::info << L"Loading " << blobFiles.size() << L" blobs..." << Endl;
 		for (auto blobFile : blobFiles)
 		{
@@ -40,9 +47,7 @@ bool Dictionary::create(const Path& blobsPath)
 				continue;
 
 			Ref< BlobFile > blob = new BlobFile(blobFile->getPath(), blobFile->getSize(), blobFile->getLastAccessTime());
-			m_blobs[blobKey] = blob;
-			m_stats.blobCount++;
-			m_stats.memoryUsage += blob->size();
+			insert(shard(blobKey), blobKey, blob, false);
 		}
 	}
 
@@ -59,11 +64,23 @@ Ref< IBlob > Dictionary::get(const Key& key, bool raw) const
 {
 	Ref< IBlob > blob;
 	{
-		T_ANONYMOUS_VAR(ReaderWriterLock::AcquireReader)(m_lockBlobs);
-		auto it = m_blobs.find(key);
-		if (it == m_blobs.end())
+		Shard& s = shard(key);
+		T_ANONYMOUS_VAR(ReaderWriterLock::AcquireReader)(s.lock);
+		auto it = s.index.find(key);
+		if (it == s.index.end())
 			return nullptr;
-		blob = it->second;
+
+		Entry& entry = s.ring[it->second];
+		blob = entry.blob;
+
+		// Only reference bit is modified thus it's safe from concurrent readers;
+		// avoid writing if already set to keep cache line shared.
+		if (!raw)
+		{
+			std::atomic_ref< uint8_t > referenced(entry.referenced);
+			if (referenced.load(std::memory_order_relaxed) == 0)
+				referenced.store(1, std::memory_order_relaxed);
+		}
 	}
 	if (!raw)
 	{
@@ -91,12 +108,7 @@ bool Dictionary::put(const Key& key, IBlob* blob, bool raw)
 		dictionaryBlob = blob;
 
 	// Store blob into dictionary.
-	{
-		T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(m_lockBlobs);
-		m_blobs[key] = dictionaryBlob;
-		m_stats.blobCount++;
-		m_stats.memoryUsage += dictionaryBlob->size();
-	}
+	insert(shard(key), key, dictionaryBlob, true);
 
 	// Invoke listeners.
 	if (!raw)
@@ -111,21 +123,34 @@ bool Dictionary::put(const Key& key, IBlob* blob, bool raw)
 bool Dictionary::remove(const Key& key)
 {
 	{
-		T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(m_lockBlobs);
+		Shard& s = shard(key);
+		T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(s.lock);
 
-		auto it = m_blobs.find(key);
-		if (it == m_blobs.end())
+		auto it = s.index.find(key);
+		if (it == s.index.end())
 			return false;
 
-		const uint64_t size = it->second->size();
+		const uint32_t index = it->second;
+		const uint64_t size = s.ring[index].blob->size();
 
-		if (!it->second->remove())
+		if (!s.ring[index].blob->remove())
 			return false;
 
-		m_stats.blobCount--;
-		m_stats.memoryUsage -= size;
+		// Move last entry into removed slot to keep ring compact; if moved
+		// entry hasn't been visited by clock hand yet then it's kept ahead of hand.
+		const uint32_t last = (uint32_t)s.ring.size() - 1;
+		if (index != last)
+		{
+			s.ring[index] = std::move(s.ring[last]);
+			s.index[s.ring[index].key] = index;
+			if (index < s.hand && last >= s.hand)
+				s.hand = index;
+		}
+		s.ring.pop_back();
+		s.index.erase(it);
 
-		m_blobs.erase(it);
+		m_blobCount--;
+		m_memoryUsage -= size;
 	}
 	{
 		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lockListeners);
@@ -137,10 +162,14 @@ bool Dictionary::remove(const Key& key)
 
 void Dictionary::snapshotKeys(AlignedVector< Key >& outKeys) const
 {
-	T_ANONYMOUS_VAR(ReaderWriterLock::AcquireReader)(m_lockBlobs);
-	outKeys.reserve(m_blobs.size());
-	for (auto it : m_blobs)
-		outKeys.push_back(it.first);
+	outKeys.reserve(outKeys.size() + m_blobCount);
+	for (uint32_t i = 0; i < ShardCount; ++i)
+	{
+		Shard& s = m_shards[i];
+		T_ANONYMOUS_VAR(ReaderWriterLock::AcquireReader)(s.lock);
+		for (const auto& entry : s.ring)
+			outKeys.push_back(entry.key);
+	}
 }
 
 void Dictionary::addListener(IListener* listener)
@@ -158,9 +187,77 @@ void Dictionary::removeListener(IListener* listener)
 
 bool Dictionary::getStats(Stats& outStats) const
 {
-	T_ANONYMOUS_VAR(ReaderWriterLock::AcquireReader)(m_lockBlobs);
-	outStats = m_stats;
+	outStats.blobCount = m_blobCount;
+	outStats.memoryUsage = m_memoryUsage;
 	return true;
 }
 
+uint32_t Dictionary::evict(uint64_t maxMemoryUsage)
+{
+	uint32_t nevicted = 0;
+	while (m_memoryUsage >= maxMemoryUsage)
+	{
+		// Select candidate from shards in round robin; sweep clock hand
+		// clearing reference bits until an unreferenced blob is found.
+		Key candidate;
+		for (uint32_t i = 0; i < ShardCount && !candidate.valid(); ++i)
+		{
+			Shard& s = m_shards[m_evictShard++ % ShardCount];
+			T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(s.lock);
+
+			const uint32_t nentries = (uint32_t)s.ring.size();
+			for (uint32_t j = 0; j < nentries * 2; ++j)
+			{
+				if (s.hand >= nentries)
+					s.hand = 0;
+
+				Entry& entry = s.ring[s.hand++];
+				if (entry.referenced == 0)
+				{
+					candidate = entry.key;
+					break;
+				}
+				entry.referenced = 0;
+			}
+		}
+		if (!candidate.valid())
+			break;
+
+		if (!remove(candidate))
+		{
+			log::warning << L"Unable to evict blob " << candidate.format() << L"." << Endl;
+			break;
+		}
+
+		nevicted++;
+	}
+	return nevicted;
+}
+
+void Dictionary::insert(Shard& shard, const Key& key, IBlob* blob, bool referenced)
+{
+	T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(shard.lock);
+
+	auto it = shard.index.find(key);
+	if (it != shard.index.end())
+	{
+		Entry& entry = shard.ring[it->second];
+		m_memoryUsage -= entry.blob->size();
+		m_memoryUsage += blob->size();
+		entry.blob = blob;
+		entry.referenced = referenced ? 1 : 0;
+		return;
+	}
+
+	shard.index.insert({ key, (uint32_t)shard.ring.size() });
+
+	Entry& entry = shard.ring.push_back();
+	entry.key = key;
+	entry.blob = blob;
+	entry.referenced = referenced ? 1 : 0;
+
+	m_blobCount++;
+	m_memoryUsage += blob->size();
+}
+
 }
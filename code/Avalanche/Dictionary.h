@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,9 +8,11 @@
  */
 #pragma once
 
+#include <atomic>
+#include <unordered_map>
 #include "Core/Object.h"
 #include "Core/Ref.h"
-#include "Core/Containers/SmallMap.h"
+#include "Core/Containers/AlignedVector.h"
 #include "Core/Io/Path.h"
 #include "Core/Misc/Key.h"
 #include "Core/Thread/ReaderWriterLock.h"
@@ -29,6 +31,17 @@ namespace traktor::avalanche
 
 class IBlob;
 
+/*! Dictionary of blobs.
+ * \ingroup Avalanche
+ *
+ * Blobs are distributed over a number of shards, each
+ * with it's own lock, to reduce contention between
+ * concurrent connections. Each shard keep a CLOCK ring
+ * of it's blobs, reference bit is set when a blob is
+ * accessed and eviction sweeps the ring for blobs which
+ * hasn't been referenced since last sweep; thus eviction
+ * doesn't need to sort the entire dictionary.
+ */
 class T_DLLCLASS Dictionary : public Object
 {
 	T_RTTI_CLASS;
@@ -67,13 +80,47 @@ public:
 
 	bool getStats(Stats& outStats) const;
 
+	/*! Evict least recently used blobs until memory usage is below budget.
+	 *
+	 * \param maxMemoryUsage Memory budget in bytes.
+	 * \return Number of evicted blobs.
+	 */
+	uint32_t evict(uint64_t maxMemoryUsage);
+
 private:
-	mutable ReaderWriterLock m_lockBlobs;
+	constexpr static uint32_t ShardCount = 16;
+
+	struct KeyHash
+	{
+		size_t operator () (const Key& key) const { return key.hash(); }
+	};
+
+	struct Entry
+	{
+		Key key;
+		Ref< IBlob > blob;
+		uint8_t referenced = 0;
+	};
+
+	struct Shard
+	{
+		ReaderWriterLock lock;
+		std::unordered_map< Key, uint32_t, KeyHash > index;
+		AlignedVector< Entry > ring;
+		uint32_t hand = 0;
+	};
+
+	mutable Shard m_shards[ShardCount];
 	mutable Semaphore m_lockListeners;
 	Path m_blobsPath;
-	SmallMap< Key, Ref< IBlob > > m_blobs;
 	AlignedVector< IListener* > m_listeners;
-	Stats m_stats;
+	std::atomic< uint32_t > m_blobCount = 0;
+	std::atomic< uint64_t > m_memoryUsage = 0;
+	uint32_t m_evictShard = 0;
+
+	Shard& shard(const Key& key) const { return m_shards[key.hash() % ShardCount]; }
+
+	void insert(Shard& shard, const Key& key, IBlob* blob, bool referenced);
 };
 
 }
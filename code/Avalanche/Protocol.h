@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -25,9 +25,15 @@ constexpr static uint8_t c_commandStats			= 0x05;
 constexpr static uint8_t c_commandKeys			= 0x06;
 constexpr static uint8_t c_commandTouch			= 0x07;
 constexpr static uint8_t c_commandEvict			= 0x08;
+constexpr static uint8_t c_commandStatBatch		= 0x09;
+constexpr static uint8_t c_commandGetBatch		= 0x0a;
+constexpr static uint8_t c_commandVersion		= 0x0b;
 
 constexpr static uint8_t c_subCommandPutAppend	= 0x41;
 constexpr static uint8_t c_subCommandPutCommit	= 0x42;
 constexpr static uint8_t c_subCommandPutDiscard	= 0x43;
 
+constexpr static int32_t c_minorVersionBatch	= 1;		//!< First minor version which support batch and version commands.
+constexpr static uint32_t c_maxBatchKeys		= 65536;	//!< Maximum number of keys in a single batch command.
+
 }
@@ -1,86 +1,84 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
+#if defined(__LINUX__) || defined(__RPI__) || defined(__ANDROID__)
+#	include <errno.h>
+#	include <fcntl.h>
+#	include <sys/sendfile.h>
+#	include <unistd.h>
+#	define T_AVALANCHE_USE_SENDFILE
+#endif
+#include <cstring>
+#include "Avalanche/BlobFile.h"
 #include "Avalanche/Dictionary.h"
 #include "Avalanche/IBlob.h"
 #include "Avalanche/Protocol.h"
 #include "Avalanche/Server/Connection.h"
+#include "Avalanche/Server/Server.h"
+#include "Core/Io/FileSystem.h"
+#include "Core/Io/MemoryStream.h"
 #include "Core/Io/StreamCopy.h"
 #include "Core/Log/Log.h"
-#include "Core/Thread/ThreadPool.h"
+#include "Core/Misc/TString.h"
 #include "Net/SocketAddressIPv4.h"
 #include "Net/SocketStream.h"
 #include "Net/TcpSocket.h"
 
 namespace traktor::avalanche
 {
+	namespace
+	{
+
+const int64_t c_maxReplyBuffer = 64 * 1024;
+const int32_t c_timeout = 5000;
+
+	}
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.avalanche.Connection", Connection, Object)
 
 Connection::Connection(Dictionary* dictionary)
 :	m_dictionary(dictionary)
-,	m_finished(false)
+,	m_name(L"<unknown>")
+,	m_armed(false)
 {
 }
 
-Connection::~Connection()
-{
-	if (m_thread)
-	{
-		ThreadPool::getInstance().stop(m_thread);
-		T_FATAL_ASSERT(m_finished);
-	}
-}
-
 bool Connection::create(net::TcpSocket* clientSocket)
 {
 	m_clientSocket = clientSocket;
-	m_clientStream = new net::SocketStream(clientSocket, true, true, 5000);
-
-	std::wstring name = L"<unknown>";
+	m_clientStream = new net::SocketStream(clientSocket, true, true, c_timeout);
 
 	auto remoteAddress = dynamic_type_cast< const net::SocketAddressIPv4* >(clientSocket->getRemoteAddress());
 	if (remoteAddress)
-		name = remoteAddress->getHostName();
+		m_name = remoteAddress->getHostName();
 
+	// Replies are written in several small chunks; disable Nagle
+	// so they aren't held back waiting for acknowledgement.
+	clientSocket->setNoDelay(true);
 	clientSocket->setQuickAck(true);
 
-	auto fn = [=]()
-	{
-		log::info << L"Connection with " << name << L" established, ready to process requests." << Endl;
-		while (!m_thread->stopped())
-		{
-			if (!process())
-				break;
-		}
-		log::info << L"Connection with " << name << L" terminated." << Endl;
-		m_finished = true;
-	};
-
-	if (!ThreadPool::getInstance().spawn(fn, m_thread))
-		return false;
-
+	log::info << L"Connection with " << m_name << L" established, ready to process requests." << Endl;
 	return true;
 }
 
-bool Connection::update()
+void Connection::destroy()
 {
-	return !m_finished;
+	if (m_clientSocket)
+	{
+		log::info << L"Connection with " << m_name << L" terminated." << Endl;
+		m_clientStream = nullptr;
+		m_clientSocket->close();
+		m_clientSocket = nullptr;
+	}
 }
 
 bool Connection::process()
 {
-	const int32_t result = m_clientSocket->select(true, false, false, 500);
-	if (result == 0)
-		return true;
-	else if (result < 0)
-		return false;
-
 	uint8_t cmd = 0;
 	if (m_clientStream->read(&cmd, sizeof(uint8_t)) != sizeof(uint8_t))
 		return false;
@@ -94,6 +92,14 @@ bool Connection::process()
 		}
 		break;
 
+	case c_commandVersion:
+		{
+			const int32_t version[] = { Server::c_majorVersion, Server::c_minorVersion };
+			if (m_clientStream->write(version, sizeof(version)) != sizeof(version))
+				return false;
+		}
+		break;
+
 	case c_commandStat:
 		{
 			const Key key = Key::read(m_clientStream);
@@ -130,40 +136,90 @@ bool Connection::process()
 				return false;
 			}
 
-			Ref< const IBlob > blob = m_dictionary->get(key, false);
+			Ref< IBlob > blob = m_dictionary->get(key, false);
 			if (blob)
 			{
-				auto readStream = blob->read();
-				if (readStream)
-				{
-					if (m_clientStream->write(&c_replyOk, sizeof(uint8_t)) != sizeof(uint8_t))
-						return false;
+				if (!sendBlob(key, blob))
+					return false;
+				log::info << L"[GET " << key.format() << L"] Sent " << blob->size() << L" bytes." << Endl;
+			}
+			else
+			{
+				log::info << L"[GET " << key.format() << L"] No such blob." << Endl;
+				if (!reply(&c_replyFailure, sizeof(uint8_t)))
+					return false;
+			}
 
-					const int64_t blobSize = blob->size();
-					if (m_clientStream->write(&blobSize, sizeof(int64_t)) != sizeof(int64_t))
-						return false;
+			if (!flush())
+				return false;
+		}
+		break;
 
-					if (!StreamCopy(m_clientStream, readStream).execute(blob->size()))
-					{
-						log::error << L"[GET " << key.format() << L"] Unable to send " << blob->size() << L" byte(s) to client; terminating connection." << Endl;
+	case c_commandStatBatch:
+		{
+			AlignedVector< Key > keys;
+			if (!readKeys(keys))
+			{
+				log::warning << L"Failed to read keys; terminating connection." << Endl;
+				return false;
+			}
+
+			// Replies are gathered and sent in as few writes as possible.
+			for (const auto& key : keys)
+			{
+				Ref< const IBlob > blob = m_dictionary->get(key, true);
+				if (blob)
+				{
+					const int64_t blobSize = blob->size();
+					if (!reply(&c_replyOk, sizeof(uint8_t)) || !reply(&blobSize, sizeof(int64_t)))
 						return false;
-					}
-					else
-						log::info << L"[GET " << key.format() << L"] Sent " << blob->size() << L" bytes." << Endl;
 				}
 				else
 				{
-					log::error <<  L"[GET " << key.format() << L"] Unable to acquire read stream from blob." << Endl;
-					if (m_clientStream->write(&c_replyFailure, sizeof(uint8_t)) != sizeof(uint8_t))
+					if (!reply(&c_replyFailure, sizeof(uint8_t)))
 						return false;
 				}
 			}
-			else
+
+			if (!flush())
+				return false;
+		}
+		break;
+
+	case c_commandGetBatch:
+		{
+			AlignedVector< Key > keys;
+			if (!readKeys(keys))
 			{
-				log::info << L"[GET " << key.format() << L"] No such blob." << Endl;
-				if (m_clientStream->write(&c_replyFailure, sizeof(uint8_t)) != sizeof(uint8_t))
-					return false;
+				log::warning << L"Failed to read keys; terminating connection." << Endl;
+				return false;
 			}
+
+			// Blobs are sent back to back in requested order, client
+			// reads replies as they arrive.
+			uint32_t nsent = 0;
+			int64_t nbytes = 0;
+			for (const auto& key : keys)
+			{
+				Ref< IBlob > blob = m_dictionary->get(key, false);
+				if (blob)
+				{
+					if (!sendBlob(key, blob))
+						return false;
+					nsent++;
+					nbytes += blob->size();
+				}
+				else
+				{
+					if (!reply(&c_replyFailure, sizeof(uint8_t)))
+						return false;
+				}
+			}
+
+			if (!flush())
+				return false;
+
+			log::info << L"[GET BATCH] Sent " << nsent << L" of " << (uint32_t)keys.size() << L" blobs, " << nbytes << L" bytes." << Endl;
 		}
 		break;
 
@@ -371,4 +427,130 @@ bool Connection::process()
 	return true;
 }
 
+bool Connection::readKeys(AlignedVector< Key >& outKeys)
+{
+	uint32_t nkeys;
+	if (m_clientStream->read(&nkeys, sizeof(uint32_t)) != sizeof(uint32_t))
+		return false;
+	if (nkeys > c_maxBatchKeys)
+		return false;
+
+	// Read all keys in one go, avoid a socket read per key.
+	const int64_t nbytes = (int64_t)nkeys * 4 * sizeof(uint32_t);
+	AlignedVector< uint8_t > data;
+	data.resize(nbytes);
+	if (m_clientStream->read(data.ptr(), nbytes) != nbytes)
+		return false;
+
+	MemoryStream ms(data.c_ptr(), nbytes);
+	outKeys.resize(nkeys);
+	for (uint32_t i = 0; i < nkeys; ++i)
+	{
+		outKeys[i] = Key::read(&ms);
+		if (!outKeys[i].valid())
+			return false;
+	}
+	return true;
+}
+
+bool Connection::sendBlob(const Key& key, IBlob* blob)
+{
+	const int64_t blobSize = blob->size();
+
+#if defined(T_AVALANCHE_USE_SENDFILE)
+	// File backed blobs are sent directly from page cache to
+	// socket, data is never copied through user space.
+	if (auto blobFile = dynamic_type_cast< const BlobFile* >(blob))
+	{
+		const std::string fileName = wstombs(FileSystem::getInstance().getAbsolutePath(blobFile->getPath()).getPathNameOS());
+		const int fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd >= 0)
+		{
+			blob->touch();
+
+			if (!reply(&c_replyOk, sizeof(uint8_t)) || !reply(&blobSize, sizeof(int64_t)) || !flush())
+			{
+				::close(fd);
+				return false;
+			}
+
+			off_t offset = 0;
+			while (offset < blobSize)
+			{
+				if (m_clientSocket->select(false, true, false, c_timeout) <= 0)
+					break;
+
+				const ssize_t result = ::sendfile((int)m_clientSocket->handle(), fd, &offset, size_t(blobSize - offset));
+				if (result < 0 && (errno == EINTR || errno == EAGAIN))
+					continue;
+				else if (result <= 0)
+					break;
+			}
+
+			::close(fd);
+
+			if (offset != blobSize)
+			{
+				log::error << L"[GET " << key.format() << L"] Unable to send " << blobSize << L" byte(s) to client; terminating connection." << Endl;
+				return false;
+			}
+			return true;
+		}
+	}
+#endif
+
+	Ref< IStream > readStream = blob->read();
+	if (!readStream)
+	{
+		log::error << L"[GET " << key.format() << L"] Unable to acquire read stream from blob." << Endl;
+		return reply(&c_replyFailure, sizeof(uint8_t));
+	}
+
+	if (!reply(&c_replyOk, sizeof(uint8_t)) || !reply(&blobSize, sizeof(int64_t)))
+		return false;
+
+	// Small blobs are gathered into reply buffer, large blobs are streamed.
+	if (blobSize <= c_maxReplyBuffer)
+	{
+		const size_t offset = m_reply.size();
+		m_reply.resize(offset + (size_t)blobSize);
+		if (readStream->read(m_reply.ptr() + offset, blobSize) != blobSize)
+		{
+			log::error << L"[GET " << key.format() << L"] Unable to read " << blobSize << L" byte(s) from blob; terminating connection." << Endl;
+			return false;
+		}
+		return m_reply.size() < c_maxReplyBuffer ? true : flush();
+	}
+
+	if (!flush())
+		return false;
+
+	if (!StreamCopy(m_clientStream, readStream).execute(blobSize))
+	{
+		log::error << L"[GET " << key.format() << L"] Unable to send " << blobSize << L" byte(s) to client; terminating connection." << Endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool Connection::reply(const void* data, int64_t size)
+{
+	const size_t offset = m_reply.size();
+	m_reply.resize(offset + (size_t)size);
+	std::memcpy(m_reply.ptr() + offset, data, (size_t)size);
+	return m_reply.size() < c_maxReplyBuffer ? true : flush();
+}
+
+bool Connection::flush()
+{
+	if (m_reply.empty())
+		return true;
+
+	const int64_t nbytes = (int64_t)m_reply.size();
+	const bool result = (m_clientStream->write(m_reply.c_ptr(), nbytes) == nbytes);
+	m_reply.resize(0);
+	return result;
+}
+
 }
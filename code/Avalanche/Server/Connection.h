@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,8 +8,11 @@
  */
 #pragma once
 
+#include <atomic>
+#include <string>
 #include "Core/Object.h"
 #include "Core/Ref.h"
+#include "Core/Containers/AlignedVector.h"
 
 // import/export mechanism.
 #undef T_DLLCLASS
@@ -22,7 +25,7 @@
 namespace traktor
 {
 
-class Thread;
+class Key;
 
 }
 
@@ -38,7 +41,16 @@ namespace traktor::avalanche
 {
 
 class Dictionary;
+class EventLoop;
+class IBlob;
 
+/*! Client connection.
+ * \ingroup Avalanche
+ *
+ * Connection doesn't own a thread, requests are
+ * processed by the event loop's workers when data
+ * is available on the socket.
+ */
 class T_DLLCLASS Connection : public Object
 {
 	T_RTTI_CLASS;
@@ -46,20 +58,36 @@ class T_DLLCLASS Connection : public Object
 public:
 	explicit Connection(Dictionary* dictionary);
 
-	virtual ~Connection();
-
 	bool create(net::TcpSocket* clientSocket);
 
-	bool update();
+	void destroy();
+
+	/*! Process a single request, blocking until request has been completely served.
+	 *
+	 * \return False if connection has been terminated.
+	 */
+	bool process();
+
+	net::TcpSocket* getSocket() const { return m_clientSocket; }
 
 private:
+	friend class EventLoop;
+
 	Dictionary* m_dictionary = nullptr;
 	Ref< net::TcpSocket > m_clientSocket;
 	Ref< net::SocketStream > m_clientStream;
-	Thread* m_thread = nullptr;
-	std::atomic< bool > m_finished;
+	std::wstring m_name;
+	AlignedVector< uint8_t > m_reply;
+	std::atomic< bool > m_armed;
 
-	bool process();
+	bool readKeys(AlignedVector< Key >& outKeys);
+
+	bool sendBlob(const Key& key, IBlob* blob);
+
+	/*! Append data to reply buffer, buffer is flushed when full. */
+	bool reply(const void* data, int64_t size);
+
+	bool flush();
 };
 
 }
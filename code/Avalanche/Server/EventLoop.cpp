@@ -0,0 +1,249 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#if defined(__LINUX__) || defined(__RPI__) || defined(__ANDROID__)
+#	include <sys/epoll.h>
+#	include <unistd.h>
+#	define T_AVALANCHE_USE_EPOLL
+#endif
+#include "Avalanche/Dictionary.h"
+#include "Avalanche/Server/Connection.h"
+#include "Avalanche/Server/EventLoop.h"
+#include "Core/Containers/SmallMap.h"
+#include "Core/Log/Log.h"
+#include "Core/Thread/Acquire.h"
+#include "Core/Timer/Timer.h"
+#include "Net/SocketSet.h"
+#include "Net/TcpSocket.h"
+
+namespace traktor::avalanche
+{
+	namespace
+	{
+
+const int32_t c_maxEvents = 64;
+const int32_t c_maxRequestsPerDispatch = 16;
+
+	}
+
+T_IMPLEMENT_RTTI_CLASS(L"traktor.avalanche.EventLoop", EventLoop, Object)
+
+bool EventLoop::create(net::TcpSocket* serverSocket, Dictionary* dictionary, int32_t workerCount)
+{
+	m_serverSocket = serverSocket;
+	m_dictionary = dictionary;
+	m_pending = 0;
+
+	if (!m_workers.create(std::max< int32_t >(workerCount, 1), Thread::Normal, JobQueue::Mode::Fifo))
+	{
+		log::error << L"Unable to create worker queue." << Endl;
+		return false;
+	}
+
+#if defined(T_AVALANCHE_USE_EPOLL)
+	m_poll = epoll_create1(EPOLL_CLOEXEC);
+	if (m_poll < 0)
+	{
+		log::error << L"Unable to create epoll instance." << Endl;
+		return false;
+	}
+
+	// Server socket is registered with null data, it's level triggered
+	// thus pending connection requests are reported until accepted.
+	epoll_event ev = {};
+	ev.events = EPOLLIN;
+	ev.data.ptr = nullptr;
+	if (epoll_ctl(m_poll, EPOLL_CTL_ADD, (int)m_serverSocket->handle(), &ev) < 0)
+	{
+		log::error << L"Unable to add server socket to epoll instance." << Endl;
+		return false;
+	}
+#endif
+
+	return true;
+}
+
+void EventLoop::destroy()
+{
+	// Let workers finish their current requests before connections are closed.
+	m_workers.wait();
+	m_workers.destroy();
+
+	for (auto connection : m_connections)
+		connection->destroy();
+
+	m_connections.clear();
+	m_closed.clear();
+
+#if defined(T_AVALANCHE_USE_EPOLL)
+	if (m_poll >= 0)
+	{
+		::close(m_poll);
+		m_poll = -1;
+	}
+#endif
+
+	m_serverSocket = nullptr;
+	m_dictionary = nullptr;
+}
+
+void EventLoop::update(int32_t timeout)
+{
+	Timer timer;
+	for (;;)
+	{
+		const int32_t remaining = timeout - int32_t(timer.getElapsedTime() * 1000.0);
+		if (remaining <= 0)
+			break;
+
+#if defined(T_AVALANCHE_USE_EPOLL)
+		epoll_event events[c_maxEvents];
+		const int32_t nevents = epoll_wait(m_poll, events, c_maxEvents, remaining);
+		for (int32_t i = 0; i < nevents; ++i)
+		{
+			if (events[i].data.ptr != nullptr)
+				dispatch((Connection*)events[i].data.ptr);
+			else
+				accept();
+		}
+#else
+		net::SocketSet sockets;
+		SmallMap< const net::Socket*, Connection* > armed;
+
+		sockets.add(m_serverSocket);
+		{
+			T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+			for (auto connection : m_connections)
+			{
+				if (connection->m_armed)
+				{
+					sockets.add(connection->getSocket());
+					armed[connection->getSocket()] = connection;
+				}
+			}
+		}
+
+		// Connections are re-armed by workers, which isn't noticed until
+		// select returns, thus use a short timeout while requests are in flight.
+		net::SocketSet ready;
+		if (sockets.select(true, false, false, m_pending > 0 ? std::min< int32_t >(remaining, 10) : remaining, ready) > 0)
+		{
+			for (int32_t i = 0; i < ready.count(); ++i)
+			{
+				Ref< net::Socket > socket = ready.get(i);
+				if (socket.ptr() == m_serverSocket.ptr())
+				{
+					accept();
+					continue;
+				}
+				auto it = armed.find(socket.ptr());
+				if (it != armed.end())
+					dispatch(it->second);
+			}
+		}
+#endif
+
+		// Close connections which workers have found terminated.
+		RefArray< Connection > closed;
+		{
+			T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+			closed.swap(m_closed);
+		}
+		for (auto connection : closed)
+			close(connection);
+	}
+}
+
+size_t EventLoop::getConnectionCount() const
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+	return m_connections.size();
+}
+
+void EventLoop::accept()
+{
+	Ref< net::TcpSocket > clientSocket = m_serverSocket->accept();
+	if (!clientSocket)
+		return;
+
+	Ref< Connection > connection = new Connection(m_dictionary);
+	if (!connection->create(clientSocket))
+		return;
+
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+		m_connections.push_back(connection);
+	}
+
+	if (!arm(connection, true))
+		close(connection);
+}
+
+void EventLoop::dispatch(Connection* connection)
+{
+	Ref< Connection > c = connection;
+	c->m_armed = false;
+
+	m_pending++;
+	m_workers.add([=, this]() {
+		// Process requests already received in one go, bounded
+		// so a pipelining client cannot starve other connections.
+		bool alive = true;
+		for (int32_t i = 0; i < c_maxRequestsPerDispatch; ++i)
+		{
+			if (!(alive = c->process()))
+				break;
+			if (c->getSocket()->select(true, false, false, 0) <= 0)
+				break;
+		}
+
+		if (!alive || !arm(c, false))
+		{
+			T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+			m_closed.push_back(c);
+		}
+
+		m_pending--;
+	});
+}
+
+bool EventLoop::arm(Connection* connection, bool add)
+{
+	connection->m_armed = true;
+
+#if defined(T_AVALANCHE_USE_EPOLL)
+	// One-shot so connection isn't reported again until
+	// worker has finished processing current request.
+	epoll_event ev = {};
+	ev.events = EPOLLIN | EPOLLONESHOT;
+	ev.data.ptr = connection;
+	if (epoll_ctl(m_poll, add ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, (int)connection->getSocket()->handle(), &ev) < 0)
+	{
+		connection->m_armed = false;
+		return false;
+	}
+#endif
+
+	return true;
+}
+
+void EventLoop::close(Connection* connection)
+{
+	Ref< Connection > c = connection;
+
+#if defined(T_AVALANCHE_USE_EPOLL)
+	epoll_ctl(m_poll, EPOLL_CTL_DEL, (int)c->getSocket()->handle(), nullptr);
+#endif
+
+	c->destroy();
+
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+	m_connections.remove(c);
+}
+
+}
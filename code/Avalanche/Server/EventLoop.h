@@ -0,0 +1,86 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <atomic>
+#include "Core/Object.h"
+#include "Core/Ref.h"
+#include "Core/RefArray.h"
+#include "Core/Thread/JobQueue.h"
+#include "Core/Thread/Semaphore.h"
+
+// import/export mechanism.
+#undef T_DLLCLASS
+#if defined(T_AVALANCHE_EXPORT)
+#	define T_DLLCLASS T_DLLEXPORT
+#else
+#	define T_DLLCLASS T_DLLIMPORT
+#endif
+
+namespace traktor::net
+{
+
+class TcpSocket;
+
+}
+
+namespace traktor::avalanche
+{
+
+class Connection;
+class Dictionary;
+
+/*! Event driven connection dispatcher.
+ * \ingroup Avalanche
+ *
+ * All client sockets are monitored from a single thread,
+ * using epoll on Linux and select on other platforms.
+ * When a request arrives on a connection it's dispatched
+ * to a small pool of worker threads which process the
+ * request; the connection isn't monitored again until
+ * the worker has finished thus each connection is only
+ * served by one worker at a time.
+ */
+class T_DLLCLASS EventLoop : public Object
+{
+	T_RTTI_CLASS;
+
+public:
+	bool create(net::TcpSocket* serverSocket, Dictionary* dictionary, int32_t workerCount);
+
+	void destroy();
+
+	/*! Wait for socket events and dispatch until timeout has elapsed.
+	 *
+	 * \param timeout Timeout in milliseconds.
+	 */
+	void update(int32_t timeout);
+
+	size_t getConnectionCount() const;
+
+private:
+	Ref< net::TcpSocket > m_serverSocket;
+	Ref< Dictionary > m_dictionary;
+	JobQueue m_workers;
+	RefArray< Connection > m_connections;
+	RefArray< Connection > m_closed;
+	mutable Semaphore m_lock;
+	std::atomic< int32_t > m_pending;
+	int32_t m_poll = -1;
+
+	void accept();
+
+	void dispatch(Connection* connection);
+
+	bool arm(Connection* connection, bool add);
+
+	void close(Connection* connection);
+};
+
+}
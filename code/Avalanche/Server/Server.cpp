@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,7 +8,7 @@
  */
 #include "Avalanche/Dictionary.h"
 #include "Avalanche/IBlob.h"
-#include "Avalanche/Server/Connection.h"
+#include "Avalanche/Server/EventLoop.h"
 #include "Avalanche/Server/Server.h"
 #include "Avalanche/Server/Peer.h"
 #include "Core/Log/Log.h"
@@ -69,6 +69,18 @@ bool Server::create(const PropertyGroup* settings)
 		return false;		
 	}
 
+	// Create event loop which dispatch client requests to a pool of workers.
+	m_eventLoop = new EventLoop();
+	if (!m_eventLoop->create(
+		m_serverSocket,
+		m_dictionary,
+		settings->getProperty< int32_t >(L"Avalanche.WorkerCount", 8)
+	))
+	{
+		log::error << L"Unable to create event loop." << Endl;
+		return false;
+	}
+
 	m_master = settings->getProperty< bool >(L"Avalanche.Master", false);
 	m_memoryBudget = settings->getProperty< int32_t >(L"Avalanche.MemoryBudget", 8);
 
@@ -95,7 +107,7 @@ bool Server::create(const PropertyGroup* settings)
 
 void Server::destroy()
 {
-	m_connections.clear();
+	safeDestroy(m_eventLoop);
 	m_peers.clear();
 	safeClose(m_serverSocket);
 	safeDestroy(m_discoveryManager);
@@ -104,29 +116,8 @@ void Server::destroy()
 
 bool Server::update()
 {
-	// Accept new connections.
-	if (m_serverSocket->select(true, false, false, 500) > 0)
-	{
-		Ref< net::TcpSocket > clientSocket = m_serverSocket->accept();
-		if (clientSocket)
-		{
-			Ref< Connection > connection = new Connection(m_dictionary);
-			if (connection->create(clientSocket))
-				m_connections.push_back(connection);
-		}
-	}
-
-	// Cleanup terminated connections.
-	{
-		auto it = std::remove_if(m_connections.begin(), m_connections.end(), [](Connection* connection) {
-			return !connection->update();
-		});
-		if (it != m_connections.end())
-		{
-			size_t n = std::distance(it, m_connections.end());
-			m_connections.erase(it, m_connections.end());
-		}
-	}
+	// Accept new connections and dispatch requests.
+	m_eventLoop->update(500);
 
 	// Search for master peers.
 	RefArray< Peer > peers;
@@ -205,51 +196,17 @@ bool Server::update()
 	if (m_master)
 	{
 		const uint64_t maxMemoryUsage = (uint64_t)m_memoryBudget * 1024UL * 1024UL * 1024UL;
-
-		Dictionary::Stats stats;
-		if (m_dictionary->getStats(stats))
-		{
-			if (stats.memoryUsage >= maxMemoryUsage)
-			{
-				AlignedVector< std::pair< Key, DateTime > > queue;
-
-				// Get snapshot of keys and last access time stamps.
-				AlignedVector< Key > keys;
-				m_dictionary->snapshotKeys(keys);
-				for (const auto& key : keys)
-				{
-					Ref< IBlob > blob = m_dictionary->get(key, true);
-					if (!blob)
-						continue;
-					queue.push_back({
-						key,
-						blob->lastAccessed()
-					});
-				}
-
-				// Sort eviction candidates on longest since access first.
-				std::sort(queue.begin(), queue.end(), [](const std::pair< Key, DateTime >& lh, const std::pair< Key, DateTime >& rh) {
-					return lh.second < rh.second;
-				});
-
-				// Evict blobs until memory budget is meet.
-				auto it = queue.begin();
-				while (it != queue.end() && stats.memoryUsage >= maxMemoryUsage)
-				{
-					Ref< IBlob > blob = m_dictionary->get(it->first, true);
-					if (!blob)
-						continue;
-
-					stats.memoryUsage -= blob->size();
-					m_dictionary->remove(it->first);
-
-					++it;
-				}
-			}
-		}
+		const uint32_t nevicted = m_dictionary->evict(maxMemoryUsage);
+		if (nevicted > 0)
+			log::info << L"Evicted " << nevicted << L" blobs to meet memory budget." << Endl;
 	}
 
 	return true;
 }
 
+size_t Server::getConnectionCount() const
+{
+	return m_eventLoop ? m_eventLoop->getConnectionCount() : 0;
+}
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -39,8 +39,8 @@ class TcpSocket;
 namespace traktor::avalanche
 {
 
-class Connection;
 class Dictionary;
+class EventLoop;
 class Peer;
 
 class T_DLLCLASS Server : public Object
@@ -49,7 +49,7 @@ class T_DLLCLASS Server : public Object
 
 public:
 	constexpr static int32_t c_majorVersion = 7;
-	constexpr static int32_t c_minorVersion = 0;
+	constexpr static int32_t c_minorVersion = 1;
 
 	bool create(const PropertyGroup* settings);
 
@@ -57,11 +57,11 @@ public:
 
 	bool update();
 
-	size_t getConnectionCount() const { return m_connections.size(); }
+	size_t getConnectionCount() const;
 
 private:
 	Ref< net::TcpSocket > m_serverSocket;
-	RefArray< Connection > m_connections;
+	Ref< EventLoop > m_eventLoop;
 	Ref< net::DiscoveryManager > m_discoveryManager;
 	RefArray< Peer > m_peers;
 	Ref< Dictionary > m_dictionary;
@@ -0,0 +1,172 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include <algorithm>
+#include <atomic>
+#include "Avalanche/Dictionary.h"
+#include "Avalanche/IBlob.h"
+#include "Avalanche/Test/CaseDictionary.h"
+#include "Core/Containers/AlignedVector.h"
+#include "Core/Io/IStream.h"
+#include "Core/Io/StringOutputStream.h"
+#include "Core/Math/Random.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/ThreadManager.h"
+#include "Core/Timer/Timer.h"
+
+namespace traktor::avalanche::test
+{
+	namespace
+	{
+
+const uint32_t c_benchmarkKeyCount = 10000000;
+const int32_t c_benchmarkThreads = 4;
+const int32_t c_benchmarkGetsPerThread = 1000000;
+const int64_t c_blobSize = 1024;
+
+class BlobStub : public IBlob
+{
+public:
+	virtual int64_t size() const override final { return c_blobSize; }
+
+	virtual Ref< IStream > append() override final { return nullptr; }
+
+	virtual Ref< IStream > read() const override final { return nullptr; }
+
+	virtual bool remove() override final { return true; }
+
+	virtual bool touch() override final { return true; }
+
+	virtual DateTime lastAccessed() const override final { return DateTime(); }
+};
+
+Key makeKey(uint32_t index)
+{
+	return Key(0x1000, 0x2000, index >> 16, (index & 0xffff) | 0x10000);
+}
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.avalanche.test.CaseDictionary", 0, CaseDictionary, traktor::test::Case)
+
+void CaseDictionary::run()
+{
+	// Recently accessed blobs survive eviction.
+	{
+		const uint32_t count = 1000;
+
+		Ref< Dictionary > dictionary = new Dictionary();
+		CASE_ASSERT(dictionary->create(L""));
+
+		for (uint32_t i = 0; i < count; ++i)
+			dictionary->put(makeKey(i), new BlobStub(), true);
+
+		CASE_ASSERT_EQUAL(dictionary->evict(count * c_blobSize), 1);
+		CASE_ASSERT_EQUAL(dictionary->evict((count - 100) * c_blobSize), 100);
+
+		// Access first half; at this point all reference bits has been cleared by eviction sweeps.
+		uint32_t referenced = 0;
+		for (uint32_t i = 0; i < count / 2; ++i)
+		{
+			if (dictionary->get(makeKey(i), false) != nullptr)
+				referenced++;
+		}
+
+		CASE_ASSERT(dictionary->evict(count / 2 * c_blobSize) > 0);
+
+		uint32_t survived = 0;
+		for (uint32_t i = 0; i < count / 2; ++i)
+		{
+			if (dictionary->get(makeKey(i), true) != nullptr)
+				survived++;
+		}
+		CASE_ASSERT(survived >= referenced * 9 / 10);
+
+		Dictionary::Stats stats;
+		dictionary->getStats(stats);
+		CASE_ASSERT(stats.memoryUsage < count / 2 * c_blobSize);
+	}
+
+	// Benchmark with a large dictionary.
+	{
+		Ref< Dictionary > dictionary = new Dictionary();
+		CASE_ASSERT(dictionary->create(L""));
+
+		Timer timer;
+		for (uint32_t i = 0; i < c_benchmarkKeyCount; ++i)
+			dictionary->put(makeKey(i), new BlobStub(), true);
+		const double putTime = timer.getElapsedTime();
+
+		Dictionary::Stats stats;
+		dictionary->getStats(stats);
+		CASE_ASSERT_EQUAL(stats.blobCount, c_benchmarkKeyCount);
+
+		// Concurrent random access.
+		std::atomic< int32_t > misses(0);
+		Thread* threads[c_benchmarkThreads];
+		for (int32_t i = 0; i < c_benchmarkThreads; ++i)
+		{
+			threads[i] = ThreadManager::getInstance().create([&, i]() {
+				Random random(i + 1);
+				for (int32_t j = 0; j < c_benchmarkGetsPerThread; ++j)
+				{
+					if (dictionary->get(makeKey(random.next() % c_benchmarkKeyCount), false) == nullptr)
+						misses++;
+				}
+			});
+		}
+
+		timer.reset();
+		for (int32_t i = 0; i < c_benchmarkThreads; ++i)
+			threads[i]->start();
+		for (int32_t i = 0; i < c_benchmarkThreads; ++i)
+		{
+			threads[i]->wait();
+			ThreadManager::getInstance().destroy(threads[i]);
+		}
+		const double getTime = timer.getElapsedTime();
+		CASE_ASSERT_EQUAL((int32_t)misses, 0);
+
+		// Evict 1% of blobs.
+		timer.reset();
+		const uint32_t nevicted = dictionary->evict(stats.memoryUsage - stats.memoryUsage / 100);
+		const double evictTime = timer.getElapsedTime();
+		CASE_ASSERT(nevicted >= c_benchmarkKeyCount / 100);
+
+		// Measure cost of a full snapshot and sort by last access, which
+		// was required for each eviction before.
+		timer.reset();
+		{
+			AlignedVector< Key > keys;
+			dictionary->snapshotKeys(keys);
+
+			AlignedVector< std::pair< Key, DateTime > > queue;
+			queue.reserve(keys.size());
+			for (const auto& key : keys)
+			{
+				Ref< IBlob > blob = dictionary->get(key, true);
+				if (blob)
+					queue.push_back({ key, blob->lastAccessed() });
+			}
+
+			std::sort(queue.begin(), queue.end(), [](const std::pair< Key, DateTime >& lh, const std::pair< Key, DateTime >& rh) {
+				return lh.second < rh.second;
+			});
+		}
+		const double sortTime = timer.getElapsedTime();
+
+		StringOutputStream ss;
+		ss << c_benchmarkKeyCount << L" keys; put " << int32_t(putTime * 1000.0) << L" ms, ";
+		ss << int32_t((c_benchmarkThreads * c_benchmarkGetsPerThread) / getTime) << L" gets/s on " << c_benchmarkThreads << L" threads, ";
+		ss << L"evict " << nevicted << L" blobs " << int32_t(evictTime * 1000.0) << L" ms, ";
+		ss << L"snapshot and sort " << int32_t(sortTime * 1000.0) << L" ms";
+		succeeded(ss.str());
+	}
+}
+
+}
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -29,7 +29,7 @@ T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.avalanche.test.CaseServer", 0, CaseServ
 void CaseServer::run()
 {
 	Ref< PropertyGroup > settings = new PropertyGroup();
-	settings->setProperty< PropertyInteger >(L"Avalanche.ListenPort", 20001);
+	settings->setProperty< PropertyInteger >(L"Avalanche.Port", 20001);
 
 	Ref< Server > server = new Server();
 	server->create(settings);
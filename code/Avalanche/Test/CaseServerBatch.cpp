@@ -0,0 +1,196 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "Avalanche/Dictionary.h"
+#include "Avalanche/Protocol.h"
+#include "Avalanche/Client/Client.h"
+#include "Avalanche/Server/Server.h"
+#include "Avalanche/Test/CaseServerBatch.h"
+#include "Core/Containers/AlignedVector.h"
+#include "Core/Io/FileSystem.h"
+#include "Core/Io/IStream.h"
+#include "Core/Io/StringOutputStream.h"
+#include "Core/Settings/PropertyGroup.h"
+#include "Core/Settings/PropertyInteger.h"
+#include "Core/Settings/PropertyString.h"
+#include "Core/System/OS.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/ThreadManager.h"
+#include "Core/Timer/Timer.h"
+#include "Net/SocketAddressIPv4.h"
+
+namespace traktor::avalanche::test
+{
+	namespace
+	{
+
+const int32_t c_port = 20003;
+const int32_t c_blobCount = 256;
+
+int64_t blobSize(int32_t index)
+{
+	return 1 + (index * 613) % 8192;
+}
+
+bool verifyBlob(int32_t index, IStream* stream)
+{
+	if (!stream || stream->available() != blobSize(index))
+		return false;
+
+	uint8_t data[8192];
+	const int64_t nread = stream->read(data, blobSize(index));
+	if (nread != blobSize(index))
+		return false;
+
+	for (int64_t i = 0; i < nread; ++i)
+	{
+		if (data[i] != uint8_t(index + i))
+			return false;
+	}
+	return true;
+}
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.avalanche.test.CaseServerBatch", 0, CaseServerBatch, traktor::test::Case)
+
+void CaseServerBatch::run()
+{
+	// Use file backed dictionary so blobs are sent through zero-copy path.
+	const std::wstring blobsPath = OS::getInstance().getWritableFolderPath() + L"/Avalanche/CaseServerBatch";
+
+	Ref< PropertyGroup > settings = new PropertyGroup();
+	settings->setProperty< PropertyInteger >(L"Avalanche.Port", c_port);
+	settings->setProperty< PropertyString >(L"Avalanche.Path", blobsPath);
+
+	Ref< Server > server = new Server();
+	CASE_ASSERT(server->create(settings));
+
+	Thread* serverThread = ThreadManager::getInstance().create([&](){
+		while (!serverThread->stopped())
+			server->update();
+	});
+	CASE_ASSERT(serverThread != nullptr);
+	if (serverThread == nullptr)
+		return;
+
+	serverThread->start();
+
+	Ref< Client > client = new Client(net::SocketAddressIPv4(L"localhost", c_port));
+
+	AlignedVector< Key > keys;
+	for (int32_t i = 0; i < c_blobCount; ++i)
+	{
+		const Key key = { 0x4000, 0x5000, 0x6000, (uint32_t)i };
+		keys.push_back(key);
+
+		uint8_t data[8192];
+		for (int64_t j = 0; j < blobSize(i); ++j)
+			data[j] = uint8_t(i + j);
+
+		Ref< IStream > s = client->put(key);
+		CASE_ASSERT(s != nullptr);
+		if (s)
+		{
+			s->write(data, blobSize(i));
+			s->close();
+		}
+	}
+
+	// Last key doesn't exist.
+	keys.push_back(Key(0x4000, 0x5000, 0x6000, 0xffff));
+
+	// One request per key.
+	Timer timer;
+	bool correct = true;
+	for (int32_t i = 0; i < c_blobCount; ++i)
+	{
+		correct &= client->have(keys[i]);
+
+		Ref< IStream > s = client->get(keys[i]);
+		correct &= verifyBlob(i, s);
+		if (s)
+			s->close();
+	}
+	correct &= !client->have(keys.back());
+	correct &= (client->get(keys.back()) == nullptr);
+	const double singleTime = timer.getElapsedTime();
+	CASE_ASSERT(correct);
+
+	// Batched requests.
+	timer.reset();
+	AlignedVector< int64_t > sizes;
+	CASE_ASSERT(client->have(keys, sizes));
+	CASE_ASSERT_EQUAL(sizes.size(), keys.size());
+
+	correct = true;
+	for (int32_t i = 0; i < c_blobCount && i < (int32_t)sizes.size(); ++i)
+		correct &= (sizes[i] == blobSize(i));
+	correct &= (sizes.back() == -1);
+	CASE_ASSERT(correct);
+
+	int32_t received = 0;
+	correct = true;
+	CASE_ASSERT(client->get(keys, [&](size_t index, IStream* stream) {
+		if (index < c_blobCount)
+			correct &= verifyBlob((int32_t)index, stream);
+		else
+			correct &= (stream == nullptr);
+		correct &= (index == (size_t)received);
+		received++;
+	}));
+	const double batchTime = timer.getElapsedTime();
+	CASE_ASSERT(correct);
+	CASE_ASSERT_EQUAL(received, (int32_t)keys.size());
+
+	// Connection is still usable after batch.
+	CASE_ASSERT(client->ping());
+
+	// Server report version which support batches.
+	int32_t majorVersion = 0, minorVersion = 0;
+	CASE_ASSERT(client->version(majorVersion, minorVersion));
+	CASE_ASSERT_EQUAL(majorVersion, Server::c_majorVersion);
+	CASE_ASSERT(minorVersion >= c_minorVersionBatch);
+
+	// More keys than server accept in a single batch are split into several requests.
+	{
+		AlignedVector< Key > manyKeys;
+		for (uint32_t i = 0; i < c_maxBatchKeys + 100; ++i)
+			manyKeys.push_back(keys[i % keys.size()]);
+
+		AlignedVector< int64_t > manySizes;
+		CASE_ASSERT(client->have(manyKeys, manySizes));
+		CASE_ASSERT_EQUAL(manySizes.size(), manyKeys.size());
+
+		correct = true;
+		for (size_t i = 0; i < manySizes.size(); ++i)
+		{
+			const size_t k = i % keys.size();
+			correct &= (manySizes[i] == ((k < c_blobCount) ? blobSize((int32_t)k) : -1));
+		}
+		CASE_ASSERT(correct);
+	}
+
+	StringOutputStream ss;
+	ss << L"STAT+GET " << c_blobCount << L" blobs; one request per key " << int32_t(singleTime * 1000000.0) << L" us, batched " << int32_t(batchTime * 1000000.0) << L" us";
+	succeeded(ss.str());
+
+	keys.pop_back();
+	client->evict(keys);
+	client->destroy();
+
+	serverThread->stop();
+	ThreadManager::getInstance().destroy(serverThread);
+
+	server->destroy();
+	server = nullptr;
+
+	FileSystem::getInstance().removeDirectory(blobsPath);
+}
+
+}
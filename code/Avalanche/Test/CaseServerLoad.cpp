@@ -0,0 +1,153 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include <algorithm>
+#include <atomic>
+#include "Avalanche/Dictionary.h"
+#include "Avalanche/Client/Client.h"
+#include "Avalanche/Server/Server.h"
+#include "Avalanche/Test/CaseServerLoad.h"
+#include "Core/Containers/AlignedVector.h"
+#include "Core/Io/IStream.h"
+#include "Core/Io/StringOutputStream.h"
+#include "Core/Settings/PropertyGroup.h"
+#include "Core/Settings/PropertyInteger.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/ThreadManager.h"
+#include "Core/Timer/Timer.h"
+#include "Net/SocketAddressIPv4.h"
+
+namespace traktor::avalanche::test
+{
+	namespace
+	{
+
+const int32_t c_port = 20002;
+const int32_t c_clientCount = 32;
+const int32_t c_requestsPerClient = 200;
+const int32_t c_blobCount = 16;
+const int32_t c_blobSize = 4096;
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.avalanche.test.CaseServerLoad", 0, CaseServerLoad, traktor::test::Case)
+
+void CaseServerLoad::run()
+{
+	Ref< PropertyGroup > settings = new PropertyGroup();
+	settings->setProperty< PropertyInteger >(L"Avalanche.Port", c_port);
+	settings->setProperty< PropertyInteger >(L"Avalanche.WorkerCount", 4);
+
+	Ref< Server > server = new Server();
+	CASE_ASSERT(server->create(settings));
+
+	Thread* serverThread = ThreadManager::getInstance().create([&](){
+		while (!serverThread->stopped())
+			server->update();
+	});
+	CASE_ASSERT(serverThread != nullptr);
+	if (serverThread == nullptr)
+		return;
+
+	serverThread->start();
+
+	const net::SocketAddressIPv4 serverAddress(L"localhost", c_port);
+
+	// Populate server with a few blobs.
+	uint8_t blob[c_blobSize];
+	for (int32_t i = 0; i < c_blobSize; ++i)
+		blob[i] = uint8_t(i);
+
+	{
+		Ref< Client > client = new Client(serverAddress);
+		for (int32_t i = 0; i < c_blobCount; ++i)
+		{
+			const Key key = { 0x1000, 0x2000, 0x3000, (uint32_t)i };
+			Ref< IStream > s = client->put(key);
+			CASE_ASSERT(s != nullptr);
+			if (s)
+			{
+				s->write(blob, c_blobSize);
+				s->close();
+			}
+		}
+		client->destroy();
+	}
+
+	// Each client thread simulates an agent issuing STAT and GET requests over
+	// it's own connection; latency is measured per request.
+	AlignedVector< double > latencies;
+	latencies.resize(c_clientCount * c_requestsPerClient * 2, 0.0);
+	std::atomic< int32_t > errors(0);
+
+	Thread* clientThreads[c_clientCount];
+	for (int32_t i = 0; i < c_clientCount; ++i)
+	{
+		clientThreads[i] = ThreadManager::getInstance().create([&, i]() {
+			Ref< Client > client = new Client(serverAddress);
+			double* clientLatencies = &latencies[i * c_requestsPerClient * 2];
+			uint8_t data[c_blobSize];
+			Timer timer;
+
+			for (int32_t j = 0; j < c_requestsPerClient; ++j)
+			{
+				const Key key = { 0x1000, 0x2000, 0x3000, (uint32_t)((i + j) % c_blobCount) };
+
+				double start = timer.getElapsedTime();
+				if (!client->have(key))
+					errors++;
+				clientLatencies[j * 2 + 0] = timer.getElapsedTime() - start;
+
+				start = timer.getElapsedTime();
+				Ref< IStream > s = client->get(key);
+				if (s)
+				{
+					if (s->read(data, c_blobSize) != c_blobSize)
+						errors++;
+					s->close();
+				}
+				else
+					errors++;
+				clientLatencies[j * 2 + 1] = timer.getElapsedTime() - start;
+			}
+
+			client->destroy();
+		});
+	}
+
+	Timer timer;
+	for (int32_t i = 0; i < c_clientCount; ++i)
+		clientThreads[i]->start();
+	for (int32_t i = 0; i < c_clientCount; ++i)
+	{
+		clientThreads[i]->wait();
+		ThreadManager::getInstance().destroy(clientThreads[i]);
+	}
+	const double duration = timer.getElapsedTime();
+
+	CASE_ASSERT_EQUAL((int32_t)errors, 0);
+
+	const size_t p99 = (latencies.size() * 99) / 100;
+	std::nth_element(latencies.ptr(), latencies.ptr() + p99, latencies.ptr() + latencies.size());
+
+	StringOutputStream ss;
+	ss << L"Served " << int32_t(latencies.size()) << L" requests from " << c_clientCount << L" clients; " << int32_t(latencies.size() / duration) << L" requests/s, p99 latency " << int32_t(latencies[p99] * 1000000.0) << L" us";
+	succeeded(ss.str());
+
+	// Connections are closed as clients disconnect.
+	ThreadManager::getInstance().getCurrentThread()->sleep(1000);
+	CASE_ASSERT_EQUAL(server->getConnectionCount(), (size_t)0);
+
+	serverThread->stop();
+	ThreadManager::getInstance().destroy(serverThread);
+
+	server->destroy();
+	server = nullptr;
+}
+
+}
@@ -0,0 +1,112 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <atomic>
+#include "Core/Config.h"
+
+namespace traktor
+{
+
+/*! Bounded Chase-Lev work stealing deque.
+ * \ingroup Core
+ *
+ * A single owner thread push and pop items at the bottom
+ * while any number of thief threads steal items from the top.
+ * Items must be trivially copyable, typically pointers.
+ *
+ * Capacity is fixed and must be a power of two; push
+ * returns false when deque is full so caller can
+ * decide how to handle overflow.
+ */
+template < typename T, int64_t Capacity >
+class WorkStealingDeque
+{
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+	/*! Push item at bottom; only called by owner. */
+	bool push(T item)
+	{
+		const int64_t b = m_bottom.load(std::memory_order_relaxed);
+		const int64_t t = m_top.load(std::memory_order_acquire);
+		if (b - t >= Capacity)
+			return false;
+
+		m_items[b & (Capacity - 1)].store(item, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/*! Pop item from bottom; only called by owner. */
+	bool pop(T& outItem)
+	{
+		const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+		m_bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = m_top.load(std::memory_order_relaxed);
+
+		if (t > b)
+		{
+			// Deque was empty.
+			m_bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		outItem = m_items[b & (Capacity - 1)].load(std::memory_order_relaxed);
+		if (t == b)
+		{
+			// Last item; race against thieves.
+			const bool won = m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			m_bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+
+		return true;
+	}
+
+	/*! Steal item from top; can be called by any thread. */
+	bool steal(T& outItem)
+	{
+		int64_t t = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t b = m_bottom.load(std::memory_order_acquire);
+		if (t >= b)
+			return false;
+
+		T item = m_items[t & (Capacity - 1)].load(std::memory_order_relaxed);
+		if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return false;
+
+		outItem = item;
+		return true;
+	}
+
+	/*! Approximate number of items in deque. */
+	int64_t size() const
+	{
+		const int64_t b = m_bottom.load(std::memory_order_relaxed);
+		const int64_t t = m_top.load(std::memory_order_relaxed);
+		return b > t ? b - t : 0;
+	}
+
+	/*! Check if deque is empty, approximate if called by a thief. */
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+private:
+	alignas(64) std::atomic< int64_t > m_top = 0;
+	alignas(64) std::atomic< int64_t > m_bottom = 0;
+	alignas(64) std::atomic< T > m_items[Capacity];
+};
+
+}
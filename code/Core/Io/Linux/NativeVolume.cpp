@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -213,7 +213,7 @@ Ref< IMappedFile > NativeVolume::map(const Path& fileName)
 	const int64_t size = st.st_size;
 
 	void* ptr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
-	if (!ptr)
+	if (ptr == MAP_FAILED)
 	{
 		close(fd);
 		return nullptr;
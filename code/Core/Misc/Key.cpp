@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -60,6 +60,16 @@ bool Key::write(IStream* stream) const
 	return stream->write(kv, sizeof(kv)) == sizeof(kv);
 }
 
+size_t Key::hash() const
+{
+	uint64_t h = ((uint64_t(std::get< 0 >(m_kv)) << 32) | std::get< 1 >(m_kv)) * 0x9e3779b97f4a7c15ull;
+	h ^= ((uint64_t(std::get< 2 >(m_kv)) << 32) | std::get< 3 >(m_kv));
+	h ^= h >> 31;
+	h *= 0xbf58476d1ce4e5b9ull;
+	h ^= h >> 29;
+	return size_t(h);
+}
+
 bool Key::operator == (const Key& rh) const
 {
 	return m_kv == rh.m_kv;
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -18,6 +18,8 @@
 #include "Core/Math/Matrix33.h"
 #include "Core/Math/Matrix44.h"
 #include "Core/Math/Quaternion.h"
+#include "Core/Math/Vector2.h"
+#include "Core/Math/Vector4.h"
 #include "Core/Misc/AutoPtr.h"
 #include "Core/Misc/Endian.h"
 #include "Core/Misc/TString.h"
@@ -39,6 +41,13 @@ namespace
 
 #if defined(T_LITTLE_ENDIAN)
 
+// Block serialized arrays rely on these being stored as is.
+static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 must be tightly packed");
+static_assert(sizeof(Vector4) == 4 * sizeof(float), "Vector4 must be tightly packed");
+static_assert(sizeof(Color4ub) == 4 * sizeof(uint8_t), "Color4ub must be tightly packed");
+static_assert(sizeof(Color4f) == 4 * sizeof(float), "Color4f must be tightly packed");
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must be tightly packed");
+
 template < typename T >
 bool read_primitive(const Ref< IStream >& stream, T& value)
 {
@@ -894,6 +903,19 @@ void BinarySerializer::operator>>(const MemberArray& m)
 			return;
 
 		m.reserve(size, size);
+
+#if defined(T_LITTLE_ENDIAN)
+		// Plain data elements are stored as is, read all in one go.
+		const size_t elementSize = m.getBlockElementSize();
+		if (elementSize > 0 && m.size() == size)
+		{
+			const int64_t blockSize = int64_t(size) * int64_t(elementSize);
+			if (blockSize > 0)
+				ensure(m_stream->read(m.getBlock(), blockSize) == blockSize);
+			return;
+		}
+#endif
+
 		m.read(*this, size);
 	}
 	else
@@ -903,6 +925,18 @@ void BinarySerializer::operator>>(const MemberArray& m)
 			return;
 
 		T_CHECK_STATUS;
+
+#if defined(T_LITTLE_ENDIAN)
+		const size_t elementSize = m.getBlockElementSize();
+		if (elementSize > 0)
+		{
+			const int64_t blockSize = int64_t(size) * int64_t(elementSize);
+			if (blockSize > 0)
+				ensure(m_stream->write(m.getBlock(), blockSize) == blockSize);
+			return;
+		}
+#endif
+
 		m.write(*this, size);
 	}
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,7 @@
  */
 #pragma once
 
+#include <type_traits>
 #include "Core/Containers/AlignedVector.h"
 #include "Core/Serialization/Member.h"
 #include "Core/Serialization/MemberArray.h"
@@ -90,6 +91,22 @@ public:
 		return true;
 	}
 
+	virtual size_t getBlockElementSize() const override final
+	{
+		if constexpr (IsBlockSerializable< ValueType >::value && std::is_same< ValueMember, Member< ValueType > >::value)
+			return sizeof(ValueType);
+		else
+			return 0;
+	}
+
+	virtual void* getBlock() const override final
+	{
+		if constexpr (IsBlockSerializable< ValueType >::value)
+			return m_ref.ptr();
+		else
+			return nullptr;
+	}
+
 private:
 	value_type& m_ref;
 	mutable size_t m_index;
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -10,6 +10,7 @@
 
 #include "Core/Config.h"
 
+#include <cstdint>
 #include <string>
 
 // import/export mechanism.
@@ -24,8 +25,13 @@ namespace traktor
 {
 
 class Attribute;
-class TypeInfo;
+class Color4f;
+class Color4ub;
 class ISerializer;
+class Quaternion;
+class TypeInfo;
+class Vector2;
+class Vector4;
 
 /*! Array member base.
  * \ingroup Core
@@ -70,6 +76,19 @@ public:
 	/*! Insert default element, used by property list to add new elements. */
 	virtual bool insert() const = 0;
 
+	/*! Get size of each element if array can be serialized as a single block.
+	 *
+	 * \return Element size, zero if elements must be serialized one by one.
+	 */
+	virtual size_t getBlockElementSize() const { return 0; }
+
+	/*! Get pointer to first element, elements are stored contiguously.
+	 *
+	 * Only valid if block element size is non-zero, when reading
+	 * the array must be reserved to it's final size first.
+	 */
+	virtual void* getBlock() const { return nullptr; }
+
 protected:
 	/*! Set attributes member. */
 	void setAttributes(const Attribute* attributes);
@@ -79,4 +98,29 @@ private:
 	const Attribute* m_attributes;
 };
 
+/*! Element types which binary serializers store as their memory representation.
+ * \ingroup Core
+ *
+ * Arrays of these elements, serialized with default member, can
+ * be read or written as a single block instead of one by one.
+ */
+template < typename ValueType >
+struct IsBlockSerializable { static constexpr bool value = false; };
+
+template < > struct IsBlockSerializable< int8_t > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< uint8_t > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< int16_t > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< uint16_t > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< int32_t > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< uint32_t > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< int64_t > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< uint64_t > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< float > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< double > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< Vector2 > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< Vector4 > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< Color4ub > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< Color4f > { static constexpr bool value = true; };
+template < > struct IsBlockSerializable< Quaternion > { static constexpr bool value = true; };
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2023 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,8 @@
  */
 #pragma once
 
+#include <type_traits>
+#include "Core/Serialization/Member.h"
 #include "Core/Serialization/MemberArray.h"
 
 namespace traktor
@@ -72,6 +74,22 @@ public:
 		return false;
 	}
 
+	virtual size_t getBlockElementSize() const override final
+	{
+		if constexpr (IsBlockSerializable< ValueType >::value && std::is_same< ValueMember, Member< ValueType > >::value)
+			return sizeof(ValueType);
+		else
+			return 0;
+	}
+
+	virtual void* getBlock() const override final
+	{
+		if constexpr (IsBlockSerializable< ValueType >::value)
+			return m_arr;
+		else
+			return nullptr;
+	}
+
 private:
 	ValueType* m_arr;
 	const wchar_t** m_elementNames;
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -17,6 +17,7 @@
 #include <list>
 #include <map>
 #include <set>
+#include <type_traits>
 #include <vector>
 
 namespace traktor
@@ -102,6 +103,22 @@ public:
 		return true;
 	}
 
+	virtual size_t getBlockElementSize() const override final
+	{
+		if constexpr (IsBlockSerializable< ValueType >::value && std::is_same< ValueMember, Member< ValueType > >::value)
+			return sizeof(ValueType);
+		else
+			return 0;
+	}
+
+	virtual void* getBlock() const override final
+	{
+		if constexpr (IsBlockSerializable< ValueType >::value)
+			return m_ref.data();
+		else
+			return nullptr;
+	}
+
 private:
 	value_type& m_ref;
 	mutable size_t m_index;
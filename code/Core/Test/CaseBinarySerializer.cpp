@@ -0,0 +1,169 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include <cstring>
+#include <vector>
+#include "Core/Io/DynamicMemoryStream.h"
+#include "Core/Math/Vector4.h"
+#include "Core/Serialization/BinarySerializer.h"
+#include "Core/Serialization/ISerializer.h"
+#include "Core/Serialization/MemberAlignedVector.h"
+#include "Core/Serialization/MemberStaticArray.h"
+#include "Core/Serialization/MemberStl.h"
+#include "Core/Test/CaseBinarySerializer.h"
+
+namespace traktor::test
+{
+
+class BinarySerializer_Arrays : public ISerializable
+{
+	T_RTTI_CLASS;
+
+public:
+	AlignedVector< Vector4 > positions;
+	std::vector< float > weights;
+	int32_t indices[5] = { 0 };
+	AlignedVector< bool > flags;
+	AlignedVector< std::wstring > names;
+
+	virtual void serialize(ISerializer& s) override
+	{
+		s >> MemberAlignedVector< Vector4 >(L"positions", positions);
+		s >> MemberStlVector< float >(L"weights", weights);
+		s >> MemberStaticArray< int32_t, 5 >(L"indices", indices);
+		s >> MemberAlignedVector< bool >(L"flags", flags);
+		s >> MemberAlignedVector< std::wstring >(L"names", names);
+	}
+};
+
+//! Value member which prevent array from being serialized as a block.
+class BinarySerializer_ValueMember : public Member< uint16_t >
+{
+public:
+	explicit BinarySerializer_ValueMember(const wchar_t* const name, uint16_t& ref)
+	:	Member< uint16_t >(name, ref)
+	{
+	}
+};
+
+class BinarySerializer_Block : public ISerializable
+{
+	T_RTTI_CLASS;
+
+public:
+	AlignedVector< uint16_t > values;
+
+	virtual void serialize(ISerializer& s) override
+	{
+		s >> MemberAlignedVector< uint16_t >(L"values", values);
+	}
+};
+
+class BinarySerializer_Element : public ISerializable
+{
+	T_RTTI_CLASS;
+
+public:
+	AlignedVector< uint16_t > values;
+
+	virtual void serialize(ISerializer& s) override
+	{
+		s >> MemberAlignedVector< uint16_t, BinarySerializer_ValueMember >(L"values", values);
+	}
+};
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.test.CaseBinarySerializer.BinarySerializer_Arrays", 0, BinarySerializer_Arrays, ISerializable)
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.test.CaseBinarySerializer.BinarySerializer_Block", 0, BinarySerializer_Block, ISerializable)
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.test.CaseBinarySerializer.BinarySerializer_Element", 0, BinarySerializer_Element, ISerializable)
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.test.CaseBinarySerializer", 0, CaseBinarySerializer, Case)
+
+void CaseBinarySerializer::run()
+{
+	// Round trip of block and element serialized arrays.
+	{
+		Ref< BinarySerializer_Arrays > src = new BinarySerializer_Arrays();
+		for (int32_t i = 0; i < 100; ++i)
+			src->positions.push_back(Vector4(float(i), float(i * 2), float(i * 3), 1.0f));
+		src->weights.push_back(0.25f);
+		src->weights.push_back(0.75f);
+		for (int32_t i = 0; i < 5; ++i)
+			src->indices[i] = i * 10 - 20;
+		src->flags.push_back(true);
+		src->flags.push_back(false);
+		src->names.push_back(L"first");
+		src->names.push_back(L"second");
+
+		DynamicMemoryStream wms(false, true);
+		CASE_ASSERT(BinarySerializer(&wms).writeObject(src));
+
+		DynamicMemoryStream rms(wms.getBuffer(), true, false);
+		Ref< BinarySerializer_Arrays > dst = BinarySerializer(&rms).readObject< BinarySerializer_Arrays >();
+		CASE_ASSERT_NOT_EQUAL(dst, nullptr);
+		if (dst)
+		{
+			CASE_ASSERT_EQUAL(dst->positions.size(), 100);
+			bool positionsEqual = true;
+			for (uint32_t i = 0; i < dst->positions.size(); ++i)
+				positionsEqual &= (dst->positions[i] == src->positions[i]);
+			CASE_ASSERT(positionsEqual);
+			CASE_ASSERT(dst->weights == src->weights);
+			CASE_ASSERT_EQUAL(dst->indices[0], -20);
+			CASE_ASSERT_EQUAL(dst->indices[4], 20);
+			CASE_ASSERT_EQUAL(dst->flags.size(), 2);
+			CASE_ASSERT_EQUAL(dst->flags[0], true);
+			CASE_ASSERT_EQUAL(dst->flags[1], false);
+			CASE_ASSERT_EQUAL(dst->names.size(), 2);
+			CASE_ASSERT(dst->names[1] == L"second");
+		}
+	}
+
+	// Block serialized arrays must be stored in same format as element serialized.
+	{
+		Ref< BinarySerializer_Block > block = new BinarySerializer_Block();
+		Ref< BinarySerializer_Element > element = new BinarySerializer_Element();
+		for (uint16_t i = 0; i < 1000; ++i)
+		{
+			block->values.push_back(i * 7);
+			element->values.push_back(i * 7);
+		}
+
+		DynamicMemoryStream blockStream(false, true);
+		DynamicMemoryStream elementStream(false, true);
+		CASE_ASSERT(BinarySerializer(&blockStream).writeObject(block));
+		CASE_ASSERT(BinarySerializer(&elementStream).writeObject(element));
+
+		// Compare only array data, type names in header differ.
+		const AlignedVector< uint8_t >& blockBuffer = blockStream.getBuffer();
+		const AlignedVector< uint8_t >& elementBuffer = elementStream.getBuffer();
+		CASE_ASSERT(blockBuffer.size() > 2000);
+		CASE_ASSERT(blockBuffer.size() + 2 == elementBuffer.size());
+		if (blockBuffer.size() > 2000 && blockBuffer.size() + 2 == elementBuffer.size())
+		{
+			const size_t tail = 1000 * sizeof(uint16_t) + sizeof(uint32_t);
+			CASE_ASSERT(std::memcmp(
+				blockBuffer.c_ptr() + blockBuffer.size() - tail,
+				elementBuffer.c_ptr() + elementBuffer.size() - tail,
+				tail
+			) == 0);
+		}
+
+		DynamicMemoryStream rms(blockStream.getBuffer(), true, false);
+		Ref< BinarySerializer_Block > dst = BinarySerializer(&rms).readObject< BinarySerializer_Block >();
+		CASE_ASSERT_NOT_EQUAL(dst, nullptr);
+		if (dst)
+		{
+			CASE_ASSERT_EQUAL(dst->values.size(), 1000);
+			CASE_ASSERT_EQUAL(dst->values[999], 999 * 7);
+		}
+	}
+}
+
+}
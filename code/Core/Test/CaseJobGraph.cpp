@@ -0,0 +1,143 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "Core/Test/CaseJobGraph.h"
+#include "Core/Thread/JobGraph.h"
+#include "Core/Thread/JobQueue.h"
+
+namespace traktor::test
+{
+	namespace
+	{
+
+const int32_t c_layerCount = 8;
+const int32_t c_layerWidth = 64;
+
+std::atomic< int32_t > g_sequence;
+int32_t g_finished[c_layerCount * c_layerWidth];
+
+bool executeLayered(JobQueue& queue)
+{
+	JobGraph graph;
+
+	// Each job depend on two jobs in previous layer; record sequence
+	// number when finished so we can verify order afterwards.
+	for (int32_t layer = 0; layer < c_layerCount; ++layer)
+	{
+		for (int32_t i = 0; i < c_layerWidth; ++i)
+		{
+			const int32_t index = layer * c_layerWidth + i;
+			const JobGraph::handle_t job = graph.add([=]() { g_finished[index] = g_sequence++; });
+			if (layer > 0)
+			{
+				graph.addDependency(job, (layer - 1) * c_layerWidth + i);
+				graph.addDependency(job, (layer - 1) * c_layerWidth + (i + 1) % c_layerWidth);
+			}
+		}
+	}
+
+	bool correct = true;
+	for (int32_t iteration = 0; iteration < 10; ++iteration)
+	{
+		g_sequence = 0;
+		for (int32_t i = 0; i < c_layerCount * c_layerWidth; ++i)
+			g_finished[i] = -1;
+
+		if (!graph.execute(queue))
+			return false;
+
+		for (int32_t layer = 1; layer < c_layerCount; ++layer)
+		{
+			for (int32_t i = 0; i < c_layerWidth; ++i)
+			{
+				const int32_t finished = g_finished[layer * c_layerWidth + i];
+				correct &= (finished > g_finished[(layer - 1) * c_layerWidth + i]);
+				correct &= (finished > g_finished[(layer - 1) * c_layerWidth + (i + 1) % c_layerWidth]);
+			}
+		}
+		correct &= (g_sequence == c_layerCount * c_layerWidth);
+	}
+	return correct;
+}
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.test.CaseJobGraph", 0, CaseJobGraph, Case)
+
+void CaseJobGraph::run()
+{
+	JobQueue fifoQueue;
+	fifoQueue.create(2, Thread::Normal, JobQueue::Mode::Fifo);
+
+	JobQueue stealQueue;
+	stealQueue.create(4, Thread::Normal, JobQueue::Mode::WorkStealing);
+
+	// Diamond; D must run after B and C which both must run after A.
+	{
+		std::atomic< int32_t > sequence(0);
+		int32_t a = -1, b = -1, c = -1, d = -1;
+
+		JobGraph graph;
+		const auto ja = graph.add([&]() { a = sequence++; });
+		const auto jb = graph.add([&]() { b = sequence++; }, { ja });
+		const auto jc = graph.add([&]() { c = sequence++; }, { ja });
+		graph.add([&]() { d = sequence++; }, { jb, jc });
+
+		CASE_ASSERT(graph.execute(stealQueue));
+		CASE_ASSERT_EQUAL(a, 0);
+		CASE_ASSERT(b > a && c > a);
+		CASE_ASSERT_EQUAL(d, 3);
+	}
+
+	// Cycles are rejected without executing any job.
+	{
+		int32_t count = 0;
+
+		JobGraph graph;
+		const auto j0 = graph.add([&]() { count++; });
+		const auto j1 = graph.add([&]() { count++; }, { j0 });
+		graph.addDependency(j0, j1);
+
+		CASE_ASSERT(!graph.execute(stealQueue));
+		CASE_ASSERT_EQUAL(count, 0);
+	}
+
+	// Cached order is updated when graph is modified after execute.
+	{
+		int32_t a = -1, b = -1, c = -1;
+		int32_t sequence = 0;
+
+		JobGraph graph;
+		const auto ja = graph.add([&]() { a = sequence++; });
+		const auto jb = graph.add([&]() { b = sequence++; }, { ja });
+
+		CASE_ASSERT(graph.execute(fifoQueue));
+		CASE_ASSERT_EQUAL(b, 1);
+
+		const auto jc = graph.add([&]() { c = sequence++; });
+		graph.addDependency(ja, jc);
+
+		sequence = 0;
+		CASE_ASSERT(graph.execute(fifoQueue));
+		CASE_ASSERT_EQUAL(c, 0);
+		CASE_ASSERT_EQUAL(a, 1);
+		CASE_ASSERT_EQUAL(b, 2);
+
+		graph.addDependency(jc, jb);
+		CASE_ASSERT(!graph.execute(fifoQueue));
+	}
+
+	// Layered graph executed repeatedly.
+	CASE_ASSERT(executeLayered(stealQueue));
+	CASE_ASSERT(executeLayered(fifoQueue));
+
+	stealQueue.destroy();
+	fifoQueue.destroy();
+}
+
+}
@@ -0,0 +1,196 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include <algorithm>
+#include "Core/Containers/AlignedVector.h"
+#include "Core/System/OS.h"
+#include "Core/Test/CaseJobQueue.h"
+#include "Core/Thread/JobQueue.h"
+#include "Core/Timer/Timer.h"
+
+namespace traktor::test
+{
+	namespace
+	{
+
+const int32_t c_forkCount = 1000;
+const int32_t c_iterations = 200;
+const int32_t c_elementCount = 20000;
+
+std::atomic< int32_t > g_counts[c_forkCount];
+std::atomic< int32_t > g_elements[c_elementCount];
+
+bool verifyCounts(int32_t expected)
+{
+	bool correct = true;
+	for (int32_t i = 0; i < c_forkCount; ++i)
+		correct &= (g_counts[i] == expected);
+	return correct;
+}
+
+void resetCounts()
+{
+	for (int32_t i = 0; i < c_forkCount; ++i)
+		g_counts[i] = 0;
+}
+
+double measureFork(JobQueue& queue)
+{
+	Job::task_t tasks[c_forkCount];
+	for (int32_t i = 0; i < c_forkCount; ++i)
+		tasks[i] = [=](){ g_counts[i]++; };
+
+	Timer timer;
+	for (int32_t i = 0; i < c_iterations; ++i)
+		queue.fork(tasks, c_forkCount);
+	return timer.getElapsedTime();
+}
+
+double measureAdd(JobQueue& queue)
+{
+	Timer timer;
+	for (int32_t i = 0; i < c_iterations; ++i)
+	{
+		for (int32_t j = 0; j < c_forkCount; ++j)
+			queue.add([=](){ g_counts[j]++; });
+		queue.wait();
+	}
+	return timer.getElapsedTime();
+}
+
+double measureForkPerElement(JobQueue& queue, int32_t elementCount, std::atomic< int32_t >* elements)
+{
+	Timer timer;
+	for (int32_t i = 0; i < c_iterations; ++i)
+	{
+		AlignedVector< Job::task_t > tasks;
+		tasks.reserve(elementCount);
+		for (int32_t j = 0; j < elementCount; ++j)
+			tasks.push_back([=](){ elements[j]++; });
+		queue.fork(tasks.c_ptr(), tasks.size());
+	}
+	return timer.getElapsedTime();
+}
+
+double measureParallelFor(JobQueue& queue, int32_t elementCount, std::atomic< int32_t >* elements)
+{
+	Timer timer;
+	for (int32_t i = 0; i < c_iterations; ++i)
+	{
+		queue.parallelFor(0, elementCount, 64, [=](size_t first, size_t last) {
+			for (size_t j = first; j < last; ++j)
+				elements[j]++;
+		});
+	}
+	return timer.getElapsedTime();
+}
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.test.CaseJobQueue", 0, CaseJobQueue, Case)
+
+void CaseJobQueue::run()
+{
+	const uint32_t workerCount = std::max< uint32_t >(OS::getInstance().getCPUCoreCount(), 2) - 1;
+
+	JobQueue fifoQueue;
+	fifoQueue.create(workerCount, Thread::Normal, JobQueue::Mode::Fifo);
+
+	JobQueue stealQueue;
+	stealQueue.create(workerCount, Thread::Normal, JobQueue::Mode::WorkStealing);
+
+	// Nested forks from inside jobs.
+	{
+		resetCounts();
+
+		Job::task_t outer[10];
+		for (int32_t i = 0; i < 10; ++i)
+		{
+			outer[i] = [&, i]() {
+				Job::task_t inner[100];
+				for (int32_t j = 0; j < 100; ++j)
+					inner[j] = [=](){ g_counts[i * 100 + j]++; };
+				stealQueue.fork(inner, 100);
+			};
+		}
+		stealQueue.fork(outer, 10);
+		CASE_ASSERT(verifyCounts(1));
+	}
+
+	// Compare fork overhead between modes.
+	{
+		resetCounts();
+		const double fifoTime = measureFork(fifoQueue);
+		CASE_ASSERT(verifyCounts(c_iterations));
+
+		resetCounts();
+		const double stealTime = measureFork(stealQueue);
+		CASE_ASSERT(verifyCounts(c_iterations));
+
+		StringOutputStream ss;
+		ss << L"Fork " << c_iterations << L" x " << c_forkCount << L" jobs on " << workerCount << L" workers; fifo " << int32_t(fifoTime * 1000.0) << L" ms, work stealing " << int32_t(stealTime * 1000.0) << L" ms";
+		succeeded(ss.str());
+	}
+
+	// Compare add and wait overhead between modes.
+	{
+		resetCounts();
+		const double fifoTime = measureAdd(fifoQueue);
+		CASE_ASSERT(verifyCounts(c_iterations));
+
+		resetCounts();
+		const double stealTime = measureAdd(stealQueue);
+		CASE_ASSERT(verifyCounts(c_iterations));
+
+		StringOutputStream ss;
+		ss << L"Add " << c_iterations << L" x " << c_forkCount << L" jobs on " << workerCount << L" workers; fifo " << int32_t(fifoTime * 1000.0) << L" ms, work stealing " << int32_t(stealTime * 1000.0) << L" ms";
+		succeeded(ss.str());
+	}
+
+	// Compare per frame scheduling overhead of one job per element versus parallel for.
+	{
+		const int32_t elementCount = c_elementCount;
+		std::atomic< int32_t >* elements = g_elements;
+
+		for (int32_t i = 0; i < elementCount; ++i)
+			elements[i] = 0;
+		const double forkTime = measureForkPerElement(stealQueue, elementCount, elements);
+
+		bool correct = true;
+		for (int32_t i = 0; i < elementCount; ++i)
+			correct &= (elements[i] == c_iterations);
+		CASE_ASSERT(correct);
+
+		for (int32_t i = 0; i < elementCount; ++i)
+			elements[i] = 0;
+		const double parallelForTime = measureParallelFor(stealQueue, elementCount, elements);
+
+		correct = true;
+		for (int32_t i = 0; i < elementCount; ++i)
+			correct &= (elements[i] == c_iterations);
+		CASE_ASSERT(correct);
+
+		StringOutputStream ss;
+		ss << L"Update " << elementCount << L" elements; job per element " << int32_t(forkTime * 1000000.0 / c_iterations) << L" us/frame, parallel for " << int32_t(parallelForTime * 1000000.0 / c_iterations) << L" us/frame";
+		succeeded(ss.str());
+	}
+
+	// Empty and single element ranges are executed on caller thread.
+	{
+		int32_t calls = 0;
+		stealQueue.parallelFor(0, 0, 1, [&](size_t, size_t) { calls++; });
+		CASE_ASSERT_EQUAL(calls, 0);
+		stealQueue.parallelFor(10, 11, 1, [&](size_t first, size_t last) { calls += int32_t(last - first); });
+		CASE_ASSERT_EQUAL(calls, 1);
+	}
+
+	stealQueue.destroy();
+	fifoQueue.destroy();
+}
+
+}
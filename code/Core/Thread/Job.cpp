@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2023 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -130,4 +130,12 @@ Job::Job(Event& jobFinishedEvent, const std::function< void() >& task)
 {
 }
 
+Job::Job(Event& jobFinishedEvent, const task_t* taskRef, std::atomic< int32_t >* join)
+:	m_jobFinishedEvent(jobFinishedEvent)
+,	m_taskRef(taskRef)
+,	m_join(join)
+,	m_finished(false)
+{
+}
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -48,14 +48,20 @@ public:
 	void operator delete (void* ptr);
 
 private:
+	friend class JobGraph;
 	friend class JobQueue;
 
 	Event& m_jobFinishedEvent;
 	task_t m_task;
+	const task_t* m_taskRef = nullptr;
+	std::atomic< int32_t >* m_join = nullptr;
 	std::atomic< bool > m_finished;
 
 	explicit Job(Event& jobFinishedEvent, const task_t& task);
 
+	/*! Fork job; references caller's task and decrements join counter when finished. */
+	explicit Job(Event& jobFinishedEvent, const task_t* taskRef, std::atomic< int32_t >* join);
+
 	Job() = delete;
 
 	Job(const Job&) = delete;
@@ -0,0 +1,165 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include <atomic>
+#include <new>
+#include "Core/Thread/JobGraph.h"
+#include "Core/Thread/JobManager.h"
+#include "Core/Thread/JobQueue.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/ThreadManager.h"
+
+namespace traktor
+{
+
+T_IMPLEMENT_RTTI_CLASS(L"traktor.JobGraph", JobGraph, Object)
+
+JobGraph::handle_t JobGraph::add(const Job::task_t& task)
+{
+	Node& node = m_nodes.push_back();
+	node.task = task;
+	m_sorted = false;
+	return handle_t(m_nodes.size() - 1);
+}
+
+JobGraph::handle_t JobGraph::add(const Job::task_t& task, const std::initializer_list< handle_t >& predecessors)
+{
+	const handle_t job = add(task);
+	for (auto predecessor : predecessors)
+		addDependency(job, predecessor);
+	return job;
+}
+
+void JobGraph::addDependency(handle_t job, handle_t predecessor)
+{
+	T_FATAL_ASSERT(job < m_nodes.size());
+	T_FATAL_ASSERT(predecessor < m_nodes.size());
+	m_nodes[predecessor].successors.push_back(job);
+	m_nodes[job].predecessorCount++;
+	m_sorted = false;
+}
+
+void JobGraph::reset()
+{
+	m_nodes.resize(0);
+	m_order.resize(0);
+	m_pending.resize(0);
+	m_run.resize(0);
+	m_sorted = false;
+}
+
+bool JobGraph::execute()
+{
+	return execute(JobManager::getInstance().getQueue());
+}
+
+bool JobGraph::execute(JobQueue& queue)
+{
+	if (!sort())
+		return false;
+
+	const uint32_t njobs = size();
+	if (njobs == 0)
+		return true;
+
+	// Only work stealing queue support releasing jobs from inside
+	// other jobs; fall back to execute jobs in order.
+	if (queue.getMode() != JobQueue::Mode::WorkStealing)
+	{
+		for (auto job : m_order)
+		{
+			if (m_nodes[job].task)
+				m_nodes[job].task();
+		}
+		return true;
+	}
+
+	std::atomic< int32_t > remaining((int32_t)njobs);
+
+	m_queue = &queue;
+	m_pending.resize(njobs);
+	m_run.resize(njobs);
+	m_jobStorage.resize(njobs * sizeof(Job));
+	m_jobs = (Job*)m_jobStorage.ptr();
+
+	for (uint32_t i = 0; i < njobs; ++i)
+	{
+		m_pending[i] = m_nodes[i].predecessorCount;
+		m_run[i] = [this, i]() { run(i); };
+		::new (&m_jobs[i]) Job(queue.m_jobFinishedEvent, &m_run[i], &remaining);
+	}
+
+	// Queue all jobs which have no predecessors.
+	for (uint32_t i = 0; i < njobs; ++i)
+	{
+		if (m_nodes[i].predecessorCount == 0)
+			queue.push(&m_jobs[i]);
+	}
+
+	// Help executing jobs until entire graph has finished.
+	Thread* current = ThreadManager::getInstance().getCurrentThread();
+	while (remaining.load(std::memory_order_acquire) > 0)
+	{
+		if (!queue.help())
+			current->yield();
+	}
+
+	for (uint32_t i = 0; i < njobs; ++i)
+		m_jobs[i].~Job();
+
+	m_jobs = nullptr;
+	m_queue = nullptr;
+	return true;
+}
+
+bool JobGraph::sort()
+{
+	if (m_sorted)
+		return m_acyclic;
+
+	const uint32_t njobs = size();
+
+	m_order.resize(0);
+	m_pending.resize(njobs);
+	for (uint32_t i = 0; i < njobs; ++i)
+	{
+		m_pending[i] = m_nodes[i].predecessorCount;
+		if (m_pending[i] == 0)
+			m_order.push_back(i);
+	}
+
+	for (uint32_t i = 0; i < m_order.size(); ++i)
+	{
+		for (auto successor : m_nodes[m_order[i]].successors)
+		{
+			if (--m_pending[successor] == 0)
+				m_order.push_back(successor);
+		}
+	}
+
+	// Jobs which never got released are part of a cycle.
+	m_acyclic = (m_order.size() == njobs);
+	m_sorted = true;
+	return m_acyclic;
+}
+
+void JobGraph::run(handle_t job)
+{
+	const Node& node = m_nodes[job];
+	if (node.task)
+		node.task();
+
+	// Release successors which have all their predecessors finished.
+	for (auto successor : node.successors)
+	{
+		if (std::atomic_ref< int32_t >(m_pending[successor]).fetch_sub(1, std::memory_order_acq_rel) == 1)
+			m_queue->push(&m_jobs[successor]);
+	}
+}
+
+}
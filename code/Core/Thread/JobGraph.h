@@ -0,0 +1,116 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "Core/Object.h"
+#include "Core/Containers/AlignedVector.h"
+#include "Core/Thread/Job.h"
+
+// import/export mechanism.
+#undef T_DLLCLASS
+#if defined(T_CORE_EXPORT)
+#	define T_DLLCLASS T_DLLEXPORT
+#else
+#	define T_DLLCLASS T_DLLIMPORT
+#endif
+
+namespace traktor
+{
+
+class JobQueue;
+
+/*! Job dependency graph.
+ * \ingroup Core
+ *
+ * Jobs are declared with edges to the jobs which must
+ * finish before they can start. When graph is executed
+ * all jobs without predecessors are queued and each
+ * successor is queued as soon as it's last predecessor
+ * has finished; thus there are no barriers between "stages".
+ *
+ * Graph can be executed multiple times, ie. built once
+ * and executed each frame.
+ */
+class T_DLLCLASS JobGraph : public Object
+{
+	T_RTTI_CLASS;
+
+public:
+	typedef uint32_t handle_t;
+
+	/*! Add job to graph.
+	 *
+	 * \param task Job functor.
+	 * \return Handle to job.
+	 */
+	handle_t add(const Job::task_t& task);
+
+	/*! Add job to graph which depend on other jobs.
+	 *
+	 * \param task Job functor.
+	 * \param predecessors Jobs which must finish before this job is started.
+	 * \return Handle to job.
+	 */
+	handle_t add(const Job::task_t& task, const std::initializer_list< handle_t >& predecessors);
+
+	/*! Add dependency edge.
+	 *
+	 * \param job Job which depend on predecessor.
+	 * \param predecessor Job which must finish before job can start.
+	 */
+	void addDependency(handle_t job, handle_t predecessor);
+
+	/*! Remove all jobs from graph. */
+	void reset();
+
+	/*! Execute graph using job manager's queue and wait until all jobs are finished.
+	 *
+	 * \return False if graph contain a cycle, no job is executed.
+	 */
+	bool execute();
+
+	/*! Execute graph and wait until all jobs are finished.
+	 *
+	 * Caller thread help executing jobs while waiting; if queue
+	 * isn't in work stealing mode jobs are executed in
+	 * dependency order on caller thread.
+	 *
+	 * \param queue Job queue.
+	 * \return False if graph contain a cycle, no job is executed.
+	 */
+	bool execute(JobQueue& queue);
+
+	/*! Get number of jobs in graph. */
+	uint32_t size() const { return uint32_t(m_nodes.size()); }
+
+private:
+	struct Node
+	{
+		Job::task_t task;
+		AlignedVector< handle_t > successors;
+		int32_t predecessorCount = 0;
+	};
+
+	AlignedVector< Node > m_nodes;
+	AlignedVector< handle_t > m_order;
+	AlignedVector< int32_t > m_pending;
+	AlignedVector< Job::task_t > m_run;
+	AlignedVector< uint8_t > m_jobStorage;
+	JobQueue* m_queue = nullptr;
+	Job* m_jobs = nullptr;
+	bool m_sorted = false;
+	bool m_acyclic = false;
+
+	/*! Sort jobs in dependency order, order is cached until graph is modified. */
+	bool sort();
+
+	void run(handle_t job);
+};
+
+}
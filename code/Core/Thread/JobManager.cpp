@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -31,7 +31,8 @@ JobManager& JobManager::getInstance()
 
 		s_instance->m_queue.create(
 			coreCount,
-			Thread::Normal
+			Thread::Normal,
+			JobQueue::Mode::WorkStealing
 		);
 	}
 	return *s_instance;
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -52,6 +52,15 @@ public:
 	 */
 	void fork(const Job::task_t* tasks, size_t ntasks) { return m_queue.fork(tasks, ntasks); }
 
+	/*! Execute function over a range in parallel.
+	 *
+	 * Range is split into chunks of at least grainSize elements
+	 * and function is called once per chunk as fn(first, last),
+	 * no job is allocated per element.
+	 */
+	template < typename FunctionType >
+	void parallelFor(size_t begin, size_t end, size_t grainSize, const FunctionType& fn) { m_queue.parallelFor(begin, end, grainSize, fn); }
+
 	/*! Wait until all jobs are finished.
 	 *
 	 * \param timeout Timeout in milliseconds; -1 if infinite timeout.
@@ -1,22 +1,39 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2023 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
+#include <new>
 #include "Core/RefArray.h"
+#include "Core/Memory/Alloc.h"
+#include "Core/Thread/Acquire.h"
 #include "Core/Thread/JobQueue.h"
 #include "Core/Thread/ThreadManager.h"
 
 namespace traktor
 {
+	namespace
+	{
+
+/*! Number of fork nodes which are allocated on caller's stack. */
+const size_t c_localForkNodes = 32;
+
+/*! Number of yields before an idle worker goes to sleep. */
+const int32_t c_spinCount = 64;
+
+thread_local JobQueue* s_workerQueue = nullptr;
+thread_local uint32_t s_workerDeque = 0;
+
+	}
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.JobQueue", JobQueue, Object)
 
 JobQueue::JobQueue()
 :	m_pending(0)
+,	m_sleeping(0)
 {
 }
 
@@ -25,13 +42,23 @@ JobQueue::~JobQueue()
 	destroy();
 }
 
-bool JobQueue::create(uint32_t workerThreads, Thread::Priority priority)
+bool JobQueue::create(uint32_t workerThreads, Thread::Priority priority, Mode mode)
 {
+	m_mode = mode;
+
+	// Deque 0 is used by threads which are not workers, each worker has it's own deque.
+	if (m_mode == Mode::WorkStealing)
+	{
+		m_deques.resize(workerThreads + 1);
+		for (uint32_t i = 0; i < uint32_t(m_deques.size()); ++i)
+			m_deques[i] = new deque_t();
+	}
+
 	m_workerThreads.resize(workerThreads);
 	for (uint32_t i = 0; i < uint32_t(m_workerThreads.size()); ++i)
 	{
 		m_workerThreads[i] = ThreadManager::getInstance().create(
-			[=, this]() { threadWorker(); },
+			[=, this]() { threadWorker(i + 1); },
 			L"Job queue, worker thread"
 		);
 		if (m_workerThreads[i])
@@ -53,12 +80,34 @@ void JobQueue::destroy()
 		ThreadManager::getInstance().destroy(m_workerThreads[i]);
 
 	m_workerThreads.clear();
+
+	// Release jobs which never got executed.
+	for (auto deque : m_deques)
+	{
+		Job* job;
+		while (deque->steal(job))
+		{
+			T_FATAL_ASSERT(job->m_join == nullptr);
+			T_SAFE_RELEASE(job);
+			m_pending--;
+		}
+		delete deque;
+	}
+	m_deques.clear();
 }
 
 Ref< Job > JobQueue::add(const Job::task_t& task)
 {
 	Ref< Job > job = new Job(m_jobFinishedEvent, task);
 	T_SAFE_ADDREF(job);
+
+	if (m_mode == Mode::WorkStealing)
+	{
+		m_pending++;
+		push(job);
+		return job;
+	}
+
 	m_jobQueue.put(job);
 	m_pending++;
 	m_jobQueuedEvent.pulse();
@@ -72,6 +121,40 @@ void JobQueue::fork(const Job::task_t* tasks, size_t ntasks)
 	if (ntasks == 0)
 		return;
 
+	if (m_mode == Mode::WorkStealing)
+	{
+		std::atomic< int32_t > join((int32_t)(ntasks - 1));
+
+		// Construct fork nodes in a single block, small forks use storage on stack.
+		const size_t nnodes = ntasks - 1;
+		alignas(Job) uint8_t localStorage[c_localForkNodes * sizeof(Job)];
+		uint8_t* storage = localStorage;
+		if (nnodes > c_localForkNodes)
+			storage = (uint8_t*)Alloc::acquireAlign(nnodes * sizeof(Job), alignof(Job), T_FILE_LINE);
+
+		Job* nodes = (Job*)storage;
+		for (size_t i = 0; i < nnodes; ++i)
+			push(::new (&nodes[i]) Job(m_jobFinishedEvent, &tasks[i + 1], &join));
+
+		// Execute first functor on caller thread.
+		tasks[0]();
+
+		// Help executing queued jobs until all forked jobs has finished.
+		Thread* current = ThreadManager::getInstance().getCurrentThread();
+		while (join.load(std::memory_order_acquire) > 0)
+		{
+			if (!help())
+				current->yield();
+		}
+
+		for (size_t i = 0; i < nnodes; ++i)
+			nodes[i].~Job();
+		if (storage != localStorage)
+			Alloc::freeAlign(storage);
+
+		return;
+	}
+
 	// Create jobs for given functors.
 	if (ntasks > 1)
 	{
@@ -103,6 +186,9 @@ bool JobQueue::wait(int32_t timeout)
 {
 	while (m_pending > 0)
 	{
+		// Help executing jobs, only block if there are no queued jobs.
+		if (m_mode == Mode::WorkStealing && help())
+			continue;
 		if (!m_jobFinishedEvent.wait(timeout))
 			return false;
 	}
@@ -122,11 +208,50 @@ void JobQueue::stop()
 		m_workerThreads[i]->stop();
 }
 
-void JobQueue::threadWorker()
+void JobQueue::threadWorker(uint32_t index)
 {
 	Thread* thread = ThreadManager::getInstance().getCurrentThread();
 	Job* job;
 
+	if (m_mode == Mode::WorkStealing)
+	{
+		s_workerQueue = this;
+		s_workerDeque = index;
+
+		int32_t idle = 0;
+		while (!thread->stopped())
+		{
+			if (help())
+			{
+				idle = 0;
+				continue;
+			}
+
+			// Spin a while before going to sleep as new jobs are usually queued shortly.
+			if (idle++ < c_spinCount)
+			{
+				thread->yield();
+				continue;
+			}
+
+			// Register as sleeping before checking for jobs a final time
+			// so we cannot miss a wake up from a concurrent push.
+			m_sleeping++;
+			if (help())
+			{
+				m_sleeping--;
+				idle = 0;
+				continue;
+			}
+			if (m_jobQueuedEvent.wait(100))
+				idle = 0;
+			m_sleeping--;
+		}
+
+		s_workerQueue = nullptr;
+		return;
+	}
+
 	while (!thread->stopped())
 	{
 		// Try to get a job from the queue.
@@ -149,4 +274,91 @@ void JobQueue::threadWorker()
 	}
 }
 
+void JobQueue::push(Job* job)
+{
+	bool pushed;
+
+	// Workers push onto their own deque, other threads onto the shared submission deque.
+	if (s_workerQueue == this)
+		pushed = m_deques[s_workerDeque]->push(job);
+	else
+	{
+		T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_submitLock);
+		pushed = m_deques[0]->push(job);
+	}
+
+	// Deque is full; execute job directly instead.
+	if (!pushed)
+	{
+		execute(job);
+		return;
+	}
+
+	// Wake a sleeping worker, fence ensure we see any worker which
+	// is about to sleep or the worker see our job.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_sleeping.load(std::memory_order_relaxed) > 0)
+		m_jobQueuedEvent.pulse();
+}
+
+bool JobQueue::acquire(Job*& outJob)
+{
+	const uint32_t ndeques = uint32_t(m_deques.size());
+	uint32_t start = 0;
+
+	// Pop our own jobs first, most recent is most likely warm in cache.
+	if (s_workerQueue == this)
+	{
+		if (m_deques[s_workerDeque]->pop(outJob))
+			return true;
+		start = s_workerDeque;
+	}
+
+	// Steal oldest job from any other deque.
+	for (uint32_t i = 1; i <= ndeques; ++i)
+	{
+		if (m_deques[(start + i) % ndeques]->steal(outJob))
+			return true;
+	}
+
+	return false;
+}
+
+void JobQueue::execute(Job* job)
+{
+	if (job->m_taskRef)
+		(*job->m_taskRef)();
+	else
+	{
+		auto task = job->m_task;
+		if (task)
+			task();
+	}
+
+	// Fork nodes are owned by forking thread; must not touch node after join is decremented.
+	std::atomic< int32_t >* join = job->m_join;
+	job->m_finished = true;
+	if (join)
+	{
+		join->fetch_sub(1, std::memory_order_release);
+		return;
+	}
+
+	T_SAFE_RELEASE(job);
+
+	// Decrement number of pending jobs and signal anyone waiting for jobs to finish.
+	m_pending--;
+	m_jobFinishedEvent.broadcast();
+}
+
+bool JobQueue::help()
+{
+	Job* job;
+	if (!acquire(job))
+		return false;
+
+	execute(job);
+	return true;
+}
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,14 +8,17 @@
  */
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include "Core/Object.h"
 #include "Core/Containers/AlignedVector.h"
 #include "Core/Containers/ThreadsafeFifo.h"
+#include "Core/Containers/WorkStealingDeque.h"
 #include "Core/Thread/Event.h"
 #include "Core/Thread/Job.h"
 #include "Core/Thread/Semaphore.h"
 #include "Core/Thread/Signal.h"
+#include "Core/Thread/SpinLock.h"
 #include "Core/Thread/Thread.h"
 
 // import/export mechanism.
@@ -31,12 +34,25 @@ namespace traktor
 
 /*! Job queue.
  * \ingroup Core
+ *
+ * Queue can run in either of two modes; in "fifo" mode
+ * all jobs are passed through a single shared queue.
+ * In "work stealing" mode each worker thread has its own
+ * deque which it pushes and pops from, idle workers steal
+ * jobs from other workers. Jobs added from threads which are
+ * not workers of this queue are put into a shared submission deque.
  */
 class T_DLLCLASS JobQueue : public Object
 {
 	T_RTTI_CLASS;
 
 public:
+	enum class Mode
+	{
+		Fifo,
+		WorkStealing
+	};
+
 	JobQueue();
 
 	virtual ~JobQueue();
@@ -44,9 +60,11 @@ public:
 	/*! Create queue.
 	 *
 	 * \param workerThreads Number of worker threads.
+	 * \param priority Priority of worker threads.
+	 * \param mode Scheduling mode.
 	 * \return True if successfully created.
 	 */
-	bool create(uint32_t workerThreads, Thread::Priority priority);
+	bool create(uint32_t workerThreads, Thread::Priority priority, Mode mode = Mode::Fifo);
 
 	/*! Destroy queue. */
 	void destroy();
@@ -64,9 +82,64 @@ public:
 	 * Add jobs to internal worker queue, one job
 	 * is always run on the caller thread to reduce
 	 * work for kernel scheduler.
+	 *
+	 * In work stealing mode the caller thread also
+	 * helps executing queued jobs until all forked
+	 * jobs are finished.
 	 */
 	void fork(const Job::task_t* tasks, size_t ntasks);
 
+	/*! Execute function over a range in parallel.
+	 *
+	 * Range is split into contiguous chunks of at least grainSize
+	 * elements, number of chunks is limited by number of worker threads.
+	 * Function is called once per chunk as fn(first, last), chunks are
+	 * forked thus caller thread also executes chunks.
+	 *
+	 * \param begin First index of range.
+	 * \param end One past last index of range.
+	 * \param grainSize Minimum number of elements per chunk.
+	 * \param fn Function called for each chunk.
+	 */
+	template < typename FunctionType >
+	void parallelFor(size_t begin, size_t end, size_t grainSize, const FunctionType& fn)
+	{
+		if (end <= begin)
+			return;
+
+		const size_t count = end - begin;
+		const size_t maxChunks = std::min< size_t >((m_workerThreads.size() + 1) * 4, MaxParallelForChunks);
+		const size_t nchunks = std::clamp< size_t >(count / std::max< size_t >(grainSize, 1), 1, maxChunks);
+		if (nchunks <= 1)
+		{
+			fn(begin, end);
+			return;
+		}
+
+		// Tasks only capture pointer to range and chunk index so functors fit in small buffer.
+		struct Range
+		{
+			const FunctionType* fn;
+			size_t begin;
+			size_t end;
+			size_t chunkSize;
+		}
+		range = { &fn, begin, end, (count + nchunks - 1) / nchunks };
+
+		Job::task_t tasks[MaxParallelForChunks];
+		size_t ntasks = 0;
+		for (size_t first = begin; first < end; first += range.chunkSize)
+		{
+			tasks[ntasks] = [r = &range, i = ntasks]() {
+				const size_t first = r->begin + i * r->chunkSize;
+				(*r->fn)(first, std::min(first + r->chunkSize, r->end));
+			};
+			++ntasks;
+		}
+
+		fork(tasks, ntasks);
+	}
+
 	/*! Wait until all jobs are finished.
 	 *
 	 * \param timeout Timeout in milliseconds; -1 if infinite timeout.
@@ -84,14 +157,38 @@ public:
 	/*! Stop all worker threads. */
 	void stop();
 
+	/*! Get scheduling mode. */
+	Mode getMode() const { return m_mode; }
+
+	/*! Get number of worker threads. */
+	uint32_t getWorkerCount() const { return uint32_t(m_workerThreads.size()); }
+
 private:
+	friend class JobGraph;
+
+	static constexpr size_t MaxParallelForChunks = 128;
+
+	typedef WorkStealingDeque< Job*, 8192 > deque_t;
+
+	Mode m_mode = Mode::Fifo;
 	AlignedVector< Thread* > m_workerThreads;
 	ThreadsafeFifo< Job* > m_jobQueue;
+	AlignedVector< deque_t* > m_deques;
+	SpinLock m_submitLock;
 	Event m_jobQueuedEvent;
 	Event m_jobFinishedEvent;
 	std::atomic< int32_t > m_pending;
+	std::atomic< int32_t > m_sleeping;
+
+	void threadWorker(uint32_t index);
+
+	void push(Job* job);
+
+	bool acquire(Job*& outJob);
+
+	void execute(Job* job);
 
-	void threadWorker();
+	bool help();
 };
 
 }
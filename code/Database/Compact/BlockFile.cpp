@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -9,11 +9,13 @@
 #include <limits>
 #include "Core/Log/Log.h"
 #include "Core/Io/FileSystem.h"
+#include "Core/Io/IMappedFile.h"
 #include "Core/Io/Reader.h"
 #include "Core/Io/StreamStream.h"
 #include "Core/Io/Writer.h"
 #include "Core/Thread/Acquire.h"
 #include "Database/Compact/BlockFile.h"
+#include "Database/Compact/BlockMappedStream.h"
 #include "Database/Compact/BlockReadStream.h"
 #include "Database/Compact/BlockWriteStream.h"
 
@@ -101,6 +103,24 @@ bool BlockFile::open(const Path& fileName, bool readOnly, bool flushAlways)
 
 	m_stream->seek(IStream::SeekSet, c_dataOffset);
 
+	// Map entire file when read-only, blocks are then read directly from memory.
+	if (readOnly)
+	{
+		m_mappedFile = FileSystem::getInstance().map(fileName);
+		if (m_mappedFile)
+		{
+			for (const auto& block : m_blocks)
+			{
+				if (block.offset + block.size > m_mappedFile->getSize())
+				{
+					log::warning << L"Block " << block.id << L" outside of mapped file; reading through stream." << Endl;
+					m_mappedFile = nullptr;
+					break;
+				}
+			}
+		}
+	}
+
 	m_fileName = fileName;
 	m_flushAlways = flushAlways;
 	m_unusedReadStreams.push_back(m_stream);
@@ -121,6 +141,7 @@ void BlockFile::close()
 
 		m_unusedReadStreams.clear();
 		m_stream = nullptr;
+		m_mappedFile = nullptr;
 	}
 }
 
@@ -213,6 +234,9 @@ Ref< IStream > BlockFile::readBlock(uint32_t blockId)
 	if (it == m_blocks.end())
 		return nullptr;
 
+	if (m_mappedFile)
+		return new BlockMappedStream(m_mappedFile, it->offset, it->size);
+
 	Ref< IStream > stream;
 
 	// Pop unused read streams from cache.
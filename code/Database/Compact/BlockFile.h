@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -18,6 +18,7 @@
 namespace traktor
 {
 
+class IMappedFile;
 class IStream;
 
 }
@@ -27,6 +28,10 @@ namespace traktor::db
 
 /*! Block file
  * \ingroup Database
+ *
+ * When opened read-only the whole file is memory mapped
+ * and blocks are read directly from the mapping, without
+ * any seeking or copying through file streams.
  */
 class BlockFile : public Object
 {
@@ -68,6 +73,7 @@ private:
 	Path m_fileName;
 	Semaphore m_lock;
 	Ref< IStream > m_stream;
+	Ref< IMappedFile > m_mappedFile;
 	RefArray< IStream > m_unusedReadStreams;
 	AlignedVector< Block > m_blocks;
 	bool m_flushAlways = false;
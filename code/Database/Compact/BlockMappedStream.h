@@ -0,0 +1,39 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "Core/Ref.h"
+#include "Core/Io/MemoryStream.h"
+
+namespace traktor
+{
+
+class IMappedFile;
+
+}
+
+namespace traktor::db
+{
+
+/*! Read stream of block directly from mapped block file.
+ * \ingroup Database
+ *
+ * Keeps mapped file alive until stream is destroyed
+ * so it's safe to use even after block file is closed.
+ */
+class BlockMappedStream : public MemoryStream
+{
+public:
+	explicit BlockMappedStream(IMappedFile* mappedFile, int64_t offset, int64_t size);
+
+private:
+	Ref< IMappedFile > m_mappedFile;
+};
+
+}
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2025 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,7 @@
  */
 #include "Database/Database.h"
 
+#include <cstring>
 #include "Core/Log/Log.h"
 #include "Core/Misc/StringSplit.h"
 #include "Core/Thread/Acquire.h"
@@ -30,20 +31,16 @@ namespace traktor::db
 namespace
 {
 
-void buildInstanceMap(Group* group, SmallMap< Guid, Ref< Instance > >& outInstanceMap)
+void collectInstances(Group* group, RefArray< Instance >& outInstances)
 {
 	RefArray< Instance > childInstances;
 	group->getChildInstances(childInstances);
-	outInstanceMap.reserve(outInstanceMap.size() + childInstances.size());
-	for (const auto childInstance : childInstances)
-		outInstanceMap.insert(std::make_pair(
-			childInstance->getGuid(),
-			childInstance));
+	outInstances.insert(outInstances.end(), childInstances.begin(), childInstances.end());
 
 	RefArray< Group > childGroups;
 	group->getChildGroups(childGroups);
 	for (const auto childGroup : childGroups)
-		buildInstanceMap(childGroup, outInstanceMap);
+		collectInstances(childGroup, outInstances);
 }
 
 }
@@ -81,7 +78,7 @@ bool Database::open(IProviderDatabase* providerDatabase)
 	if (!m_rootGroup->internalCreate(m_providerDatabase->getRootGroup(), nullptr))
 		return false;
 
-	buildInstanceMap(m_rootGroup, m_instanceMap);
+	rebuildInstanceMap();
 	return true;
 }
 
@@ -143,7 +140,13 @@ bool Database::create(const ConnectionString& connectionString)
 
 void Database::close()
 {
-	m_instanceMap.clear();
+	for (uint32_t i = 0; i < ShardCount; ++i)
+	{
+		Shard& s = m_shards[i];
+		T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(s.lock);
+		s.instances.clear();
+		s.paths.clear();
+	}
 
 	if (m_rootGroup)
 	{
@@ -206,32 +209,57 @@ Ref< Instance > Database::getInstance(const Guid& instanceGuid)
 	if (instanceGuid.isNull() || !instanceGuid.isValid())
 		return nullptr;
 
-	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
 	T_ASSERT(m_providerDatabase);
-
-	const auto it = m_instanceMap.find(instanceGuid);
-	return it != m_instanceMap.end() ? it->second : nullptr;
+	return findInstance(instanceGuid);
 }
 
 Ref< Instance > Database::getInstance(const std::wstring& instancePath, const TypeInfo* primaryType)
 {
-	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
 	T_ASSERT(m_providerDatabase);
 
-	std::wstring instanceName = instancePath;
-	Ref< Group > group = m_rootGroup;
+	Ref< Instance > instance;
 
-	const auto i = instanceName.find_last_of(L'/');
-	if (i != std::wstring::npos)
+	// Find instance in path index first.
 	{
-		group = getGroup(instanceName.substr(0, i));
-		instanceName = instanceName.substr(i + 1);
+		Shard& s = shard(instancePath);
+		T_ANONYMOUS_VAR(ReaderWriterLock::AcquireReader)(s.lock);
+		const auto it = s.paths.find(instancePath);
+		if (it != s.paths.end())
+			instance = it->second;
 	}
 
-	if (!group)
+	// Not indexed; need to traverse group tree.
+	if (!instance)
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+
+		std::wstring instanceName = instancePath;
+		Ref< Group > group = m_rootGroup;
+
+		const auto i = instanceName.find_last_of(L'/');
+		if (i != std::wstring::npos)
+		{
+			group = getGroup(instanceName.substr(0, i));
+			instanceName = instanceName.substr(i + 1);
+		}
+
+		if (!group)
+			return nullptr;
+
+		if (!(instance = group->getInstance(instanceName)))
+			return nullptr;
+
+		// Path index is flushed under same lock thus instance
+		// cannot have been removed or moved since it was found.
+		Shard& s = shard(instancePath);
+		T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(s.lock);
+		s.paths[instancePath] = instance;
+	}
+
+	if (primaryType && !is_type_of(*primaryType, *instance->getPrimaryType()))
 		return nullptr;
 
-	return group->getInstance(instanceName, primaryType);
+	return instance;
 }
 
 Ref< Instance > Database::createInstance(const std::wstring& instancePath, uint32_t flags, const Guid* guid)
@@ -270,14 +298,11 @@ Ref< ISerializable > Database::getObjectReadOnly(const Guid& guid) const
 	if (guid.isNull() || !guid.isValid())
 		return nullptr;
 
-	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
 	T_ASSERT(m_providerDatabase);
 
-	const auto it = m_instanceMap.find(guid);
-	if (it == m_instanceMap.end() || !it->second)
-		return nullptr;
-
-	return it->second->getObject();
+	// Instance is read outside of any database lock.
+	Ref< Instance > instance = findInstance(guid);
+	return instance ? instance->getObject() : nullptr;
 }
 
 bool Database::getEvent(Ref< const IEvent >& outEvent, bool& outRemote)
@@ -293,8 +318,7 @@ bool Database::getEvent(Ref< const IEvent >& outEvent, bool& outRemote)
 
 		if (dynamic_type_cast< const EvtGroupRenamed* >(outEvent))
 		{
-			m_instanceMap.clear();
-			buildInstanceMap(m_rootGroup, m_instanceMap);
+			rebuildInstanceMap();
 		}
 
 		else if (const EvtInstanceCreated* created = dynamic_type_cast< const EvtInstanceCreated* >(outEvent))
@@ -322,39 +346,35 @@ bool Database::getEvent(Ref< const IEvent >& outEvent, bool& outRemote)
 					log::error << L"Unable to add instance; remotely created instance not found." << Endl;
 			}
 
-			m_instanceMap.clear();
-			buildInstanceMap(m_rootGroup, m_instanceMap);
+			rebuildInstanceMap();
 		}
 
 		else if (const EvtInstanceRemoved* removed = dynamic_type_cast< const EvtInstanceRemoved* >(outEvent))
 		{
-			auto it = m_instanceMap.find(removed->getInstanceGuid());
-			if (it != m_instanceMap.end())
-				m_instanceMap.erase(it);
+			removeInstance(removed->getInstanceGuid());
+			flushPaths();
 		}
 
 		else if (const EvtInstanceGuidChanged* guidChanged = dynamic_type_cast< const EvtInstanceGuidChanged* >(outEvent))
 		{
-			auto it = m_instanceMap.find(guidChanged->getInstancePreviousGuid());
-			if (it != m_instanceMap.end())
-				it->second->internalFlush();
+			Ref< Instance > instance = findInstance(guidChanged->getInstancePreviousGuid());
+			if (instance)
+				instance->internalFlush();
 
-			m_instanceMap.clear();
-			buildInstanceMap(m_rootGroup, m_instanceMap);
+			rebuildInstanceMap();
 		}
 
 		else if (const EvtInstanceRenamed* renamed = dynamic_type_cast< const EvtInstanceRenamed* >(outEvent))
 		{
-			auto it = m_instanceMap.find(renamed->getInstanceGuid());
-			if (it != m_instanceMap.end())
+			Ref< Instance > instance = findInstance(renamed->getInstanceGuid());
+			if (instance)
 			{
-				Ref< Group > parent = it->second->getParent();
+				Ref< Group > parent = instance->getParent();
 				if (parent)
 					parent->internalFlushChildInstances();
 			}
 
-			m_instanceMap.clear();
-			buildInstanceMap(m_rootGroup, m_instanceMap);
+			rebuildInstanceMap();
 		}
 	}
 
@@ -366,7 +386,7 @@ void Database::instanceEventCreated(Instance* instance)
 	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
 
 	// Insert new cache entry.
-	m_instanceMap[instance->getGuid()] = instance;
+	insertInstance(instance->getGuid(), instance);
 
 	// Notify others about new instance.
 	if (m_providerBus)
@@ -379,10 +399,9 @@ void Database::instanceEventRemoved(Instance* instance)
 {
 	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
 
-	// Remove previous cached entry.
-	const auto it = m_instanceMap.find(instance->getGuid());
-	if (it != m_instanceMap.end())
-		m_instanceMap.erase(it);
+	// Remove previous cached entries.
+	removeInstance(instance->getGuid());
+	flushPaths();
 
 	// Notify others about removed instance.
 	if (m_providerBus)
@@ -393,13 +412,9 @@ void Database::instanceEventGuidChanged(Instance* instance, const Guid& previous
 {
 	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
 
-	// Remove previous cached entry.
-	const auto it = m_instanceMap.find(previousGuid);
-	if (it != m_instanceMap.end())
-		m_instanceMap.erase(it);
-
-	// Insert new cache entry.
-	m_instanceMap[instance->getGuid()] = instance;
+	// Replace previous cached entry.
+	removeInstance(previousGuid);
+	insertInstance(instance->getGuid(), instance);
 
 	// Notify others about instance change.
 	if (m_providerBus)
@@ -408,6 +423,11 @@ void Database::instanceEventGuidChanged(Instance* instance, const Guid& previous
 
 void Database::instanceEventRenamed(Instance* instance, const std::wstring& previousName)
 {
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+		flushPaths();
+	}
+
 	// Notify others about instance change.
 	if (m_providerBus)
 		m_providerBus->putEvent(new EvtInstanceRenamed(instance->getGuid(), previousName));
@@ -422,9 +442,89 @@ void Database::instanceEventCommitted(Instance* instance)
 
 void Database::groupEventRenamed(Group* group, const std::wstring& previousPath)
 {
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+		flushPaths();
+	}
+
 	// Notify others about group change.
 	if (m_providerBus)
 		m_providerBus->putEvent(new EvtGroupRenamed(group->getName(), previousPath));
 }
 
+size_t Database::GuidHash::operator () (const Guid& guid) const
+{
+	size_t hash;
+	std::memcpy(&hash, (const uint8_t*)guid, sizeof(hash));
+	return hash;
+}
+
+Database::Shard& Database::shard(const Guid& guid) const
+{
+	// Use other bytes than hash so instances are spread evenly over buckets in each shard.
+	return m_shards[((const uint8_t*)guid)[15] % ShardCount];
+}
+
+Database::Shard& Database::shard(const std::wstring& path) const
+{
+	return m_shards[(std::hash< std::wstring >()(path) >> 8) % ShardCount];
+}
+
+Ref< Instance > Database::findInstance(const Guid& instanceGuid) const
+{
+	Shard& s = shard(instanceGuid);
+	T_ANONYMOUS_VAR(ReaderWriterLock::AcquireReader)(s.lock);
+	const auto it = s.instances.find(instanceGuid);
+	return it != s.instances.end() ? it->second : nullptr;
+}
+
+void Database::insertInstance(const Guid& instanceGuid, Instance* instance)
+{
+	Shard& s = shard(instanceGuid);
+	T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(s.lock);
+	s.instances[instanceGuid] = instance;
+}
+
+void Database::removeInstance(const Guid& instanceGuid)
+{
+	Shard& s = shard(instanceGuid);
+	T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(s.lock);
+	s.instances.erase(instanceGuid);
+}
+
+void Database::rebuildInstanceMap()
+{
+	// Collect all instances first, querying guid might need to access provider.
+	RefArray< Instance > instances;
+	collectInstances(m_rootGroup, instances);
+
+	// Build new shards aside so concurrent lookups never see a partial index;
+	// instances with duplicated guids, first instance found is kept.
+	std::unordered_map< Guid, Ref< Instance >, GuidHash > instanceShards[ShardCount];
+	for (const auto instance : instances)
+	{
+		const Guid instanceGuid = instance->getGuid();
+		const uint32_t index = uint32_t(&shard(instanceGuid) - m_shards);
+		instanceShards[index].insert(std::make_pair(instanceGuid, instance));
+	}
+
+	for (uint32_t i = 0; i < ShardCount; ++i)
+	{
+		Shard& s = m_shards[i];
+		T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(s.lock);
+		s.instances.swap(instanceShards[i]);
+		s.paths.clear();
+	}
+}
+
+void Database::flushPaths()
+{
+	for (uint32_t i = 0; i < ShardCount; ++i)
+	{
+		Shard& s = m_shards[i];
+		T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(s.lock);
+		s.paths.clear();
+	}
+}
+
 }
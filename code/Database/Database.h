@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,10 +8,13 @@
  */
 #pragma once
 
+#include <string>
+#include <unordered_map>
 #include "Core/Guid.h"
 #include "Core/Object.h"
 #include "Core/Ref.h"
-#include "Core/Containers/SmallMap.h"
+#include "Core/RefArray.h"
+#include "Core/Thread/ReaderWriterLock.h"
 #include "Core/Thread/Semaphore.h"
 #include "Database/ConnectionString.h"
 #include "Database/IGroupEventListener.h"
@@ -47,6 +50,13 @@ class Instance;
  *
  * The Database class manages a local view of
  * a database provider.
+ *
+ * Instances are indexed by guid, and by path once looked
+ * up, in maps which are split into shards each with it's
+ * own reader/writer lock; lookups only take the reader
+ * lock of a single shard thus concurrent lookups from
+ * multiple threads doesn't contend. Structural changes
+ * of the group tree are still serialized.
  */
 class T_DLLCLASS Database
 :	public Object
@@ -145,13 +155,43 @@ public:
 	virtual bool getEvent(Ref< const IEvent >& outEvent, bool& outRemote);
 
 private:
+	constexpr static uint32_t ShardCount = 16;
+
+	struct GuidHash
+	{
+		size_t operator () (const Guid& guid) const;
+	};
+
+	struct Shard
+	{
+		ReaderWriterLock lock;
+		std::unordered_map< Guid, Ref< Instance >, GuidHash > instances;
+		std::unordered_map< std::wstring, Ref< Instance > > paths;
+	};
+
 	Ref< IProviderDatabase > m_providerDatabase;
 	Ref< IProviderBus > m_providerBus;
 	Ref< Group > m_rootGroup;
 	mutable Semaphore m_lock;
-	SmallMap< Guid, Ref< Instance > > m_instanceMap;
+	mutable Shard m_shards[ShardCount];
 	uint64_t m_lastEntrySqnr = 0;
 
+	Shard& shard(const Guid& guid) const;
+
+	Shard& shard(const std::wstring& path) const;
+
+	Ref< Instance > findInstance(const Guid& instanceGuid) const;
+
+	void insertInstance(const Guid& instanceGuid, Instance* instance);
+
+	void removeInstance(const Guid& instanceGuid);
+
+	/*! Rebuild guid index from group tree, also flush path index. */
+	void rebuildInstanceMap();
+
+	/*! Flush path index, must be called when instances are removed or moved. */
+	void flushPaths();
+
 	// \name IInstanceEventListener
 	// \{
 
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2023 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -56,8 +56,11 @@ const std::wstring& Instance::getName() const
 	if (!(m_cachedFlags & IchName))
 	{
 		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
-		m_name = m_providerInstance->getName();
-		m_cachedFlags |= IchName;
+		if (!(m_cachedFlags & IchName))
+		{
+			m_name = m_providerInstance->getName();
+			m_cachedFlags |= IchName;
+		}
 	}
 	return m_name;
 }
@@ -71,6 +74,7 @@ std::wstring Instance::getPath() const
 
 Guid Instance::getGuid() const
 {
+	// Guid is copied by value and might be replaced by a commit, thus always lock.
 	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
 	if (!(m_cachedFlags & IchGuid))
 	{
@@ -101,8 +105,11 @@ std::wstring Instance::getPrimaryTypeName() const
 	if (!(m_cachedFlags & IchPrimaryType))
 	{
 		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
-		m_type = m_providerInstance->getPrimaryTypeName();
-		m_cachedFlags |= IchPrimaryType;
+		if (!(m_cachedFlags & IchPrimaryType))
+		{
+			m_type = m_providerInstance->getPrimaryTypeName();
+			m_cachedFlags |= IchPrimaryType;
+		}
 	}
 	return m_type;
 }
@@ -414,6 +421,7 @@ void Instance::internalDestroy()
 
 void Instance::internalFlush()
 {
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
 	m_cachedFlags = 0;
 }
 
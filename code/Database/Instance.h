@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2023 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include "Core/Guid.h"
 #include "Core/Object.h"
 #include "Core/Ref.h"
@@ -124,7 +125,7 @@ private:
 	Group* m_parent;
 
 	mutable Semaphore m_lock;
-	mutable uint32_t m_cachedFlags;
+	mutable std::atomic< uint32_t > m_cachedFlags;
 	mutable std::wstring m_name;
 	mutable Guid m_guid;
 	mutable std::wstring m_type;
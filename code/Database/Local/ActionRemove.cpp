@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -30,7 +30,7 @@ bool ActionRemove::execute(Context& context)
 	const Path instanceObjectPath = getInstanceObjectPath(m_instancePath);
 	const Path instanceMetaPath = getInstanceMetaPath(m_instancePath);
 
-	Ref< LocalInstanceMeta > instanceMeta = readPhysicalObject< LocalInstanceMeta >(instanceMetaPath);
+	Ref< LocalInstanceMeta > instanceMeta = readInstanceMeta(context, m_instancePath);
 	if (!instanceMeta)
 	{
 		log::error << L"Action remove failed; unable to read meta object." << Endl;
@@ -65,6 +65,7 @@ bool ActionRemove::execute(Context& context)
 		return false;
 	}
 
+	invalidateInstanceMeta(context, m_instancePath);
 	return true;
 }
 
@@ -77,6 +78,7 @@ bool ActionRemove::undo(Context& context)
 			return false;
 	}
 	m_renamedFiles.clear();
+	invalidateInstanceMeta(context, m_instancePath);
 	return true;
 }
 
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -30,7 +30,7 @@ bool ActionRemoveAllData::execute(Context& context)
 	const Path instanceObjectPath = getInstanceObjectPath(m_instancePath);
 	const Path instanceMetaPath = getInstanceMetaPath(m_instancePath);
 
-	Ref< LocalInstanceMeta > instanceMeta = readPhysicalObject< LocalInstanceMeta >(instanceMetaPath);
+	Ref< LocalInstanceMeta > instanceMeta = readInstanceMeta(context, m_instancePath);
 	if (!instanceMeta)
 	{
 		log::error << L"Action remove failed; unable to read meta object" << Endl;
@@ -57,7 +57,7 @@ bool ActionRemoveAllData::execute(Context& context)
 
 	instanceMeta->removeAllBlobs();
 
-	if (!writePhysicalObject(instanceMetaPath, instanceMeta, context.preferBinary()))
+	if (!writeInstanceMeta(context, m_instancePath, instanceMeta))
 	{
 		log::error << L"Unable to write instance meta \"" << instanceMetaPath.getPathName() << L"\"." << Endl;
 		return false;
@@ -80,6 +80,7 @@ bool ActionRemoveAllData::undo(Context& context)
 	// Rollback meta also since it contain named references to blobs.
 	const Path instanceMetaPath = getInstanceMetaPath(m_instancePath);
 	fileStore->rollback(instanceMetaPath);
+	invalidateInstanceMeta(context, m_instancePath);
 	return true;
 }
 
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -35,7 +35,7 @@ bool ActionSetGuid::execute(Context& context)
 
 	if (!m_create)
 	{
-		instanceMeta = readPhysicalObject< LocalInstanceMeta >(instanceMetaPath);
+		instanceMeta = readInstanceMeta(context, m_instancePath);
 		if (!instanceMeta)
 		{
 			log::error << L"Unable to read instance meta data, \"" << instanceMetaPath.getPathName() << L"\"." << Endl;
@@ -54,7 +54,7 @@ bool ActionSetGuid::execute(Context& context)
 
 	instanceMeta->setGuid(m_newGuid);
 
-	if (!writePhysicalObject(instanceMetaPath, instanceMeta, context.preferBinary()))
+	if (!writeInstanceMeta(context, m_instancePath, instanceMeta))
 	{
 		log::error << L"Unable to write instance meta data, \"" << instanceMetaPath.getPathName() << L"\"." << Endl;
 		return false;
@@ -71,6 +71,8 @@ bool ActionSetGuid::undo(Context& context)
 	IFileStore* fileStore = context.getFileStore();
 	const Path instanceMetaPath = getInstanceMetaPath(m_instancePath);
 
+	invalidateInstanceMeta(context, m_instancePath);
+
 	if (m_editMeta)
 	{
 		fileStore->rollback(instanceMetaPath);
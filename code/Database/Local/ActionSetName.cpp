@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -36,7 +36,7 @@ bool ActionSetName::execute(Context& context)
 	const Path newInstanceMetaPath = getInstanceMetaPath(m_instancePathNew);
 	const Path newInstanceObjectPath = getInstanceObjectPath(m_instancePathNew);
 
-	Ref< LocalInstanceMeta > instanceMeta = readPhysicalObject< LocalInstanceMeta >(oldInstanceMetaPath);
+	Ref< LocalInstanceMeta > instanceMeta = readInstanceMeta(context, m_instancePath);
 	if (!instanceMeta)
 		return false;
 
@@ -66,6 +66,7 @@ bool ActionSetName::execute(Context& context)
 		m_removedData[blob] = fileStore->remove(oldInstanceDataPath);
 	}
 
+	invalidateInstanceMeta(context, m_instancePath);
 	return true;
 }
 
@@ -92,6 +93,8 @@ bool ActionSetName::undo(Context& context)
 
 	m_removedData.clear();
 
+	invalidateInstanceMeta(context, m_instancePath);
+	invalidateInstanceMeta(context, m_instancePathNew);
 	return true;
 }
 
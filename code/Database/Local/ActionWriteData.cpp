@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -38,7 +38,7 @@ bool ActionWriteData::execute(Context& context)
 	const Path instanceMetaPath = getInstanceMetaPath(m_instancePath);
 	const Path instanceDataPath = getInstanceDataPath(m_instancePath, m_dataName);
 
-	Ref< LocalInstanceMeta > instanceMeta = readPhysicalObject< LocalInstanceMeta >(instanceMetaPath);
+	Ref< LocalInstanceMeta > instanceMeta = readInstanceMeta(context, m_instancePath);
 	if (!instanceMeta)
 	{
 		log::error << L"Unable to read instance meta data, \"" << instanceMetaPath.getPathName() << L"\"." << Endl;
@@ -105,7 +105,7 @@ bool ActionWriteData::execute(Context& context)
 
 	instanceMeta->setBlob(m_dataName);
 
-	if (!writePhysicalObject(instanceMetaPath, instanceMeta, context.preferBinary()))
+	if (!writeInstanceMeta(context, m_instancePath, instanceMeta))
 	{
 		log::error << L"Unable to write instance meta \"" << instanceMetaPath.getPathName() << L"\"." << Endl;
 		return false;
@@ -135,6 +135,7 @@ bool ActionWriteData::undo(Context& context)
 	else
 		fileStore->rollback(instanceMetaPath);
 
+	invalidateInstanceMeta(context, m_instancePath);
 	return true;
 }
 
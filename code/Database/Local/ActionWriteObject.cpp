@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -44,7 +44,7 @@ bool ActionWriteObject::execute(Context& context)
 		return false;
 	}
 
-	Ref< LocalInstanceMeta > instanceMeta = readPhysicalObject< LocalInstanceMeta >(instanceMetaPath);
+	Ref< LocalInstanceMeta > instanceMeta = readInstanceMeta(context, m_instancePath);
 	if (!instanceMeta)
 	{
 		log::error << L"Unable to read instance meta data, \"" << instanceMetaPath.getPathName() << L"\"." << Endl;
@@ -88,7 +88,7 @@ bool ActionWriteObject::execute(Context& context)
 
 		instanceMeta->setPrimaryType(m_primaryTypeName);
 
-		if (!writePhysicalObject(instanceMetaPath, instanceMeta, context.preferBinary()))
+		if (!writeInstanceMeta(context, m_instancePath, instanceMeta))
 		{
 			log::error << L"Unable to write instance meta data, \"" << instanceMetaPath.getPathName() << L"\"." << Endl;
 			return false;
@@ -107,7 +107,10 @@ bool ActionWriteObject::undo(Context& context)
 	if (m_editObject)
 		fileStore->rollback(instanceObjectPath);
 	if (m_editMeta)
+	{
 		fileStore->rollback(instanceMetaPath);
+		invalidateInstanceMeta(context, m_instancePath);
+	}
 
 	m_editObject =
 	m_editMeta = false;
@@ -1,22 +1,25 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 #include "Database/Local/Context.h"
+#include "Database/Local/IFileStore.h"
+#include "Database/Local/LocalIndex.h"
 
 namespace traktor::db
 {
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.db.Context", Context, Object)
 
-Context::Context(bool preferBinary, IFileStore* fileStore)
+Context::Context(bool preferBinary, IFileStore* fileStore, LocalIndex* index)
 :	m_sessionGuid(Guid::create())
 ,	m_preferBinary(preferBinary)
 ,	m_fileStore(fileStore)
+,	m_index(index)
 {
 }
 
@@ -35,4 +38,9 @@ IFileStore* Context::getFileStore() const
 	return m_fileStore;
 }
 
+LocalIndex* Context::getIndex() const
+{
+	return m_index;
+}
+
 }
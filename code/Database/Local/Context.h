@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -16,6 +16,7 @@ namespace traktor::db
 {
 
 class IFileStore;
+class LocalIndex;
 
 /*! Local database context.
  * \ingroup Database
@@ -27,7 +28,7 @@ class Context : public Object
 public:
 	Context() = default;
 
-	explicit Context(bool preferBinary, IFileStore* fileStore);
+	explicit Context(bool preferBinary, IFileStore* fileStore, LocalIndex* index);
 
 	const Guid& getSessionGuid() const;
 
@@ -35,10 +36,14 @@ public:
 
 	IFileStore* getFileStore() const;
 
+	/*! Meta data index, null if database is opened without index. */
+	LocalIndex* getIndex() const;
+
 private:
 	Guid m_sessionGuid;
 	bool m_preferBinary = false;
 	Ref< IFileStore > m_fileStore;
+	Ref< LocalIndex > m_index;
 };
 
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -16,6 +16,7 @@
 #include "Database/Local/LocalBus.h"
 #include "Database/Local/LocalDatabase.h"
 #include "Database/Local/LocalGroup.h"
+#include "Database/Local/LocalIndex.h"
 #include "Xml/XmlDeserializer.h"
 #include "Xml/XmlSerializer.h"
 
@@ -50,6 +51,7 @@ bool LocalDatabase::open(const ConnectionString& connectionString)
 	const Path groupPath = FileSystem::getInstance().getAbsolutePath(connectionString.get(L"groupPath"));
 	const bool journal = connectionString.have(L"journal") ? parseString< bool >(connectionString.get(L"journal")) : true;
 	const bool binary = connectionString.have(L"binary") ? parseString< bool >(connectionString.get(L"binary")) : false;
+	const bool index = connectionString.have(L"index") ? parseString< bool >(connectionString.get(L"index")) : true;
 
 	// Ensure group path exists.
 	if (!FileSystem::getInstance().makeAllDirectories(groupPath))
@@ -91,10 +93,19 @@ bool LocalDatabase::open(const ConnectionString& connectionString)
 		}
 	}
 
+	// Open meta data index; index is rebuilt if missing or invalid.
+	Ref< LocalIndex > localIndex;
+	if (index)
+	{
+		localIndex = new LocalIndex();
+		localIndex->open(groupPath.getPathName() + L"/Index.bin");
+	}
+
 	// Create context.
 	m_context = Context(
 		binary,
-		fileStore
+		fileStore,
+		localIndex
 	);
 
 	// Create event journal file.
@@ -125,6 +136,9 @@ void LocalDatabase::close()
 		m_bus = nullptr;
 	}
 
+	if (m_context.getIndex())
+		m_context.getIndex()->close();
+
 	if (m_context.getFileStore())
 	{
 		m_context.getFileStore()->destroy();
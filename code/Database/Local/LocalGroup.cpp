@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -11,6 +11,7 @@
 #include "Core/Misc/String.h"
 #include "Database/Types.h"
 #include "Database/Local/LocalGroup.h"
+#include "Database/Local/LocalIndex.h"
 #include "Database/Local/LocalInstance.h"
 #include "Database/Local/LocalFileLink.h"
 #include "Database/Local/Context.h"
@@ -84,7 +85,11 @@ bool LocalGroup::getChildren(RefArray< IProviderGroup >& outChildGroups, RefArra
 	T_ASSERT(outChildGroups.empty());
 	T_ASSERT(outChildInstances.empty());
 
-	RefArray< File > groupFiles = FileSystem::getInstance().find(m_groupPath.getPathName() + L"/*.*");
+	RefArray< File > groupFiles;
+	if (m_context.getIndex())
+		groupFiles = m_context.getIndex()->findGroupFiles(m_groupPath);
+	else
+		groupFiles = FileSystem::getInstance().find(m_groupPath.getPathName() + L"/*.*");
 	if (groupFiles.empty())
 		return false;
 
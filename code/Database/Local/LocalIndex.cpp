@@ -0,0 +1,519 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include <algorithm>
+#include <cstring>
+#include "Core/Date/DateTime.h"
+#include "Core/Io/File.h"
+#include "Core/Io/FileSystem.h"
+#include "Core/Io/IMappedFile.h"
+#include "Core/Io/IStream.h"
+#include "Core/Io/Utf8Encoding.h"
+#include "Core/Log/Log.h"
+#include "Core/Misc/TString.h"
+#include "Core/Thread/Acquire.h"
+#include "Database/Local/LocalIndex.h"
+#include "Database/Local/LocalInstanceMeta.h"
+#include "Database/Local/PhysicalAccess.h"
+
+namespace traktor::db
+{
+	namespace
+	{
+
+const uint32_t c_magic = 'T' | ('L' << 8) | ('I' << 16) | ('X' << 24);
+const uint32_t c_version = 1;
+
+/*! Index file layout:
+ *
+ * Header
+ * InstanceRecord[instanceCount], sorted by hash
+ * GroupRecord[groupCount], sorted by hash
+ * uint32_t[nameCount], string offsets of blob and child names
+ * char[stringsSize], zero terminated UTF-8 strings
+ */
+#pragma pack(push, 1)
+
+struct Header
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t instanceCount;
+	uint32_t groupCount;
+	uint32_t nameCount;
+	uint32_t stringsSize;
+};
+
+struct InstanceRecord
+{
+	uint64_t hash;
+	uint64_t writeTime;
+	uint64_t size;
+	uint64_t recordedAt;
+	uint8_t guid[16];
+	uint32_t path;
+	uint32_t primaryType;
+	uint32_t firstBlob;
+	uint32_t blobCount;
+};
+
+struct GroupRecord
+{
+	uint64_t hash;
+	uint64_t writeTime;
+	uint64_t size;
+	uint64_t recordedAt;
+	uint32_t path;
+	uint32_t firstChild;
+	uint32_t childCount;
+	uint32_t pad;
+};
+
+#pragma pack(pop)
+
+uint64_t hashPath(const std::wstring& path)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (const wchar_t ch : path)
+	{
+		hash ^= uint64_t(ch);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+struct Layout
+{
+	const Header* header = nullptr;
+	const InstanceRecord* instances = nullptr;
+	const GroupRecord* groups = nullptr;
+	const uint32_t* names = nullptr;
+	const char* strings = nullptr;
+
+	explicit Layout(const uint8_t* base)
+	{
+		header = (const Header*)base;
+		instances = (const InstanceRecord*)(header + 1);
+		groups = (const GroupRecord*)(instances + header->instanceCount);
+		names = (const uint32_t*)(groups + header->groupCount);
+		strings = (const char*)(names + header->nameCount);
+	}
+
+	std::wstring string(uint32_t offset) const
+	{
+		return offset < header->stringsSize ? mbstows(Utf8Encoding(), strings + offset) : std::wstring();
+	}
+
+	std::wstring name(uint32_t index) const
+	{
+		return index < header->nameCount ? string(names[index]) : std::wstring();
+	}
+};
+
+/*! Find record of path, records with same hash are compared by path. */
+template < typename RecordType >
+const RecordType* findRecord(const Layout& layout, const RecordType* records, uint32_t count, const std::wstring& path)
+{
+	const uint64_t hash = hashPath(path);
+	const RecordType* it = std::lower_bound(records, records + count, hash, [](const RecordType& record, uint64_t hash) {
+		return record.hash < hash;
+	});
+	for (; it != records + count && it->hash == hash; ++it)
+	{
+		if (layout.string(it->path) == path)
+			return it;
+	}
+	return nullptr;
+}
+
+class StringPool
+{
+public:
+	uint32_t add(const std::wstring& s)
+	{
+		auto it = m_offsets.find(s);
+		if (it != m_offsets.end())
+			return it->second;
+
+		const std::string mbs = wstombs(Utf8Encoding(), s);
+		const uint32_t offset = uint32_t(m_data.size());
+		m_data.insert(m_data.end(), mbs.begin(), mbs.end());
+		m_data.push_back(0);
+
+		m_offsets.insert(std::make_pair(s, offset));
+		return offset;
+	}
+
+	const AlignedVector< char >& data() const { return m_data; }
+
+private:
+	std::map< std::wstring, uint32_t > m_offsets;
+	AlignedVector< char > m_data;
+};
+
+void setStamp(const File* file, uint64_t& outWriteTime, uint64_t& outSize, uint64_t& outRecordedAt)
+{
+	outWriteTime = file->getLastWriteTime().getSecondsSinceEpoch();
+	outSize = file->getSize();
+	outRecordedAt = DateTime::now().getSecondsSinceEpoch();
+}
+
+	}
+
+T_IMPLEMENT_RTTI_CLASS(L"traktor.db.LocalIndex", LocalIndex, Object)
+
+bool LocalIndex::Stamp::valid(const File* file) const
+{
+	return
+		writeTime == file->getLastWriteTime().getSecondsSinceEpoch() &&
+		size == file->getSize() &&
+		writeTime < recordedAt;
+}
+
+bool LocalIndex::open(const Path& indexPath)
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+
+	m_indexPath = indexPath;
+	m_mappedFile = nullptr;
+	m_base = nullptr;
+	m_instances.clear();
+	m_groups.clear();
+	m_modified = false;
+
+	if (!FileSystem::getInstance().exist(indexPath))
+		return true;
+
+	Ref< IMappedFile > mappedFile = FileSystem::getInstance().map(indexPath);
+	if (!mappedFile || mappedFile->getSize() < (int64_t)sizeof(Header))
+	{
+		log::warning << L"Unable to map database index \"" << indexPath.getPathName() << L"\"; index ignored." << Endl;
+		return false;
+	}
+
+	// Ensure file is complete before any record is accessed.
+	const uint8_t* base = (const uint8_t*)mappedFile->getBase();
+	const Header* header = (const Header*)base;
+	if (header->magic != c_magic || header->version != c_version)
+	{
+		log::warning << L"Database index \"" << indexPath.getPathName() << L"\" of unknown version; index ignored." << Endl;
+		return false;
+	}
+
+	const int64_t size =
+		sizeof(Header) +
+		int64_t(header->instanceCount) * sizeof(InstanceRecord) +
+		int64_t(header->groupCount) * sizeof(GroupRecord) +
+		int64_t(header->nameCount) * sizeof(uint32_t) +
+		int64_t(header->stringsSize);
+	if (size != mappedFile->getSize() || (header->stringsSize > 0 && base[size - 1] != 0))
+	{
+		log::warning << L"Database index \"" << indexPath.getPathName() << L"\" corrupt; index ignored." << Endl;
+		return false;
+	}
+
+	m_mappedFile = mappedFile;
+	m_base = base;
+	return true;
+}
+
+void LocalIndex::close()
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+
+	// Records which hasn't been accessed are dropped, write back
+	// if any has been dropped even if nothing has been modified.
+	bool modified = m_modified;
+	if (m_base)
+	{
+		const Header* header = (const Header*)m_base;
+		if (header->instanceCount != m_instances.size() || header->groupCount != m_groups.size())
+			modified = true;
+	}
+
+	m_mappedFile = nullptr;
+	m_base = nullptr;
+
+	if (modified && !m_indexPath.empty())
+	{
+		if (!write())
+			log::warning << L"Unable to write database index \"" << m_indexPath.getPathName() << L"\"." << Endl;
+	}
+
+	m_instances.clear();
+	m_groups.clear();
+	m_modified = false;
+}
+
+Ref< LocalInstanceMeta > LocalIndex::readInstanceMeta(const Path& instancePath)
+{
+	const Path instanceMetaPath = getInstanceMetaPath(instancePath);
+	const std::wstring key = instancePath.getPathName();
+
+	Ref< File > file = FileSystem::getInstance().get(instanceMetaPath);
+	if (!file)
+	{
+		invalidateInstanceMeta(instancePath);
+		return nullptr;
+	}
+
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+		const Instance* instance = findInstance(key);
+		if (instance && instance->stamp.valid(file))
+		{
+			Ref< LocalInstanceMeta > instanceMeta = new LocalInstanceMeta(instance->guid, instance->primaryType);
+			for (const auto& blob : instance->blobs)
+				instanceMeta->setBlob(blob);
+			return instanceMeta;
+		}
+	}
+
+	// Parse meta file outside of lock; if file is modified after it
+	// was stat:ed then the record will be invalid on next access.
+	Ref< LocalInstanceMeta > instanceMeta = readPhysicalObject< LocalInstanceMeta >(instanceMetaPath);
+	if (!instanceMeta)
+		return nullptr;
+
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+
+	Instance& instance = m_instances[key];
+	setStamp(file, instance.stamp.writeTime, instance.stamp.size, instance.stamp.recordedAt);
+	instance.guid = instanceMeta->getGuid();
+	instance.primaryType = instanceMeta->getPrimaryType();
+	instance.blobs.resize(0);
+	for (const auto& blob : instanceMeta->getBlobs())
+		instance.blobs.push_back(blob);
+
+	m_modified = true;
+	return instanceMeta;
+}
+
+void LocalIndex::updateInstanceMeta(const Path& instancePath, const LocalInstanceMeta* instanceMeta)
+{
+	Ref< File > file = FileSystem::getInstance().get(getInstanceMetaPath(instancePath));
+	if (!file)
+	{
+		invalidateInstanceMeta(instancePath);
+		return;
+	}
+
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+
+	Instance& instance = m_instances[instancePath.getPathName()];
+	setStamp(file, instance.stamp.writeTime, instance.stamp.size, instance.stamp.recordedAt);
+	instance.guid = instanceMeta->getGuid();
+	instance.primaryType = instanceMeta->getPrimaryType();
+	instance.blobs.resize(0);
+	for (const auto& blob : instanceMeta->getBlobs())
+		instance.blobs.push_back(blob);
+
+	m_modified = true;
+}
+
+void LocalIndex::invalidateInstanceMeta(const Path& instancePath)
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+	if (m_instances.erase(instancePath.getPathName()) > 0)
+		m_modified = true;
+}
+
+RefArray< File > LocalIndex::findGroupFiles(const Path& groupPath)
+{
+	const std::wstring key = groupPath.getPathName();
+
+	Ref< File > directory = FileSystem::getInstance().get(groupPath);
+	if (directory)
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+		const Group* group = findGroup(key);
+		if (group && group->stamp.valid(directory))
+		{
+			RefArray< File > files;
+			files.reserve(group->children.size());
+			for (const auto& child : group->children)
+			{
+				if (!child.empty() && child.back() == L'/')
+					files.push_back(new File(key + L"/" + child.substr(0, child.length() - 1), 0, File::FfDirectory));
+				else
+					files.push_back(new File(key + L"/" + child, 0, File::FfNormal));
+			}
+			return files;
+		}
+	}
+
+	RefArray< File > files = FileSystem::getInstance().find(key + L"/*.*");
+	if (!directory || files.empty())
+		return files;
+
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+
+	AlignedVector< std::wstring > children;
+	children.reserve(files.size());
+	for (auto file : files)
+	{
+		const std::wstring fileName = file->getPath().getFileName();
+		if (fileName == L"." || fileName == L"..")
+			continue;
+		if (file->isDirectory())
+			children.push_back(fileName + L"/");
+		else
+			children.push_back(fileName);
+	}
+
+	// Don't write back index only because directory time has changed, ex. root
+	// group is touched each time the index, or journal, is written.
+	Group& group = m_groups[key];
+	if (group.children.size() != children.size() || !std::equal(children.begin(), children.end(), group.children.begin()))
+	{
+		group.children.swap(children);
+		m_modified = true;
+	}
+	setStamp(directory, group.stamp.writeTime, group.stamp.size, group.stamp.recordedAt);
+	return files;
+}
+
+const LocalIndex::Instance* LocalIndex::findInstance(const std::wstring& instancePath)
+{
+	auto it = m_instances.find(instancePath);
+	if (it != m_instances.end())
+		return &it->second;
+
+	if (!m_base)
+		return nullptr;
+
+	// Decode record from mapped file.
+	const Layout layout(m_base);
+	const InstanceRecord* record = findRecord(layout, layout.instances, layout.header->instanceCount, instancePath);
+	if (!record)
+		return nullptr;
+
+	Instance& instance = m_instances[instancePath];
+	instance.stamp.writeTime = record->writeTime;
+	instance.stamp.size = record->size;
+	instance.stamp.recordedAt = record->recordedAt;
+	instance.guid = Guid(record->guid);
+	instance.primaryType = layout.string(record->primaryType);
+	instance.blobs.reserve(record->blobCount);
+	for (uint32_t i = 0; i < record->blobCount; ++i)
+		instance.blobs.push_back(layout.name(record->firstBlob + i));
+	return &instance;
+}
+
+const LocalIndex::Group* LocalIndex::findGroup(const std::wstring& groupPath)
+{
+	auto it = m_groups.find(groupPath);
+	if (it != m_groups.end())
+		return &it->second;
+
+	if (!m_base)
+		return nullptr;
+
+	// Decode record from mapped file.
+	const Layout layout(m_base);
+	const GroupRecord* record = findRecord(layout, layout.groups, layout.header->groupCount, groupPath);
+	if (!record)
+		return nullptr;
+
+	Group& group = m_groups[groupPath];
+	group.stamp.writeTime = record->writeTime;
+	group.stamp.size = record->size;
+	group.stamp.recordedAt = record->recordedAt;
+	group.children.reserve(record->childCount);
+	for (uint32_t i = 0; i < record->childCount; ++i)
+		group.children.push_back(layout.name(record->firstChild + i));
+	return &group;
+}
+
+bool LocalIndex::write() const
+{
+	StringPool strings;
+	AlignedVector< uint32_t > names;
+
+	AlignedVector< InstanceRecord > instanceRecords;
+	instanceRecords.reserve(m_instances.size());
+	for (const auto& it : m_instances)
+	{
+		InstanceRecord& record = instanceRecords.push_back();
+		std::memset(&record, 0, sizeof(record));
+		record.hash = hashPath(it.first);
+		record.writeTime = it.second.stamp.writeTime;
+		record.size = it.second.stamp.size;
+		record.recordedAt = it.second.stamp.recordedAt;
+		std::memcpy(record.guid, (const uint8_t*)it.second.guid, sizeof(record.guid));
+		record.path = strings.add(it.first);
+		record.primaryType = strings.add(it.second.primaryType);
+		record.firstBlob = uint32_t(names.size());
+		record.blobCount = uint32_t(it.second.blobs.size());
+		for (const auto& blob : it.second.blobs)
+			names.push_back(strings.add(blob));
+	}
+
+	AlignedVector< GroupRecord > groupRecords;
+	groupRecords.reserve(m_groups.size());
+	for (const auto& it : m_groups)
+	{
+		GroupRecord& record = groupRecords.push_back();
+		std::memset(&record, 0, sizeof(record));
+		record.hash = hashPath(it.first);
+		record.writeTime = it.second.stamp.writeTime;
+		record.size = it.second.stamp.size;
+		record.recordedAt = it.second.stamp.recordedAt;
+		record.path = strings.add(it.first);
+		record.firstChild = uint32_t(names.size());
+		record.childCount = uint32_t(it.second.children.size());
+		for (const auto& child : it.second.children)
+			names.push_back(strings.add(child));
+	}
+
+	std::stable_sort(instanceRecords.begin(), instanceRecords.end(), [](const InstanceRecord& lh, const InstanceRecord& rh) {
+		return lh.hash < rh.hash;
+	});
+	std::stable_sort(groupRecords.begin(), groupRecords.end(), [](const GroupRecord& lh, const GroupRecord& rh) {
+		return lh.hash < rh.hash;
+	});
+
+	Header header;
+	header.magic = c_magic;
+	header.version = c_version;
+	header.instanceCount = uint32_t(instanceRecords.size());
+	header.groupCount = uint32_t(groupRecords.size());
+	header.nameCount = uint32_t(names.size());
+	header.stringsSize = uint32_t(strings.data().size());
+
+	// Write to temporary file first, other processes might
+	// have mapped the index or be writing it concurrently.
+	const Path temporaryPath = m_indexPath.getPathName() + L"~" + Guid::create().format();
+
+	Ref< IStream > stream = FileSystem::getInstance().open(temporaryPath, File::FmWrite);
+	if (!stream)
+		return false;
+
+	const auto writeBlock = [&](const void* data, size_t size) {
+		return size == 0 || stream->write(data, int64_t(size)) == int64_t(size);
+	};
+
+	bool result =
+		writeBlock(&header, sizeof(header)) &&
+		writeBlock(instanceRecords.c_ptr(), instanceRecords.size() * sizeof(InstanceRecord)) &&
+		writeBlock(groupRecords.c_ptr(), groupRecords.size() * sizeof(GroupRecord)) &&
+		writeBlock(names.c_ptr(), names.size() * sizeof(uint32_t)) &&
+		writeBlock(strings.data().c_ptr(), strings.data().size());
+
+	stream->close();
+
+	if (result)
+		result = FileSystem::getInstance().move(m_indexPath, temporaryPath, true);
+
+	if (!result)
+		FileSystem::getInstance().remove(temporaryPath);
+
+	return result;
+}
+
+}
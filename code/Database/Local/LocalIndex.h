@@ -0,0 +1,113 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <map>
+#include <string>
+#include "Core/Guid.h"
+#include "Core/Object.h"
+#include "Core/Ref.h"
+#include "Core/RefArray.h"
+#include "Core/Containers/AlignedVector.h"
+#include "Core/Io/Path.h"
+#include "Core/Thread/Semaphore.h"
+
+namespace traktor
+{
+
+class File;
+class IMappedFile;
+
+}
+
+namespace traktor::db
+{
+
+class LocalInstanceMeta;
+
+/*! Persistent index of local database meta data.
+ * \ingroup Database
+ *
+ * Keeps instance meta (guid, primary type and blob names)
+ * and group listings so opening a database doesn't need
+ * to parse every meta file nor enumerate every directory.
+ *
+ * The index file is memory mapped as is; records are sorted
+ * by path hash and decoded on first access. Each record is
+ * validated against the write time and size of the file, or
+ * directory, it was created from and is only trusted if the
+ * file was written before the second it was recorded, as
+ * file times only have a resolution of seconds.
+ *
+ * Records which hasn't been accessed during the session
+ * are dropped when the index is written back.
+ */
+class LocalIndex : public Object
+{
+	T_RTTI_CLASS;
+
+public:
+	/*! Open index, index is empty if file doesn't exist or is invalid. */
+	bool open(const Path& indexPath);
+
+	/*! Write back index if modified and release mapped file. */
+	void close();
+
+	/*! Read instance meta, through index if valid else from meta file. */
+	Ref< LocalInstanceMeta > readInstanceMeta(const Path& instancePath);
+
+	/*! Update instance meta after it's been written to meta file. */
+	void updateInstanceMeta(const Path& instancePath, const LocalInstanceMeta* instanceMeta);
+
+	/*! Discard instance meta, re-read from meta file on next access. */
+	void invalidateInstanceMeta(const Path& instancePath);
+
+	/*! Find files in group directory, through index if valid else from file system. */
+	RefArray< File > findGroupFiles(const Path& groupPath);
+
+private:
+	struct Stamp
+	{
+		uint64_t writeTime = 0;
+		uint64_t size = 0;
+		uint64_t recordedAt = 0;
+
+		bool valid(const File* file) const;
+	};
+
+	struct Instance
+	{
+		Stamp stamp;
+		Guid guid;
+		std::wstring primaryType;
+		AlignedVector< std::wstring > blobs;
+	};
+
+	struct Group
+	{
+		Stamp stamp;
+		AlignedVector< std::wstring > children;	//!< Child file names, directories have a trailing slash.
+	};
+
+	Path m_indexPath;
+	Ref< IMappedFile > m_mappedFile;
+	const uint8_t* m_base = nullptr;
+	std::map< std::wstring, Instance > m_instances;
+	std::map< std::wstring, Group > m_groups;
+	Semaphore m_lock;
+	bool m_modified = false;
+
+	const Instance* findInstance(const std::wstring& instancePath);
+
+	const Group* findGroup(const std::wstring& groupPath);
+
+	bool write() const;
+};
+
+}
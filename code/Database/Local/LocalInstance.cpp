@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2023 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -57,8 +57,7 @@ bool LocalInstance::internalCreateNew(const Guid& instanceGuid)
 
 std::wstring LocalInstance::getPrimaryTypeName() const
 {
-	const Path instanceMetaPath = getInstanceMetaPath(m_instancePath);
-	Ref< LocalInstanceMeta > instanceMeta = readPhysicalObject< LocalInstanceMeta >(instanceMetaPath);
+	Ref< LocalInstanceMeta > instanceMeta = readInstanceMeta(m_context, m_instancePath);
 	return instanceMeta ? instanceMeta->getPrimaryType() : L"";
 }
 
@@ -129,8 +128,7 @@ bool LocalInstance::setName(const std::wstring& name)
 
 Guid LocalInstance::getGuid() const
 {
-	const Path instanceMetaPath = getInstanceMetaPath(m_instancePath);
-	Ref< LocalInstanceMeta > instanceMeta = readPhysicalObject< LocalInstanceMeta >(instanceMetaPath);
+	Ref< LocalInstanceMeta > instanceMeta = readInstanceMeta(m_context, m_instancePath);
 	return instanceMeta ? instanceMeta->getGuid() : Guid();
 }
 
@@ -234,9 +232,7 @@ Ref< IStream > LocalInstance::writeObject(const std::wstring& primaryTypeName, c
 
 uint32_t LocalInstance::getDataNames(AlignedVector< std::wstring >& outDataNames) const
 {
-	const Path instanceMetaPath = getInstanceMetaPath(m_instancePath);
-
-	Ref< LocalInstanceMeta > instanceMeta = readPhysicalObject< LocalInstanceMeta >(instanceMetaPath);
+	Ref< LocalInstanceMeta > instanceMeta = readInstanceMeta(m_context, m_instancePath);
 	if (!instanceMeta)
 		return 0;
 
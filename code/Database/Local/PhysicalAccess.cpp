@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -11,6 +11,9 @@
 #include "Core/Io/IMappedFile.h"
 #include "Core/Io/MemoryStream.h"
 #include "Core/Serialization/BinarySerializer.h"
+#include "Database/Local/Context.h"
+#include "Database/Local/LocalIndex.h"
+#include "Database/Local/LocalInstanceMeta.h"
 #include "Database/Local/PhysicalAccess.h"
 #include "Xml/XmlSerializer.h"
 #include "Xml/XmlDeserializer.h"
@@ -98,4 +101,32 @@ bool writePhysicalObject(const Path& objectPath, const ISerializable* object, bo
 	return result;
 }
 
+Ref< LocalInstanceMeta > readInstanceMeta(const Context& context, const Path& instancePath)
+{
+	if (context.getIndex())
+		return context.getIndex()->readInstanceMeta(instancePath);
+	else
+		return readPhysicalObject< LocalInstanceMeta >(getInstanceMetaPath(instancePath));
+}
+
+bool writeInstanceMeta(const Context& context, const Path& instancePath, const LocalInstanceMeta* instanceMeta)
+{
+	if (!writePhysicalObject(getInstanceMetaPath(instancePath), instanceMeta, context.preferBinary()))
+	{
+		invalidateInstanceMeta(context, instancePath);
+		return false;
+	}
+
+	if (context.getIndex())
+		context.getIndex()->updateInstanceMeta(instancePath, instanceMeta);
+
+	return true;
+}
+
+void invalidateInstanceMeta(const Context& context, const Path& instancePath)
+{
+	if (context.getIndex())
+		context.getIndex()->invalidateInstanceMeta(instancePath);
+}
+
 }
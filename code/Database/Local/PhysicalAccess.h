@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -23,6 +23,9 @@ class ISerializable;
 namespace traktor::db
 {
 
+class Context;
+class LocalInstanceMeta;
+
 Path getInstanceObjectPath(const Path& instancePath);
 
 Path getInstanceMetaPath(const Path& instancePath);
@@ -33,6 +36,15 @@ Ref< ISerializable > readPhysicalObject(const Path& objectPath);
 
 bool writePhysicalObject(const Path& objectPath, const ISerializable* object, bool binary);
 
+/*! Read instance meta, through context's index if available. */
+Ref< LocalInstanceMeta > readInstanceMeta(const Context& context, const Path& instancePath);
+
+/*! Write instance meta and update context's index. */
+bool writeInstanceMeta(const Context& context, const Path& instancePath, const LocalInstanceMeta* instanceMeta);
+
+/*! Discard indexed instance meta, ex. after meta file has been rolled back. */
+void invalidateInstanceMeta(const Context& context, const Path& instancePath);
+
 template < typename ObjectType >
 Ref< ObjectType > readPhysicalObject(const Path& objectPath)
 {
@@ -0,0 +1,279 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "Database/Local/Test/CaseLocalIndex.h"
+
+#include "Core/Containers/AlignedVector.h"
+#include "Core/Io/File.h"
+#include "Core/Io/FileSystem.h"
+#include "Core/Io/IStream.h"
+#include "Core/Io/StringOutputStream.h"
+#include "Core/Misc/String.h"
+#include "Core/System/OS.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/ThreadManager.h"
+#include "Core/Timer/Timer.h"
+#include "Database/Local/LocalIndex.h"
+#include "Database/Local/LocalInstanceMeta.h"
+#include "Database/Local/PhysicalAccess.h"
+
+namespace traktor::db::test
+{
+namespace
+{
+
+const int32_t c_instanceCount = 1000;
+
+Path instancePath(const std::wstring& groupPath, int32_t index)
+{
+	return groupPath + L"/Instance" + toString(index);
+}
+
+bool writeMeta(const Path& instancePath, const Guid& guid, const std::wstring& primaryType)
+{
+	Ref< LocalInstanceMeta > instanceMeta = new LocalInstanceMeta(guid, primaryType);
+	instanceMeta->setBlob(L"Object");
+	return writePhysicalObject(getInstanceMetaPath(instancePath), instanceMeta, false);
+}
+
+bool readFile(const Path& path, AlignedVector< uint8_t >& outData)
+{
+	Ref< IStream > stream = FileSystem::getInstance().open(path, File::FmRead);
+	if (!stream)
+		return false;
+
+	outData.resize(size_t(stream->available()));
+	const bool result = outData.empty() || stream->read(outData.ptr(), int64_t(outData.size())) == int64_t(outData.size());
+	stream->close();
+	return result;
+}
+
+bool writeFile(const Path& path, const uint8_t* data, size_t size)
+{
+	Ref< IStream > stream = FileSystem::getInstance().open(path, File::FmWrite);
+	if (!stream)
+		return false;
+
+	const bool result = size == 0 || stream->write(data, int64_t(size)) == int64_t(size);
+	stream->close();
+	return result;
+}
+
+/*! Count files in group, directory listing from file system include "." and "..". */
+size_t countGroupFiles(LocalIndex* index, const std::wstring& groupPath)
+{
+	size_t count = 0;
+	for (auto file : index->findGroupFiles(groupPath))
+	{
+		const std::wstring fileName = file->getPath().getFileName();
+		if (fileName != L"." && fileName != L"..")
+			++count;
+	}
+	return count;
+}
+
+/*! Read meta of all instances through index, true if all match what was written. */
+bool readAll(LocalIndex* index, const std::wstring& groupPath, const AlignedVector< Guid >& guids)
+{
+	bool match = true;
+	for (int32_t i = 0; i < (int32_t)guids.size(); ++i)
+	{
+		Ref< LocalInstanceMeta > instanceMeta = index->readInstanceMeta(instancePath(groupPath, i));
+		match &= (
+			instanceMeta != nullptr &&
+			instanceMeta->getGuid() == guids[i] &&
+			instanceMeta->getPrimaryType() == L"traktor.test.Object" &&
+			instanceMeta->haveBlob(L"Object")
+		);
+	}
+	return match;
+}
+
+/*! Remove directory and all files within. */
+void removeAll(const Path& directory)
+{
+	for (auto file : FileSystem::getInstance().find(directory.getPathName() + L"/*.*"))
+	{
+		const std::wstring fileName = file->getPath().getFileName();
+		if (fileName == L"." || fileName == L"..")
+			continue;
+		if (file->isDirectory())
+			removeAll(file->getPath());
+		else
+			FileSystem::getInstance().remove(file->getPath());
+	}
+	FileSystem::getInstance().removeDirectory(directory);
+}
+
+/*! File times have a resolution of seconds, records are only trusted for files written before the second they were recorded. */
+void waitNextSecond()
+{
+	ThreadManager::getInstance().getCurrentThread()->sleep(1100);
+}
+
+}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.db.test.CaseLocalIndex", 0, CaseLocalIndex, traktor::test::Case)
+
+void CaseLocalIndex::run()
+{
+	const std::wstring rootPath = OS::getInstance().getWritableFolderPath() + L"/Database/CaseLocalIndex";
+	const std::wstring groupPath = rootPath + L"/Group";
+	const Path indexPath = rootPath + L"/Index.bin";
+
+	removeAll(rootPath);
+	CASE_ASSERT(FileSystem::getInstance().makeAllDirectories(groupPath));
+
+	AlignedVector< Guid > guids;
+	bool allWritten = true;
+	for (int32_t i = 0; i < c_instanceCount; ++i)
+	{
+		guids.push_back(Guid::create());
+		allWritten &= writeMeta(instancePath(groupPath, i), guids.back(), L"traktor.test.Object");
+	}
+	CASE_ASSERT(allWritten);
+	if (!allWritten)
+		return;
+
+	waitNextSecond();
+
+	Timer timer;
+
+	// Build index from meta files.
+	double coldTime = 0.0;
+	{
+		const double start = timer.getElapsedTime();
+
+		Ref< LocalIndex > index = new LocalIndex();
+		CASE_ASSERT(index->open(indexPath));
+		CASE_ASSERT(readAll(index, groupPath, guids));
+		CASE_ASSERT_EQUAL(countGroupFiles(index, groupPath), size_t(c_instanceCount));
+		index->close();
+
+		coldTime = timer.getElapsedTime() - start;
+		CASE_ASSERT(FileSystem::getInstance().exist(indexPath));
+	}
+
+	// Warm open read meta from index, nothing modified thus index isn't written back.
+	double warmTime = 0.0;
+	{
+		AlignedVector< uint8_t > before;
+		CASE_ASSERT(readFile(indexPath, before));
+
+		const double start = timer.getElapsedTime();
+
+		Ref< LocalIndex > index = new LocalIndex();
+		CASE_ASSERT(index->open(indexPath));
+		CASE_ASSERT(readAll(index, groupPath, guids));
+		CASE_ASSERT_EQUAL(countGroupFiles(index, groupPath), size_t(c_instanceCount));
+		index->close();
+
+		warmTime = timer.getElapsedTime() - start;
+
+		AlignedVector< uint8_t > after;
+		CASE_ASSERT(readFile(indexPath, after));
+		CASE_ASSERT(before == after);
+	}
+
+	// Record is invalidated when meta file is written, or renamed.
+	{
+		Ref< LocalIndex > index = new LocalIndex();
+		CASE_ASSERT(index->open(indexPath));
+
+		// Rewritten meta file; different primary type so size also differ.
+		guids[0] = Guid::create();
+		CASE_ASSERT(writeMeta(instancePath(groupPath, 0), guids[0], L"traktor.test.OtherObject"));
+		Ref< LocalInstanceMeta > instanceMeta = index->readInstanceMeta(instancePath(groupPath, 0));
+		CASE_ASSERT(instanceMeta != nullptr);
+		if (instanceMeta)
+		{
+			CASE_ASSERT(instanceMeta->getGuid() == guids[0]);
+			CASE_ASSERT(instanceMeta->getPrimaryType() == L"traktor.test.OtherObject");
+		}
+
+		// Renamed meta file.
+		const Path renamedPath = groupPath + L"/Renamed";
+		CASE_ASSERT(FileSystem::getInstance().move(getInstanceMetaPath(renamedPath), getInstanceMetaPath(instancePath(groupPath, 1)), false));
+		CASE_ASSERT(index->readInstanceMeta(instancePath(groupPath, 1)) == nullptr);
+		instanceMeta = index->readInstanceMeta(renamedPath);
+		CASE_ASSERT(instanceMeta != nullptr);
+		if (instanceMeta)
+			CASE_ASSERT(instanceMeta->getGuid() == guids[1]);
+
+		// Group listing must reflect rename.
+		bool renamedFound = false, originalFound = false;
+		for (auto file : index->findGroupFiles(groupPath))
+		{
+			renamedFound |= (file->getPath().getFileName() == getInstanceMetaPath(renamedPath).getFileName());
+			originalFound |= (file->getPath().getFileName() == getInstanceMetaPath(instancePath(groupPath, 1)).getFileName());
+		}
+		CASE_ASSERT(renamedFound);
+		CASE_ASSERT(!originalFound);
+
+		index->close();
+
+		// Changes are persistent.
+		CASE_ASSERT(index->open(indexPath));
+		instanceMeta = index->readInstanceMeta(instancePath(groupPath, 0));
+		CASE_ASSERT(instanceMeta != nullptr && instanceMeta->getGuid() == guids[0]);
+		CASE_ASSERT(index->readInstanceMeta(instancePath(groupPath, 1)) == nullptr);
+		index->close();
+
+		// Restore renamed instance.
+		CASE_ASSERT(FileSystem::getInstance().move(getInstanceMetaPath(instancePath(groupPath, 1)), getInstanceMetaPath(renamedPath), false));
+		CASE_ASSERT(writeMeta(instancePath(groupPath, 0), guids[0], L"traktor.test.Object"));
+	}
+
+	// Corrupt or truncated index is rejected, meta is read from files and index is rebuilt.
+	{
+		AlignedVector< uint8_t > data;
+		CASE_ASSERT(readFile(indexPath, data));
+		CASE_ASSERT(data.size() > 64);
+		if (data.size() <= 64)
+			return;
+
+		AlignedVector< AlignedVector< uint8_t > > invalids;
+
+		// Truncated.
+		invalids.push_back(AlignedVector< uint8_t >(data.begin(), data.begin() + data.size() / 2));
+		invalids.push_back(AlignedVector< uint8_t >(data.begin(), data.begin() + 8));
+
+		// Unknown magic.
+		invalids.push_back(data);
+		invalids.back()[0] ^= 0xff;
+
+		// Unterminated strings.
+		invalids.push_back(data);
+		invalids.back().back() = 'x';
+
+		// Header count doesn't match size.
+		invalids.push_back(data);
+		invalids.back()[8] += 1;
+
+		for (const auto& invalid : invalids)
+		{
+			CASE_ASSERT(writeFile(indexPath, invalid.c_ptr(), invalid.size()));
+
+			Ref< LocalIndex > index = new LocalIndex();
+			CASE_ASSERT(!index->open(indexPath));
+			CASE_ASSERT(readAll(index, groupPath, guids));
+			index->close();
+
+			CASE_ASSERT(index->open(indexPath));
+			index->close();
+		}
+	}
+
+	StringOutputStream ss;
+	ss << L"Index " << c_instanceCount << L" instances; cold open " << int32_t(coldTime * 1000000.0) << L" us, warm open " << int32_t(warmTime * 1000000.0) << L" us";
+	succeeded(ss.str());
+
+	removeAll(rootPath);
+}
+
+}
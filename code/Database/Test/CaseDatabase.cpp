@@ -0,0 +1,266 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "Database/Test/CaseDatabase.h"
+
+#include "Core/Io/StringOutputStream.h"
+#include "Core/Math/Random.h"
+#include "Core/Misc/String.h"
+#include "Core/RefArray.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/ThreadManager.h"
+#include "Core/Timer/Timer.h"
+#include "Database/Database.h"
+#include "Database/Instance.h"
+#include "Database/Provider/IProviderDatabase.h"
+#include "Database/Provider/IProviderGroup.h"
+#include "Database/Provider/IProviderInstance.h"
+
+#include <atomic>
+
+namespace traktor::db::test
+{
+	namespace
+	{
+
+const int32_t c_groupCount = 16;
+const int32_t c_instanceCount = 256;
+const int32_t c_lookupCount = 100000;
+const int32_t c_threadCounts[] = { 1, 2, 4, 8 };
+
+//! Memory provider instance, only keep name and guid.
+class MemoryProviderInstance : public IProviderInstance
+{
+public:
+	explicit MemoryProviderInstance(const std::wstring& name, const Guid& guid)
+	:	m_name(name)
+	,	m_guid(guid)
+	{
+	}
+
+	virtual std::wstring getPrimaryTypeName() const override final { return L""; }
+
+	virtual bool openTransaction() override final { return true; }
+
+	virtual bool commitTransaction() override final { return true; }
+
+	virtual bool closeTransaction() override final { return true; }
+
+	virtual std::wstring getName() const override final { return m_name; }
+
+	virtual bool setName(const std::wstring& name) override final { m_name = name; return true; }
+
+	virtual Guid getGuid() const override final { return m_guid; }
+
+	virtual bool setGuid(const Guid& guid) override final { m_guid = guid; return true; }
+
+	virtual bool getLastModifyDate(DateTime& outModifyDate) const override final { return false; }
+
+	virtual uint32_t getFlags() const override final { return 0; }
+
+	virtual bool remove() override final { return false; }
+
+	virtual Ref< IStream > readObject(const TypeInfo*& outSerializerType) const override final { return nullptr; }
+
+	virtual Ref< IStream > writeObject(const std::wstring& primaryTypeName, const TypeInfo*& outSerializerType) override final { return nullptr; }
+
+	virtual uint32_t getDataNames(AlignedVector< std::wstring >& outDataNames) const override final { return 0; }
+
+	virtual bool getDataLastWriteTime(const std::wstring& dataName, DateTime& outLastWriteTime) const override final { return false; }
+
+	virtual bool removeAllData() override final { return false; }
+
+	virtual Ref< IStream > readData(const std::wstring& dataName) const override final { return nullptr; }
+
+	virtual Ref< IStream > writeData(const std::wstring& dataName) override final { return nullptr; }
+
+private:
+	std::wstring m_name;
+	Guid m_guid;
+};
+
+//! Memory provider group.
+class MemoryProviderGroup : public IProviderGroup
+{
+public:
+	RefArray< IProviderGroup > groups;
+	RefArray< IProviderInstance > instances;
+
+	explicit MemoryProviderGroup(const std::wstring& name)
+	:	m_name(name)
+	{
+	}
+
+	virtual std::wstring getName() const override final { return m_name; }
+
+	virtual uint32_t getFlags() const override final { return 0; }
+
+	virtual bool rename(const std::wstring& name) override final { return false; }
+
+	virtual bool remove() override final { return false; }
+
+	virtual Ref< IProviderGroup > createGroup(const std::wstring& groupName) override final { return nullptr; }
+
+	virtual Ref< IProviderInstance > createInstance(const std::wstring& instanceName, const Guid& instanceGuid) override final { return nullptr; }
+
+	virtual bool getChildren(RefArray< IProviderGroup >& outChildGroups, RefArray< IProviderInstance >& outChildInstances) override final
+	{
+		outChildGroups = groups;
+		outChildInstances = instances;
+		return true;
+	}
+
+private:
+	std::wstring m_name;
+};
+
+//! Memory provider database, without bus.
+class MemoryProviderDatabase : public IProviderDatabase
+{
+public:
+	Ref< MemoryProviderGroup > rootGroup = new MemoryProviderGroup(L"");
+
+	virtual bool create(const ConnectionString& connectionString) override final { return true; }
+
+	virtual bool open(const ConnectionString& connectionString) override final { return true; }
+
+	virtual void close() override final {}
+
+	virtual IProviderBus* getBus() override final { return nullptr; }
+
+	virtual IProviderGroup* getRootGroup() override final { return rootGroup; }
+};
+
+std::wstring instancePath(int32_t group, int32_t instance)
+{
+	return L"Group" + toString(group) + L"/Instance" + toString(instance);
+}
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.db.test.CaseDatabase", 0, CaseDatabase, traktor::test::Case)
+
+void CaseDatabase::run()
+{
+	Ref< MemoryProviderDatabase > providerDatabase = new MemoryProviderDatabase();
+	AlignedVector< Guid > guids;
+
+	for (int32_t i = 0; i < c_groupCount; ++i)
+	{
+		Ref< MemoryProviderGroup > group = new MemoryProviderGroup(L"Group" + toString(i));
+		for (int32_t j = 0; j < c_instanceCount; ++j)
+		{
+			const Guid guid = Guid::create();
+			group->instances.push_back(new MemoryProviderInstance(L"Instance" + toString(j), guid));
+			guids.push_back(guid);
+		}
+		providerDatabase->rootGroup->groups.push_back(group);
+	}
+
+	Ref< Database > database = new Database();
+	CASE_ASSERT(database->open(providerDatabase));
+
+	// Instances are found both by guid and path.
+	{
+		bool allFound = true;
+		for (int32_t i = 0; i < c_groupCount; ++i)
+		{
+			for (int32_t j = 0; j < c_instanceCount; ++j)
+			{
+				const Guid& guid = guids[i * c_instanceCount + j];
+				Ref< Instance > instance = database->getInstance(guid);
+				allFound &= (instance != nullptr && instance->getGuid() == guid);
+				allFound &= (database->getInstance(instancePath(i, j)) == instance);
+			}
+		}
+		CASE_ASSERT(allFound);
+	}
+
+	// Guid of an instance is changed back and forth while other threads
+	// are looking up instances; readers must never see a partial guid.
+	Ref< Instance > changingInstance = database->getInstance(guids[0]);
+	CASE_ASSERT(changingInstance != nullptr);
+	if (!changingInstance)
+		return;
+
+	const Guid guidA = guids[0];
+	const Guid guidB = Guid::create();
+	std::atomic< int32_t > changeCount(0);
+
+	Thread* changeThread = ThreadManager::getInstance().create([&]() {
+		Thread* current = ThreadManager::getInstance().getCurrentThread();
+		while (!current->stopped())
+		{
+			if (!changingInstance->checkout())
+				break;
+			changingInstance->setGuid((changeCount & 1) ? guidA : guidB);
+			changingInstance->commit();
+			++changeCount;
+		}
+	}, L"Database change");
+	changeThread->start();
+
+	StringOutputStream ss;
+	ss << L"Lookup " << c_lookupCount << L" instances per thread;";
+
+	bool guidsValid = true;
+	bool instancesFound = true;
+
+	for (auto threadCount : c_threadCounts)
+	{
+		std::atomic< bool > threadGuidsValid(true);
+		std::atomic< bool > threadInstancesFound(true);
+		Thread* threads[8] = { nullptr };
+
+		Timer timer;
+		for (int32_t i = 0; i < threadCount; ++i)
+		{
+			threads[i] = ThreadManager::getInstance().create([&, i]() {
+				Random random(i);
+				for (int32_t j = 0; j < c_lookupCount; ++j)
+				{
+					const uint32_t index = 1 + random.next() % (uint32_t)(guids.size() - 1);
+					Ref< Instance > instance = ((j & 7) != 0) ?
+						database->getInstance(guids[index]) :
+						database->getInstance(instancePath(index / c_instanceCount, index % c_instanceCount));
+					if (!instance)
+						threadInstancesFound = false;
+
+					const Guid guid = changingInstance->getGuid();
+					if (guid != guidA && guid != guidB)
+						threadGuidsValid = false;
+				}
+			}, L"Database lookup");
+			threads[i]->start();
+		}
+		for (int32_t i = 0; i < threadCount; ++i)
+		{
+			threads[i]->wait();
+			ThreadManager::getInstance().destroy(threads[i]);
+		}
+		const double duration = timer.getElapsedTime();
+
+		guidsValid &= threadGuidsValid;
+		instancesFound &= threadInstancesFound;
+
+		ss << ((threadCount != c_threadCounts[0]) ? L", " : L" ") << threadCount << L" thread(s) " << int32_t(duration * 1000.0) << L" ms";
+	}
+
+	changeThread->stop();
+	ThreadManager::getInstance().destroy(changeThread);
+
+	CASE_ASSERT(guidsValid);
+	CASE_ASSERT(instancesFound);
+	CASE_ASSERT(changeCount > 0);
+
+	succeeded(ss.str());
+
+	database->close();
+}
+
+}
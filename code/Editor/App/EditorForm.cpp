@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -1799,7 +1799,14 @@ void EditorForm::buildAssetsThread(AlignedVector< Guid > assetGuids, bool rebuil
 			log::info << L"Collected " << dependencySet.size() << L" dependencies from " << assetGuids.size() << L" root(s) in " << formatDuration(elapsedDependencies) << L"." << Endl;
 		}
 
-		// Build output.
+		// Build output; zero build thread count means one thread per core.
+		uint32_t buildThreadCount = 1;
+		if (m_mergedSettings->getProperty< bool >(L"Pipeline.BuildThreads", true))
+		{
+			const int32_t threadCount = m_mergedSettings->getProperty< int32_t >(L"Pipeline.BuildThreads.Count", 0);
+			buildThreadCount = threadCount > 0 ? (uint32_t)threadCount : OS::getInstance().getCPUCoreCount();
+		}
+
 		Ref< IPipelineBuilder > pipelineBuilder = new PipelineBuilder(
 			&pipelineFactory,
 			m_sourceDatabase,
@@ -1808,7 +1815,8 @@ void EditorForm::buildAssetsThread(AlignedVector< Guid > assetGuids, bool rebuil
 			m_pipelineDb,
 			&instanceCache,
 			this,
-			verbose);
+			verbose,
+			buildThreadCount);
 
 		if (rebuild)
 			log::info << L"Rebuilding " << dependencySet.size() << L" asset(s)..." << Endl;
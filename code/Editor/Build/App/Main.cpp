@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -128,6 +128,7 @@ int main(int argc, const char** argv)
 		log::info << L"    -file-cache=path               Specify pipeline file cache directory." << Endl;
 		log::info << L"    -file-cache-access=r|w|rw      File cache access." << Endl;
 		log::info << L"    -sequential-depends            Disable multithreaded pipeline dependency scanner." << Endl;
+		log::info << L"    -sequential-build              Disable multithreaded pipeline builder." << Endl;
 		return 1;
 	}
 
@@ -256,6 +257,9 @@ int main(int argc, const char** argv)
 	if (cmdLine.hasOption(L"sequential-depends"))
 		settings->setProperty< PropertyBoolean >(L"Pipeline.DependsThreads", false);
 
+	if (cmdLine.hasOption(L"sequential-build"))
+		settings->setProperty< PropertyBoolean >(L"Pipeline.BuildThreads", false);
+
 	// Remove filestore option from source database.
 	db::ConnectionString sourceDatabaseCS = settings->getProperty< std::wstring >(L"Editor.SourceDatabase");
 	sourceDatabaseCS.set(L"fileStore", L"");
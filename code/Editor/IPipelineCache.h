@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -10,6 +10,7 @@
 
 #include "Core/Guid.h"
 #include "Core/Object.h"
+#include "Core/Containers/AlignedVector.h"
 #include "Core/Ref.h"
 #include "Core/Misc/Key.h"
 #include "Editor/PipelineTypes.h"
@@ -59,6 +60,10 @@ public:
 	 */
 	virtual bool commit(const Guid& guid, const PipelineDependencyHash& hash) = 0;
 
+	/*! Hint that entries are about to be read, cache might fetch them in a single request.
+	 */
+	virtual void prefetch(const AlignedVector< std::pair< Guid, PipelineDependencyHash > >& entries) = 0;
+
 	/*!
 	 */
 	virtual Ref< IStream > get(const Key& key) = 0;
@@ -1,28 +1,47 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
+#include "Avalanche/Protocol.h"
 #include "Avalanche/Client/Client.h"
 #include "Compress/Lzf/DeflateStreamLzf.h"
 #include "Compress/Lzf/InflateStreamLzf.h"
 #include "Core/Io/BufferedStream.h"
+#include "Core/Io/MemoryStream.h"
 #include "Core/Io/OutputStream.h"
+#include "Core/Log/Log.h"
 #include "Core/Misc/SafeDestroy.h"
 #include "Core/Misc/String.h"
 #include "Core/Settings/PropertyBoolean.h"
 #include "Core/Settings/PropertyGroup.h"
 #include "Core/Settings/PropertyInteger.h"
 #include "Core/Settings/PropertyString.h"
+#include "Core/Thread/Acquire.h"
 #include "Core/Thread/JobManager.h"
 #include "Editor/Pipeline/Avalanche/AvalanchePipelineCache.h"
 #include "Net/Network.h"
 
 namespace traktor::editor
 {
+	namespace
+	{
+
+const int64_t c_maxPrefetchBlobSize = 1024 * 1024;
+const int64_t c_maxPrefetchSize = 16 * 1024 * 1024;
+
+Key makeKey(const Guid& guid, const PipelineDependencyHash& hash)
+{
+	// Combine guid and hash to generate 128-bit storage key.
+	const Guid gk = guid.permutation(Guid((const uint8_t*)&hash));
+	const uint32_t* kv = (const uint32_t*)(const uint8_t*)gk;
+	return Key(kv[0], kv[1], kv[2], kv[3]);
+}
+
+	}
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.editor.AvalanchePipelineCache", AvalanchePipelineCache, IPipelineCache)
 
@@ -44,6 +63,12 @@ bool AvalanchePipelineCache::create(const PropertyGroup* settings)
 		return false;
 	}
 
+	// Older servers doesn't support batch requests; fall back to one request per key.
+	int32_t majorVersion = 0, minorVersion = 0;
+	m_batch = m_client->version(majorVersion, minorVersion) && minorVersion >= avalanche::c_minorVersionBatch;
+	if (!m_batch)
+		log::info << L"Avalanche server doesn't support batch requests; prefetching disabled." << Endl;
+
 	return true;
 }
 
@@ -60,6 +85,7 @@ void AvalanchePipelineCache::destroy()
 		m_statsJob->wait();
 		m_statsJob = nullptr;
 	}
+	m_prefetched.clear();
 	safeDestroy(m_client);
 }
 
@@ -68,12 +94,7 @@ Ref< IStream > AvalanchePipelineCache::get(const Guid& guid, const PipelineDepen
 	if (!m_accessRead)
 		return nullptr;
 
-	// Combine guid and hash to generate 128-bit storage key.
-	const Guid gk = guid.permutation(Guid((const uint8_t*)&hash));
-	const uint32_t* kv = (const uint32_t*)(const uint8_t*)gk;
-	const Key key(kv[0], kv[1], kv[2], kv[3]);
-
-	Ref< IStream > stream = m_client->get(key);
+	Ref< IStream > stream = read(makeKey(guid, hash));
 	if (!stream)
 	{
 		m_misses++;
@@ -89,12 +110,7 @@ Ref< IStream > AvalanchePipelineCache::put(const Guid& guid, const PipelineDepen
 	if (!m_accessWrite)
 		return nullptr;
 
-	// Combine guid and hash to generate 128-bit storage key.
-	const Guid gk = guid.permutation(Guid((const uint8_t*)&hash));
-	const uint32_t* kv = (const uint32_t*)(const uint8_t*)gk;
-	const Key key(kv[0], kv[1], kv[2], kv[3]);
-
-	Ref< IStream > stream = m_client->put(key);
+	Ref< IStream > stream = m_client->put(makeKey(guid, hash));
 	if (!stream)
 		return nullptr;
 
@@ -106,7 +122,7 @@ Ref< IStream > AvalanchePipelineCache::get(const Key& key)
 	if (!m_accessRead)
 		return nullptr;
 
-	Ref< IStream > stream = m_client->get(key);
+	Ref< IStream > stream = read(key);
 	if (!stream)
 		return nullptr;
 
@@ -148,7 +164,7 @@ void AvalanchePipelineCache::getInformation(OutputStream& os)
 		os << L"disabled";
 	os << L", " << m_stats.blobCount << L" blobs, " << formatByteSize(m_stats.memoryUsage);
 	if (m_accessRead)
-		os << L", " << m_hits << L" hits, " << m_misses << L" misses";
+		os << L", " << (uint32_t)m_hits << L" hits, " << (uint32_t)m_misses << L" misses";
 	os << L")";
 }
 
@@ -157,4 +173,71 @@ bool AvalanchePipelineCache::commit(const Guid& guid, const PipelineDependencyHa
 	return true;
 }
 
+void AvalanchePipelineCache::prefetch(const AlignedVector< std::pair< Guid, PipelineDependencyHash > >& entries)
+{
+	if (!m_accessRead || !m_batch || entries.size() <= 1)
+		return;
+
+	AlignedVector< Key > keys;
+	keys.reserve(entries.size());
+	for (const auto& entry : entries)
+		keys.push_back(makeKey(entry.first, entry.second));
+
+	// Query sizes first so only small blobs are fetched into memory,
+	// larger blobs are streamed from server when read.
+	AlignedVector< int64_t > sizes;
+	if (!m_client->have(keys, sizes))
+		return;
+
+	AlignedVector< Key > fetchKeys;
+	int64_t fetchSize = 0;
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		if (sizes[i] < 0)
+		{
+			// Remember missing blob so it's not queried again when read.
+			T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_prefetchedLock);
+			m_prefetched[keys[i]] = nullptr;
+		}
+		else if (sizes[i] <= c_maxPrefetchBlobSize && fetchSize + sizes[i] <= c_maxPrefetchSize)
+		{
+			fetchKeys.push_back(keys[i]);
+			fetchSize += sizes[i];
+		}
+	}
+	if (fetchKeys.empty())
+		return;
+
+	m_client->get(fetchKeys, [&](size_t index, IStream* stream) {
+		Ref< IStream > blob;
+		if (stream)
+		{
+			const int64_t size = stream->available();
+			uint8_t* data = new uint8_t [size];
+			if (stream->read(data, size) == size)
+				blob = new MemoryStream(data, size, true, false, true);
+			else
+				delete[] data;
+		}
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_prefetchedLock);
+		m_prefetched[fetchKeys[index]] = blob;
+	});
+}
+
+Ref< IStream > AvalanchePipelineCache::read(const Key& key)
+{
+	// Prefetched blobs are only read once.
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_prefetchedLock);
+		auto it = m_prefetched.find(key);
+		if (it != m_prefetched.end())
+		{
+			Ref< IStream > stream = it->second;
+			m_prefetched.erase(it);
+			return stream;
+		}
+	}
+	return m_client->get(key);
+}
+
 }
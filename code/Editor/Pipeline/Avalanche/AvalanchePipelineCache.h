@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,7 +8,10 @@
  */
 #pragma once
 
+#include <atomic>
 #include "Avalanche/Dictionary.h"
+#include "Core/Containers/SmallMap.h"
+#include "Core/Thread/Semaphore.h"
 #include "Editor/IPipelineCache.h"
 
 // import/export mechanism.
@@ -53,6 +56,8 @@ public:
 
 	virtual bool commit(const Guid& guid, const PipelineDependencyHash& hash) override final;
 
+	virtual void prefetch(const AlignedVector< std::pair< Guid, PipelineDependencyHash > >& entries) override final;
+
 	virtual Ref< IStream > get(const Key& key) override final;
 
 	virtual Ref< IStream > put(const Key& key) override final;
@@ -63,10 +68,15 @@ private:
 	Ref< avalanche::Client > m_client;
 	bool m_accessRead = true;
 	bool m_accessWrite = true;
-	uint32_t m_hits = 0;
-	uint32_t m_misses = 0;
+	bool m_batch = false;
+	SmallMap< Key, Ref< IStream > > m_prefetched;
+	Semaphore m_prefetchedLock;
+	std::atomic< uint32_t > m_hits = 0;
+	std::atomic< uint32_t > m_misses = 0;
 	Ref< Job > m_statsJob;
 	avalanche::Dictionary::Stats m_stats;
+
+	Ref< IStream > read(const Key& key);
 };
 
 }
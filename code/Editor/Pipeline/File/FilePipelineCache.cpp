@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -146,7 +146,7 @@ void FilePipelineCache::getInformation(OutputStream& os)
 	else
 		os << L"disabled";
 	if (m_accessRead)
-		os << L", " << m_hits << L" hits, " << m_misses << L" misses";
+		os << L", " << (uint32_t)m_hits << L" hits, " << (uint32_t)m_misses << L" misses";
 	os << L")";
 }
 
@@ -155,4 +155,8 @@ bool FilePipelineCache::commit(const Guid& guid, const PipelineDependencyHash& h
 	return true;
 }
 
+void FilePipelineCache::prefetch(const AlignedVector< std::pair< Guid, PipelineDependencyHash > >& entries)
+{
+}
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include "Editor/IPipelineCache.h"
 
 // import/export mechanism.
@@ -36,6 +37,8 @@ public:
 
 	virtual bool commit(const Guid& guid, const PipelineDependencyHash& hash) override final;
 
+	virtual void prefetch(const AlignedVector< std::pair< Guid, PipelineDependencyHash > >& entries) override final;
+
 	virtual Ref< IStream > get(const Key& key) override final;
 
 	virtual Ref< IStream > put(const Key& key) override final;
@@ -46,8 +49,8 @@ private:
 	bool m_accessRead = true;
 	bool m_accessWrite = true;
 	std::wstring m_path;
-	uint32_t m_hits = 0;
-	uint32_t m_misses = 0;
+	std::atomic< uint32_t > m_hits = 0;
+	std::atomic< uint32_t > m_misses = 0;
 };
 
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -64,6 +64,10 @@ bool MemoryPipelineCache::commit(const Guid& guid, const PipelineDependencyHash&
 	return true;
 }
 
+void MemoryPipelineCache::prefetch(const AlignedVector< std::pair< Guid, PipelineDependencyHash > >& entries)
+{
+}
+
 Ref< IStream > MemoryPipelineCache::get(const Key& key)
 {
 	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
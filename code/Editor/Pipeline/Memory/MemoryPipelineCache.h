@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -39,6 +39,8 @@ public:
 
 	virtual bool commit(const Guid& guid, const PipelineDependencyHash& hash) override final;
 
+	virtual void prefetch(const AlignedVector< std::pair< Guid, PipelineDependencyHash > >& entries) override final;
+
 	virtual Ref< IStream > get(const Key& key) override final;
 
 	virtual Ref< IStream > put(const Key& key) override final;
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -16,6 +16,9 @@
 #include "Core/Settings/PropertyGroup.h"
 #include "Core/Settings/PropertyInteger.h"
 #include "Core/System/OS.h"
+#include "Core/Thread/Acquire.h"
+#include "Core/Thread/JobGraph.h"
+#include "Core/Thread/JobQueue.h"
 #include "Core/Thread/Thread.h"
 #include "Core/Thread/ThreadManager.h"
 #include "Core/Timer/Timer.h"
@@ -70,6 +73,34 @@ private:
 	uint32_t m_count;
 };
 
+/*! Keep log output of a build together, written to final target when build has finished. */
+class LogTargetBuffer : public ILogTarget
+{
+public:
+	struct Entry
+	{
+		ILogTarget* target;
+		uint32_t threadId;
+		int32_t level;
+		std::wstring str;
+	};
+
+	explicit LogTargetBuffer(AlignedVector< Entry >& entries, ILogTarget* target)
+	:	m_entries(entries)
+	,	m_target(target)
+	{
+	}
+
+	virtual void log(uint32_t threadId, int32_t level, const wchar_t* str) override final
+	{
+		m_entries.push_back({ m_target, threadId, level, str });
+	}
+
+private:
+	AlignedVector< Entry >& m_entries;
+	ILogTarget* m_target;
+};
+
 void calculateGlobalHash(
 	const PipelineDependencySet* dependencySet,
 	const PipelineDependency* dependency,
@@ -104,6 +135,134 @@ void calculateGlobalHash(
 	}
 }
 
+/*! Flag dependencies which use, directly or indirectly, a modified dependency.
+ *
+ * Strongly connected components of the "use" graph are found in a single
+ * pass (Tarjan) and as components are completed in reverse topological order
+ * it's known, for each component, if any dependency reachable outside of the
+ * component is modified. Thus a dependency is flagged if a dependency reachable
+ * outside of it's component, or another dependency within it's component, is modified.
+ */
+void propagateDependencyModified(const PipelineDependencySet* dependencySet, AlignedVector< uint32_t >& reasons)
+{
+	const uint32_t dependencyCount = dependencySet->size();
+	const uint32_t c_unvisited = ~0U;
+
+	struct Frame
+	{
+		uint32_t index;
+		uint32_t child;
+	};
+
+	AlignedVector< uint32_t > order;
+	AlignedVector< uint32_t > lowLink;
+	AlignedVector< uint32_t > component;
+	AlignedVector< uint8_t > onStack(dependencyCount, 0);
+	order.resize(dependencyCount, c_unvisited);
+	lowLink.resize(dependencyCount, 0);
+	component.resize(dependencyCount, c_unvisited);
+
+	AlignedVector< uint32_t > componentModifiedCount;	//!< Number of modified dependencies in component.
+	AlignedVector< uint8_t > componentReachModified;	//!< Any modified dependency reachable outside of component.
+
+	AlignedVector< Frame > callStack;
+	AlignedVector< uint32_t > stack;
+	AlignedVector< uint32_t > members;
+	uint32_t next = 0;
+
+	auto isUsed = [&](uint32_t index) {
+		return (dependencySet->get(index)->flags & PdfUse) != 0;
+	};
+
+	for (uint32_t root = 0; root < dependencyCount; ++root)
+	{
+		if (order[root] != c_unvisited)
+			continue;
+
+		callStack.push_back({ root, 0 });
+		order[root] = lowLink[root] = next++;
+		stack.push_back(root);
+		onStack[root] = 1;
+
+		while (!callStack.empty())
+		{
+			Frame& frame = callStack.back();
+			const auto& children = dependencySet->get(frame.index)->children;
+
+			if (frame.child < children.size())
+			{
+				const uint32_t child = children[frame.child++];
+				if (!isUsed(child))
+					continue;
+
+				if (order[child] == c_unvisited)
+				{
+					order[child] = lowLink[child] = next++;
+					stack.push_back(child);
+					onStack[child] = 1;
+					callStack.push_back({ child, 0 });
+				}
+				else if (onStack[child])
+					lowLink[frame.index] = std::min(lowLink[frame.index], order[child]);
+				continue;
+			}
+
+			const uint32_t index = frame.index;
+			callStack.pop_back();
+
+			if (!callStack.empty())
+			{
+				const uint32_t parent = callStack.back().index;
+				lowLink[parent] = std::min(lowLink[parent], lowLink[index]);
+			}
+
+			if (lowLink[index] != order[index])
+				continue;
+
+			// Index is root of a component; pop all members.
+			const uint32_t id = (uint32_t)componentModifiedCount.size();
+			members.resize(0);
+			for (;;)
+			{
+				const uint32_t member = stack.back();
+				stack.pop_back();
+				onStack[member] = 0;
+				component[member] = id;
+				members.push_back(member);
+				if (member == index)
+					break;
+			}
+
+			// All components reachable from this component has already been completed.
+			uint32_t modifiedCount = 0;
+			bool reachModified = false;
+			for (auto member : members)
+			{
+				if ((reasons[member] & PbrSourceModified) != 0)
+					++modifiedCount;
+
+				for (auto child : dependencySet->get(member)->children)
+				{
+					if (!isUsed(child) || component[child] == id)
+						continue;
+					const uint32_t cid = component[child];
+					reachModified |= (componentModifiedCount[cid] > 0 || componentReachModified[cid] != 0);
+				}
+			}
+
+			componentModifiedCount.push_back(modifiedCount);
+			componentReachModified.push_back(reachModified ? 1 : 0);
+
+			for (auto member : members)
+			{
+				const uint32_t selfModified = (reasons[member] & PbrSourceModified) != 0 ? 1 : 0;
+				if (reachModified || modifiedCount > selfModified)
+					reasons[member] |= PbrDependencyModified;
+			}
+		}
+	}
+}
+
 	}
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.editor.PipelineBuilder", PipelineBuilder, IPipelineBuilder)
@@ -116,7 +275,8 @@ PipelineBuilder::PipelineBuilder(
 	IPipelineDb* pipelineDb,
 	IPipelineInstanceCache* instanceCache,
 	IListener* listener,
-	bool verbose
+	bool verbose,
+	uint32_t threadCount
 )
 :	m_pipelineFactory(pipelineFactory)
 ,	m_sourceDatabase(sourceDatabase)
@@ -126,10 +286,10 @@ PipelineBuilder::PipelineBuilder(
 ,	m_instanceCache(instanceCache)
 ,	m_listener(listener)
 ,	m_verbose(verbose)
+,	m_threadCount(threadCount)
 ,	m_rebuild(false)
 ,	m_profiler(new PipelineProfiler())
 ,	m_dependencySet(nullptr)
-,	m_adHocDepth(0)
 ,	m_progressEnd(0)
 ,	m_progress(0)
 ,	m_succeeded(0)
@@ -154,12 +314,6 @@ bool PipelineBuilder::build(const PipelineDependencySet* dependencySet, bool reb
 	T_ANONYMOUS_VAR(ScopeIndent)(log::error);
 	T_ANONYMOUS_VAR(ScopeIndent)(log::debug);
 
-	struct Work
-	{
-		Ref< const PipelineDependency > dependency;
-		Ref< const Object > buildParams;
-		uint32_t reason;
-	};
 	AlignedVector< Work > workSet;
 	Timer timer;
 
@@ -265,49 +419,20 @@ bool PipelineBuilder::build(const PipelineDependencySet* dependencySet, bool reb
 			reasons[i] |= PbrForced;
 	}
 
+	// Propagate modifications to dependencies which use modified dependencies.
+	if (!rebuild && modifiedCount > 0)
+		propagateDependencyModified(dependencySet, reasons);
+
 	// Collect work set.
 	for (uint32_t i = 0; i < dependencyCount; ++i)
 	{
-		const PipelineDependency* dependency = dependencySet->get(i);
-		T_ASSERT(dependency);
-
-		SmallSet< uint32_t > visited;
-		visited.insert(i);
-
-		AlignedVector< uint32_t > children;
-		children.insert(children.end(), dependency->children.begin(), dependency->children.end());
-
-		while (!children.empty())
-		{
-			if (visited.find(children.back()) != visited.end())
-			{
-				children.pop_back();
-				continue;
-			}
-
-			const PipelineDependency* childDependency = dependencySet->get(children.back());
-			T_ASSERT(childDependency);
-
-			if ((childDependency->flags & PdfUse) == 0)
-			{
-				children.pop_back();
-				continue;
-			}
-
-			if ((reasons[children.back()] & PbrSourceModified) != 0)
-				reasons[i] |= PbrDependencyModified;
-
-			visited.insert(children.back());
-
-			children.pop_back();
-			children.insert(children.end(), childDependency->children.begin(), childDependency->children.end());
-		}
-
 		if (reasons[i] != 0)
-			workSet.push_back({ dependency, nullptr, reasons[i] });
+			workSet.push_back({ dependencySet->get(i), nullptr, reasons[i] });
 	}
 
-	T_DEBUG(L"Pipeline build; analyzed build reasons in " << formatDuration(timer.getDeltaTime()) << L".");
+	const double analysisTime = timer.getElapsedTime();
+	if (m_verbose)
+		log::info << L"Analyzed build reasons in " << formatDuration(analysisTime) << L"; " << modifiedCount << L" modified, " << (int32_t)workSet.size() << L" to build." << Endl;
 
 	if (m_verbose && !workSet.empty())
 		log::info << L"Dispatching " << (int32_t)workSet.size() << L" build(s)..." << Endl;
@@ -323,38 +448,22 @@ bool PipelineBuilder::build(const PipelineDependencySet* dependencySet, bool reb
 	m_cacheVoid = 0;	// No hash on source asset will result in a void.
 	m_dependencySet = dependencySet;
 
-	for (const auto& w : workSet)
+	Thread* buildThread = ThreadManager::getInstance().getCurrentThread();
+	if (m_threadCount > 1 && workSet.size() > 1)
+		buildParallel(dependencySet, workSet, buildThread);
+	else
 	{
-		if (ThreadManager::getInstance().getCurrentThread()->stopped())
-			break;
-
-		if (m_listener)
-			m_listener->beginBuild(
-				m_progress,
-				m_progressEnd,
-				w.dependency
-			);
-
-		const BuildResult result = performBuild(dependencySet, w.dependency, w.buildParams, w.reason);
-		if (result == BuildResult::Succeeded || result == BuildResult::SucceededWithWarnings)
-			m_succeeded++;
-		else
-			m_failed++;
-
-		if (m_listener)
-			m_listener->endBuild(
-				m_progress,
-				m_progressEnd,
-				w.dependency,
-				result
-			);
-
-		m_progress++;
+		for (const auto& w : workSet)
+		{
+			if (buildThread->stopped())
+				break;
+			buildWork(dependencySet, w);
+		}
 	}
 
 	// Log cache performance.
 	if (m_cache && m_verbose)
-		log::info << L"Pipeline cache; " << m_cacheHit << L" hit(s), " << m_cacheMiss << L" miss(es), " << m_cacheVoid << L" uncachable(s)." << Endl;
+		log::info << L"Pipeline cache; " << (int32_t)m_cacheHit << L" hit(s), " << (int32_t)m_cacheMiss << L" miss(es), " << (int32_t)m_cacheVoid << L" uncachable(s)." << Endl;
 
 	// Log results.
 	if (!ThreadManager::getInstance().getCurrentThread()->stopped())
@@ -373,9 +482,9 @@ bool PipelineBuilder::build(const PipelineDependencySet* dependencySet, bool reb
 		}
 
 		if (m_failed == 0)
-			log::info << L"Build finished in " << formatDuration(timer.getElapsedTime()) << L"; " << m_succeeded << L" succeeded (" << m_succeededBuilt << L" built), " << m_failed << L" failed." << Endl;
+			log::info << L"Build finished in " << formatDuration(timer.getElapsedTime()) << L" (analysis " << formatDuration(analysisTime) << L"); " << (int32_t)m_succeeded << L" succeeded (" << (int32_t)m_succeededBuilt << L" built), " << (int32_t)m_failed << L" failed." << Endl;
 		else
-			log::error << L"Build failed in " << formatDuration(timer.getElapsedTime()) << L"; " << m_succeeded << L" succeeded (" << m_succeededBuilt << L" built), " << m_failed << L" failed." << Endl;
+			log::error << L"Build failed in " << formatDuration(timer.getElapsedTime()) << L" (analysis " << formatDuration(analysisTime) << L"); " << (int32_t)m_succeeded << L" succeeded (" << (int32_t)m_succeededBuilt << L" built), " << (int32_t)m_failed << L" failed." << Endl;
 	}
 	else
 		log::info << L"Build finished; aborted." << Endl;
@@ -401,17 +510,20 @@ Ref< ISerializable > PipelineBuilder::buildProduct(const db::Instance* sourceIns
 	if (const ISerializable* sbp = dynamic_type_cast< const ISerializable* >(buildParams))
 		sourceHash += DeepHash(sbp).get();
 
-	auto it = m_builtCache.find(sourceHash);
-	if (it != m_builtCache.end())
 	{
-		built_cache_list_t& bcl = it->second;
-		T_ASSERT(!bcl.empty());
-
-		// Return same instance as before if pointer and hash match.
-		for (built_cache_list_t::const_iterator j = bcl.begin(); j != bcl.end(); ++j)
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_builtCacheLock);
+		auto it = m_builtCache.find(sourceHash);
+		if (it != m_builtCache.end())
 		{
-			if (j->sourceAsset == sourceAsset)
-				return j->product;
+			built_cache_list_t& bcl = it->second;
+			T_ASSERT(!bcl.empty());
+
+			// Return same instance as before if pointer and hash match.
+			for (built_cache_list_t::const_iterator j = bcl.begin(); j != bcl.end(); ++j)
+			{
+				if (j->sourceAsset == sourceAsset)
+					return j->product;
+			}
 		}
 	}
 
@@ -421,13 +533,17 @@ Ref< ISerializable > PipelineBuilder::buildProduct(const db::Instance* sourceIns
 	if (!product)
 		return nullptr;
 
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_builtCacheLock);
 	m_builtCache[sourceHash].push_back({ sourceAsset, product });
 	return product;
 }
 
 bool PipelineBuilder::buildAdHocOutput(const Guid& outputGuid)
 {
-	m_adHocBuilds.insert(outputGuid);
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_adHocBuildsLock);
+	auto it = m_adHocBuilds.try_emplace(outputGuid);
+	if (it.second)
+		it.first->second.finished = true;
 	return true;
 }
 
@@ -446,6 +562,7 @@ bool PipelineBuilder::buildAdHocOutput(const ISerializable* sourceAsset, const s
 		if (m_dependencySet->get(id) != PipelineDependencySet::DiInvalid)
 			return false;
 
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_adHocBuildsLock);
 		if (m_adHocBuilds.find(id) != m_adHocBuilds.end())
 			return false;
 
@@ -479,6 +596,8 @@ bool PipelineBuilder::buildAdHocOutput(const ISerializable* sourceAsset, const s
 
 	T_ANONYMOUS_VAR(ScopeIndent)(log::info);
 
+	BuildContext& bc = getBuildContext();
+
 	// Build dependencies.
 	bool result = true;
 	for (uint32_t i = 0; i < dependencySet.size() && result; ++i)
@@ -487,8 +606,44 @@ bool PipelineBuilder::buildAdHocOutput(const ISerializable* sourceAsset, const s
 		if ((dependency->flags & PdfBuild) == 0)
 			continue;
 
-		if (m_adHocBuilds.find(dependency->outputGuid) != m_adHocBuilds.end())
+		// Claim ad-hoc output so it's not built concurrently by another thread; if
+		// already claimed by another thread then wait until it has been built.
+		Thread* currentThread = ThreadManager::getInstance().getCurrentThread();
+		AdHocBuild* adHocBuild = nullptr;
+		bool claimed = false;
+		bool claimedByOther = false;
+		{
+			T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_adHocBuildsLock);
+			auto it = m_adHocBuilds.try_emplace(dependency->outputGuid);
+			adHocBuild = &it.first->second;
+			if ((claimed = it.second) == true)
+				adHocBuild->thread = currentThread;
+			else if (adHocBuild->thread != currentThread)
+			{
+				// Ad-hoc outputs which depend on each other are claimed by different threads; waiting would
+				// dead-lock thus treat as nested build, same as when both are built by a single thread.
+				if (!isAdHocWaitCycle(adHocBuild, currentThread))
+				{
+					m_adHocWaits[currentThread] = adHocBuild;
+					claimedByOther = true;
+				}
+				else
+					log::warning << L"Cyclic ad-hoc dependency to \"" << dependency->outputPath << L"\" built by another thread; not waiting." << Endl;
+			}
+		}
+		if (!claimed)
+		{
+			if (claimedByOther)
+			{
+				while (!adHocBuild->finished)
+					adHocBuild->finishedEvent.wait(100);
+				result &= adHocBuild->succeeded;
+
+				T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_adHocBuildsLock);
+				m_adHocWaits.erase(currentThread);
+			}
 			continue;
+		}
 
 		// Calculate hash entry.
 		PipelineDependencyHash dependencyHash;
@@ -518,9 +673,9 @@ bool PipelineBuilder::buildAdHocOutput(const ISerializable* sourceAsset, const s
 		// Build output instances; keep an array of written instances as we
 		// need them to update the cache for this specific build.
 		RefArray< db::Instance > previousBuiltInstances;
-		m_builtInstances.swap(previousBuiltInstances);
+		bc.builtInstances.swap(previousBuiltInstances);
 		AlignedVector< CacheKey > previousBuiltAdHocKeys;
-		m_builtAdHocKeys.swap(previousBuiltAdHocKeys);
+		bc.builtAdHocKeys.swap(previousBuiltAdHocKeys);
 
 		// Get output instances from memory cache.
 		if (m_cache && pipeline->shouldCache() && cachePermitted)
@@ -528,11 +683,12 @@ bool PipelineBuilder::buildAdHocOutput(const ISerializable* sourceAsset, const s
 			if (getInstancesFromCache(
 				m_cache,
 				{ dependency->outputGuid, dependencyHash },
-				&m_builtInstances,
-				&m_builtAdHocKeys
+				&bc.builtInstances,
+				&bc.builtAdHocKeys
 			))
 			{
-				for (const auto& child : m_builtAdHocKeys)
+				prefetchFromCache(m_cache, bc.builtAdHocKeys);
+				for (const auto& child : bc.builtAdHocKeys)
 				{
 					if (!getInstancesFromCache(
 						m_cache,
@@ -540,20 +696,23 @@ bool PipelineBuilder::buildAdHocOutput(const ISerializable* sourceAsset, const s
 						nullptr,
 						nullptr
 					))
+					{
+						finishAdHocBuild(*adHocBuild, false);
 						return false;
+					}
 				}
 
 				m_pipelineDb->setDependency(dependency->outputGuid, dependencyHash);
 
 				previousBuiltAdHocKeys.push_back({ dependency->outputGuid, dependencyHash });
-				previousBuiltAdHocKeys.insert(previousBuiltAdHocKeys.end(), m_builtAdHocKeys.begin(), m_builtAdHocKeys.end());
+				previousBuiltAdHocKeys.insert(previousBuiltAdHocKeys.end(), bc.builtAdHocKeys.begin(), bc.builtAdHocKeys.end());
 
-				m_builtInstances.swap(previousBuiltInstances);
-				m_builtAdHocKeys.swap(previousBuiltAdHocKeys);
+				bc.builtInstances.swap(previousBuiltInstances);
+				bc.builtAdHocKeys.swap(previousBuiltAdHocKeys);
 
-				m_adHocBuilds.insert(dependency->outputGuid);
 
 				m_cacheHit++;
+				finishAdHocBuild(*adHocBuild, true);
 				continue;
 			}
 			else
@@ -563,12 +722,12 @@ bool PipelineBuilder::buildAdHocOutput(const ISerializable* sourceAsset, const s
 			m_cacheVoid++;
 
 		if (m_verbose)
-			log::info << L"Building \"" << dependency->outputPath << L"\" (ad-hoc " << m_adHocDepth << L")..." << Endl;
+			log::info << L"Building \"" << dependency->outputPath << L"\" (ad-hoc " << bc.adHocDepth << L")..." << Endl;
 		log::info << IncreaseIndent;
 
-		m_adHocDepth++;
+		bc.adHocDepth++;
 		m_profiler->begin(*dependency->pipelineType);
-		result &= pipeline->buildOutput(
+		const bool built = pipeline->buildOutput(
 			this,
 			&dependencySet,
 			dependency,
@@ -580,19 +739,20 @@ bool PipelineBuilder::buildAdHocOutput(const ISerializable* sourceAsset, const s
 			PbrSourceModified
 		);
 		m_profiler->end();
-		m_adHocDepth--;
+		bc.adHocDepth--;
+		result &= built;
 
 		if (result && m_cache && pipeline->shouldCache() && cachePermitted)
 		{
 			putInstancesInCache(
 				m_cache,
 				{ dependency->outputGuid, dependencyHash },
-				m_builtInstances,
-				m_builtAdHocKeys
+				bc.builtInstances,
+				bc.builtAdHocKeys
 			);
 			
 			previousBuiltAdHocKeys.push_back({ dependency->outputGuid, dependencyHash });
-			previousBuiltAdHocKeys.insert(previousBuiltAdHocKeys.end(), m_builtAdHocKeys.begin(), m_builtAdHocKeys.end());
+			previousBuiltAdHocKeys.insert(previousBuiltAdHocKeys.end(), bc.builtAdHocKeys.begin(), bc.builtAdHocKeys.end());
 		}
 
 		// Store dependency hash in database so getInstancesFromCache only touches
@@ -602,10 +762,9 @@ bool PipelineBuilder::buildAdHocOutput(const ISerializable* sourceAsset, const s
 
 		// Restore previous set but also insert built instances from synthesized build;
 		// when caching is enabled then synthesized built instances should be included in parent build as well.
-		m_builtInstances.swap(previousBuiltInstances);
-		m_builtAdHocKeys.swap(previousBuiltAdHocKeys);
+		bc.builtInstances.swap(previousBuiltInstances);
+		bc.builtAdHocKeys.swap(previousBuiltAdHocKeys);
 
-		m_adHocBuilds.insert(dependency->outputGuid);
 
 		log::info << DecreaseIndent;
 		if (m_verbose)
@@ -615,6 +774,8 @@ bool PipelineBuilder::buildAdHocOutput(const ISerializable* sourceAsset, const s
 			else
 				log::info << L"Build \"" << dependency->outputPath << L"\" (ad-hoc, " << type_name(pipeline) << L") failed." << Endl;
 		}
+
+		finishAdHocBuild(*adHocBuild, built);
 	}
 
 	return result;
@@ -651,6 +812,7 @@ Ref< ISerializable > PipelineBuilder::getBuildProduct(const ISerializable* sourc
 
 	const uint32_t sourceHash = DeepHash(sourceAsset).get();
 
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_builtCacheLock);
 	const auto it = m_builtCache.find(sourceHash);
 	if (it == m_builtCache.end())
 		return nullptr;
@@ -698,7 +860,7 @@ Ref< db::Instance > PipelineBuilder::createOutputInstance(const std::wstring& in
 	);
 	if (instance)
 	{
-		m_builtInstances.push_back(instance);
+		getBuildContext().builtInstances.push_back(instance);
 		return instance;
 	}
 	else
@@ -740,6 +902,178 @@ PipelineProfiler* PipelineBuilder::getProfiler() const
 	return m_profiler;
 }
 
+PipelineBuilder::BuildContext& PipelineBuilder::getBuildContext()
+{
+	BuildContext* bc = static_cast< BuildContext* >(m_buildContext.get());
+	return bc != nullptr ? *bc : m_defaultBuildContext;
+}
+
+bool PipelineBuilder::isAdHocWaitCycle(const AdHocBuild* adHocBuild, const Thread* waitingThread) const
+{
+	// Follow chain of threads waiting on ad-hoc outputs, if it leads back to
+	// waiting thread then waiting would never finish.
+	for (const AdHocBuild* build = adHocBuild; build != nullptr; )
+	{
+		if (build->thread == waitingThread)
+			return true;
+		const auto it = m_adHocWaits.find(build->thread);
+		build = (it != m_adHocWaits.end()) ? it->second : nullptr;
+	}
+	return false;
+}
+
+void PipelineBuilder::finishAdHocBuild(AdHocBuild& adHocBuild, bool succeeded)
+{
+	adHocBuild.succeeded = succeeded;
+	adHocBuild.finished = true;
+	adHocBuild.finishedEvent.broadcast();
+}
+
+void PipelineBuilder::buildParallel(const PipelineDependencySet* dependencySet, const AlignedVector< Work >& workSet, Thread* buildThread)
+{
+	const uint32_t workCount = (uint32_t)workSet.size();
+
+	AlignedVector< int32_t > workIndices(dependencySet->size(), -1);
+	for (uint32_t i = 0; i < workCount; ++i)
+		workIndices[dependencySet->get(workSet[i].dependency->outputGuid)] = (int32_t)i;
+
+	// Rank work in depth first post order so children are ranked before their parents;
+	// edges back into an unfinished parent are part of a cycle and are ignored.
+	AlignedVector< uint32_t > ranks;
+	ranks.resize(workCount, ~0U);
+	AlignedVector< std::pair< uint32_t, uint32_t > > stack;
+	uint32_t rank = 0;
+	for (uint32_t i = 0; i < workCount; ++i)
+	{
+		if (ranks[i] != ~0U)
+			continue;
+
+		stack.push_back({ i, 0 });
+		ranks[i] = ~1U;
+
+		while (!stack.empty())
+		{
+			auto& top = stack.back();
+			const auto& children = workSet[top.first].dependency->children;
+			if (top.second < children.size())
+			{
+				const int32_t child = workIndices[children[top.second++]];
+				if (child >= 0 && ranks[child] == ~0U)
+				{
+					ranks[child] = ~1U;
+					stack.push_back({ (uint32_t)child, 0 });
+				}
+			}
+			else
+			{
+				ranks[top.first] = rank++;
+				stack.pop_back();
+			}
+		}
+	}
+
+	// Targets of calling thread, buffered log output of each build is written to these.
+	ILogTarget* infoTarget = log::info.getLocalTarget();
+	ILogTarget* warningTarget = log::warning.getLocalTarget();
+	ILogTarget* errorTarget = log::error.getLocalTarget();
+
+	Ref< JobGraph > jobGraph = new JobGraph();
+	for (uint32_t i = 0; i < workCount; ++i)
+	{
+		jobGraph->add([&, i]() {
+			if (buildThread->stopped())
+				return;
+
+			AlignedVector< LogTargetBuffer::Entry > entries;
+			LogTargetBuffer infoBuffer(entries, infoTarget);
+			LogTargetBuffer warningBuffer(entries, warningTarget);
+			LogTargetBuffer errorBuffer(entries, errorTarget);
+
+			Ref< ILogTarget > previousInfoTarget = log::info.getLocalTarget();
+			Ref< ILogTarget > previousWarningTarget = log::warning.getLocalTarget();
+			Ref< ILogTarget > previousErrorTarget = log::error.getLocalTarget();
+
+			log::info.setLocalTarget(&infoBuffer);
+			log::warning.setLocalTarget(&warningBuffer);
+			log::error.setLocalTarget(&errorBuffer);
+
+			buildWork(dependencySet, workSet[i]);
+
+			log::info.setLocalTarget(previousInfoTarget);
+			log::warning.setLocalTarget(previousWarningTarget);
+			log::error.setLocalTarget(previousErrorTarget);
+
+			T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_logLock);
+			for (const auto& entry : entries)
+			{
+				if (entry.target)
+					entry.target->log(entry.threadId, entry.level, entry.str.c_str());
+			}
+		});
+	}
+
+	for (uint32_t i = 0; i < workCount; ++i)
+	{
+		for (auto child : workSet[i].dependency->children)
+		{
+			const int32_t childWork = workIndices[child];
+			if (childWork >= 0 && ranks[childWork] < ranks[i])
+				jobGraph->addDependency(i, (uint32_t)childWork);
+		}
+	}
+
+	JobQueue jobQueue;
+	if (!jobQueue.create(m_threadCount - 1, Thread::Normal, JobQueue::Mode::WorkStealing))
+	{
+		log::warning << L"Unable to create build threads; building sequentially." << Endl;
+		for (const auto& w : workSet)
+		{
+			if (buildThread->stopped())
+				break;
+			buildWork(dependencySet, w);
+		}
+		return;
+	}
+
+	if (m_verbose)
+		log::info << L"Building on " << m_threadCount << L" thread(s)..." << Endl;
+
+	jobGraph->execute(jobQueue);
+	jobQueue.destroy();
+}
+
+void PipelineBuilder::buildWork(const PipelineDependencySet* dependencySet, const Work& work)
+{
+	if (m_listener)
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_listenerLock);
+		m_listener->beginBuild(
+			m_progress,
+			m_progressEnd,
+			work.dependency
+		);
+	}
+
+	const BuildResult result = performBuild(dependencySet, work.dependency, work.buildParams, work.reason);
+	if (result == BuildResult::Succeeded || result == BuildResult::SucceededWithWarnings)
+		m_succeeded++;
+	else
+		m_failed++;
+
+	if (m_listener)
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_listenerLock);
+		m_listener->endBuild(
+			m_progress,
+			m_progressEnd,
+			work.dependency,
+			result
+		);
+	}
+
+	m_progress++;
+}
+
 IPipelineBuilder::BuildResult PipelineBuilder::performBuild(
 	const PipelineDependencySet* dependencySet,
 	const PipelineDependency* dependency,
@@ -776,8 +1110,13 @@ IPipelineBuilder::BuildResult PipelineBuilder::performBuild(
 	Ref< IPipeline > pipeline = m_pipelineFactory->findPipeline(*dependency->pipelineType);
 	T_ASSERT(pipeline);
 
-	m_builtInstances.resize(0);
-	m_builtAdHocKeys.resize(0);
+	// Setup state of this build, ad-hoc builds and created output instances are recorded into this context.
+	BuildContext bc;
+	BuildContext* previousContext = static_cast< BuildContext* >(m_buildContext.get());
+	T_ANONYMOUS_VAR(EnterLeave)(
+		[&]() { m_buildContext.set(&bc); },
+		[&]() { m_buildContext.set(previousContext); }
+	);
 
 	// Get output instances from cache.
 	if (m_cache && pipeline->shouldCache())
@@ -785,11 +1124,12 @@ IPipelineBuilder::BuildResult PipelineBuilder::performBuild(
 		if (getInstancesFromCache(
 			m_cache,
 			{ dependency->outputGuid, currentDependencyHash },
-			&m_builtInstances,
-			&m_builtAdHocKeys
+			&bc.builtInstances,
+			&bc.builtAdHocKeys
 		))
 		{
-			for (const auto& child : m_builtAdHocKeys)
+			prefetchFromCache(m_cache, bc.builtAdHocKeys);
+			for (const auto& child : bc.builtAdHocKeys)
 			{
 				if (!getInstancesFromCache(
 					m_cache,
@@ -854,8 +1194,8 @@ IPipelineBuilder::BuildResult PipelineBuilder::performBuild(
 		putInstancesInCache(
 			m_cache,
 			{ dependency->outputGuid, currentDependencyHash },
-			m_builtInstances,
-			m_builtAdHocKeys
+			bc.builtInstances,
+			bc.builtAdHocKeys
 		);
 	}
 
@@ -872,9 +1212,6 @@ IPipelineBuilder::BuildResult PipelineBuilder::performBuild(
 			log::info << L"Build \"" << dependency->outputPath << L"\" failed (" << type_name(pipeline) << L")." << Endl;
 	}
 
-	m_builtInstances.resize(0);
-	m_builtAdHocKeys.resize(0);
-
 	if (result)
 		return (warningTarget.getCount() + errorTarget.getCount()) > 0 ? BuildResult::SucceededWithWarnings : BuildResult::Succeeded;
 	else
@@ -941,6 +1278,19 @@ bool PipelineBuilder::putInstancesInCache(
 	return true;
 }
 
+void PipelineBuilder::prefetchFromCache(IPipelineCache* cache, const AlignedVector< CacheKey >& keys) const
+{
+	if (keys.size() <= 1)
+		return;
+
+	AlignedVector< std::pair< Guid, PipelineDependencyHash > > entries;
+	entries.reserve(keys.size());
+	for (const auto& key : keys)
+		entries.push_back(std::make_pair(key.guid, key.hash));
+
+	cache->prefetch(entries);
+}
+
 bool PipelineBuilder::getInstancesFromCache(
 	IPipelineCache* cache,
 	const CacheKey& key,
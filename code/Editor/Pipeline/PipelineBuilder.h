@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,10 +8,14 @@
  */
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <set>
 #include "Core/Io/Path.h"
+#include "Core/Thread/Event.h"
+#include "Core/Thread/Semaphore.h"
+#include "Core/Thread/ThreadLocal.h"
 #include "Editor/IPipelineBuilder.h"
 #include "Editor/PipelineTypes.h"
 
@@ -48,6 +52,11 @@ class PipelineProfiler;
 
 /*! Pipeline manager.
  * \ingroup Editor
+ *
+ * Work set is built on a number of worker threads where
+ * each dependency is built after it's children; output
+ * logged from a build is kept together and written
+ * when the build has finished.
  */
 class T_DLLCLASS PipelineBuilder : public IPipelineBuilder
 {
@@ -62,7 +71,8 @@ public:
 		IPipelineDb* db,
 		IPipelineInstanceCache* instanceCache,
 		IListener* listener,
-		bool verbose
+		bool verbose,
+		uint32_t threadCount = 1
 	);
 
 	virtual bool build(const PipelineDependencySet* dependencySet, bool rebuild) override final;
@@ -104,6 +114,30 @@ private:
 		Ref< ISerializable > product;
 	};
 
+	struct Work
+	{
+		Ref< const PipelineDependency > dependency;
+		Ref< const Object > buildParams;
+		uint32_t reason;
+	};
+
+	//! Per build state, each thread keep a pointer to the build it's currently performing.
+	struct BuildContext
+	{
+		RefArray< db::Instance > builtInstances;
+		AlignedVector< CacheKey > builtAdHocKeys;
+		int32_t adHocDepth = 0;
+	};
+
+	//! Ad-hoc output claimed by a thread, other threads depending on same output wait until it's finished.
+	struct AdHocBuild
+	{
+		Event finishedEvent;
+		Thread* thread = nullptr;
+		std::atomic< bool > finished = false;
+		bool succeeded = true;
+	};
+
 	typedef std::list< BuiltCacheEntry > built_cache_list_t;
 
 	Ref< PipelineFactory > m_pipelineFactory;
@@ -115,23 +149,43 @@ private:
 	Ref< DataAccessCache > m_dataAccessCache;
 	IListener* m_listener;
 	bool m_verbose;
+	uint32_t m_threadCount;
 	bool m_rebuild;
 	Ref< PipelineProfiler > m_profiler;
 	const PipelineDependencySet* m_dependencySet;
 	std::map< Guid, Ref< ISerializable > > m_readCache;
 	std::map< uint32_t, built_cache_list_t > m_builtCache;
-	std::set< Guid > m_adHocBuilds;
-	RefArray< db::Instance > m_builtInstances;
-	AlignedVector< CacheKey > m_builtAdHocKeys;
-	int32_t m_adHocDepth;
+	std::map< Guid, AdHocBuild > m_adHocBuilds;
+	std::map< const Thread*, const AdHocBuild* > m_adHocWaits;
+	Semaphore m_builtCacheLock;
+	Semaphore m_adHocBuildsLock;
+	Semaphore m_listenerLock;
+	Semaphore m_logLock;
+	ThreadLocal m_buildContext;
+	BuildContext m_defaultBuildContext;
 	int32_t m_progressEnd;
-	int32_t m_progress;
-	int32_t m_succeeded;
-	int32_t m_succeededBuilt;
-	int32_t m_failed;
-	int32_t m_cacheHit;
-	int32_t m_cacheMiss;
-	int32_t m_cacheVoid;
+	std::atomic< int32_t > m_progress;
+	std::atomic< int32_t > m_succeeded;
+	std::atomic< int32_t > m_succeededBuilt;
+	std::atomic< int32_t > m_failed;
+	std::atomic< int32_t > m_cacheHit;
+	std::atomic< int32_t > m_cacheMiss;
+	std::atomic< int32_t > m_cacheVoid;
+
+	/*! Get state of build performed by calling thread. */
+	BuildContext& getBuildContext();
+
+	/*! Check if waiting on ad-hoc output would cause a dead-lock, must be called with ad-hoc lock held. */
+	bool isAdHocWaitCycle(const AdHocBuild* adHocBuild, const Thread* waitingThread) const;
+
+	/*! Mark claimed ad-hoc output as finished and wake waiting threads. */
+	void finishAdHocBuild(AdHocBuild& adHocBuild, bool succeeded);
+
+	/*! Build work set on worker threads, dependencies are built before their parents. */
+	void buildParallel(const PipelineDependencySet* dependencySet, const AlignedVector< Work >& workSet, Thread* buildThread);
+
+	/*! Build single work item and report progress. */
+	void buildWork(const PipelineDependencySet* dependencySet, const Work& work);
 
 	/*! Perform build. */
 	BuildResult performBuild(const PipelineDependencySet* dependencySet, const PipelineDependency* dependency, const Object* buildParams, uint32_t reason);
@@ -144,6 +198,9 @@ private:
 		const AlignedVector< CacheKey >& children
 	) const;
 
+	/*! Hint cache that instances of keys are about to be read. */
+	void prefetchFromCache(IPipelineCache* cache, const AlignedVector< CacheKey >& keys) const;
+
 	/*! Get isolated instance from cache. */
 	bool getInstancesFromCache(
 		IPipelineCache* cache,
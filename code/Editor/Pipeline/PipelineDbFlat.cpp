@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -147,6 +147,7 @@ void PipelineDbFlat::close()
 
 void PipelineDbFlat::beginTransaction()
 {
+	T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(m_lock);
 	T_FATAL_ASSERT(!m_transaction);
 	T_FATAL_ASSERT(m_changes == 0);
 	m_transaction = true;
@@ -154,7 +155,14 @@ void PipelineDbFlat::beginTransaction()
 
 void PipelineDbFlat::endTransaction()
 {
+	T_ANONYMOUS_VAR(ReaderWriterLock::AcquireWriter)(m_lock);
 	T_FATAL_ASSERT(m_transaction);
+	flush();
+	m_transaction = false;
+}
+
+void PipelineDbFlat::flush()
+{
 	if (m_changes > 0)
 	{
 		Ref< IStream > f = FileSystem::getInstance().open(m_file, File::FmWrite);
@@ -188,7 +196,6 @@ void PipelineDbFlat::endTransaction()
 		else
 			log::error << L"Unable to flush pipeline db; failed to write latest changes." << Endl;
 	}
-	m_transaction = false;
 }
 
 void PipelineDbFlat::setDependency(const Guid& guid, const PipelineDependencyHash& hash)
@@ -197,10 +204,7 @@ void PipelineDbFlat::setDependency(const Guid& guid, const PipelineDependencyHas
 	T_FATAL_ASSERT(m_transaction);
 	m_dependencies[guid] = hash;
 	if (++m_changes >= c_flushAfterChanges)
-	{
-		endTransaction();
-		beginTransaction();
-	}
+		flush();
 }
 
 bool PipelineDbFlat::getDependency(const Guid& guid, PipelineDependencyHash& outHash) const
@@ -219,10 +223,7 @@ void PipelineDbFlat::setFile(const Path& path, const PipelineFileHash& file)
 	T_FATAL_ASSERT(m_transaction);
 	m_files[path.getPathName()] = file;
 	if (++m_changes >= c_flushAfterChanges)
-	{
-		endTransaction();
-		beginTransaction();
-	}
+		flush();
 }
 
 bool PipelineDbFlat::getFile(const Path& path, PipelineFileHash& outFile) const
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -60,6 +60,9 @@ private:
 	SmallMap< std::wstring, PipelineFileHash > m_files;
 	uint32_t m_changes = 0;
 	bool m_transaction = false;
+
+	/*! Write changes to file, caller must hold writer lock. */
+	void flush();
 };
 
 }
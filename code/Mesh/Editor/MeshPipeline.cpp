@@ -70,8 +70,8 @@ namespace
 class FragmentReaderAdapter : public render::FragmentLinker::FragmentReaderTransientCache
 {
 public:
-	explicit FragmentReaderAdapter(SmallMap< Key, Ref< render::ShaderGraph > >& cache, editor::IPipelineBuilder* pipelineBuilder)
-		: render::FragmentLinker::FragmentReaderTransientCache(cache)
+	explicit FragmentReaderAdapter(SmallMap< Key, Ref< render::ShaderGraph > >& cache, Semaphore& lock, editor::IPipelineBuilder* pipelineBuilder)
+		: render::FragmentLinker::FragmentReaderTransientCache(cache, lock)
 		, m_pipelineBuilder(pipelineBuilder)
 	{
 	}
@@ -569,7 +569,7 @@ bool MeshPipeline::buildOutput(
 
 		// Link shader fragments.
 		pipelineBuilder->getProfiler()->begin(L"MeshPipeline link fragments");
-		FragmentReaderAdapter fragmentReader(m_linkerCache, pipelineBuilder);
+		FragmentReaderAdapter fragmentReader(m_linkerCache, m_linkerCacheLock, pipelineBuilder);
 		materialShaderGraph = render::FragmentLinker(fragmentReader).resolve(materialShaderGraph, true);
 		pipelineBuilder->getProfiler()->end();
 		if (!materialShaderGraph)
@@ -93,6 +93,7 @@ private:
 	mutable Semaphore m_programCompilerLock;
 	mutable Ref< render::IProgramCompiler > m_programCompiler;
 	mutable SmallMap< Key, Ref< render::ShaderGraph > > m_linkerCache;
+	mutable Semaphore m_linkerCacheLock;
 
 	render::IProgramCompiler* getProgramCompiler() const;
 };
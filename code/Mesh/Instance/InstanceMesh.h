@@ -86,6 +86,8 @@ public:
 
 	const render::Buffer* getRTVertexAttributes() const;
 
+	const render::Mesh* getRenderMesh() const { return m_renderMesh; }
+
 	/* world::CullingComponent::ICullable */
 
 	virtual Aabb3 cullableGetBoundingBox() const override final { return getBoundingBox(); }
@@ -47,6 +47,7 @@ void InstanceMeshComponent::setWorld(world::World* world)
 	safeDestroy(m_cullingInstance);
 	safeDestroy(m_rtwInstance);
 	m_world = world;
+	MeshComponent::setWorld(world);
 }
 
 void InstanceMeshComponent::setState(const world::EntityState& state, const world::EntityState& mask, bool includeChildren)
@@ -60,14 +61,14 @@ void InstanceMeshComponent::setState(const world::EntityState& state, const worl
 			if (rtw != nullptr)
 			{
 				m_rtwInstance = rtw->createInstance(m_mesh->getAccelerationStructure(), m_mesh->getRTVertexAttributes());
-				m_rtwInstance->setTransform(m_transform.get0());
+				m_rtwInstance->setTransform(getTransform().get0());
 			}
 		}
 		if (!m_cullingInstance)
 		{
 			world::CullingComponent* culling = m_world->getComponent< world::CullingComponent >();
 			m_cullingInstance = culling->createInstance(m_mesh, (intptr_t)m_mesh.getResource());
-			m_cullingInstance->setTransform(m_transform.get0());
+			m_cullingInstance->setTransform(getTransform().get0());
 		}
 	}
 	else
@@ -108,7 +109,7 @@ void InstanceMeshComponent::build(
 			if (rtw != nullptr)
 			{
 				m_rtwInstance = rtw->createInstance(m_mesh->getAccelerationStructure(), m_mesh->getRTVertexAttributes());
-				m_rtwInstance->setTransform(m_transform.get0());
+				m_rtwInstance->setTransform(getTransform().get0());
 			}
 		}
 		if (m_cullingInstance)
@@ -117,7 +118,7 @@ void InstanceMeshComponent::build(
 
 			world::CullingComponent* culling = m_world->getComponent< world::CullingComponent >();
 			m_cullingInstance = culling->createInstance(m_mesh, (intptr_t)m_mesh.getResource());
-			m_cullingInstance->setTransform(m_transform.get0());
+			m_cullingInstance->setTransform(getTransform().get0());
 		}
 		m_mesh.consume();
 	}
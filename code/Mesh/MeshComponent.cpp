@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,7 @@
  */
 #include "Mesh/MeshComponent.h"
 #include "World/Entity.h"
+#include "World/World.h"
 
 namespace traktor::mesh
 {
@@ -16,6 +17,7 @@ T_IMPLEMENT_RTTI_CLASS(L"traktor.mesh.MeshComponent", MeshComponent, world::IEnt
 
 void MeshComponent::destroy()
 {
+	MeshComponent::setWorld(nullptr);
 	m_owner = nullptr;
 }
 
@@ -23,20 +25,46 @@ void MeshComponent::setOwner(world::Entity* owner)
 {
 	if ((m_owner = owner) != nullptr)
 	{
-		m_transform = IntervalTransform(
+		getTransform() = IntervalTransform(
 			m_owner->getTransform()
 		);
 	}
 }
 
+void MeshComponent::setWorld(world::World* world)
+{
+	// Move transform back into component.
+	if (m_transformArray)
+	{
+		m_transform = m_transformArray->get(m_transformHandle);
+		m_transformArray->release(m_transformHandle);
+		m_transformArray = nullptr;
+	}
+
+	// Move transform into world's storage; transforms are stepped in batch after entities has been updated.
+	world::WorldComponentStorage* storage = (world != nullptr) ? world->getComponentStorage() : nullptr;
+	if (storage)
+	{
+		m_transformArray = storage->getArray< IntervalTransform >(
+			type_of< MeshComponent >(),
+			[](IntervalTransform* transforms, size_t count, const world::UpdateParams& update) {
+				for (size_t i = 0; i < count; ++i)
+					transforms[i].step();
+			}
+		);
+		m_transformHandle = m_transformArray->allocate(m_transform);
+	}
+}
+
 void MeshComponent::setTransform(const Transform& transform)
 {
-	m_transform.set(transform);
+	getTransform().set(transform);
 }
 
 void MeshComponent::update(const world::UpdateParams& update)
 {
-	m_transform.step();
+	if (!m_transformArray)
+		m_transform.step();
 }
 
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -11,6 +11,7 @@
 #include "Core/Ref.h"
 #include "Core/Math/IntervalTransform.h"
 #include "World/IEntityComponent.h"
+#include "World/WorldComponentStorage.h"
 
 // import/export mechanism.
 #undef T_DLLCLASS
@@ -47,6 +48,8 @@ public:
 
 	virtual void setOwner(world::Entity* owner) override;
 
+	virtual void setWorld(world::World* world) override;
+
 	virtual void setTransform(const Transform& transform) override;
 
 	virtual void update(const world::UpdateParams& update) override;
@@ -65,14 +68,18 @@ public:
 
 	const IMeshParameterCallback* getParameterCallback() const { return m_parameterCallback; }
 
-	const IntervalTransform& getTransform() const { return m_transform; }
+	const IntervalTransform& getTransform() const { return m_transformArray ? m_transformArray->get(m_transformHandle) : m_transform; }
 
-	IntervalTransform& getTransform() { return m_transform; }
+	IntervalTransform& getTransform() { return m_transformArray ? m_transformArray->get(m_transformHandle) : m_transform; }
 
 protected:
 	world::Entity* m_owner = nullptr;
 	const IMeshParameterCallback* m_parameterCallback = nullptr;
-	IntervalTransform m_transform = Transform::identity();	//!< Contain interval of update transforms. 
+
+private:
+	IntervalTransform m_transform = Transform::identity();	//!< Contain interval of update transforms, when not stored in world. 
+	world::WorldComponentArray< IntervalTransform >* m_transformArray = nullptr;
+	uint32_t m_transformHandle = 0;
 };
 
 }
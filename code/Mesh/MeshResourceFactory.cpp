@@ -14,11 +14,54 @@
 #include "Mesh/IMesh.h"
 #include "Mesh/MeshResource.h"
 #include "Mesh/MeshResourceFactory.h"
+#include "Mesh/Instance/InstanceMesh.h"
+#include "Mesh/Skinned/SkinnedMesh.h"
+#include "Mesh/Static/StaticMesh.h"
+#include "Render/Buffer.h"
 #include "Render/IRenderSystem.h"
+#include "Render/Mesh/Mesh.h"
 #include "Render/Mesh/RenderMeshFactory.h"
 
 namespace traktor::mesh
 {
+	namespace
+	{
+
+uint64_t getRenderMeshSize(const render::Mesh* renderMesh)
+{
+	if (!renderMesh)
+		return 0;
+
+	uint64_t size = 0;
+	if (renderMesh->getVertexBuffer())
+		size += renderMesh->getVertexBuffer()->getBufferSize();
+	if (renderMesh->getIndexBuffer())
+		size += renderMesh->getIndexBuffer()->getBufferSize();
+	for (const auto& auxBuffer : renderMesh->getAuxBuffers())
+	{
+		if (auxBuffer.second)
+			size += auxBuffer.second->getBufferSize();
+	}
+	return size;
+}
+
+void destroyRenderMesh(const render::Mesh* renderMesh)
+{
+	if (!renderMesh)
+		return;
+
+	if (renderMesh->getVertexBuffer())
+		renderMesh->getVertexBuffer()->destroy();
+	if (renderMesh->getIndexBuffer())
+		renderMesh->getIndexBuffer()->destroy();
+	for (const auto& auxBuffer : renderMesh->getAuxBuffers())
+	{
+		if (auxBuffer.second)
+			auxBuffer.second->destroy();
+	}
+}
+
+	}
 
 T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.mesh.MeshResourceFactory", 0, MeshResourceFactory, resource::IResourceFactory)
 
@@ -93,6 +136,24 @@ Ref< Object > MeshResourceFactory::create(resource::IResourceManager* resourceMa
 
 void MeshResourceFactory::destroy(Object* resource) const
 {
+	if (auto staticMesh = dynamic_type_cast< const StaticMesh* >(resource))
+		destroyRenderMesh(staticMesh->getRenderMesh());
+	else if (auto skinnedMesh = dynamic_type_cast< const SkinnedMesh* >(resource))
+		destroyRenderMesh(skinnedMesh->getRenderMesh());
+	else if (auto instanceMesh = dynamic_type_cast< const InstanceMesh* >(resource))
+		destroyRenderMesh(instanceMesh->getRenderMesh());
+}
+
+uint64_t MeshResourceFactory::getProductSize(const Object* product) const
+{
+	if (auto staticMesh = dynamic_type_cast< const StaticMesh* >(product))
+		return getRenderMeshSize(staticMesh->getRenderMesh());
+	else if (auto skinnedMesh = dynamic_type_cast< const SkinnedMesh* >(product))
+		return getRenderMeshSize(skinnedMesh->getRenderMesh());
+	else if (auto instanceMesh = dynamic_type_cast< const InstanceMesh* >(product))
+		return getRenderMeshSize(instanceMesh->getRenderMesh());
+	else
+		return 0;
 }
 
 }
@@ -53,6 +53,8 @@ public:
 
 	virtual void destroy(Object* resource) const override final;
 
+	virtual uint64_t getProductSize(const Object* product) const override final;
+
 private:
 	Ref< render::IRenderSystem > m_renderSystem;
 	Ref< render::MeshFactory > m_meshFactory;
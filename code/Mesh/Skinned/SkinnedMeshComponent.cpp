@@ -60,6 +60,7 @@ void SkinnedMeshComponent::setWorld(world::World* world)
 {
 	safeDestroy(m_rtwInstance);
 	m_world = world;
+	MeshComponent::setWorld(world);
 }
 
 void SkinnedMeshComponent::setState(const world::EntityState& state, const world::EntityState& mask, bool includeChildren)
@@ -73,7 +74,7 @@ void SkinnedMeshComponent::setState(const world::EntityState& state, const world
 			if (rtw != nullptr)
 			{
 				m_rtwInstance = rtw->createInstance(m_rtAccelerationStructure, m_mesh->getRTVertexAttributes());
-				m_rtwInstance->setTransform(m_transform.get0());
+				m_rtwInstance->setTransform(getTransform().get0());
 			}
 		}
 	}
@@ -95,8 +96,8 @@ Aabb3 SkinnedMeshComponent::getBoundingBox() const
 
 void SkinnedMeshComponent::build(const world::WorldBuildContext& context, const world::WorldRenderView& worldRenderView, const world::IWorldRenderPass& worldRenderPass)
 {
-	const Transform worldTransform = m_transform.get(worldRenderView.getInterval());
-	const Transform lastWorldTransform = m_transform.get(worldRenderView.getInterval() - 1.0f);
+	const Transform worldTransform = getTransform().get(worldRenderView.getInterval());
+	const Transform lastWorldTransform = getTransform().get(worldRenderView.getInterval() - 1.0f);
 
 	if ((worldRenderPass.getPassFlags() & world::IWorldRenderPass::First) != 0 && worldRenderView.getIndex() == 0)
 	{
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2025 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -85,6 +85,8 @@ public:
 
 	const render::Buffer* getRTVertexAttributes() const;
 
+	const render::Mesh* getRenderMesh() const { return m_renderMesh; }
+
 private:
 	friend class StaticMeshResource;
 
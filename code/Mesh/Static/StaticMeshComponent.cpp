@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -51,6 +51,7 @@ void StaticMeshComponent::setWorld(world::World* world)
 {
 	safeDestroy(m_rtwInstance);
 	m_world = world;
+	MeshComponent::setWorld(world);
 }
 
 void StaticMeshComponent::setState(const world::EntityState& state, const world::EntityState& mask, bool includeChildren)
@@ -64,7 +65,7 @@ void StaticMeshComponent::setState(const world::EntityState& state, const world:
 			if (rtw != nullptr)
 			{
 				m_rtwInstance = rtw->createInstance(m_mesh->getAccelerationStructure(), m_mesh->getRTVertexAttributes());
-				m_rtwInstance->setTransform(m_transform.get0());
+				m_rtwInstance->setTransform(getTransform().get0());
 			}
 		}
 	}
@@ -93,7 +94,7 @@ void StaticMeshComponent::build(const world::WorldBuildContext& context, const w
 	if (!techniqueParts)
 		return;
 
-	const Transform worldTransform = m_transform.get(worldRenderView.getInterval());
+	const Transform worldTransform = getTransform().get(worldRenderView.getInterval());
 
 	// Skip rendering velocities if mesh hasn't moved since last frame.
 	if (worldRenderPass.getTechnique() == s_techniqueVelocityWrite)
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,13 +8,20 @@
  */
 #pragma once
 
-#include <unordered_map>
-#include "Core/Containers/SmallMap.h"
-#include "Core/Containers/SmallSet.h"
+#include <algorithm>
+#include "Core/Containers/AlignedVector.h"
 
 namespace traktor::model
 {
 
+/*! Vector of values with hash index.
+ * \ingroup Model
+ *
+ * Index is a flat open addressing table with linear probing,
+ * each slot store hash and index of value inline so probing
+ * only touch values with matching hashes, and growing the
+ * table doesn't need to touch values at all.
+ */
 template < typename ValueType, typename HashFunction >
 class HashVector
 {
@@ -23,36 +30,30 @@ public:
 
 	void clear()
 	{
-		m_indices.clear();
+		m_slots.clear();
 		m_values.clear();
+		m_tombstones = 0;
 	}
 
+	/*! Swap values and rebuild index in a single pass. */
 	void swap(AlignedVector< ValueType >& values)
 	{
 		m_values.swap(values);
-		m_indices.clear();		
-		for (uint32_t i = 0; i < (uint32_t)m_values.size(); ++i)
-		{
-			const uint32_t hash = HashFunction::get(m_values[i]);
-			m_indices[hash].insert(i);
-		}
+		rebuild(size());
 	}
 
+	/*! Replace values and rebuild index in a single pass. */
 	void replace(const AlignedVector< ValueType >& values)
 	{
 		m_values = values;
-		m_indices.clear();
-		for (uint32_t i = 0; i < (uint32_t)m_values.size(); ++i)
-		{
-			const uint32_t hash = HashFunction::get(m_values[i]);
-			m_indices[hash].insert(i);
-		}
+		rebuild(size());
 	}
 
 	void reserve(uint32_t capacity)
 	{
 		m_values.reserve(capacity);
-		m_indices.reserve(capacity);
+		if (slotCount(capacity) > m_slots.size())
+			grow(capacity);
 	}
 
 	uint32_t size() const
@@ -62,51 +63,99 @@ public:
 
 	uint32_t add(const ValueType& v)
 	{
-		const uint32_t hash = HashFunction::get(v);
-		const uint32_t index = (uint32_t)m_values.size();
+		const uint32_t index = size();
 		m_values.push_back(v);
-		m_indices[hash].insert(index);
+		if (needGrow())
+			grow();
+		insert(HashFunction::get(v), index);
 		return index;
 	}
 
-	void set(uint32_t index, const ValueType& v)
+	/*! Find value or add if no such value, only probe index once. */
+	uint32_t addUnique(const ValueType& v)
 	{
-		// Remove old index.
+		if (m_slots.empty())
+			return add(v);
+
+		const uint32_t hash = HashFunction::get(v);
+		const uint32_t mask = (uint32_t)m_slots.size() - 1;
+
+		uint32_t free = InvalidIndex;
+		for (uint32_t i = mix(hash) & mask; ; i = (i + 1) & mask)
 		{
-			const uint32_t hash = HashFunction::get(m_values[index]);
-			m_indices[hash].erase(index);
+			const Slot& slot = m_slots[i];
+			if (slot.index == EmptySlot)
+			{
+				if (free == InvalidIndex)
+					free = i;
+				break;
+			}
+			else if (slot.index == TombstoneSlot)
+			{
+				if (free == InvalidIndex)
+					free = i;
+			}
+			else if (slot.hash == hash && m_values[slot.index] == v)
+				return slot.index;
 		}
 
-		// Replace value.
-		m_values[index] = v;
-
-		// Add new index.
+		const uint32_t index = size();
+		m_values.push_back(v);
+		if (needGrow())
+		{
+			grow();
+			insert(hash, index);
+		}
+		else
 		{
-			const uint32_t hash = HashFunction::get(v);
-			m_indices[hash].insert(index);
+			if (m_slots[free].index == TombstoneSlot)
+				--m_tombstones;
+			m_slots[free] = { hash, index };
 		}
+		return index;
 	}
 
-	uint32_t find(const ValueType& v) const
+	void set(uint32_t index, const ValueType& v)
 	{
-		const uint32_t hash = HashFunction::get(v);
+		erase(HashFunction::get(m_values[index]), index);
+		m_values[index] = v;
+		insert(HashFunction::get(v), index);
+		if (needGrow())
+			grow();
+	}
 
-		const auto it = m_indices.find(hash);
-		if (it == m_indices.end())
+	uint32_t find(const ValueType& v) const
+	{
+		if (m_slots.empty())
 			return InvalidIndex;
 
-		for (uint32_t index : it->second)
+		const uint32_t hash = HashFunction::get(v);
+		const uint32_t mask = (uint32_t)m_slots.size() - 1;
+
+		for (uint32_t i = mix(hash) & mask; ; i = (i + 1) & mask)
 		{
-			if (m_values[index] == v)
-				return index;
+			const Slot& slot = m_slots[i];
+			if (slot.index == EmptySlot)
+				return InvalidIndex;
+			else if (slot.index != TombstoneSlot && slot.hash == hash && m_values[slot.index] == v)
+				return slot.index;
 		}
-
-		return InvalidIndex;
 	}
 
-	const std::unordered_map< uint32_t, SmallSet< uint32_t > >& indices() const
+	/*! Check that every value is indexed exactly once. */
+	bool validate() const
 	{
-		return m_indices;
+		AlignedVector< uint8_t > indexed;
+		indexed.resize(m_values.size(), 0);
+		for (const auto& slot : m_slots)
+		{
+			if (slot.index == EmptySlot || slot.index == TombstoneSlot)
+				continue;
+			if (slot.index >= size() || indexed[slot.index] != 0 || slot.hash != HashFunction::get(m_values[slot.index]))
+				return false;
+			indexed[slot.index] = 1;
+		}
+		return std::find(indexed.begin(), indexed.end(), 0) == indexed.end();
 	}
 
 	const AlignedVector< ValueType >& values() const
@@ -120,8 +169,99 @@ public:
 	}
 
 private:
-	std::unordered_map< uint32_t, SmallSet< uint32_t > > m_indices;
-	AlignedVector< ValueType > m_values;	
+	static const uint32_t EmptySlot = ~0U;
+	static const uint32_t TombstoneSlot = ~1U;
+
+	struct Slot
+	{
+		uint32_t hash;
+		uint32_t index;
+	};
+
+	AlignedVector< Slot > m_slots;
+	AlignedVector< ValueType > m_values;
+	uint32_t m_tombstones = 0;
+
+	/*! Spread hash over slots, hash functions are often sequential indices. */
+	static uint32_t mix(uint32_t hash)
+	{
+		hash ^= hash >> 16;
+		hash *= 0x7feb352dU;
+		hash ^= hash >> 15;
+		hash *= 0x846ca68bU;
+		hash ^= hash >> 16;
+		return hash;
+	}
+
+	/*! Number of slots required to keep load factor below 3/4. */
+	static size_t slotCount(size_t count)
+	{
+		size_t slots = 16;
+		while (slots * 3 < count * 4)
+			slots <<= 1;
+		return slots;
+	}
+
+	bool needGrow() const
+	{
+		return (m_values.size() + m_tombstones) * 4 > m_slots.size() * 3;
+	}
+
+	/*! Rebuild index from values. */
+	void rebuild(size_t capacity)
+	{
+		m_slots.resize(0);
+		m_slots.resize(slotCount(std::max(capacity, m_values.size()) + 1), { 0, EmptySlot });
+		m_tombstones = 0;
+		for (uint32_t i = 0; i < size(); ++i)
+			insert(HashFunction::get(m_values[i]), i);
+	}
+
+	/*! Grow index, slots are moved without touching values. */
+	void grow(size_t capacity = 0)
+	{
+		AlignedVector< Slot > slots;
+		slots.resize(slotCount(std::max(capacity, m_values.size()) + 1), { 0, EmptySlot });
+		slots.swap(m_slots);
+		m_tombstones = 0;
+		for (const auto& slot : slots)
+		{
+			if (slot.index != EmptySlot && slot.index != TombstoneSlot)
+				insert(slot.hash, slot.index);
+		}
+	}
+
+	void insert(uint32_t hash, uint32_t index)
+	{
+		const uint32_t mask = (uint32_t)m_slots.size() - 1;
+		for (uint32_t i = mix(hash) & mask; ; i = (i + 1) & mask)
+		{
+			Slot& slot = m_slots[i];
+			if (slot.index == EmptySlot || slot.index == TombstoneSlot)
+			{
+				if (slot.index == TombstoneSlot)
+					--m_tombstones;
+				slot = { hash, index };
+				return;
+			}
+		}
+	}
+
+	void erase(uint32_t hash, uint32_t index)
+	{
+		const uint32_t mask = (uint32_t)m_slots.size() - 1;
+		for (uint32_t i = mix(hash) & mask; ; i = (i + 1) & mask)
+		{
+			Slot& slot = m_slots[i];
+			if (slot.index == index)
+			{
+				slot.index = TombstoneSlot;
+				++m_tombstones;
+				return;
+			}
+			T_ASSERT(slot.index != EmptySlot);
+		}
+	}
 };
 
 }
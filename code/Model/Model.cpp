@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -191,8 +191,7 @@ uint32_t Model::addVertex(const Vertex& vertex)
 
 uint32_t Model::addUniqueVertex(const Vertex& vertex)
 {
-	const uint32_t id = m_vertices.find(vertex);
-	return id != m_vertices.InvalidIndex ? id : m_vertices.add(vertex);
+	return m_vertices.addUnique(vertex);
 }
 
 Polygon& Model::addPolygon()
@@ -539,12 +538,7 @@ void Model::serialize(ISerializer& s)
 
 void Model::validate() const
 {
-	for (const auto& indices : m_vertices.indices())
-	{
-		T_FATAL_ASSERT(!indices.second.empty());
-		for (auto vertexId : indices.second)
-			T_FATAL_ASSERT(vertexId < m_vertices.size());
-	}
+	T_FATAL_ASSERT(m_vertices.validate());
 
 	for (const auto& polygon : m_polygons)
 	{
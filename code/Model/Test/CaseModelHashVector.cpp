@@ -0,0 +1,70 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "Model/HashVector.h"
+#include "Model/Vertex.h"
+#include "Model/Test/CaseModelHashVector.h"
+
+namespace traktor::model::test
+{
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.model.test.CaseModelHashVector", 0, CaseModelHashVector, traktor::test::Case)
+
+void CaseModelHashVector::run()
+{
+	HashVector< Vertex, VertexHashFunction > hv;
+
+	// Several vertices share same position, thus same hash.
+	for (uint32_t i = 0; i < 10000; ++i)
+	{
+		const uint32_t id = hv.addUnique(Vertex(i / 4, i % 4));
+		CASE_ASSERT_EQUAL(id, i);
+	}
+	CASE_ASSERT_EQUAL(hv.size(), 10000);
+	CASE_ASSERT(hv.validate());
+
+	// Adding existing vertices must return existing index.
+	bool existing = true;
+	for (uint32_t i = 0; i < 10000; ++i)
+		existing &= (hv.addUnique(Vertex(i / 4, i % 4)) == i);
+	CASE_ASSERT(existing);
+	CASE_ASSERT_EQUAL(hv.size(), 10000);
+
+	CASE_ASSERT_EQUAL(hv.find(Vertex(10000, 0)), hv.InvalidIndex);
+	CASE_ASSERT_EQUAL(hv.find(Vertex(2, 3)), 11);
+
+	// Replace vertices, old value must no longer be found.
+	for (uint32_t i = 0; i < 10000; i += 2)
+		hv.set(i, Vertex(20000 + i, 0));
+	CASE_ASSERT(hv.validate());
+	CASE_ASSERT_EQUAL(hv.find(Vertex(0, 0)), hv.InvalidIndex);
+	CASE_ASSERT_EQUAL(hv.find(Vertex(0, 1)), 1);
+	CASE_ASSERT_EQUAL(hv.find(Vertex(20000, 0)), 0);
+	CASE_ASSERT_EQUAL(hv.find(Vertex(29998, 0)), 9998);
+
+	// Duplicates can be added explicitly.
+	const uint32_t duplicate = hv.add(Vertex(0, 1));
+	CASE_ASSERT_EQUAL(duplicate, 10000);
+	CASE_ASSERT(hv.validate());
+	const uint32_t found = hv.find(Vertex(0, 1));
+	CASE_ASSERT(found == 1 || found == 10000);
+
+	// Rebuild from values.
+	AlignedVector< Vertex > vertices = hv.values();
+	hv.swap(vertices);
+	CASE_ASSERT(hv.validate());
+	CASE_ASSERT_EQUAL(hv.size(), 10001);
+	CASE_ASSERT_EQUAL(hv.find(Vertex(29998, 0)), 9998);
+
+	hv.clear();
+	CASE_ASSERT_EQUAL(hv.size(), 0);
+	CASE_ASSERT_EQUAL(hv.find(Vertex(0, 1)), hv.InvalidIndex);
+	CASE_ASSERT_EQUAL(hv.addUnique(Vertex(0, 1)), 0);
+}
+
+}
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -472,7 +472,14 @@ bool perform(const PipelineParameters& params)
 	if (params.getProgress())
 		statusListener.reset(new StatusListener());
 
-	// Build output.
+	// Build output; zero build thread count means one thread per core.
+	uint32_t buildThreadCount = 1;
+	if (settings->getProperty< bool >(L"Pipeline.BuildThreads", true))
+	{
+		const int32_t threadCount = settings->getProperty< int32_t >(L"Pipeline.BuildThreads.Count", 0);
+		buildThreadCount = threadCount > 0 ? (uint32_t)threadCount : OS::getInstance().getCPUCoreCount();
+	}
+
 	editor::PipelineBuilder pipelineBuilder(
 		&pipelineFactory,
 		sourceDatabaseAndCache.database,
@@ -481,7 +488,8 @@ bool perform(const PipelineParameters& params)
 		pipelineDb,
 		sourceDatabaseAndCache.cache,
 		statusListener.ptr(),
-		params.getVerbose()
+		params.getVerbose(),
+		buildThreadCount
 	);
 
 	if (params.getRebuild())
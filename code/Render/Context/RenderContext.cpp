@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,9 +8,14 @@
  */
 #include "Render/Context/RenderContext.h"
 
+#include "Core/Math/MathUtils.h"
 #include "Core/Memory/Alloc.h"
+#include "Core/Thread/Acquire.h"
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
 
 #if defined(_DEBUG)
 #	include "Core/Log/Log.h"
@@ -23,26 +28,161 @@ namespace
 {
 
 const float c_distanceQuantizeRangeInv = 1.0f / 10.0f;
+const uint32_t c_distanceBucketCount = 1 << 20;
+const uint32_t c_radixSortThreshold = 256;
+const uint32_t c_chunkSize = 1 * 1024 * 1024;
+const uint32_t c_childHeapSize = 1 * 1024 * 1024;
+const uint32_t c_maxPooledSize = 64 * 1024 * 1024;
+const uint32_t c_highWaterMarkDecay = 16;
 
-T_FORCE_INLINE bool SortOpaquePredicate(const DrawableRenderBlock* renderBlock1, const DrawableRenderBlock* renderBlock2)
+std::atomic< uint32_t > s_frameUsage(0);
+
+/*! Pool of heap chunks shared by all render contexts. */
+class ChunkPool
+{
+public:
+	~ChunkPool()
+	{
+		for (const auto& chunk : m_chunks)
+			Alloc::freeAlign(chunk.first);
+	}
+
+	/*! Acquire chunk, smallest pooled chunk which fit, and isn't larger than maxSize, is reused. */
+	uint8_t* acquire(uint32_t size, uint32_t& outSize, uint32_t maxSize = ~0U)
+	{
+		{
+			T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_lock);
+			auto best = m_chunks.end();
+			for (auto it = m_chunks.begin(); it != m_chunks.end(); ++it)
+			{
+				if (it->second >= size && it->second <= maxSize && (best == m_chunks.end() || it->second < best->second))
+					best = it;
+			}
+			if (best != m_chunks.end())
+			{
+				uint8_t* ptr = best->first;
+				outSize = best->second;
+				m_chunks.erase(best);
+				m_pooledSize -= outSize;
+				m_capacity += outSize;
+				return ptr;
+			}
+		}
+
+		uint8_t* ptr = static_cast< uint8_t* >(Alloc::acquireAlign(size, 16, T_FILE_LINE));
+		T_FATAL_ASSERT_M(ptr, L"Out of memory (Render context)");
+		outSize = size;
+		m_capacity += size;
+		return ptr;
+	}
+
+	/*! Release chunk back to pool, chunk is freed if pool is full. */
+	void release(uint8_t* ptr, uint32_t size)
+	{
+		m_capacity -= size;
+		{
+			T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_lock);
+			if (m_pooledSize + size <= c_maxPooledSize)
+			{
+				m_chunks.push_back({ ptr, size });
+				m_pooledSize += size;
+				return;
+			}
+		}
+		Alloc::freeAlign(ptr);
+	}
+
+	uint32_t getCapacity() const { return m_capacity; }
+
+	uint32_t getPooledSize() const { return m_pooledSize; }
+
+private:
+	SpinLock m_lock;
+	AlignedVector< std::pair< uint8_t*, uint32_t > > m_chunks;
+	std::atomic< uint32_t > m_capacity = 0;
+	std::atomic< uint32_t > m_pooledSize = 0;
+};
+
+ChunkPool& chunkPool()
 {
+	static ChunkPool s_chunkPool;
+	return s_chunkPool;
+}
+
+/*! Map float into unsigned integer with same order. */
+T_FORCE_INLINE uint32_t sortableFloat(float value)
+{
+	const uint32_t bits = std::bit_cast< uint32_t >(value);
+	return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+}
+
+/*! Opaque sort key; front-to-back by quantized distance, then by program and parameters to reduce state changes.
+ *
+ * | 20 bits quantized distance | 24 bits program | 20 bits program parameters |
+ *
+ * Distance is quantized into fixed size buckets, blocks behind view or beyond last bucket are clamped.
+ */
+T_FORCE_INLINE uint64_t opaqueSortKey(const DrawableRenderBlock* renderBlock)
+{
+	uint64_t key = 0;
+
 // Don't sort front-to-back on iOS as it's a TDBR architecture thus
 // we focus on minimizing state changes on the CPU instead.
 #if !defined(__IOS__)
-	const float d1 = std::floor(renderBlock1->distance * c_distanceQuantizeRangeInv);
-	const float d2 = std::floor(renderBlock2->distance * c_distanceQuantizeRangeInv);
-	if (d1 < d2)
-		return true;
-	else if (d1 > d2)
-		return false;
+	const float d = clamp(renderBlock->distance * c_distanceQuantizeRangeInv, 0.0f, float(c_distanceBucketCount - 1));
+	key |= uint64_t(d) << 44;
 #endif
 
-	return renderBlock1->program < renderBlock2->program;
+	key |= (uint64_t(uintptr_t(renderBlock->program) >> 4) & 0xffffff) << 20;
+	key |= (uint64_t(uintptr_t(renderBlock->programParams) >> 4) & 0xfffff);
+	return key;
+}
+
+/*! Alpha blend sort key; back-to-front. */
+T_FORCE_INLINE uint64_t alphaBlendSortKey(const DrawableRenderBlock* renderBlock)
+{
+	return uint64_t(~sortableFloat(renderBlock->distance)) << 32;
 }
 
-T_FORCE_INLINE bool SortAlphaBlendPredicate(const DrawableRenderBlock* renderBlock1, const DrawableRenderBlock* renderBlock2)
+/*! Stable LSD radix sort of items by key, 8 bits per pass; passes where all keys share digit are skipped. */
+template < typename ItemType >
+void radixSort(ItemType* items, ItemType* scratch, uint32_t count)
 {
-	return renderBlock1->distance > renderBlock2->distance;
+	uint32_t histograms[8][256] = { { 0 } };
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const uint64_t key = items[i].key;
+		for (uint32_t b = 0; b < 8; ++b)
+			histograms[b][(key >> (b * 8)) & 0xff]++;
+	}
+
+	ItemType* src = items;
+	ItemType* dst = scratch;
+
+	for (uint32_t b = 0; b < 8; ++b)
+	{
+		const uint32_t shift = b * 8;
+		uint32_t* histogram = histograms[b];
+
+		if (histogram[(src[0].key >> shift) & 0xff] == count)
+			continue;
+
+		uint32_t offset = 0;
+		for (uint32_t i = 0; i < 256; ++i)
+		{
+			const uint32_t n = histogram[i];
+			histogram[i] = offset;
+			offset += n;
+		}
+
+		for (uint32_t i = 0; i < count; ++i)
+			dst[histogram[(src[i].key >> shift) & 0xff]++] = src[i];
+
+		std::swap(src, dst);
+	}
+
+	if (src != items)
+		std::memcpy(items, src, count * sizeof(ItemType));
 }
 
 }
@@ -50,25 +190,33 @@ T_FORCE_INLINE bool SortAlphaBlendPredicate(const DrawableRenderBlock* renderBlo
 T_IMPLEMENT_RTTI_CLASS(L"traktor.render.RenderContext", RenderContext, Object)
 
 RenderContext::RenderContext(uint32_t heapSize)
-	: m_heapEnd(nullptr)
+	: m_chunk(0)
+	, m_chunkOffset(0)
+	, m_heapEnd(nullptr)
 	, m_heapPtr(nullptr)
+	, m_highWaterMark(0)
+	, m_frameUsage(0)
+	, m_heapSize(heapSize)
 {
-	m_heap.reset(static_cast< uint8_t* >(Alloc::acquireAlign(heapSize, 16, T_FILE_LINE)));
-	T_FATAL_ASSERT_M(m_heap.ptr(), L"Out of memory (Render context)");
-	m_heapEnd = m_heap.ptr() + heapSize;
-	m_heapPtr = m_heap.ptr();
+	Chunk& chunk = m_chunks.push_back();
+	chunk.ptr = chunkPool().acquire(heapSize, chunk.size);
+	m_heapPtr = chunk.ptr;
+	m_heapEnd = chunk.ptr + chunk.size;
 }
 
 RenderContext::~RenderContext()
 {
 	flush();
-	m_heap.release();
+	s_frameUsage -= m_frameUsage;
+	for (const auto& chunk : m_chunks)
+		chunkPool().release(chunk.ptr, chunk.size);
+	m_chunks.clear();
 }
 
 void* RenderContext::alloc(uint32_t blockSize)
 {
-	if (m_heapPtr + blockSize >= m_heapEnd)
-		T_FATAL_ERROR;
+	if (m_heapPtr + blockSize > m_heapEnd)
+		grow(blockSize);
 
 	void* ptr = m_heapPtr;
 	m_heapPtr += blockSize;
@@ -79,8 +227,14 @@ void* RenderContext::alloc(uint32_t blockSize)
 void* RenderContext::alloc(uint32_t blockSize, uint32_t align)
 {
 	T_ASSERT(align > 0);
-	m_heapPtr = alignUp(m_heapPtr, align);
-	return alloc(blockSize);
+	uint8_t* ptr = alignUp(m_heapPtr, align);
+	if (ptr + blockSize > m_heapEnd)
+	{
+		grow(blockSize + align);
+		ptr = alignUp(m_heapPtr, align);
+	}
+	m_heapPtr = ptr + blockSize;
+	return ptr;
 }
 
 void RenderContext::compute(RenderBlock* renderBlock)
@@ -96,17 +250,17 @@ void RenderContext::draw(RenderBlock* renderBlock)
 void RenderContext::draw(uint32_t type, DrawableRenderBlock* renderBlock)
 {
 	if (type == RenderPriority::Setup)
-		m_priorityQueue[0].push_back(renderBlock);
+		m_priorityQueue[0].push_back({ 0, renderBlock });
 	else if (type == RenderPriority::Opaque)
-		m_priorityQueue[1].push_back(renderBlock);
+		m_priorityQueue[1].push_back({ opaqueSortKey(renderBlock), renderBlock });
 	else if (type == RenderPriority::PostOpaque)
-		m_priorityQueue[2].push_back(renderBlock);
+		m_priorityQueue[2].push_back({ opaqueSortKey(renderBlock), renderBlock });
 	else if (type == RenderPriority::AlphaBlend)
-		m_priorityQueue[3].push_back(renderBlock);
+		m_priorityQueue[3].push_back({ alphaBlendSortKey(renderBlock), renderBlock });
 	else if (type == RenderPriority::PostAlphaBlend)
-		m_priorityQueue[4].push_back(renderBlock);
+		m_priorityQueue[4].push_back({ alphaBlendSortKey(renderBlock), renderBlock });
 	else if (type == RenderPriority::Overlay)
-		m_priorityQueue[5].push_back(renderBlock);
+		m_priorityQueue[5].push_back({ 0, renderBlock });
 }
 
 void RenderContext::direct(RenderBlock* renderBlock)
@@ -118,49 +272,27 @@ void RenderContext::mergePriorityIntoDraw(uint32_t priorities)
 {
 	// Merge setup blocks unsorted.
 	if (priorities & RenderPriority::Setup)
-	{
-		m_drawQueue.insert(m_drawQueue.end(), m_priorityQueue[0].begin(), m_priorityQueue[0].end());
-		m_priorityQueue[0].resize(0);
-	}
+		mergeQueue(m_priorityQueue[0], false);
 
 	// Merge opaque blocks, sorted by shader.
 	if (priorities & RenderPriority::Opaque)
-	{
-		std::sort(m_priorityQueue[1].begin(), m_priorityQueue[1].end(), SortOpaquePredicate);
-		m_drawQueue.insert(m_drawQueue.end(), m_priorityQueue[1].begin(), m_priorityQueue[1].end());
-		m_priorityQueue[1].resize(0);
-	}
+		mergeQueue(m_priorityQueue[1], true);
 
 	// Merge post opaque blocks, sorted by shader.
 	if (priorities & RenderPriority::PostOpaque)
-	{
-		std::sort(m_priorityQueue[2].begin(), m_priorityQueue[2].end(), SortOpaquePredicate);
-		m_drawQueue.insert(m_drawQueue.end(), m_priorityQueue[2].begin(), m_priorityQueue[2].end());
-		m_priorityQueue[2].resize(0);
-	}
+		mergeQueue(m_priorityQueue[2], true);
 
 	// Merge alpha blend blocks back to front.
 	if (priorities & RenderPriority::AlphaBlend)
-	{
-		std::sort(m_priorityQueue[3].begin(), m_priorityQueue[3].end(), SortAlphaBlendPredicate);
-		m_drawQueue.insert(m_drawQueue.end(), m_priorityQueue[3].begin(), m_priorityQueue[3].end());
-		m_priorityQueue[3].resize(0);
-	}
+		mergeQueue(m_priorityQueue[3], true);
 
 	// Merge post alpha blend blocks back to front.
 	if (priorities & RenderPriority::PostAlphaBlend)
-	{
-		std::sort(m_priorityQueue[4].begin(), m_priorityQueue[4].end(), SortAlphaBlendPredicate);
-		m_drawQueue.insert(m_drawQueue.end(), m_priorityQueue[4].begin(), m_priorityQueue[4].end());
-		m_priorityQueue[4].resize(0);
-	}
+		mergeQueue(m_priorityQueue[4], true);
 
 	// Merge overlay blocks unsorted.
 	if (priorities & RenderPriority::Overlay)
-	{
-		m_drawQueue.insert(m_drawQueue.end(), m_priorityQueue[5].begin(), m_priorityQueue[5].end());
-		m_priorityQueue[5].resize(0);
-	}
+		mergeQueue(m_priorityQueue[5], false);
 }
 
 void RenderContext::mergeComputeIntoRender()
@@ -193,8 +325,8 @@ void RenderContext::flush()
 		T_ASSERT(m_priorityQueue[i].empty());
 
 		// As blocks are allocated from a fixed pool we need to manually call destructors.
-		for (auto renderBlock : m_priorityQueue[i])
-			renderBlock->~DrawableRenderBlock();
+		for (const auto& item : m_priorityQueue[i])
+			item.renderBlock->~DrawableRenderBlock();
 
 		m_priorityQueue[i].resize(0);
 	}
@@ -211,7 +343,70 @@ void RenderContext::flush()
 	m_drawQueue.resize(0);
 	m_renderQueue.resize(0);
 
-	m_heapPtr = m_heap.ptr();
+	// Blocks recorded in child contexts has been appended and destroyed by this context.
+	uint32_t frameUsage = getAllocatedSize();
+	for (auto child : m_children)
+	{
+		frameUsage += child->getAllocatedSize();
+		child->reset();
+	}
+
+	// Replace this context's contribution to usage of all contexts.
+	s_frameUsage += frameUsage - m_frameUsage;
+	m_frameUsage = frameUsage;
+
+	rewind();
+}
+
+RenderContext* RenderContext::acquireChild()
+{
+	T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_childLock);
+	if (!m_idleChildren.empty())
+	{
+		RenderContext* child = m_idleChildren.back();
+		m_idleChildren.pop_back();
+		return child;
+	}
+	Ref< RenderContext > child = new RenderContext(std::min(m_heapSize, c_childHeapSize));
+	m_children.push_back(child);
+	return child;
+}
+
+void RenderContext::releaseChild(RenderContext* child)
+{
+	T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_childLock);
+	m_idleChildren.push_back(child);
+}
+
+RenderContext::Mark RenderContext::mark() const
+{
+	Mark m;
+	m.compute = (uint32_t)m_computeQueue.size();
+	m.draw = (uint32_t)m_drawQueue.size();
+	m.render = (uint32_t)m_renderQueue.size();
+	return m;
+}
+
+void RenderContext::append(const RenderContext* child, const Mark& from, const Mark& to)
+{
+	m_computeQueue.insert(m_computeQueue.end(), child->m_computeQueue.begin() + from.compute, child->m_computeQueue.begin() + to.compute);
+	m_drawQueue.insert(m_drawQueue.end(), child->m_drawQueue.begin() + from.draw, child->m_drawQueue.begin() + to.draw);
+	m_renderQueue.insert(m_renderQueue.end(), child->m_renderQueue.begin() + from.render, child->m_renderQueue.begin() + to.render);
+}
+
+uint32_t RenderContext::getCapacity() const
+{
+	uint32_t capacity = 0;
+	for (const auto& chunk : m_chunks)
+		capacity += chunk.size;
+	return capacity;
+}
+
+void RenderContext::getStatistics(RenderContextStatistics& outStatistics)
+{
+	outStatistics.frameUsage = s_frameUsage;
+	outStatistics.heapCapacity = chunkPool().getCapacity();
+	outStatistics.pooledSize = chunkPool().getPooledSize();
 }
 
 bool RenderContext::havePendingComputes() const
@@ -227,4 +422,84 @@ bool RenderContext::havePendingDraws() const
 	return false;
 }
 
+void RenderContext::mergeQueue(AlignedVector< SortItem >& queue, bool sort)
+{
+	const uint32_t count = (uint32_t)queue.size();
+	if (count == 0)
+		return;
+
+	// Sort by key; small queues are sorted by comparison as radix sort has a fixed cost.
+	if (sort)
+	{
+		if (count >= c_radixSortThreshold)
+		{
+			m_sortScratch.resize(count);
+			radixSort(queue.ptr(), m_sortScratch.ptr(), count);
+		}
+		else
+			std::stable_sort(queue.begin(), queue.end(), [](const SortItem& lh, const SortItem& rh) { return lh.key < rh.key; });
+	}
+
+	const size_t offset = m_drawQueue.size();
+	m_drawQueue.resize(offset + count);
+	for (uint32_t i = 0; i < count; ++i)
+		m_drawQueue[offset + i] = queue[i].renderBlock;
+
+	queue.resize(0);
+}
+
+void RenderContext::reset()
+{
+	T_ASSERT(!havePendingDraws());
+	m_computeQueue.resize(0);
+	m_drawQueue.resize(0);
+	m_renderQueue.resize(0);
+	rewind();
+}
+
+void RenderContext::grow(uint32_t blockSize)
+{
+	m_chunkOffset += uint32_t(m_heapPtr - m_chunks[m_chunk].ptr);
+
+	// Use next chunk if retained from an earlier frame and large enough, else acquire a new chunk from pool.
+	++m_chunk;
+	if (m_chunk >= m_chunks.size() || m_chunks[m_chunk].size < blockSize)
+	{
+		Chunk chunk;
+		chunk.ptr = chunkPool().acquire(std::max(blockSize, c_chunkSize), chunk.size);
+		m_chunks.insert(m_chunks.begin() + m_chunk, chunk);
+	}
+
+	m_heapPtr = m_chunks[m_chunk].ptr;
+	m_heapEnd = m_heapPtr + m_chunks[m_chunk].size;
+}
+
+void RenderContext::rewind()
+{
+	// Slowly decay high water mark so spikes doesn't keep memory forever.
+	m_highWaterMark = std::max(getAllocatedSize(), m_highWaterMark - m_highWaterMark / c_highWaterMarkDecay);
+
+	// Replace initial chunk with a smaller if it's much larger than recent usage.
+	if (m_chunks[0].size > c_chunkSize && m_highWaterMark < m_chunks[0].size / 4)
+	{
+		chunkPool().release(m_chunks[0].ptr, m_chunks[0].size);
+		m_chunks[0].ptr = chunkPool().acquire(std::max(m_highWaterMark, c_chunkSize), m_chunks[0].size, m_chunks[0].size / 2);
+	}
+
+	// Keep enough chunks to cover high water mark, return rest to pool.
+	uint32_t capacity = m_chunks[0].size;
+	uint32_t keep = 1;
+	while (keep < m_chunks.size() && capacity < m_highWaterMark)
+		capacity += m_chunks[keep++].size;
+
+	for (uint32_t i = keep; i < m_chunks.size(); ++i)
+		chunkPool().release(m_chunks[i].ptr, m_chunks[i].size);
+	m_chunks.resize(keep);
+
+	m_chunk = 0;
+	m_chunkOffset = 0;
+	m_heapPtr = m_chunks[0].ptr;
+	m_heapEnd = m_heapPtr + m_chunks[0].size;
+}
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -13,6 +13,8 @@
 #include "Core/Math/Vector4.h"
 #include "Core/Misc/AutoPtr.h"
 #include "Core/Object.h"
+#include "Core/RefArray.h"
+#include "Core/Thread/SpinLock.h"
 #include "Render/Context/ProgramParameters.h"
 #include "Render/Context/RenderBlock.h"
 
@@ -29,17 +31,46 @@ namespace traktor::render
 
 class IRenderView;
 
+/*! Render context heap statistics.
+ * \ingroup Render
+ */
+struct RenderContextStatistics
+{
+	uint32_t frameUsage = 0;	//!< Sum of heap usage of last flushed frame of all contexts, including child contexts.
+	uint32_t heapCapacity = 0;	//!< Total size of heap chunks held by all contexts.
+	uint32_t pooledSize = 0;	//!< Total size of idle heap chunks kept for reuse.
+};
+
 /*! Deferred render context.
  * \ingroup Render
  *
  * A render context is used to defer rendering in a
  * multi-threaded renderer.
+ *
+ * Blocks are allocated from a heap which is grown
+ * with chunks from a shared pool when the initial
+ * heap is exhausted; extra chunks are kept while
+ * usage remain high and returned to the pool once
+ * the usage has decayed. An initial heap much larger
+ * than the usage is replaced with a smaller chunk.
  */
 class T_DLLCLASS RenderContext : public Object
 {
 	T_RTTI_CLASS;
 
 public:
+	/*! Queue positions, used to identify blocks queued between two points. */
+	struct Mark
+	{
+		uint32_t compute = 0;
+		uint32_t draw = 0;
+		uint32_t render = 0;
+	};
+
+	/*! Create render context.
+	 *
+	 * \param heapSize Size of initial heap, heap grows if more memory is required.
+	 */
 	explicit RenderContext(uint32_t heapSize);
 
 	virtual ~RenderContext();
@@ -118,6 +149,23 @@ public:
 	/*! Flush blocks. */
 	void flush();
 
+	/*! Acquire child context, thread safe.
+	 *
+	 * Child contexts are used to record blocks in parallel;
+	 * recorded blocks are appended into this context and
+	 * child contexts are reset when this context is flushed.
+	 */
+	RenderContext* acquireChild();
+
+	/*! Release child context, thread safe. */
+	void releaseChild(RenderContext* child);
+
+	/*! Get current queue positions. */
+	Mark mark() const;
+
+	/*! Append blocks queued in child context between two marks onto this context's queues. */
+	void append(const RenderContext* child, const Mark& from, const Mark& to);
+
 	/*! Check if any computes are pending for merge. */
 	bool havePendingComputes() const;
 
@@ -125,16 +173,54 @@ public:
 	bool havePendingDraws() const;
 
 	/*! Return how much of the heap has been allocated. */
-	uint32_t getAllocatedSize() const { return uint32_t(m_heapPtr - m_heap.c_ptr()); }
+	uint32_t getAllocatedSize() const { return m_chunkOffset + uint32_t(m_heapPtr - m_chunks[m_chunk].ptr); }
+
+	/*! Return total size of heap chunks currently held by this context. */
+	uint32_t getCapacity() const;
+
+	/*! Return heap usage of last flushed frame, including child contexts. */
+	uint32_t getFrameUsage() const { return m_frameUsage; }
+
+	/*! Get heap statistics of all render contexts. */
+	static void getStatistics(RenderContextStatistics& outStatistics);
 
 private:
-	AutoPtr< uint8_t, AllocFreeAlign > m_heap;
+	struct Chunk
+	{
+		uint8_t* ptr;
+		uint32_t size;
+	};
+
+	struct SortItem
+	{
+		uint64_t key;
+		DrawableRenderBlock* renderBlock;
+	};
+
+	AlignedVector< Chunk > m_chunks;
+	uint32_t m_chunk;
+	uint32_t m_chunkOffset;
 	uint8_t* m_heapEnd;
 	uint8_t* m_heapPtr;
+	uint32_t m_highWaterMark;
+	uint32_t m_frameUsage;
 	AlignedVector< RenderBlock* > m_computeQueue;
-	AlignedVector< DrawableRenderBlock* > m_priorityQueue[6];
+	AlignedVector< SortItem > m_priorityQueue[6];
+	AlignedVector< SortItem > m_sortScratch;
 	AlignedVector< RenderBlock* > m_drawQueue;
 	AlignedVector< RenderBlock* > m_renderQueue;
+	uint32_t m_heapSize;
+	RefArray< RenderContext > m_children;
+	AlignedVector< RenderContext* > m_idleChildren;
+	SpinLock m_childLock;
+
+	void reset();
+
+	void grow(uint32_t blockSize);
+
+	void rewind();
+
+	void mergeQueue(AlignedVector< SortItem >& queue, bool sort);
 };
 
 }
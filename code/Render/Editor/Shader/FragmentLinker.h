@@ -14,6 +14,7 @@
 #include "Core/Object.h"
 #include "Core/Ref.h"
 #include "Core/RefArray.h"
+#include "Core/Thread/Semaphore.h"
 
 #include <functional>
 #include <string>
@@ -72,10 +73,11 @@ public:
 		virtual void put(const Key& key, const ShaderGraph* shaderGraph) const override final;
 	};
 
+	/*! Cache resolved fragments in map owned by caller; map might be shared between threads thus guarded by lock. */
 	class T_DLLCLASS FragmentReaderTransientCache : public IFragmentReader
 	{
 	public:
-		explicit FragmentReaderTransientCache(SmallMap< Key, Ref< ShaderGraph > >& cache);
+		explicit FragmentReaderTransientCache(SmallMap< Key, Ref< ShaderGraph > >& cache, Semaphore& lock);
 
 		virtual Ref< const ShaderGraph > get(const Key& key) const override final;
 
@@ -83,6 +85,7 @@ public:
 
 	private:
 		SmallMap< Key, Ref< ShaderGraph > >& m_cache;
+		Semaphore& m_lock;
 	};
 
 	FragmentLinker() = default;
@@ -88,6 +88,7 @@ private:
 	std::wstring m_debugPath;
 	bool m_editor = false;
 	mutable SmallMap< Key, Ref< ShaderGraph > > m_linkerCache;
+	mutable Semaphore m_linkerCacheLock;
 
 	IProgramCompiler* getProgramCompiler() const;
 };
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2025 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -12,6 +12,7 @@
 #include "Core/Log/Log.h"
 #include "Core/Misc/SafeDestroy.h"
 #include "Core/Misc/String.h"
+#include "Core/Thread/JobGraph.h"
 #include "Core/Timer/Profiler.h"
 #include "Render/Context/RenderBlock.h"
 #include "Render/Context/RenderContext.h"
@@ -24,11 +25,17 @@
 #include "Render/IRenderTargetSet.h"
 #include "Render/IRenderView.h"
 
+#define T_USE_BUILD_JOBS
+
 namespace traktor::render
 {
 namespace
 {
 
+// Pass currently being built by calling thread.
+thread_local const RenderGraph* s_buildingGraph = nullptr;
+thread_local uint32_t s_buildingPass = 0;
+
 void traverse(const RefArray< const RenderPass >& passes, int32_t depth, int32_t index, StaticVector< uint32_t, 512 >& chain, const std::function< void(int32_t, int32_t) >& fn)
 {
 	// Check if we're in a cyclic path.
@@ -74,6 +81,7 @@ RenderGraph::RenderGraph(
 	, m_nextResourceId(1)
 	, m_profiler(profiler)
 	, m_ownContext(false)
+	, m_buildJobGraph(new JobGraph())
 {
 }
 
@@ -87,6 +95,7 @@ RenderGraph::RenderGraph(
 	, m_nextResourceId(1)
 	, m_profiler(profiler)
 	, m_ownContext(true)
+	, m_buildJobGraph(new JobGraph())
 {
 }
 
@@ -246,6 +255,18 @@ IRenderTargetSet* RenderGraph::getTargetSet(RGTargetSet resource) const
 {
 	T_FATAL_ASSERT(m_buildingPasses);
 
+	// Resolve targets as they were when pass was scheduled.
+	if (s_buildingGraph == this)
+	{
+		const PassBuild& pb = m_passBuilds[s_buildingPass];
+		for (uint32_t i = pb.targetsOffset; i < pb.targetsOffset + pb.targetsCount; ++i)
+		{
+			if (m_passTargets[i].first == resource)
+				return m_passTargets[i].second;
+		}
+		return nullptr;
+	}
+
 	const auto it = m_targets.find(resource);
 	if (it == m_targets.end() || it->second.targetSet == nullptr)
 		return nullptr;
@@ -288,7 +309,7 @@ bool RenderGraph::validate()
 		else if (output.resourceId != ~0 && output.resourceId != 0)
 		{
 			auto it = m_targets.find(RGTargetSet(output.resourceId));
-			if (it->second.external)
+			if (it != m_targets.end() && it->second.external)
 				roots.push_back(i);
 		}
 		else if (output.resourceId == 0)
@@ -435,6 +456,20 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 		}
 	}
 
+	// Operations on render context are recorded and replayed
+	// after all passes has been built, since passes are built
+	// in parallel into child contexts.
+	m_recording.resize(0);
+	m_passBuilds.resize(0);
+	m_passBuilds.resize(m_passes.size());
+	m_passTargets.resize(0);
+	m_scheduled.resize(0);
+
+	const auto mergeComputeIntoRender = [&]() { m_recording.push_back({ Recording::Type::MergeCompute, nullptr, 0 }); };
+	const auto mergeDrawIntoRender = [&]() { m_recording.push_back({ Recording::Type::MergeDraw, nullptr, 0 }); };
+	const auto direct = [&](RenderBlock* renderBlock) { m_recording.push_back({ Recording::Type::Direct, renderBlock, 0 }); };
+	const auto draw = [&](RenderBlock* renderBlock) { m_recording.push_back({ Recording::Type::Draw, renderBlock, 0 }); };
+
 #if !defined(__ANDROID__) && !defined(__IOS__)
 	double referenceOffset = Profiler::getInstance().getTime();
 
@@ -451,18 +486,18 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 		referenceQueryHandle = queryHandles;
 		passQueryHandles = queryHandles + 1;
 
-		renderContext->direct< ProfileBeginRenderBlock >(referenceQueryHandle);
+		direct(renderContext->alloc< ProfileBeginRenderBlock >(referenceQueryHandle));
 	}
 
 #	define T_PASS_PROFILE_BEGIN() \
 		if (profiling) \
 		{ \
-			renderContext->direct< ProfileBeginRenderBlock >(profiling); \
+			direct(renderContext->alloc< ProfileBeginRenderBlock >(profiling)); \
 		}
 #	define T_PASS_PROFILE_END() \
 		if (profiling) \
 		{ \
-			renderContext->direct< ProfileEndRenderBlock >(profiling); \
+			direct(renderContext->alloc< ProfileEndRenderBlock >(profiling)); \
 			profiling = nullptr; \
 		}
 #	define T_PASS_IS_PROFILING \
@@ -502,9 +537,9 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 						if (currentOutput.resourceId != ~0U)
 						{
 							T_PASS_PROFILE_BEGIN();
-							renderContext->mergeComputeIntoRender();
-							renderContext->mergeDrawIntoRender();
-							renderContext->direct< EndPassRenderBlock >();
+							mergeComputeIntoRender();
+							mergeDrawIntoRender();
+							direct(renderContext->alloc< EndPassRenderBlock >());
 							T_PASS_PROFILE_END();
 
 							if (currentTarget && currentTarget->doubleBuffered)
@@ -514,8 +549,8 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 						{
 							// Profiling of a non-output pass.
 							T_PASS_PROFILE_BEGIN();
-							renderContext->mergeComputeIntoRender();
-							renderContext->mergeDrawIntoRender();
+							mergeComputeIntoRender();
+							mergeDrawIntoRender();
 							T_PASS_PROFILE_END();
 						}
 
@@ -529,6 +564,7 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 								T_ASSERT(!target.external);
 								if (!acquire(target))
 								{
+									replay(renderContext);
 									cleanup();
 									return false;
 								}
@@ -541,7 +577,7 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 								tb->clear = output.clear;
 								tb->load = output.load;
 								tb->store = output.store;
-								renderContext->draw(tb);
+								draw(tb);
 
 								currentTarget = &target;
 								currentOutput = output;
@@ -566,9 +602,9 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 						if (currentOutput.resourceId != ~0U)
 						{
 							T_PASS_PROFILE_BEGIN();
-							renderContext->mergeComputeIntoRender();
-							renderContext->mergeDrawIntoRender();
-							renderContext->direct< EndPassRenderBlock >();
+							mergeComputeIntoRender();
+							mergeDrawIntoRender();
+							direct(renderContext->alloc< EndPassRenderBlock >());
 							T_PASS_PROFILE_END();
 
 							if (currentTarget && currentTarget->doubleBuffered)
@@ -578,8 +614,8 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 						{
 							// Profiling of a non-output pass.
 							T_PASS_PROFILE_BEGIN();
-							renderContext->mergeComputeIntoRender();
-							renderContext->mergeDrawIntoRender();
+							mergeComputeIntoRender();
+							mergeDrawIntoRender();
 							T_PASS_PROFILE_END();
 						}
 						
@@ -587,7 +623,7 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 						tb->clear = output.clear;
 						tb->load = output.load;
 						tb->store = output.store;
-						renderContext->draw(tb);
+						draw(tb);
 
 						currentTarget = nullptr;
 						currentOutput = output;
@@ -597,9 +633,9 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 			else if (currentOutput.resourceId != ~0U)
 			{
 				T_PASS_PROFILE_BEGIN();
-				renderContext->mergeComputeIntoRender();
-				renderContext->mergeDrawIntoRender();
-				renderContext->direct< EndPassRenderBlock >();
+				mergeComputeIntoRender();
+				mergeDrawIntoRender();
+				direct(renderContext->alloc< EndPassRenderBlock >());
 				T_PASS_PROFILE_END();
 
 				if (currentTarget && currentTarget->doubleBuffered)
@@ -612,14 +648,23 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 			{
 				// Profiling of a non-output pass.
 				T_PASS_PROFILE_BEGIN();
-				renderContext->mergeComputeIntoRender();
-				renderContext->mergeDrawIntoRender();
+				mergeComputeIntoRender();
+				mergeDrawIntoRender();
 				T_PASS_PROFILE_END();
 			}
 
-			// Build this pass.
-			T_PROFILER_BEGIN(L"RenderGraph build \"" + pass->getName() + L"\"");
-			m_buildingPasses = true;
+			// Schedule build of this pass; snapshot targets as they are at this point.
+			PassBuild& pb = m_passBuilds[index];
+			pb.targetsOffset = (uint32_t)m_passTargets.size();
+			for (const auto& it : m_targets)
+			{
+				if (it.second.targetSet != nullptr)
+					m_passTargets.push_back({ it.first, it.second.targetSet->getReadTargetSet() });
+			}
+			pb.targetsCount = (uint32_t)m_passTargets.size() - pb.targetsOffset;
+
+			m_recording.push_back({ Recording::Type::Build, nullptr, index });
+			m_scheduled.push_back(index);
 
 #if !defined(__ANDROID__) && !defined(__IOS__)
 			if (m_profiler)
@@ -628,15 +673,6 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 				profiling = &passQueryHandles[index];
 			}
 #endif
-			for (const auto& build : pass->getBuilds())
-			{
-				build(*this, renderContext);
-
-				// Merge all pending priority draws (sorted by depth) after each build step.
-				renderContext->mergePriorityIntoDraw(RenderPriority::All);
-			}
-			m_buildingPasses = false;
-			T_PROFILER_END();
 
 			// Decrement reference counts on input targets; release if last reference.
 			for (const auto& input : inputs)
@@ -661,9 +697,9 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 	if (currentOutput.resourceId != ~0U)
 	{
 		T_PASS_PROFILE_BEGIN();
-		renderContext->mergeComputeIntoRender();
-		renderContext->mergeDrawIntoRender();
-		renderContext->direct< EndPassRenderBlock >();
+		mergeComputeIntoRender();
+		mergeDrawIntoRender();
+		direct(renderContext->alloc< EndPassRenderBlock >());
 		T_PASS_PROFILE_END();
 
 		if (currentTarget && currentTarget->doubleBuffered)
@@ -673,7 +709,7 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 #if !defined(__ANDROID__) && !defined(__IOS__)
 	if (m_profiler)
 	{
-		renderContext->direct< ProfileEndRenderBlock >(referenceQueryHandle);
+		direct(renderContext->alloc< ProfileEndRenderBlock >(referenceQueryHandle));
 
 		// Report all queries last using reference query to calculate offset.
 		int32_t ordinal = 0;
@@ -692,7 +728,7 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 				pr->sink = [=, name = pass->getName(), this](double start, double duration) {
 					m_profiler(ordinal, i, name, start, duration);
 				};
-				renderContext->direct(pr);
+				direct(pr);
 
 				++ordinal;
 			}
@@ -700,6 +736,10 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 	}
 #endif
 
+	// Build all scheduled passes and stitch them into render context.
+	buildPasses(renderContext);
+	replay(renderContext);
+
 	T_FATAL_ASSERT(!renderContext->havePendingComputes());
 	T_FATAL_ASSERT(!renderContext->havePendingDraws());
 
@@ -740,6 +780,125 @@ bool RenderGraph::build(RenderContext* renderContext, int32_t width, int32_t hei
 	return true;
 }
 
+void RenderGraph::buildPasses(RenderContext* renderContext)
+{
+	m_buildingPasses = true;
+
+#if defined(T_USE_BUILD_JOBS)
+	const bool reentrant = std::any_of(m_scheduled.begin(), m_scheduled.end(), [&](uint32_t index) {
+		return m_passes[index]->isReentrant();
+	});
+	if (reentrant)
+	{
+		// Build re-entrant passes in parallel; a pass is only built after all passes,
+		// scheduled before it, which output any of its inputs. Passes which aren't
+		// re-entrant are built one at a time, in scheduled order, since their
+		// build callbacks might modify state shared with other passes.
+		AlignedVector< JobGraph::handle_t > jobs(m_scheduled.size());
+		JobGraph::handle_t serial = ~0U;
+		m_buildJobGraph->reset();
+		for (uint32_t i = 0; i < (uint32_t)m_scheduled.size(); ++i)
+		{
+			const uint32_t index = m_scheduled[i];
+			jobs[i] = m_buildJobGraph->add([=, this]() {
+				buildPass(renderContext, index);
+			});
+			for (const auto& input : m_passes[index]->getInputs())
+			{
+				for (uint32_t j = 0; j < i; ++j)
+				{
+					if (m_passes[m_scheduled[j]]->getOutput().resourceId == input.resourceId)
+						m_buildJobGraph->addDependency(jobs[i], jobs[j]);
+				}
+			}
+			if (!m_passes[index]->isReentrant())
+			{
+				if (serial != ~0U)
+					m_buildJobGraph->addDependency(jobs[i], serial);
+				serial = jobs[i];
+			}
+		}
+		m_buildJobGraph->execute();
+	}
+	else
+	{
+		for (const auto index : m_scheduled)
+			buildPass(renderContext, index);
+	}
+#else
+	for (const auto index : m_scheduled)
+		buildPass(renderContext, index);
+#endif
+
+	m_buildingPasses = false;
+}
+
+void RenderGraph::buildPass(RenderContext* renderContext, uint32_t index)
+{
+	const auto pass = m_passes[index];
+	PassBuild& pb = m_passBuilds[index];
+
+	const RenderGraph* previousGraph = s_buildingGraph;
+	const uint32_t previousPass = s_buildingPass;
+	s_buildingGraph = this;
+	s_buildingPass = index;
+
+	RenderContext* context = renderContext->acquireChild();
+	pb.context = context;
+	pb.from = context->mark();
+
+	T_PROFILER_BEGIN(L"RenderGraph build \"" + pass->getName() + L"\"");
+	for (const auto& build : pass->getBuilds())
+	{
+		build(*this, context);
+
+		// Merge all pending priority draws (sorted by depth) after each build step.
+		context->mergePriorityIntoDraw(RenderPriority::All);
+	}
+	T_PROFILER_END();
+
+	pb.to = context->mark();
+	renderContext->releaseChild(context);
+
+	s_buildingGraph = previousGraph;
+	s_buildingPass = previousPass;
+}
+
+void RenderGraph::replay(RenderContext* renderContext)
+{
+	for (const auto& recording : m_recording)
+	{
+		switch (recording.type)
+		{
+		case Recording::Type::MergeCompute:
+			renderContext->mergeComputeIntoRender();
+			break;
+
+		case Recording::Type::MergeDraw:
+			renderContext->mergeDrawIntoRender();
+			break;
+
+		case Recording::Type::Direct:
+			renderContext->direct(recording.renderBlock);
+			break;
+
+		case Recording::Type::Draw:
+			renderContext->draw(recording.renderBlock);
+			break;
+
+		case Recording::Type::Build:
+			{
+				// Stitch blocks recorded by pass, unless pass never got built.
+				const PassBuild& pb = m_passBuilds[recording.pass];
+				if (pb.context != nullptr)
+					renderContext->append(pb.context, pb.from, pb.to);
+			}
+			break;
+		}
+	}
+	m_recording.resize(0);
+}
+
 bool RenderGraph::realizeTargetDimensions(int32_t width, int32_t height, RGTargetSet targetId)
 {
 	TargetResource& target = m_targets[targetId];
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2025 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,11 +8,13 @@
  */
 #pragma once
 
+#include "Core/Containers/AlignedVector.h"
 #include "Core/Containers/SmallMap.h"
 #include "Core/Containers/StaticSet.h"
 #include "Core/Containers/StaticVector.h"
 #include "Core/Object.h"
 #include "Core/RefArray.h"
+#include "Render/Context/RenderContext.h"
 #include "Render/Frame/RenderGraphTypes.h"
 #include "Render/Frame/RenderPass.h"
 
@@ -28,6 +30,13 @@
 #	define T_DLLCLASS T_DLLIMPORT
 #endif
 
+namespace traktor
+{
+
+class JobGraph;
+
+}
+
 namespace traktor::render
 {
 
@@ -266,7 +275,19 @@ public:
 	 */
 	bool validate();
 
-	/*! */
+	/*! Build render graph into render context.
+	 *
+	 * Passes are scheduled in dependency order on calling thread,
+	 * independent passes are then built in parallel into child
+	 * contexts which are finally stitched in dependency order
+	 * into the render context; the result is identical to building
+	 * all passes serially.
+	 *
+	 * \param renderContext Render context.
+	 * \param width Width of primary target.
+	 * \param height Height of primary target.
+	 * \return True if build succeeded.
+	 */
 	bool build(RenderContext* renderContext, int32_t width, int32_t height);
 
 	/*! */
@@ -282,6 +303,31 @@ public:
 	const RefArray< const RenderPass >& getPasses() const { return m_passes; }
 
 private:
+	struct Recording
+	{
+		enum class Type
+		{
+			MergeCompute,
+			MergeDraw,
+			Direct,
+			Draw,
+			Build
+		};
+
+		Type type;
+		RenderBlock* renderBlock;
+		uint32_t pass;
+	};
+
+	struct PassBuild
+	{
+		RenderContext* context = nullptr;
+		RenderContext::Mark from;
+		RenderContext::Mark to;
+		uint32_t targetsOffset = 0;
+		uint32_t targetsCount = 0;
+	};
+
 	Ref< RenderGraphContext > m_context;
 	SmallMap< RGTargetSet, TargetResource > m_targets;
 	SmallMap< RGBuffer, BufferResource > m_buffers;
@@ -295,6 +341,17 @@ private:
 	fn_profiler_t m_profiler;
 	bool m_buildingPasses = false;
 	bool m_ownContext = false;
+	Ref< JobGraph > m_buildJobGraph;
+	AlignedVector< Recording > m_recording;
+	AlignedVector< PassBuild > m_passBuilds;
+	AlignedVector< std::pair< RGTargetSet, IRenderTargetSet* > > m_passTargets;
+	AlignedVector< uint32_t > m_scheduled;
+
+	void buildPasses(RenderContext* renderContext);
+
+	void buildPass(RenderContext* renderContext, uint32_t index);
+
+	void replay(RenderContext* renderContext);
 
 	bool realizeTargetDimensions(int32_t width, int32_t height, RGTargetSet targetId);
 
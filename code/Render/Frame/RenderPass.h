@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -145,6 +145,19 @@ public:
 
 	const AlignedVector< fn_build_t >& getBuilds() const { return m_builds; }
 
+	/*! Set if build callbacks are re-entrant.
+	 *
+	 * Passes are built one at a time unless they are
+	 * re-entrant; a re-entrant pass only record into its
+	 * render context and read from render graph, thus it
+	 * can be built concurrently with other passes.
+	 *
+	 * \param reentrant True if build callbacks are re-entrant.
+	 */
+	void setReentrant(bool reentrant) { m_reentrant = reentrant; }
+
+	bool isReentrant() const { return m_reentrant; }
+
 	//! \}
 
 	void* operator new(size_t size);
@@ -156,6 +169,7 @@ protected:
 	StaticVector< Input, 16 > m_inputs;
 	Output m_output;
 	AlignedVector< fn_build_t > m_builds;
+	bool m_reentrant = false;
 };
 
 }
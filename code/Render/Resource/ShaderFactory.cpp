@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2025 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -37,8 +37,13 @@ public:
 
 	virtual Ref< ITexture > read(const Guid& textureGuid) const override final
 	{
+		// Stream texture if a placeholder texture has been registered, texture is resolved each
+		// time program is drawn; without placeholder texture must be loaded immediately.
 		resource::Proxy< ITexture > texture;
-		if (m_resourceManager->bind(resource::Id< ITexture >(textureGuid), texture))
+		if (
+			(m_resourceManager->bindAsync(resource::Id< ITexture >(textureGuid), texture, resource::ResourcePriority::Critical) && texture) ||
+			m_resourceManager->bind(resource::Id< ITexture >(textureGuid), texture)
+		)
 			return new TextureProxy(texture);
 		else
 		{
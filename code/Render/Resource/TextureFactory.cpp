@@ -326,6 +326,27 @@ Ref< Object > TextureFactory::create(resource::IResourceManager* resourceManager
 
 void TextureFactory::destroy(Object* resource) const
 {
+	mandatory_non_null_type_cast< ITexture* >(resource)->destroy();
+}
+
+uint64_t TextureFactory::getProductSize(const Object* product) const
+{
+	const ITexture* texture = dynamic_type_cast< const ITexture* >(product);
+	if (!texture)
+		return 0;
+
+	// Texel format isn't known from texture thus estimate
+	// size as if all textures are 32 bits per texel.
+	const ITexture::Size size = texture->getSize();
+	uint64_t productSize = 0;
+	for (int32_t mip = 0; mip < std::max(size.mips, 1); ++mip)
+	{
+		const uint64_t x = std::max(size.x >> mip, 1);
+		const uint64_t y = std::max(size.y >> mip, 1);
+		const uint64_t z = std::max(size.z >> mip, 1);
+		productSize += x * y * z * 4;
+	}
+	return productSize;
 }
 
 }
@@ -51,6 +51,8 @@ public:
 
 	virtual void destroy(Object* resource) const override final;
 
+	virtual uint64_t getProductSize(const Object* product) const override final;
+
 private:
 	Ref< IRenderSystem > m_renderSystem;
 	int32_t m_skipMips = 0;
@@ -0,0 +1,278 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "Render/Test/CaseRenderContext.h"
+
+#include "Core/Containers/AlignedVector.h"
+#include "Core/Io/StringOutputStream.h"
+#include "Core/Math/Random.h"
+#include "Core/Timer/Timer.h"
+#include "Render/Context/RenderBlock.h"
+#include "Render/Context/RenderContext.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace traktor::render::test
+{
+	namespace
+	{
+
+const int32_t c_blockCount = 50000;
+const int32_t c_programCount = 64;
+const int32_t c_iterations = 20;
+
+class OrderRenderBlock : public DrawableRenderBlock
+{
+public:
+	AlignedVector< const DrawableRenderBlock* >* rendered = nullptr;
+
+	virtual void render(IRenderView* renderView) const override final
+	{
+		rendered->push_back(this);
+	}
+};
+
+float quantizedDistance(const DrawableRenderBlock* renderBlock)
+{
+	return std::floor(renderBlock->distance * (1.0f / 10.0f));
+}
+
+void allocateBlocks(RenderContext* renderContext, Random& random, AlignedVector< const DrawableRenderBlock* >& rendered, AlignedVector< DrawableRenderBlock* >& outBlocks)
+{
+	outBlocks.resize(0);
+	for (int32_t i = 0; i < c_blockCount; ++i)
+	{
+		auto rb = renderContext->alloc< OrderRenderBlock >();
+		rb->distance = random.nextFloat() * 1000.0f;
+		rb->program = (IProgram*)(uintptr_t(1 + random.next() % c_programCount) << 6);
+		rb->rendered = &rendered;
+		outBlocks.push_back(rb);
+	}
+}
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.render.test.CaseRenderContext", 0, CaseRenderContext, traktor::test::Case)
+
+void CaseRenderContext::run()
+{
+	Ref< RenderContext > renderContext = new RenderContext(16 * 1024 * 1024);
+	AlignedVector< const DrawableRenderBlock* > rendered;
+	AlignedVector< DrawableRenderBlock* > blocks;
+	Random random;
+
+	// Opaque blocks are sorted front-to-back by quantized distance and grouped by program.
+	{
+		allocateBlocks(renderContext, random, rendered, blocks);
+		for (auto block : blocks)
+			renderContext->draw(RenderPriority::Opaque, block);
+		renderContext->mergePriorityIntoDraw(RenderPriority::All);
+		renderContext->mergeDrawIntoRender();
+
+		rendered.resize(0);
+		renderContext->render(nullptr);
+		renderContext->flush();
+
+		CASE_ASSERT_EQUAL(rendered.size(), (size_t)c_blockCount);
+
+		bool correct = true;
+		for (size_t i = 1; i < rendered.size(); ++i)
+		{
+			const float d0 = quantizedDistance(rendered[i - 1]);
+			const float d1 = quantizedDistance(rendered[i]);
+			if (d0 > d1 || (d0 == d1 && rendered[i - 1]->program > rendered[i]->program))
+				correct = false;
+		}
+		CASE_ASSERT(correct);
+	}
+
+	// Far away blocks must still be sorted front-to-back, each bucket span 10 units.
+	{
+		const float distances[] = { 30035.0f, 30025.0f, 30015.0f, 30005.0f, 250015.0f, 250005.0f };
+		for (uint32_t i = 0; i < sizeof_array(distances); ++i)
+		{
+			auto rb = renderContext->alloc< OrderRenderBlock >();
+			rb->distance = distances[i];
+			rb->program = (IProgram*)(uintptr_t(1 + i) << 6);
+			rb->rendered = &rendered;
+			renderContext->draw(RenderPriority::Opaque, rb);
+		}
+		renderContext->mergePriorityIntoDraw(RenderPriority::All);
+		renderContext->mergeDrawIntoRender();
+
+		rendered.resize(0);
+		renderContext->render(nullptr);
+		renderContext->flush();
+
+		CASE_ASSERT_EQUAL(rendered.size(), sizeof_array(distances));
+
+		bool correct = true;
+		for (size_t i = 1; i < rendered.size(); ++i)
+		{
+			if (rendered[i - 1]->distance > rendered[i]->distance)
+				correct = false;
+		}
+		CASE_ASSERT(correct);
+	}
+
+	// Alpha blended blocks are sorted back-to-front.
+	{
+		allocateBlocks(renderContext, random, rendered, blocks);
+		for (auto block : blocks)
+			renderContext->draw(RenderPriority::AlphaBlend, block);
+		renderContext->mergePriorityIntoDraw(RenderPriority::All);
+		renderContext->mergeDrawIntoRender();
+
+		rendered.resize(0);
+		renderContext->render(nullptr);
+		renderContext->flush();
+
+		CASE_ASSERT_EQUAL(rendered.size(), (size_t)c_blockCount);
+
+		bool correct = true;
+		for (size_t i = 1; i < rendered.size(); ++i)
+		{
+			if (rendered[i - 1]->distance < rendered[i]->distance)
+				correct = false;
+		}
+		CASE_ASSERT(correct);
+	}
+
+	// Compare queue and sort time against comparison sort of block pointers.
+	{
+		double keyTime = 0.0;
+		double predicateTime = 0.0;
+		bool allRendered = true;
+
+		for (int32_t i = 0; i < c_iterations; ++i)
+		{
+			Random r(i);
+			allocateBlocks(renderContext, r, rendered, blocks);
+
+			// Sort pointers using predicate which dereference blocks.
+			Timer timer;
+			AlignedVector< const DrawableRenderBlock* > sorted;
+			for (auto block : blocks)
+				sorted.push_back(block);
+			std::sort(sorted.begin(), sorted.end(), [](const DrawableRenderBlock* lh, const DrawableRenderBlock* rh) {
+				const float d1 = quantizedDistance(lh);
+				const float d2 = quantizedDistance(rh);
+				if (d1 < d2)
+					return true;
+				else if (d1 > d2)
+					return false;
+				return lh->program < rh->program;
+			});
+			predicateTime += timer.getElapsedTime();
+
+			// Queue same blocks with sort keys and merge.
+			timer.reset();
+			for (auto block : blocks)
+				renderContext->draw(RenderPriority::Opaque, block);
+			renderContext->mergePriorityIntoDraw(RenderPriority::All);
+			keyTime += timer.getElapsedTime();
+
+			renderContext->mergeDrawIntoRender();
+			rendered.resize(0);
+			renderContext->render(nullptr);
+			renderContext->flush();
+
+			allRendered &= (rendered.size() == sorted.size());
+		}
+		CASE_ASSERT(allRendered);
+
+		StringOutputStream ss;
+		ss << L"Sort " << c_blockCount << L" opaque blocks; predicate sort " << int32_t(predicateTime * 1000000.0 / c_iterations) << L" us, radix sorted keys " << int32_t(keyTime * 1000000.0 / c_iterations) << L" us";
+		succeeded(ss.str());
+	}
+
+	// Heap grows beyond initial size and shrinks back once usage has decayed.
+	{
+		const uint32_t initialSize = 64 * 1024;
+		Ref< RenderContext > renderContext = new RenderContext(initialSize);
+
+		// Initial chunk might be a larger chunk reused from pool.
+		const uint32_t initialCapacity = renderContext->getCapacity();
+		CASE_ASSERT(initialCapacity >= initialSize);
+
+		bool allWritable = true;
+		AlignedVector< uint8_t* > blocks;
+		for (int32_t i = 0; i < 1000; ++i)
+		{
+			uint8_t* block = (uint8_t*)renderContext->alloc(1024, 64);
+			std::memset(block, uint8_t(i), 1024);
+			allWritable &= ((uintptr_t(block) & 63) == 0);
+			blocks.push_back(block);
+		}
+		// Spike must exceed initial chunk, even if it's a larger chunk reused from pool.
+		const uint32_t largeSize = initialCapacity + 1024 * 1024;
+		uint8_t* large = (uint8_t*)renderContext->alloc(largeSize);
+		std::memset(large, 0xff, largeSize);
+
+		for (int32_t i = 0; i < 1000; ++i)
+			allWritable &= (blocks[i][0] == uint8_t(i) && blocks[i][1023] == uint8_t(i));
+		CASE_ASSERT(allWritable);
+		CASE_ASSERT(renderContext->getAllocatedSize() >= 1000 * 1024 + largeSize);
+		CASE_ASSERT(renderContext->getCapacity() > initialCapacity);
+
+		renderContext->flush();
+		CASE_ASSERT(renderContext->getFrameUsage() >= 1000 * 1024 + largeSize);
+		CASE_ASSERT_EQUAL(renderContext->getAllocatedSize(), 0U);
+
+		// Statistics accumulate usage of all contexts.
+		{
+			Ref< RenderContext > otherContext = new RenderContext(initialSize);
+			(void)otherContext->alloc(1024);
+			otherContext->flush();
+			CASE_ASSERT_EQUAL(otherContext->getFrameUsage(), 1024U);
+
+			RenderContextStatistics stats;
+			RenderContext::getStatistics(stats);
+			CASE_ASSERT(stats.frameUsage >= renderContext->getFrameUsage() + otherContext->getFrameUsage());
+		}
+
+		// Chunks are retained directly after a spike.
+		const uint32_t spikeCapacity = renderContext->getCapacity();
+		CASE_ASSERT(spikeCapacity >= 1000 * 1024 + largeSize);
+
+		for (int32_t i = 0; i < 200; ++i)
+		{
+			(void)renderContext->alloc(1024);
+			renderContext->flush();
+		}
+		CASE_ASSERT(renderContext->getCapacity() <= initialCapacity);
+	}
+
+	// Initial heap much larger than usage is replaced with a smaller chunk.
+	{
+		const uint32_t initialSize = 16 * 1024 * 1024;
+		Ref< RenderContext > renderContext = new RenderContext(initialSize);
+		CASE_ASSERT(renderContext->getCapacity() >= initialSize);
+
+		for (int32_t i = 0; i < 10; ++i)
+		{
+			(void)renderContext->alloc(1024);
+			renderContext->flush();
+		}
+		CASE_ASSERT(renderContext->getCapacity() <= initialSize / 2);
+
+		bool allWritable = true;
+		for (int32_t i = 0; i < 10; ++i)
+		{
+			uint8_t* block = (uint8_t*)renderContext->alloc(64 * 1024);
+			std::memset(block, uint8_t(i), 64 * 1024);
+			allWritable &= (block[0] == uint8_t(i) && block[64 * 1024 - 1] == uint8_t(i));
+			renderContext->flush();
+		}
+		CASE_ASSERT(allWritable);
+	}
+}
+
+}
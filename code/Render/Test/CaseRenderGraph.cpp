@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,10 +8,40 @@
  */
 #include "Render/Test/CaseRenderGraph.h"
 
+#include "Core/Containers/AlignedVector.h"
+#include "Core/Thread/Atomic.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/ThreadManager.h"
+#include "Render/Context/RenderBlock.h"
+#include "Render/Context/RenderContext.h"
 #include "Render/Frame/RenderGraph.h"
 
 namespace traktor::render::test
 {
+	namespace
+	{
+
+class RecordRenderBlock : public RenderBlock
+{
+public:
+	AlignedVector< std::wstring >* recorded = nullptr;
+
+	virtual void render(IRenderView* renderView) const override final
+	{
+		recorded->push_back(name);
+	}
+};
+
+RenderPass::fn_build_t recordBuild(AlignedVector< std::wstring >& outRecorded, const std::wstring& name)
+{
+	return [&outRecorded, name](const RenderGraph&, RenderContext* renderContext) {
+		auto rb = renderContext->allocNamed< RecordRenderBlock >(name);
+		rb->recorded = &outRecorded;
+		renderContext->direct(rb);
+	};
+}
+
+	}
 
 T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.render.test.CaseRenderGraph", 0, CaseRenderGraph, traktor::test::Case)
 
@@ -46,6 +76,112 @@ void CaseRenderGraph::run()
 	rg = nullptr;
 
 	CASE_ASSERT(result);
+
+	// Passes built in parallel must be stitched in same order as if built serially.
+	{
+		Ref< RenderContext > renderContext = new RenderContext(1024 * 1024);
+		AlignedVector< std::wstring > recorded;
+
+		rg = new RenderGraph((IRenderSystem*)nullptr, 0);
+		for (int32_t frame = 0; frame < 2; ++frame)
+		{
+			const RGDependency d1 = rg->addDependency();
+			const RGDependency d2 = rg->addDependency();
+
+			Ref< RenderPass > a = new RenderPass(L"A");
+			a->setOutput(d1);
+			a->addBuild(recordBuild(recorded, L"A0"));
+			a->addBuild(recordBuild(recorded, L"A1"));
+			rg->addPass(a);
+
+			Ref< RenderPass > b = new RenderPass(L"B");
+			b->addInput(d1);
+			b->setOutput(d2);
+			b->addBuild(recordBuild(recorded, L"B"));
+			rg->addPass(b);
+
+			Ref< RenderPass > c = new RenderPass(L"C");
+			c->addBuild(recordBuild(recorded, L"C"));
+			rg->addPass(c);
+
+			Ref< RenderPass > d = new RenderPass(L"D");
+			d->addInput(d2);
+			d->addBuild(recordBuild(recorded, L"D"));
+			rg->addPass(d);
+
+			CASE_ASSERT(rg->validate());
+			CASE_ASSERT(rg->build(renderContext, 64, 64));
+
+			recorded.resize(0);
+			renderContext->render(nullptr);
+			renderContext->flush();
+
+			CASE_ASSERT_EQUAL(recorded.size(), 5);
+			if (recorded.size() == 5)
+			{
+				CASE_ASSERT_EQUAL(recorded[0], L"A0");
+				CASE_ASSERT_EQUAL(recorded[1], L"A1");
+				CASE_ASSERT_EQUAL(recorded[2], L"B");
+				CASE_ASSERT_EQUAL(recorded[3], L"C");
+				CASE_ASSERT_EQUAL(recorded[4], L"D");
+			}
+		}
+
+		rg->destroy();
+		rg = nullptr;
+	}
+
+	// Passes which aren't re-entrant, such as passes sharing entity renderers, must never be built concurrently.
+	{
+		Ref< RenderContext > renderContext = new RenderContext(1024 * 1024);
+		AlignedVector< int32_t > shared;
+		int32_t building = 0;
+		int32_t overlaps = 0;
+
+		auto sharedBuild = [&](int32_t value) {
+			return [&, value](const RenderGraph&, RenderContext*) {
+				if (Atomic::increment(building) != 1)
+					Atomic::increment(overlaps);
+				ThreadManager::getInstance().getCurrentThread()->sleep(1);
+				shared.push_back(value);
+				Atomic::decrement(building);
+			};
+		};
+
+		rg = new RenderGraph((IRenderSystem*)nullptr, 0);
+		for (int32_t frame = 0; frame < 4; ++frame)
+		{
+			shared.resize(0);
+
+			for (int32_t i = 0; i < 8; ++i)
+			{
+				Ref< RenderPass > rp = new RenderPass(L"Shared");
+				rp->addBuild(sharedBuild(i));
+				rg->addPass(rp);
+
+				Ref< RenderPass > rrp = new RenderPass(L"Reentrant");
+				rrp->setReentrant(true);
+				rrp->addBuild([](const RenderGraph&, RenderContext*) {
+					ThreadManager::getInstance().getCurrentThread()->sleep(1);
+				});
+				rg->addPass(rrp);
+			}
+
+			CASE_ASSERT(rg->validate());
+			CASE_ASSERT(rg->build(renderContext, 64, 64));
+			renderContext->flush();
+
+			CASE_ASSERT_EQUAL(overlaps, 0);
+			CASE_ASSERT_EQUAL(shared.size(), 8);
+			bool ordered = true;
+			for (int32_t i = 0; i < (int32_t)shared.size(); ++i)
+				ordered &= (shared[i] == i);
+			CASE_ASSERT(ordered);
+		}
+
+		rg->destroy();
+		rg = nullptr;
+	}
 }
 
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -13,4 +13,9 @@ namespace traktor::resource
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.resource.IResourceFactory", IResourceFactory, Object)
 
+uint64_t IResourceFactory::getProductSize(const Object* product) const
+{
+	return 0;
+}
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -108,6 +108,16 @@ public:
 	 * \param resource Previously created resource by this factory.
 	 */
 	virtual void destroy(Object* resource) const = 0;
+
+	/*! Get size of product.
+	 *
+	 * Used by resource manager to enforce residency budgets;
+	 * should return an estimate of memory held by product.
+	 *
+	 * \param product Product created by this factory.
+	 * \return Size in bytes, 0 if unknown.
+	 */
+	virtual uint64_t getProductSize(const Object* product) const;
 };
 
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -10,6 +10,7 @@
 
 #include "Core/Object.h"
 #include "Core/Guid.h"
+#include "Core/Containers/AlignedVector.h"
 #include "Resource/Id.h"
 #include "Resource/IdProxy.h"
 #include "Resource/Proxy.h"
@@ -29,6 +30,18 @@ class IResourceFactory;
 class ResourceBundle;
 class ResourceHandle;
 
+/*! Resource residency statistics of a product type.
+ * \ingroup Resource
+ */
+struct ResourceTypeStatistics
+{
+	const TypeInfo* productType = nullptr;
+	uint64_t residentSize = 0;		//!< Size in bytes of resident resources.
+	uint64_t budget = 0;			//!< Residency budget in bytes, 0 if unlimited.
+	uint32_t residentCount = 0;		//!< Number of resident resources.
+	uint32_t evictedCount = 0;		//!< Number of resources evicted to stay within budget.
+};
+
 /*! Resource manager statistics.
  * \ingroup Resource
  */
@@ -36,8 +49,25 @@ struct ResourceManagerStatistics
 {
 	uint32_t residentCount = 0;		//!< Number of resident resources.
 	uint32_t exclusiveCount = 0;	//!< Number of exclusive (non-shareable) resources.
+	uint32_t pendingCount = 0;		//!< Number of asynchronously bound resources not yet loaded.
+	AlignedVector< ResourceTypeStatistics > types;	//!< Residency per product type.
 };
 
+/*! Asynchronous bind priorities.
+ * \ingroup Resource
+ *
+ * Resources are loaded in order of descending priority,
+ * any value can be used, ex. negated distance to viewer.
+ */
+namespace ResourcePriority
+{
+
+const float Background = -1000.0f;	//!< Loaded when nothing else is pending.
+const float Normal = 0.0f;			//!< Default priority.
+const float Critical = 1000.0f;		//!< Required before stage can be presented.
+
+}
+
 /*! Resource manager interface.
  * \ingroup Resource
  */
@@ -64,6 +94,10 @@ public:
 	virtual void removeAllFactories() = 0;
 
 	/*! Load all resources in bundle.
+	 *
+	 * Resources are loaded in parallel as critical
+	 * asynchronous resources, returns when all resources
+	 * has been loaded.
 	 *
 	 * \param bundle Resource bundle.
 	 * \return True if all resources loaded successfully.
@@ -78,6 +112,36 @@ public:
 	 */
 	virtual Ref< ResourceHandle > bind(const TypeInfo& productType, const Guid& guid) = 0;
 
+	/*! Bind handle to resource identifier, resource is loaded asynchronously.
+	 *
+	 * Handle is returned immediately; until resource has been
+	 * loaded handle contain placeholder product, if any has
+	 * been registered for product type, or null.
+	 *
+	 * \param productType Type of product.
+	 * \param guid Resource identifier.
+	 * \param priority Load priority, higher priority is loaded first.
+	 * \return Resource handle.
+	 */
+	virtual Ref< ResourceHandle > bindAsync(const TypeInfo& productType, const Guid& guid, float priority) = 0;
+
+	/*! Set placeholder product used while resource is loaded asynchronously.
+	 *
+	 * \param productType Type of product.
+	 * \param placeholder Placeholder product, null to remove placeholder.
+	 */
+	virtual void setPlaceholder(const TypeInfo& productType, Object* placeholder) = 0;
+
+	/*! Wait until asynchronously bound resources has been loaded.
+	 *
+	 * Calling thread help loading pending resources while waiting.
+	 *
+	 * \param minimumPriority Only wait for resources of at least this priority.
+	 * \param timeout Timeout in milliseconds, -1 wait infinitely.
+	 * \return True if all resources of at least given priority has been loaded.
+	 */
+	virtual bool wait(float minimumPriority, int32_t timeout = -1) = 0;
+
 	/*! Reload resource.
 	 *
 	 * \param guid Resource identifier.
@@ -106,6 +170,26 @@ public:
 	 */
 	virtual void unloadUnusedResident() = 0;
 
+	/*! Set residency budget of product type.
+	 *
+	 * When resident resources exceed budget, those which
+	 * have been unused for the longest time are evicted
+	 * in next update(); an evicted resource is reloaded
+	 * when accessed.
+	 *
+	 * \param productType Type of product, budget include all derived product types.
+	 * \param budget Budget in bytes, 0 to remove budget.
+	 */
+	virtual void setBudget(const TypeInfo& productType, uint64_t budget) = 0;
+
+	/*! Update residency.
+	 *
+	 * Advance residency epoch and evict resources
+	 * exceeding budgets, should be called once per frame
+	 * from the same thread which access resource handles.
+	 */
+	virtual void update() = 0;
+
 	/*! Get statistics. */
 	virtual void getStatistics(ResourceManagerStatistics& outStatistics) const = 0;
 
@@ -128,6 +212,27 @@ public:
 		return bool(handle->get() != nullptr);
 	}
 
+	/*! Bind handle to resource identifier, resource is loaded asynchronously.
+	 *
+	 * \param id Resource identifier.
+	 * \param outProxy Resource proxy.
+	 * \param priority Load priority.
+	 * \return True if handle was bound.
+	 */
+	template <
+		typename ResourceType,
+		typename ProductType
+	>
+	bool bindAsync(const Id< ResourceType >& id, Proxy< ProductType >& outProxy, float priority = ResourcePriority::Normal)
+	{
+		Ref< ResourceHandle > handle = bindAsync(type_of< ProductType >(), id, priority);
+		if (!handle)
+			return false;
+
+		outProxy = Proxy< ProductType >(handle);
+		return true;
+	}
+
 	/*! Bind handle to resource identifier.
 	 *
 	 * \param proxy Resource identifier proxy.
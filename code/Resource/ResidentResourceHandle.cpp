@@ -1,11 +1,13 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
+#include "Core/Thread/Acquire.h"
+#include "Resource/IResourceManager.h"
 #include "Resource/ResidentResourceHandle.h"
 
 namespace traktor::resource
@@ -13,10 +15,37 @@ namespace traktor::resource
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.resource.ResidentResourceHandle", ResidentResourceHandle, ResourceHandle)
 
-ResidentResourceHandle::ResidentResourceHandle(const TypeInfo& resourceType, bool persistent)
+ResidentResourceHandle::ResidentResourceHandle(const TypeInfo& resourceType, const Guid& guid, bool persistent)
 :	m_resourceType(resourceType)
+,	m_guid(guid)
 ,	m_persistent(persistent)
 {
 }
 
+Ref< Object > ResidentResourceHandle::evict(IResourceManager* resourceManager)
+{
+	// Set flag before clearing object; accessors which see a null
+	// object must also see flag and wait for resource to be restored.
+	m_resourceManager = resourceManager;
+	m_evicted = true;
+
+	Ref< Object > object = m_object;
+	m_object = nullptr;
+	return object;
+}
+
+void ResidentResourceHandle::restore() const
+{
+	// Concurrent accessors wait until first accessor has
+	// restored resource, flag is cleared once loaded.
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_restoreLock);
+	if (!m_evicted)
+		return;
+
+	if (m_resourceManager)
+		m_resourceManager->bind(m_resourceType, m_guid);
+
+	m_evicted = false;
+}
+
 }
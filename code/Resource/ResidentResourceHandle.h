@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,8 @@
  */
 #pragma once
 
+#include "Core/Guid.h"
+#include "Core/Thread/Semaphore.h"
 #include "Resource/ResourceHandle.h"
 
 // import/export mechanism.
@@ -21,26 +23,45 @@
 namespace traktor::resource
 {
 
+class IResourceManager;
+
 /*! Cached resource handle.
  * \ingroup Resource
  *
  * Cached resource persist in the resource manager
- * thus are never reloaded unless explicitly flushed.
+ * thus are never reloaded unless explicitly flushed
+ * or evicted; evicted resources are reloaded through
+ * the resource manager when accessed.
  */
 class T_DLLCLASS ResidentResourceHandle : public ResourceHandle
 {
 	T_RTTI_CLASS;
 
 public:
-	explicit ResidentResourceHandle(const TypeInfo& type, bool persistent);
+	explicit ResidentResourceHandle(const TypeInfo& type, const Guid& guid, bool persistent);
+
+	/*! Evict resource object.
+	 *
+	 * \param resourceManager Resource manager used to reload resource when accessed.
+	 * \return Evicted resource object.
+	 */
+	Ref< Object > evict(IResourceManager* resourceManager);
 
 	const TypeInfo& getProductType() const { return m_resourceType; }
 
+	const Guid& getGuid() const { return m_guid; }
+
 	bool isPersistent() const { return m_persistent; }
 
+protected:
+	virtual void restore() const override final;
+
 private:
 	const TypeInfo& m_resourceType;
+	Guid m_guid;
 	bool m_persistent;
+	IResourceManager* m_resourceManager = nullptr;
+	mutable Semaphore m_restoreLock;
 };
 
 }
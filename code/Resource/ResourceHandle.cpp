@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -13,4 +13,11 @@ namespace traktor::resource
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.resource.ResourceHandle", ResourceHandle, Object)
 
+std::atomic< uint32_t > ResourceHandle::ms_epoch(0);
+
+void ResourceHandle::restore() const
+{
+	m_evicted = false;
+}
+
 }
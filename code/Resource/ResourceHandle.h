@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include "Core/Object.h"
 #include "Core/Ref.h"
 
@@ -24,6 +25,11 @@ namespace traktor::resource
 
 /*! Resource handle base class.
  * \ingroup Resource
+ *
+ * Each access to the resource object is stamped with
+ * the current residency epoch, which is advanced once per frame
+ * by the resource manager, so the manager can determine
+ * which resources have been unused for the longest time.
  */
 class T_DLLCLASS ResourceHandle : public Object
 {
@@ -34,20 +40,66 @@ public:
 	 *
 	 * \param object New resource object.
 	 */
-	void replace(Object* object) { m_object = object; }
+	void replace(Object* object) { m_object = object; m_evicted = false; }
 
 	/*! Get resource object.
+	 *
+	 * If resource object has been evicted then it's
+	 * reloaded before this method returns.
+	 *
+	 * \return Resource object.
+	 */
+	Object* get() const
+	{
+		touch();
+		if (m_object == nullptr && m_evicted.load(std::memory_order_relaxed))
+			restore();
+		return m_object;
+	}
+
+	/*! Record access to resource object in current residency epoch. */
+	void touch() const
+	{
+		const uint32_t epoch = ms_epoch.load(std::memory_order_relaxed);
+		if (m_lastAccess.load(std::memory_order_relaxed) != epoch)
+			m_lastAccess.store(epoch, std::memory_order_relaxed);
+	}
+
+	/*! Get resource object without recording access or reloading evicted resource.
 	 *
 	 * \return Resource object.
 	 */
-	Object* get() const { return m_object; }
+	Object* peek() const { return m_object; }
 
 	/*! Flush resource object.
 	 */
-	void flush() { m_object = nullptr; }
+	void flush() { m_object = nullptr; m_evicted = false; }
+
+	/*! Check if resource object has been evicted. */
+	bool evicted() const { return m_evicted; }
+
+	/*! Get epoch when resource object was last accessed. */
+	uint32_t getLastAccess() const { return m_lastAccess.load(std::memory_order_relaxed); }
+
+	/*! Get current residency epoch. */
+	static uint32_t getEpoch() { return ms_epoch.load(std::memory_order_relaxed); }
+
+	/*! Advance residency epoch.
+	 *
+	 * \return New epoch.
+	 */
+	static uint32_t advanceEpoch() { return ++ms_epoch; }
 
 protected:
 	mutable Ref< Object > m_object;
+	mutable std::atomic< uint32_t > m_lastAccess = 0;
+	mutable std::atomic< bool > m_evicted = false;
+
+	/*! Reload evicted resource object. */
+	virtual void restore() const;
+
+private:
+	static std::atomic< uint32_t > ms_epoch;
 };
 
 }
@@ -1,16 +1,19 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 #include <algorithm>
+#include <limits>
 #include "Core/Log/Log.h"
 #include "Core/Thread/Acquire.h"
+#include "Core/Thread/JobManager.h"
 #include "Core/Thread/Thread.h"
 #include "Core/Thread/ThreadManager.h"
+#include "Core/Timer/Timer.h"
 #include "Database/Database.h"
 #include "Database/Instance.h"
 #include "Resource/ExclusiveResourceHandle.h"
@@ -21,11 +24,31 @@
 
 namespace traktor::resource
 {
+	namespace
+	{
+
+const uint32_t c_evictAge = 2;	//!< Number of epochs resource must be unused before it can be evicted.
+
+struct RequestLess
+{
+	template < typename RequestType >
+	bool operator () (const RequestType& lh, const RequestType& rh) const
+	{
+		// Max heap on priority, requests of same priority are loaded in order of binding.
+		if (lh.priority != rh.priority)
+			return lh.priority < rh.priority;
+		return lh.sequence > rh.sequence;
+	}
+};
+
+	}
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.resource.ResourceManager", ResourceManager, IResourceManager)
 
 ResourceManager::ResourceManager(db::Database* database, bool verbose)
 :	m_database(database)
+,	m_queueJobs(0)
+,	m_sequence(0)
 ,	m_verbose(verbose)
 {
 }
@@ -37,6 +60,15 @@ ResourceManager::~ResourceManager()
 
 void ResourceManager::destroy()
 {
+	// Drop pending requests and wait until all loading jobs has finished.
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+		m_queue.clear();
+		m_queued.clear();
+	}
+	while (m_queueJobs > 0)
+		ThreadManager::getInstance().getCurrentThread()->yield();
+
 	for (auto& residentHandle : m_residentHandles)
 		residentHandle.second->replace(nullptr);
 
@@ -50,6 +82,13 @@ void ResourceManager::destroy()
 	m_resourceFactories.clear();
 	m_residentHandles.clear();
 	m_exclusiveHandles.clear();
+	m_placeholders.clear();
+
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_residencyLock);
+		m_residency.clear();
+		m_resident.clear();
+	}
 }
 
 void ResourceManager::addFactory(const IResourceFactory* factory)
@@ -74,151 +113,141 @@ void ResourceManager::removeAllFactories()
 
 bool ResourceManager::load(const ResourceBundle* bundle)
 {
-	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
-	for (const auto& resource : bundle->get())
+	RefArray< ResidentResourceHandle > pending;
+
+	// Queue all resources in bundle as critical; they are loaded in parallel
+	// on the job system while calling thread help loading them.
 	{
-		// Get resource instance from database.
-		Ref< db::Instance > instance = m_database->getInstance(resource.second);
-		if (!instance)
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+		for (const auto& resource : bundle->get())
 		{
-			log::error << L"Unable to preload resource " << resource.second.format() << L"; no such instance." << Endl;
-			return false;
-		}
+			// Get resource instance from database.
+			Ref< db::Instance > instance = m_database->getInstance(resource.second);
+			if (!instance)
+			{
+				log::error << L"Unable to preload resource " << resource.second.format() << L"; no such instance." << Endl;
+				return false;
+			}
 
-		// Get type of resource.
-		const TypeInfo* resourceType = instance->getPrimaryType();
-		if (!resourceType)
-		{
-			log::error << L"Unable to preload resource " << resource.second.format() << L"; unable to read resource type." << Endl;
-			return false;
-		}
+			// Get type of resource.
+			const TypeInfo* resourceType = instance->getPrimaryType();
+			if (!resourceType)
+			{
+				log::error << L"Unable to preload resource " << resource.second.format() << L"; unable to read resource type." << Endl;
+				return false;
+			}
 
-		// Find factory which can create products from resource.
-		const IResourceFactory* factory = findFactory(*resourceType);
-		if (!factory)
-		{
-			log::error << L"Unable to preload resource " << resource.second.format() << L"; no factory for specified resource type \"" << resourceType->getName() << L"\"." << Endl;
-			return false;
-		}
+			// Find factory which can create products from resource.
+			const IResourceFactory* factory = findFactory(*resourceType);
+			if (!factory)
+			{
+				log::error << L"Unable to preload resource " << resource.second.format() << L"; no factory for specified resource type \"" << resourceType->getName() << L"\"." << Endl;
+				return false;
+			}
 
-		// Determine product type; must be explicitly determined if we can safely preload the resource.
-		const TypeInfoSet productTypes = factory->getProductTypes(*resourceType);
-		if (productTypes.size() != 1)
-		{
-			log::warning << L"Unable to preload resource " << resource.second.format() << L"; unable to determine product type, skipped." << Endl;
-			continue;
-		}
+			// Determine product type; must be explicitly determined if we can safely preload the resource.
+			const TypeInfoSet productTypes = factory->getProductTypes(*resourceType);
+			if (productTypes.size() != 1)
+			{
+				log::warning << L"Unable to preload resource " << resource.second.format() << L"; unable to determine product type, skipped." << Endl;
+				continue;
+			}
 
-		const bool cacheable = factory->isCacheable(*resource.first);
-		if (!cacheable)
-		{
-			log::warning << L"Unable to preload resource " << resource.second.format() << L"; resource non cacheable, skipped." << Endl;
-			continue;
-		}
+			const bool cacheable = factory->isCacheable(*resource.first);
+			if (!cacheable)
+			{
+				log::warning << L"Unable to preload resource " << resource.second.format() << L"; resource non cacheable, skipped." << Endl;
+				continue;
+			}
 
-		Ref< ResidentResourceHandle > residentHandle = m_residentHandles[resource.second];
-		if (residentHandle == nullptr || residentHandle->get() == nullptr)
-		{
 			const TypeInfo& productType = *(*productTypes.begin());
 
+			Ref< ResidentResourceHandle > residentHandle = m_residentHandles[resource.second];
 			if (!residentHandle)
 			{
-				residentHandle = new ResidentResourceHandle(productType, bundle->persistent());
+				residentHandle = new ResidentResourceHandle(productType, resource.second, bundle->persistent());
 				m_residentHandles[resource.second] = residentHandle;
 			}
 
-			load(instance, factory, productType, residentHandle);
-
-			if (!residentHandle->get())
-			{
-				log::error << L"Unable to preload resource " << resource.second.format() << L"; skipped." << Endl;
-				continue;
-			}
+			// Already loaded resources are not queued, already queued are re-prioritized.
+			queue(instance, factory, productType, residentHandle, ResourcePriority::Critical);
+			pending.push_back(residentHandle);
 		}
 	}
 
+	wait(ResourcePriority::Critical, -1);
+
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+	for (auto residentHandle : pending)
+	{
+		Object* current = residentHandle->peek();
+		if (current == nullptr || isPlaceholder(residentHandle->getProductType(), current))
+			log::error << L"Unable to preload resource " << residentHandle->getGuid().format() << L"; skipped." << Endl;
+	}
+
 	return true;
 }
 
 Ref< ResourceHandle > ResourceManager::bind(const TypeInfo& productType, const Guid& guid)
 {
-	Ref< ResourceHandle > handle;
+	Ref< db::Instance > instance;
+	const IResourceFactory* factory = nullptr;
 
-	if (guid.isNull() || !guid.isValid())
-	{
-		if (!guid.isNull())
-			log::error << L"Unable to bind a " << productType.getName() << L" resource; invalid id." << Endl;
+	Ref< ResourceHandle > handle = acquireHandle(productType, guid, instance, factory);
+	if (!handle)
 		return nullptr;
-	}
 
-	// Get resource instance from database.
-	Ref< db::Instance > instance = m_database->getInstance(guid);
-	if (!instance)
-	{
-		log::error << L"Unable to bind a " << productType.getName() << L" resource; no such instance (" << guid.format() << L")." << Endl;
-		return nullptr;
-	}
+	// If no resource loaded into handle then load resource through factory.
+	loadOnce(instance, factory, productType, handle);
+	return handle;
+}
 
-	// Get type of resource.
-	const TypeInfo* resourceType = instance->getPrimaryType();
-	if (!resourceType)
-	{
-		log::error << L"Unable to bind a " << productType.getName() << L" resource; unable to read resource type (" << guid.format() << L")." << Endl;
-		return nullptr;
-	}
+Ref< ResourceHandle > ResourceManager::bindAsync(const TypeInfo& productType, const Guid& guid, float priority)
+{
+	Ref< db::Instance > instance;
+	const IResourceFactory* factory = nullptr;
 
-	// Find factory which can create products from resource.
-	const IResourceFactory* factory = findFactory(*resourceType);
-	if (!factory)
-	{
-		log::error << L"Unable to bind a " << productType.getName() << L" resource; no factory for instance type \"" << resourceType->getName() << L"\" (" << guid.format() << L")." << Endl;
+	Ref< ResourceHandle > handle = acquireHandle(productType, guid, instance, factory);
+	if (!handle)
 		return nullptr;
-	}
 
-	// Create resource handle.
-	const bool cacheable = factory->isCacheable(productType);
-	if (cacheable)
-	{
-		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
-		auto it = m_residentHandles.find(guid);
-		if (it != m_residentHandles.end())
-			handle = it->second;
-		else
-		{
-			Ref< ResidentResourceHandle > residentHandle = new ResidentResourceHandle(productType, false);
-			m_residentHandles[guid] = residentHandle;
-			handle = residentHandle;
-		}
-	}
-	else
-	{
-		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
-		RefArray< ExclusiveResourceHandle >& handles = m_exclusiveHandles[guid];
+	queue(instance, factory, productType, handle, priority);
+	return handle;
+}
 
-		// First try to reuse handles which are no longer in use.
-		for (auto h : handles)
-		{
-			if (!h->get())
-			{
-				handle = h;
-				break;
-			}
-		}
+void ResourceManager::setPlaceholder(const TypeInfo& productType, Object* placeholder)
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+	if (placeholder)
+		m_placeholders[&productType] = placeholder;
+	else
+		m_placeholders.remove(&productType);
+}
 
-		if (!handle)
+bool ResourceManager::wait(float minimumPriority, int32_t timeout)
+{
+	Timer timer;
+	for (;;)
+	{
+		bool pending = false;
 		{
-			Ref< ExclusiveResourceHandle > exclusiveHandle = new ExclusiveResourceHandle(productType);
-			handles.push_back(exclusiveHandle);
-			handle = exclusiveHandle;
+			T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+			for (const auto& queued : m_queued)
+				pending |= (queued.second >= minimumPriority);
+			for (const auto& loading : m_loading)
+				pending |= (loading.second >= minimumPriority);
 		}
-	}
-	T_ASSERT(handle);
+		if (!pending)
+			return true;
 
-	// If no resource loaded into handle then load resource through factory.
-	if (!handle->get())
-		load(instance, factory, productType, handle);
+		if (timeout >= 0 && timer.getElapsedTime() * 1000.0 >= timeout)
+			return false;
 
-	return handle;
+		// Help loading instead of idle waiting; if nothing left to load
+		// then wait for other threads to finish.
+		if (!loadQueued(minimumPriority))
+			m_loadedEvent.wait(10);
+	}
 }
 
 bool ResourceManager::reload(const Guid& guid, bool flushedOnly)
@@ -249,7 +278,7 @@ bool ResourceManager::reload(const Guid& guid, bool flushedOnly)
 	if (i1 != m_residentHandles.end())
 	{
 		const TypeInfo& productType = i1->second->getProductType();
-		if (!flushedOnly || i1->second->get() == nullptr)
+		if (!flushedOnly || i1->second->peek() == nullptr)
 		{
 			load(instance, factory, productType, i1->second);
 			loaded = true;
@@ -262,7 +291,7 @@ bool ResourceManager::reload(const Guid& guid, bool flushedOnly)
 		for (auto handle : i0->second)
 		{
 			const TypeInfo& productType = handle->getProductType();
-			if (!flushedOnly || handle->get() == nullptr)
+			if (!flushedOnly || handle->peek() == nullptr)
 			{
 				load(instance, factory, productType, handle);
 				loaded = true;
@@ -300,7 +329,7 @@ void ResourceManager::reload(const TypeInfo& productType, bool flushedOnly)
 			const TypeInfo& handleProductType = handle->getProductType();
 			if (is_type_of(productType, handleProductType))
 			{
-				if (!flushedOnly || handle->get() == nullptr)
+				if (!flushedOnly || handle->peek() == nullptr)
 				{
 					load(instance, factory, handleProductType, handle);
 				}
@@ -328,7 +357,7 @@ void ResourceManager::reload(const TypeInfo& productType, bool flushedOnly)
 			if (!factory)
 				continue;
 
-			if (!flushedOnly || i->second->get() == nullptr)
+			if (!flushedOnly || i->second->peek() == nullptr)
 			{
 				load(instance, factory, handleProductType, i->second);
 			}
@@ -350,7 +379,10 @@ void ResourceManager::unload(const TypeInfo& productType)
 	for (auto& pair : m_residentHandles)
 	{
 		if (is_type_of(productType, pair.second->getProductType()))
+		{
 			pair.second->flush();
+			removeResident(pair.second);
+		}
 	}
 }
 
@@ -362,16 +394,32 @@ void ResourceManager::unloadUnusedResident()
 		if (
 			!pair.second->isPersistent() &&
 			pair.second->getReferenceCount() <= 1 &&
-			pair.second->get() != nullptr
+			pair.second->peek() != nullptr
 		)
 		{
 			if (m_verbose)
-				log::info << L"Unloading resource \"" << pair.first.format() << L"\" (" << type_name(pair.second->get()) << L")." << Endl;
+				log::info << L"Unloading resource \"" << pair.first.format() << L"\" (" << type_name(pair.second->peek()) << L")." << Endl;
 			pair.second->replace(nullptr);
+			removeResident(pair.second);
 		}
 	}
 }
 
+void ResourceManager::setBudget(const TypeInfo& productType, uint64_t budget)
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_residencyLock);
+	if (budget > 0)
+		m_budgets[&productType] = budget;
+	else
+		m_budgets.remove(&productType);
+}
+
+void ResourceManager::update()
+{
+	ResourceHandle::advanceEpoch();
+	enforceBudgets();
+}
+
 void ResourceManager::getStatistics(ResourceManagerStatistics& outStatistics) const
 {
 	if (!m_lock.wait(0))
@@ -380,7 +428,7 @@ void ResourceManager::getStatistics(ResourceManagerStatistics& outStatistics) co
 	outStatistics.residentCount = 0;
 	for (auto i = m_residentHandles.begin(); i != m_residentHandles.end(); ++i)
 	{
-		if (i->second->get() != nullptr)
+		if (i->second->peek() != nullptr)
 			++outStatistics.residentCount;
 	}
 
@@ -395,6 +443,30 @@ void ResourceManager::getStatistics(ResourceManagerStatistics& outStatistics) co
 	}
 
 	m_lock.release();
+
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+		outStatistics.pendingCount = uint32_t(m_queued.size() + m_loading.size());
+	}
+
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_residencyLock);
+	outStatistics.types.resize(0);
+	for (const auto& residency : m_residency)
+	{
+		ResourceTypeStatistics& ts = outStatistics.types.push_back();
+		ts.productType = residency.first;
+		ts.residentSize = residency.second.size;
+		ts.residentCount = residency.second.count;
+		ts.evictedCount = residency.second.evicted;
+		for (const auto& budget : m_budgets)
+		{
+			if (is_type_of(*budget.first, *residency.first))
+			{
+				ts.budget = budget.second;
+				break;
+			}
+		}
+	}
 }
 
 const IResourceFactory* ResourceManager::findFactory(const TypeInfo& resourceType) const
@@ -407,6 +479,211 @@ const IResourceFactory* ResourceManager::findFactory(const TypeInfo& resourceTyp
 	return nullptr;
 }
 
+Ref< ResourceHandle > ResourceManager::acquireHandle(const TypeInfo& productType, const Guid& guid, Ref< db::Instance >& outInstance, const IResourceFactory*& outFactory)
+{
+	Ref< ResourceHandle > handle;
+
+	if (guid.isNull() || !guid.isValid())
+	{
+		if (!guid.isNull())
+			log::error << L"Unable to bind a " << productType.getName() << L" resource; invalid id." << Endl;
+		return nullptr;
+	}
+
+	// Get resource instance from database.
+	outInstance = m_database->getInstance(guid);
+	if (!outInstance)
+	{
+		log::error << L"Unable to bind a " << productType.getName() << L" resource; no such instance (" << guid.format() << L")." << Endl;
+		return nullptr;
+	}
+
+	// Get type of resource.
+	const TypeInfo* resourceType = outInstance->getPrimaryType();
+	if (!resourceType)
+	{
+		log::error << L"Unable to bind a " << productType.getName() << L" resource; unable to read resource type (" << guid.format() << L")." << Endl;
+		return nullptr;
+	}
+
+	// Find factory which can create products from resource.
+	outFactory = findFactory(*resourceType);
+	if (!outFactory)
+	{
+		log::error << L"Unable to bind a " << productType.getName() << L" resource; no factory for instance type \"" << resourceType->getName() << L"\" (" << guid.format() << L")." << Endl;
+		return nullptr;
+	}
+
+	// Create resource handle.
+	const bool cacheable = outFactory->isCacheable(productType);
+	if (cacheable)
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+		auto it = m_residentHandles.find(guid);
+		if (it != m_residentHandles.end())
+			handle = it->second;
+		else
+		{
+			Ref< ResidentResourceHandle > residentHandle = new ResidentResourceHandle(productType, guid, false);
+			m_residentHandles[guid] = residentHandle;
+			handle = residentHandle;
+		}
+	}
+	else
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+		RefArray< ExclusiveResourceHandle >& handles = m_exclusiveHandles[guid];
+
+		// First try to reuse handles which are no longer in use; handles
+		// which are pending asynchronous load are already in use.
+		{
+			T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+			for (auto h : handles)
+			{
+				if (!h->peek() && m_queued.find(h) == m_queued.end() && m_loading.find(h) == m_loading.end())
+				{
+					handle = h;
+					break;
+				}
+			}
+		}
+
+		if (!handle)
+		{
+			Ref< ExclusiveResourceHandle > exclusiveHandle = new ExclusiveResourceHandle(productType);
+			handles.push_back(exclusiveHandle);
+			handle = exclusiveHandle;
+		}
+	}
+
+	T_ASSERT(handle);
+	return handle;
+}
+
+bool ResourceManager::isPlaceholder(const TypeInfo& productType, const Object* object) const
+{
+	auto it = m_placeholders.find(&productType);
+	return it != m_placeholders.end() && it->second == object;
+}
+
+void ResourceManager::loadOnce(const db::Instance* instance, const IResourceFactory* factory, const TypeInfo& productType, ResourceHandle* handle)
+{
+	for (;;)
+	{
+		{
+			T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+			if (m_loading.find(handle) == m_loading.end())
+			{
+				// Nothing to do if resource already loaded and not queued for loading.
+				const bool queued = m_queued.remove(handle);
+				Object* current = handle->peek();
+				if (!queued && current != nullptr && !isPlaceholder(productType, current))
+					return;
+
+				// Claim resource, stale request in queue is skipped.
+				m_loading.insert(handle, ResourcePriority::Critical);
+				break;
+			}
+		}
+
+		// Resource is being loaded by another thread; wait until it's finished.
+		m_loadedEvent.wait(10);
+	}
+
+	load(instance, factory, productType, handle);
+
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+		m_loading.remove(handle);
+	}
+	m_loadedEvent.broadcast();
+}
+
+void ResourceManager::queue(const db::Instance* instance, const IResourceFactory* factory, const TypeInfo& productType, ResourceHandle* handle, float priority)
+{
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+
+		// Already loaded or being loaded by another thread.
+		Object* current = handle->peek();
+		if (current != nullptr && !isPlaceholder(productType, current))
+			return;
+		if (m_loading.find(handle) != m_loading.end())
+			return;
+
+		// Put placeholder into handle until resource has been loaded.
+		if (current == nullptr)
+		{
+			auto it = m_placeholders.find(&productType);
+			if (it != m_placeholders.end())
+				handle->replace(it->second);
+		}
+
+		// Queue request; if already queued with lower priority
+		// then old request is ignored when popped.
+		auto it = m_queued.find(handle);
+		if (it != m_queued.end())
+		{
+			if (it->second >= priority)
+				return;
+			it->second = priority;
+		}
+		else
+			m_queued.insert(handle, priority);
+
+		Request& request = m_queue.push_back();
+		request.handle = handle;
+		request.instance = instance;
+		request.factory = factory;
+		request.productType = &productType;
+		request.priority = priority;
+		request.sequence = m_sequence++;
+		std::push_heap(m_queue.begin(), m_queue.end(), RequestLess());
+	}
+
+	// Each request spawn a job which load the most prioritized queued resource.
+	++m_queueJobs;
+	JobManager::getInstance().add([this]() {
+		loadQueued(-std::numeric_limits< float >::max());
+		--m_queueJobs;
+	});
+}
+
+bool ResourceManager::loadQueued(float minimumPriority)
+{
+	Request request;
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+		for (;;)
+		{
+			if (m_queue.empty() || m_queue.front().priority < minimumPriority)
+				return false;
+
+			std::pop_heap(m_queue.begin(), m_queue.end(), RequestLess());
+			request = m_queue.back();
+			m_queue.pop_back();
+
+			// Skip stale requests, ie. resource already claimed or re-queued with higher priority.
+			auto it = m_queued.find(request.handle);
+			if (it == m_queued.end() || it->second != request.priority)
+				continue;
+
+			m_queued.erase(it);
+			m_loading.insert(request.handle, request.priority);
+			break;
+		}
+	}
+
+	load(request.instance, request.factory, *request.productType, request.handle);
+
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+		m_loading.remove(request.handle);
+	}
+	m_loadedEvent.broadcast();
+	return true;
+}
+
 void ResourceManager::load(const db::Instance* instance, const IResourceFactory* factory, const TypeInfo& productType, ResourceHandle* handle)
 {
 	Thread* currentThread = ThreadManager::getInstance().getCurrentThread();
@@ -420,7 +697,16 @@ void ResourceManager::load(const db::Instance* instance, const IResourceFactory*
 		return;
 	}
 
-	Ref< Object > object = factory->create(this, m_database, instance, productType, handle->get());
+	// Placeholder products are never passed to, or destroyed by, factory.
+	Object* current = handle->peek();
+	if (current != nullptr)
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+		if (isPlaceholder(productType, current))
+			current = nullptr;
+	}
+
+	Ref< Object > object = factory->create(this, m_database, instance, productType, current);
 	if (object)
 	{
 		if (m_verbose)
@@ -428,10 +714,16 @@ void ResourceManager::load(const db::Instance* instance, const IResourceFactory*
 
 		// In case resource gets reloaded; call factory to do specialized cleanup of old resource before
 		// replacing resource in handle.
-		if (handle->get() != nullptr)
-			factory->destroy(handle->get());
+		if (current != nullptr)
+			factory->destroy(current);
 
 		handle->replace(object);
+		handle->touch();
+
+		// Account size of resident resources; loads can run on worker threads concurrently with
+		// handle access thus budgets are only enforced in update().
+		if (auto residentHandle = dynamic_type_cast< ResidentResourceHandle* >(handle))
+			addResident(residentHandle, factory, factory->getProductSize(object));
 
 		// Yield current thread; we want other threads to get some periodic CPU time to
 		// render loading screens etc.
@@ -441,4 +733,111 @@ void ResourceManager::load(const db::Instance* instance, const IResourceFactory*
 		log::error << L"Unable to create resource \"" << instance->getGuid().format() << L"\" (" << productType.getName() << L") using factory \"" << type_name(factory) << L"\"." << Endl;
 }
 
+void ResourceManager::addResident(ResidentResourceHandle* handle, const IResourceFactory* factory, uint64_t size)
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_residencyLock);
+	Residency& residency = m_residency[&handle->getProductType()];
+	auto it = m_resident.find(handle);
+	if (it != m_resident.end())
+		residency.size -= it->second.size;
+	else
+		residency.count++;
+	Resident& resident = m_resident[handle];
+	resident.factory = factory;
+	resident.size = size;
+	residency.size += size;
+}
+
+void ResourceManager::removeResident(ResidentResourceHandle* handle)
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_residencyLock);
+	auto it = m_resident.find(handle);
+	if (it == m_resident.end())
+		return;
+
+	Residency& residency = m_residency[&handle->getProductType()];
+	residency.size -= it->second.size;
+	residency.count--;
+	m_resident.erase(it);
+}
+
+void ResourceManager::enforceBudgets()
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_residencyLock);
+
+	const uint32_t epoch = ResourceHandle::getEpoch();
+	AlignedVector< std::pair< ResidentResourceHandle*, uint64_t > > candidates;
+
+	for (const auto& budget : m_budgets)
+	{
+		uint64_t usage = 0;
+		for (const auto& residency : m_residency)
+		{
+			if (is_type_of(*budget.first, *residency.first))
+				usage += residency.second.size;
+		}
+		if (usage <= budget.second)
+			continue;
+
+		// Gather resources which can be evicted; resources accessed in
+		// recent epochs might still be referenced by frames in flight.
+		candidates.resize(0);
+		{
+			T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_queueLock);
+			for (const auto& resident : m_resident)
+			{
+				// Product which is referenced elsewhere isn't released by
+				// evicting it, and would be duplicated when restored.
+				ResidentResourceHandle* handle = resident.first;
+				const Object* product = handle->peek();
+				if (
+					resident.second.size == 0 ||
+					product == nullptr ||
+					product->getReferenceCount() > 1 ||
+					handle->isPersistent() ||
+					epoch - handle->getLastAccess() < c_evictAge ||
+					!is_type_of(*budget.first, handle->getProductType()) ||
+					m_queued.find(handle) != m_queued.end() ||
+					m_loading.find(handle) != m_loading.end()
+				)
+					continue;
+				candidates.push_back({ handle, resident.second.size });
+			}
+		}
+
+		// Evict least recently used first, larger resources first if used at the same time.
+		std::sort(candidates.begin(), candidates.end(), [](const std::pair< ResidentResourceHandle*, uint64_t >& lh, const std::pair< ResidentResourceHandle*, uint64_t >& rh) {
+			const uint32_t la = lh.first->getLastAccess();
+			const uint32_t ra = rh.first->getLastAccess();
+			if (la != ra)
+				return la < ra;
+			return lh.second > rh.second;
+		});
+
+		for (const auto& candidate : candidates)
+		{
+			if (usage <= budget.second)
+				break;
+
+			ResidentResourceHandle* handle = candidate.first;
+			if (m_verbose)
+				log::info << L"Evicting resource \"" << handle->getGuid().format() << L"\" (" << type_name(handle->peek()) << L"), " << candidate.second << L" bytes." << Endl;
+
+			// Let factory release product's resources directly, handle held last reference.
+			Ref< const IResourceFactory > factory = m_resident[handle].factory;
+			Ref< Object > product = handle->evict(this);
+			if (factory && product)
+				factory->destroy(product);
+
+			Residency& residency = m_residency[&handle->getProductType()];
+			residency.size -= candidate.second;
+			residency.count--;
+			residency.evicted++;
+
+			m_resident.remove(handle);
+			usage -= candidate.second;
+		}
+	}
+}
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,9 +8,11 @@
  */
 #pragma once
 
+#include <atomic>
 #include <utility>
 #include "Core/RefArray.h"
 #include "Core/Containers/SmallMap.h"
+#include "Core/Thread/Event.h"
 #include "Core/Thread/Semaphore.h"
 #include "Resource/IResourceManager.h"
 
@@ -39,6 +41,11 @@ class ResourceHandle;
 
 /*! Resource manager.
  * \ingroup Resource
+ *
+ * Asynchronously bound resources are queued by priority
+ * and loaded on the job system; a resource is only ever
+ * loaded by one thread at a time, binding a resource which
+ * is being loaded by another thread wait until it's loaded.
  */
 class T_DLLCLASS ResourceManager : public IResourceManager
 {
@@ -61,6 +68,12 @@ public:
 
 	virtual Ref< ResourceHandle > bind(const TypeInfo& productType, const Guid& guid) override final;
 
+	virtual Ref< ResourceHandle > bindAsync(const TypeInfo& productType, const Guid& guid, float priority) override final;
+
+	virtual void setPlaceholder(const TypeInfo& productType, Object* placeholder) override final;
+
+	virtual bool wait(float minimumPriority, int32_t timeout) override final;
+
 	virtual bool reload(const Guid& guid, bool flushedOnly) override final;
 
 	virtual void reload(const TypeInfo& productType, bool flushedOnly) override final;
@@ -69,19 +82,78 @@ public:
 
 	virtual void unloadUnusedResident() override final;
 
+	virtual void setBudget(const TypeInfo& productType, uint64_t budget) override final;
+
+	virtual void update() override final;
+
 	virtual void getStatistics(ResourceManagerStatistics& outStatistics) const override final;
 
 private:
+	struct Request
+	{
+		Ref< ResourceHandle > handle;
+		Ref< const db::Instance > instance;
+		Ref< const IResourceFactory > factory;
+		const TypeInfo* productType;
+		float priority;
+		uint32_t sequence;
+	};
+
+	struct Resident
+	{
+		Ref< const IResourceFactory > factory;
+		uint64_t size = 0;
+	};
+
+	struct Residency
+	{
+		uint64_t size = 0;
+		uint32_t count = 0;
+		uint32_t evicted = 0;
+	};
+
 	Ref< db::Database > m_database;
 	AlignedVector< std::pair< const TypeInfo*, Ref< const IResourceFactory > > > m_resourceFactories;
 	SmallMap< Guid, Ref< ResidentResourceHandle > > m_residentHandles;
 	SmallMap< Guid, RefArray< ExclusiveResourceHandle > > m_exclusiveHandles;
+	SmallMap< const TypeInfo*, Ref< Object > > m_placeholders;
 	mutable Semaphore m_lock;
+	AlignedVector< Request > m_queue;
+	SmallMap< const ResourceHandle*, float > m_queued;
+	SmallMap< const ResourceHandle*, float > m_loading;
+	mutable Semaphore m_queueLock;
+	Event m_loadedEvent;
+	std::atomic< int32_t > m_queueJobs;
+	uint32_t m_sequence;
+	SmallMap< const TypeInfo*, uint64_t > m_budgets;
+	SmallMap< const TypeInfo*, Residency > m_residency;
+	SmallMap< ResidentResourceHandle*, Resident > m_resident;
+	mutable Semaphore m_residencyLock;
 	bool m_verbose;
 
 	const IResourceFactory* findFactory(const TypeInfo& resourceType) const;
 
+	Ref< ResourceHandle > acquireHandle(const TypeInfo& productType, const Guid& guid, Ref< db::Instance >& outInstance, const IResourceFactory*& outFactory);
+
+	bool isPlaceholder(const TypeInfo& productType, const Object* object) const;
+
+	/*! Load resource unless already loaded, waits if resource is being loaded by another thread. */
+	void loadOnce(const db::Instance* instance, const IResourceFactory* factory, const TypeInfo& productType, ResourceHandle* handle);
+
+	/*! Queue resource for asynchronous load, placeholder is put into handle until it's loaded. */
+	void queue(const db::Instance* instance, const IResourceFactory* factory, const TypeInfo& productType, ResourceHandle* handle, float priority);
+
+	/*! Load queued resource with highest priority, if any. */
+	bool loadQueued(float minimumPriority);
+
 	void load(const db::Instance* instance, const IResourceFactory* factory, const TypeInfo& productType, ResourceHandle* handle);
+
+	void addResident(ResidentResourceHandle* handle, const IResourceFactory* factory, uint64_t size);
+
+	void removeResident(ResidentResourceHandle* handle);
+
+	/*! Evict least recently used resources until all budgets are met. */
+	void enforceBudgets();
 };
 
 }
@@ -0,0 +1,293 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "Resource/Test/CaseBindAsync.h"
+
+#include "Core/Io/StringOutputStream.h"
+#include "Core/RefArray.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/ThreadManager.h"
+#include "Core/Timer/Timer.h"
+#include "Database/Database.h"
+#include "Database/Provider/IProviderDatabase.h"
+#include "Database/Provider/IProviderGroup.h"
+#include "Database/Provider/IProviderInstance.h"
+#include "Resource/IResourceFactory.h"
+#include "Resource/ResourceBundle.h"
+#include "Resource/ResourceHandle.h"
+#include "Resource/ResourceManager.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace traktor::resource::test
+{
+	namespace
+	{
+
+const int32_t c_resourceCount = 16;
+
+class AsyncResource : public Object
+{
+	T_RTTI_CLASS;
+};
+
+class AsyncProduct : public Object
+{
+	T_RTTI_CLASS;
+};
+
+T_IMPLEMENT_RTTI_CLASS(L"traktor.resource.test.CaseBindAsync.AsyncResource", AsyncResource, Object)
+
+T_IMPLEMENT_RTTI_CLASS(L"traktor.resource.test.CaseBindAsync.AsyncProduct", AsyncProduct, Object)
+
+//! Factory which count created products and concurrent creations.
+class AsyncFactory : public IResourceFactory
+{
+public:
+	mutable std::atomic< int32_t > created = 0;
+	mutable std::atomic< int32_t > creating = 0;
+	mutable std::atomic< int32_t > maxCreating = 0;
+
+	virtual bool initialize(const ObjectStore& objectStore) override final { return true; }
+
+	virtual const TypeInfoSet getResourceTypes() const override final { return makeTypeInfoSet< AsyncResource >(); }
+
+	virtual const TypeInfoSet getProductTypes(const TypeInfo& resourceType) const override final { return makeTypeInfoSet< AsyncProduct >(); }
+
+	virtual bool isCacheable(const TypeInfo& productType) const override final { return true; }
+
+	virtual Ref< Object > create(IResourceManager* resourceManager, const db::Database* database, const db::Instance* instance, const TypeInfo& productType, const Object* current) const override final
+	{
+		const int32_t concurrent = ++creating;
+		int32_t expected = maxCreating;
+		while (concurrent > expected && !maxCreating.compare_exchange_weak(expected, concurrent))
+			;
+
+		// Simulate loading from disk.
+		ThreadManager::getInstance().getCurrentThread()->sleep(10);
+
+		--creating;
+		++created;
+		return new AsyncProduct();
+	}
+
+	virtual void destroy(Object* resource) const override final {}
+
+	virtual uint64_t getProductSize(const Object* product) const override final { return 0; }
+};
+
+//! Memory provider instance, always of async resource type.
+class MemoryProviderInstance : public db::IProviderInstance
+{
+public:
+	explicit MemoryProviderInstance(const Guid& guid)
+	:	m_guid(guid)
+	{
+	}
+
+	virtual std::wstring getPrimaryTypeName() const override final { return type_name< AsyncResource >(); }
+
+	virtual bool openTransaction() override final { return false; }
+
+	virtual bool commitTransaction() override final { return false; }
+
+	virtual bool closeTransaction() override final { return false; }
+
+	virtual std::wstring getName() const override final { return m_guid.format(); }
+
+	virtual bool setName(const std::wstring& name) override final { return false; }
+
+	virtual Guid getGuid() const override final { return m_guid; }
+
+	virtual bool setGuid(const Guid& guid) override final { return false; }
+
+	virtual bool getLastModifyDate(DateTime& outModifyDate) const override final { return false; }
+
+	virtual uint32_t getFlags() const override final { return 0; }
+
+	virtual bool remove() override final { return false; }
+
+	virtual Ref< IStream > readObject(const TypeInfo*& outSerializerType) const override final { return nullptr; }
+
+	virtual Ref< IStream > writeObject(const std::wstring& primaryTypeName, const TypeInfo*& outSerializerType) override final { return nullptr; }
+
+	virtual uint32_t getDataNames(AlignedVector< std::wstring >& outDataNames) const override final { return 0; }
+
+	virtual bool getDataLastWriteTime(const std::wstring& dataName, DateTime& outLastWriteTime) const override final { return false; }
+
+	virtual bool removeAllData() override final { return false; }
+
+	virtual Ref< IStream > readData(const std::wstring& dataName) const override final { return nullptr; }
+
+	virtual Ref< IStream > writeData(const std::wstring& dataName) override final { return nullptr; }
+
+private:
+	Guid m_guid;
+};
+
+//! Memory provider group, only root group with instances.
+class MemoryProviderGroup : public db::IProviderGroup
+{
+public:
+	RefArray< db::IProviderInstance > instances;
+
+	virtual std::wstring getName() const override final { return L""; }
+
+	virtual uint32_t getFlags() const override final { return 0; }
+
+	virtual bool rename(const std::wstring& name) override final { return false; }
+
+	virtual bool remove() override final { return false; }
+
+	virtual Ref< db::IProviderGroup > createGroup(const std::wstring& groupName) override final { return nullptr; }
+
+	virtual Ref< db::IProviderInstance > createInstance(const std::wstring& instanceName, const Guid& instanceGuid) override final { return nullptr; }
+
+	virtual bool getChildren(RefArray< db::IProviderGroup >& outChildGroups, RefArray< db::IProviderInstance >& outChildInstances) override final
+	{
+		outChildInstances = instances;
+		return true;
+	}
+};
+
+//! Memory provider database, without bus.
+class MemoryProviderDatabase : public db::IProviderDatabase
+{
+public:
+	Ref< MemoryProviderGroup > rootGroup = new MemoryProviderGroup();
+
+	virtual bool create(const db::ConnectionString& connectionString) override final { return true; }
+
+	virtual bool open(const db::ConnectionString& connectionString) override final { return true; }
+
+	virtual void close() override final {}
+
+	virtual db::IProviderBus* getBus() override final { return nullptr; }
+
+	virtual db::IProviderGroup* getRootGroup() override final { return rootGroup; }
+};
+
+bool allLoaded(const RefArray< ResourceHandle >& handles, const Object* placeholder)
+{
+	for (auto handle : handles)
+	{
+		if (handle->peek() == nullptr || handle->peek() == placeholder)
+			return false;
+	}
+	return true;
+}
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.resource.test.CaseBindAsync", 0, CaseBindAsync, traktor::test::Case)
+
+void CaseBindAsync::run()
+{
+	Ref< MemoryProviderDatabase > providerDatabase = new MemoryProviderDatabase();
+	AlignedVector< Guid > guids;
+	for (int32_t i = 0; i < 4 * c_resourceCount; ++i)
+	{
+		guids.push_back(Guid::create());
+		providerDatabase->rootGroup->instances.push_back(new MemoryProviderInstance(guids.back()));
+	}
+
+	Ref< db::Database > database = new db::Database();
+	CASE_ASSERT(database->open(providerDatabase));
+
+	Ref< AsyncFactory > factory = new AsyncFactory();
+	Ref< ResourceManager > resourceManager = new ResourceManager(database, false);
+	resourceManager->addFactory(factory);
+
+	Ref< AsyncProduct > placeholder = new AsyncProduct();
+	resourceManager->setPlaceholder(type_of< AsyncProduct >(), placeholder);
+
+	StringOutputStream ss;
+
+	// Bind synchronously as reference.
+	{
+		RefArray< ResourceHandle > handles;
+		Timer timer;
+		for (int32_t i = 0; i < c_resourceCount; ++i)
+			handles.push_back(resourceManager->bind(type_of< AsyncProduct >(), guids[i]));
+		const double duration = timer.getElapsedTime();
+
+		CASE_ASSERT(allLoaded(handles, placeholder));
+		CASE_ASSERT_EQUAL((int32_t)factory->created, c_resourceCount);
+		ss << L"Load " << c_resourceCount << L" resources; bind " << int32_t(duration * 1000.0) << L" ms";
+	}
+
+	// Bind asynchronously, handles contain placeholder until critical resources are loaded.
+	{
+		RefArray< ResourceHandle > handles;
+		Timer timer;
+		for (int32_t i = 0; i < c_resourceCount; ++i)
+		{
+			Ref< ResourceHandle > handle = resourceManager->bindAsync(type_of< AsyncProduct >(), guids[c_resourceCount + i], ResourcePriority::Critical);
+			CASE_ASSERT(handle != nullptr);
+			if (!handle)
+				return;
+			CASE_ASSERT(handle->peek() != nullptr);
+			handles.push_back(handle);
+		}
+		CASE_ASSERT(resourceManager->wait(ResourcePriority::Critical, -1));
+		const double duration = timer.getElapsedTime();
+
+		CASE_ASSERT(allLoaded(handles, placeholder));
+		CASE_ASSERT_EQUAL((int32_t)factory->created, 2 * c_resourceCount);
+		ss << L", bind async " << int32_t(duration * 1000.0) << L" ms (" << (int32_t)factory->maxCreating << L" concurrent)";
+
+		// Binding already loaded resource returns same handle without loading again.
+		Ref< ResourceHandle > handle = resourceManager->bind(type_of< AsyncProduct >(), guids[c_resourceCount]);
+		CASE_ASSERT(handle == handles[0]);
+		CASE_ASSERT_EQUAL((int32_t)factory->created, 2 * c_resourceCount);
+	}
+
+	// Synchronous bind of a queued resource loads it directly, it's only loaded once.
+	{
+		RefArray< ResourceHandle > handles;
+		for (int32_t i = 0; i < c_resourceCount; ++i)
+			handles.push_back(resourceManager->bindAsync(type_of< AsyncProduct >(), guids[2 * c_resourceCount + i], ResourcePriority::Background));
+
+		Ref< ResourceHandle > handle = resourceManager->bind(type_of< AsyncProduct >(), guids[3 * c_resourceCount - 1]);
+		CASE_ASSERT(handle == handles.back());
+		CASE_ASSERT(handle->peek() != nullptr && handle->peek() != placeholder);
+
+		CASE_ASSERT(resourceManager->wait(ResourcePriority::Background, -1));
+		CASE_ASSERT(allLoaded(handles, placeholder));
+		CASE_ASSERT_EQUAL((int32_t)factory->created, 3 * c_resourceCount);
+
+		ResourceManagerStatistics statistics;
+		resourceManager->getStatistics(statistics);
+		CASE_ASSERT_EQUAL(statistics.pendingCount, 0);
+	}
+
+	// Bundle is loaded in parallel and all resources are loaded when returning.
+	{
+		AlignedVector< std::pair< const TypeInfo*, Guid > > resources;
+		for (int32_t i = 0; i < c_resourceCount; ++i)
+			resources.push_back(std::make_pair(&type_of< AsyncResource >(), guids[3 * c_resourceCount + i]));
+
+		Ref< ResourceBundle > bundle = new ResourceBundle(resources, false);
+		CASE_ASSERT(resourceManager->load(bundle));
+		CASE_ASSERT_EQUAL((int32_t)factory->created, 4 * c_resourceCount);
+
+		RefArray< ResourceHandle > handles;
+		for (int32_t i = 0; i < c_resourceCount; ++i)
+			handles.push_back(resourceManager->bind(type_of< AsyncProduct >(), guids[3 * c_resourceCount + i]));
+		CASE_ASSERT(allLoaded(handles, placeholder));
+		CASE_ASSERT_EQUAL((int32_t)factory->created, 4 * c_resourceCount);
+	}
+
+	succeeded(ss.str());
+
+	resourceManager->destroy();
+	database->close();
+}
+
+}
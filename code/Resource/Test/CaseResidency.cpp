@@ -0,0 +1,280 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "Resource/Test/CaseResidency.h"
+
+#include "Core/RefArray.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/ThreadManager.h"
+#include "Database/Database.h"
+#include "Database/Provider/IProviderDatabase.h"
+#include "Database/Provider/IProviderGroup.h"
+#include "Database/Provider/IProviderInstance.h"
+#include "Resource/IResourceFactory.h"
+#include "Resource/ResourceHandle.h"
+#include "Resource/ResourceManager.h"
+
+#include <atomic>
+
+namespace traktor::resource::test
+{
+	namespace
+	{
+
+const uint64_t c_productSize = 1000;
+const int32_t c_resourceCount = 4;
+const int32_t c_threadCount = 4;
+
+class ResidencyResource : public Object
+{
+	T_RTTI_CLASS;
+};
+
+class ResidencyProduct : public Object
+{
+	T_RTTI_CLASS;
+
+public:
+	bool destroyed = false;
+};
+
+T_IMPLEMENT_RTTI_CLASS(L"traktor.resource.test.CaseResidency.ResidencyResource", ResidencyResource, Object)
+
+T_IMPLEMENT_RTTI_CLASS(L"traktor.resource.test.CaseResidency.ResidencyProduct", ResidencyProduct, Object)
+
+//! Factory which count created and destroyed products.
+class ResidencyFactory : public IResourceFactory
+{
+public:
+	mutable std::atomic< int32_t > created = 0;
+	mutable std::atomic< int32_t > destroyed = 0;
+
+	virtual bool initialize(const ObjectStore& objectStore) override final { return true; }
+
+	virtual const TypeInfoSet getResourceTypes() const override final { return makeTypeInfoSet< ResidencyResource >(); }
+
+	virtual const TypeInfoSet getProductTypes(const TypeInfo& resourceType) const override final { return makeTypeInfoSet< ResidencyProduct >(); }
+
+	virtual bool isCacheable(const TypeInfo& productType) const override final { return true; }
+
+	virtual Ref< Object > create(IResourceManager* resourceManager, const db::Database* database, const db::Instance* instance, const TypeInfo& productType, const Object* current) const override final
+	{
+		// Yield so concurrent accessors of an evicted handle get a chance to see it while it's restored.
+		ThreadManager::getInstance().getCurrentThread()->sleep(10);
+		++created;
+		return new ResidencyProduct();
+	}
+
+	virtual void destroy(Object* resource) const override final
+	{
+		mandatory_non_null_type_cast< ResidencyProduct* >(resource)->destroyed = true;
+		++destroyed;
+	}
+
+	virtual uint64_t getProductSize(const Object* product) const override final { return c_productSize; }
+};
+
+//! Memory provider instance, always of residency resource type.
+class MemoryProviderInstance : public db::IProviderInstance
+{
+public:
+	explicit MemoryProviderInstance(const Guid& guid)
+	:	m_guid(guid)
+	{
+	}
+
+	virtual std::wstring getPrimaryTypeName() const override final { return type_name< ResidencyResource >(); }
+
+	virtual bool openTransaction() override final { return false; }
+
+	virtual bool commitTransaction() override final { return false; }
+
+	virtual bool closeTransaction() override final { return false; }
+
+	virtual std::wstring getName() const override final { return m_guid.format(); }
+
+	virtual bool setName(const std::wstring& name) override final { return false; }
+
+	virtual Guid getGuid() const override final { return m_guid; }
+
+	virtual bool setGuid(const Guid& guid) override final { return false; }
+
+	virtual bool getLastModifyDate(DateTime& outModifyDate) const override final { return false; }
+
+	virtual uint32_t getFlags() const override final { return 0; }
+
+	virtual bool remove() override final { return false; }
+
+	virtual Ref< IStream > readObject(const TypeInfo*& outSerializerType) const override final { return nullptr; }
+
+	virtual Ref< IStream > writeObject(const std::wstring& primaryTypeName, const TypeInfo*& outSerializerType) override final { return nullptr; }
+
+	virtual uint32_t getDataNames(AlignedVector< std::wstring >& outDataNames) const override final { return 0; }
+
+	virtual bool getDataLastWriteTime(const std::wstring& dataName, DateTime& outLastWriteTime) const override final { return false; }
+
+	virtual bool removeAllData() override final { return false; }
+
+	virtual Ref< IStream > readData(const std::wstring& dataName) const override final { return nullptr; }
+
+	virtual Ref< IStream > writeData(const std::wstring& dataName) override final { return nullptr; }
+
+private:
+	Guid m_guid;
+};
+
+//! Memory provider group, only root group with instances.
+class MemoryProviderGroup : public db::IProviderGroup
+{
+public:
+	RefArray< db::IProviderInstance > instances;
+
+	virtual std::wstring getName() const override final { return L""; }
+
+	virtual uint32_t getFlags() const override final { return 0; }
+
+	virtual bool rename(const std::wstring& name) override final { return false; }
+
+	virtual bool remove() override final { return false; }
+
+	virtual Ref< db::IProviderGroup > createGroup(const std::wstring& groupName) override final { return nullptr; }
+
+	virtual Ref< db::IProviderInstance > createInstance(const std::wstring& instanceName, const Guid& instanceGuid) override final { return nullptr; }
+
+	virtual bool getChildren(RefArray< db::IProviderGroup >& outChildGroups, RefArray< db::IProviderInstance >& outChildInstances) override final
+	{
+		outChildInstances = instances;
+		return true;
+	}
+};
+
+//! Memory provider database, without bus.
+class MemoryProviderDatabase : public db::IProviderDatabase
+{
+public:
+	Ref< MemoryProviderGroup > rootGroup = new MemoryProviderGroup();
+
+	virtual bool create(const db::ConnectionString& connectionString) override final { return true; }
+
+	virtual bool open(const db::ConnectionString& connectionString) override final { return true; }
+
+	virtual void close() override final {}
+
+	virtual db::IProviderBus* getBus() override final { return nullptr; }
+
+	virtual db::IProviderGroup* getRootGroup() override final { return rootGroup; }
+};
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.resource.test.CaseResidency", 0, CaseResidency, traktor::test::Case)
+
+void CaseResidency::run()
+{
+	Ref< MemoryProviderDatabase > providerDatabase = new MemoryProviderDatabase();
+	Guid guids[c_resourceCount];
+	for (int32_t i = 0; i < c_resourceCount; ++i)
+	{
+		guids[i] = Guid::create();
+		providerDatabase->rootGroup->instances.push_back(new MemoryProviderInstance(guids[i]));
+	}
+
+	Ref< db::Database > database = new db::Database();
+	CASE_ASSERT(database->open(providerDatabase));
+
+	Ref< ResidencyFactory > factory = new ResidencyFactory();
+	Ref< ResourceManager > resourceManager = new ResourceManager(database, false);
+	resourceManager->addFactory(factory);
+
+	Ref< ResourceHandle > handles[c_resourceCount];
+	for (int32_t i = 0; i < c_resourceCount; ++i)
+	{
+		handles[i] = resourceManager->bind(type_of< ResidencyProduct >(), guids[i]);
+		CASE_ASSERT(handles[i] != nullptr);
+		if (!handles[i])
+			return;
+	}
+	CASE_ASSERT_EQUAL((int32_t)factory->created, c_resourceCount);
+
+	// Product of first resource is referenced outside of handle, thus cannot be evicted.
+	Ref< ResidencyProduct > referenced = checked_type_cast< ResidencyProduct* >(handles[0]->get());
+	CASE_ASSERT(referenced != nullptr);
+
+	// Let resources age, budget only fit two resources.
+	for (int32_t i = 0; i < 3; ++i)
+		resourceManager->update();
+	resourceManager->setBudget(type_of< ResidencyProduct >(), 2 * c_productSize + c_productSize / 2);
+
+	// Budget is only enforced when updated.
+	for (int32_t i = 0; i < c_resourceCount; ++i)
+		CASE_ASSERT(!handles[i]->evicted());
+	resourceManager->update();
+
+	int32_t evicted = 0;
+	for (int32_t i = 0; i < c_resourceCount; ++i)
+	{
+		if (handles[i]->evicted())
+			++evicted;
+	}
+	CASE_ASSERT_EQUAL(evicted, 2);
+	CASE_ASSERT(!handles[0]->evicted());
+	CASE_ASSERT(!referenced->destroyed);
+	CASE_ASSERT(handles[0]->peek() == referenced);
+	CASE_ASSERT_EQUAL((int32_t)factory->destroyed, 2);
+
+	{
+		ResourceManagerStatistics statistics;
+		resourceManager->getStatistics(statistics);
+		CASE_ASSERT_EQUAL(statistics.types.size(), 1);
+		if (statistics.types.size() == 1)
+		{
+			CASE_ASSERT_EQUAL(statistics.types[0].residentSize, 2 * c_productSize);
+			CASE_ASSERT_EQUAL(statistics.types[0].residentCount, 2);
+			CASE_ASSERT_EQUAL(statistics.types[0].evictedCount, 2);
+		}
+	}
+
+	// Concurrent accessors of an evicted handle all get the restored product, which is only created once.
+	ResourceHandle* evictedHandle = nullptr;
+	for (int32_t i = 1; i < c_resourceCount && !evictedHandle; ++i)
+	{
+		if (handles[i]->evicted())
+			evictedHandle = handles[i];
+	}
+	CASE_ASSERT(evictedHandle != nullptr);
+	if (!evictedHandle)
+		return;
+
+	// Allow restored resource to evict others.
+	resourceManager->setBudget(type_of< ResidencyProduct >(), 0);
+
+	std::atomic< int32_t > nullCount = 0;
+	Thread* threads[c_threadCount] = { nullptr };
+	for (int32_t i = 0; i < c_threadCount; ++i)
+	{
+		threads[i] = ThreadManager::getInstance().create([&]() {
+			if (evictedHandle->get() == nullptr)
+				++nullCount;
+		}, L"Residency test");
+		threads[i]->start();
+	}
+	for (int32_t i = 0; i < c_threadCount; ++i)
+	{
+		threads[i]->wait();
+		ThreadManager::getInstance().destroy(threads[i]);
+	}
+
+	CASE_ASSERT_EQUAL((int32_t)nullCount, 0);
+	CASE_ASSERT(!evictedHandle->evicted());
+	CASE_ASSERT_EQUAL((int32_t)factory->created, c_resourceCount + 1);
+
+	resourceManager->destroy();
+	database->close();
+}
+
+}
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -202,10 +202,23 @@ void ProfilerDialog::receivedPerfSets()
 	m_performanceGrid->addRow(createPerformanceRow(L"Render Passes", str(L"%d", render.renderViewStats.passCount)));
 	m_performanceGrid->addRow(createPerformanceRow(L"Draw Calls", str(L"%d", render.renderViewStats.drawCalls)));
 	m_performanceGrid->addRow(createPerformanceRow(L"Primitives", str(L"%d", render.renderViewStats.primitiveCount)));
+	m_performanceGrid->addRow(createPerformanceRow(L"Render Context Usage", str(L"%d KiB", render.renderContextStats.frameUsage / 1024)));
+	m_performanceGrid->addRow(createPerformanceRow(L"Render Context Capacity", str(L"%d KiB", render.renderContextStats.heapCapacity / 1024)));
+	m_performanceGrid->addRow(createPerformanceRow(L"Render Context Pooled", str(L"%d KiB", render.renderContextStats.pooledSize / 1024)));
 
 	const TpsResource& resource = m_connection->getPerformance< TpsResource >();
 	m_performanceGrid->addRow(createPerformanceRow(L"Resident Resources", str(L"%d", resource.residentResourcesCount)));
 	m_performanceGrid->addRow(createPerformanceRow(L"Exclusive Resources", str(L"%d", resource.exclusiveResourcesCount)));
+	m_performanceGrid->addRow(createPerformanceRow(L"Pending Resources", str(L"%d", resource.pendingResourcesCount)));
+	m_performanceGrid->addRow(createPerformanceRow(L"Evicted Resources", str(L"%d", resource.evictedResourcesCount)));
+	m_performanceGrid->addRow(createPerformanceRow(L"Resident Resources Size", str(L"%d KiB", int32_t(resource.residentResourcesSize / 1024))));
+	for (const auto& type : resource.types)
+	{
+		if (type.budget > 0)
+			m_performanceGrid->addRow(createPerformanceRow(type.productType, str(L"%d / %d KiB", int32_t(type.residentSize / 1024), int32_t(type.budget / 1024))));
+		else
+			m_performanceGrid->addRow(createPerformanceRow(type.productType, str(L"%d KiB", int32_t(type.residentSize / 1024))));
+	}
 
 	const TpsPhysics& physics = m_connection->getPerformance< TpsPhysics >();
 	m_performanceGrid->addRow(createPerformanceRow(L"Bodies", str(L"%d", physics.bodyCount)));
@@ -215,6 +228,10 @@ void ProfilerDialog::receivedPerfSets()
 
 	const TpsAudio& audio = m_connection->getPerformance< TpsAudio >();
 	m_performanceGrid->addRow(createPerformanceRow(L"Active Sound Channels", str(L"%d", audio.activeSoundChannels)));
+	const uint64_t blockCacheReads = audio.blockCacheHits + audio.blockCacheMisses;
+	m_performanceGrid->addRow(createPerformanceRow(L"Audio Cache Hit Rate", str(L"%d%%", blockCacheReads > 0 ? int32_t(audio.blockCacheHits * 100 / blockCacheReads) : 0)));
+	m_performanceGrid->addRow(createPerformanceRow(L"Audio Cache Saved", str(L"%d KiB", int32_t(audio.blockCacheBytesSaved / 1024))));
+	m_performanceGrid->addRow(createPerformanceRow(L"Audio Cache Size", str(L"%d KiB", int32_t(audio.blockCacheSize / 1024))));
 }
 
 void ProfilerDialog::eventToolClick(ui::ToolBarButtonClickEvent* event)
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -12,6 +12,8 @@
 #include "Core/Thread/JobManager.h"
 #include "Core/Timer/Timer.h"
 #include "Database/Database.h"
+#include "Resource/IResourceManager.h"
+#include "Runtime/IResourceServer.h"
 #include "Runtime/IEnvironment.h"
 #include "Runtime/Engine/StageData.h"
 #include "Runtime/Engine/StageLoader.h"
@@ -29,7 +31,14 @@ void jobLoader(IEnvironment* environment, Guid stageGuid, Ref< const Object > pa
 
 	Timer timer;
 	outStage = stageData->createInstance(environment, params);
-	log::info << L"Stage " << stageGuid.format() << L" loaded in " << formatDuration(timer.getElapsedTime()) << L"." << Endl;
+	const double createTime = timer.getElapsedTime();
+
+	// Stage isn't ready to be presented until all critical resources
+	// which has been bound asynchronously are loaded.
+	if (outStage)
+		environment->getResource()->getResourceManager()->wait(resource::ResourcePriority::Critical);
+
+	log::info << L"Stage " << stageGuid.format() << L" loaded in " << formatDuration(timer.getElapsedTime()) << L" (created in " << formatDuration(createTime) << L")." << Endl;
 }
 
 	}
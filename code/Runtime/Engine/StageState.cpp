@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -43,7 +43,7 @@ StageState::StageState(
 
 	m_frames.resize(frameCount);
 	for (auto& frame : m_frames)
-		frame.renderContext = new render::RenderContext(16 * 1024 * 1024);
+		frame.renderContext = new render::RenderContext(1 * 1024 * 1024);
 
 	m_renderGraph = new render::RenderGraph(
 		environment->getRender()->getRenderSystem(),
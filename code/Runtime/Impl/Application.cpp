@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -55,6 +55,7 @@
 #include "Render/IRenderSystem.h"
 #include "Render/IRenderView.h"
 #include "Resource/IResourceManager.h"
+#include "Sound/AudioBlockCache.h"
 #include "Script/IScriptManager.h"
 
 namespace traktor::runtime
@@ -898,6 +899,9 @@ bool Application::update()
 
 		m_updateInfo.m_frame++;
 
+		// Advance resource residency.
+		m_resourceServer->update();
+
 		// Receive remote events from editor.
 		if (m_targetManagerConnection && m_targetManagerConnection->connected())
 		{
@@ -958,6 +962,7 @@ bool Application::update()
 				TpsRender tp;
 				m_renderServer->getRenderSystem()->getStatistics(tp.renderSystemStats);
 				tp.renderViewStats = m_renderViewStats;
+				render::RenderContext::getStatistics(tp.renderContextStats);
 				m_targetPerformance.publish(m_targetManagerConnection->getTransport(), tp);
 			}
 
@@ -968,6 +973,19 @@ bool Application::update()
 				m_resourceServer->getResourceManager()->getStatistics(rms);
 				tp.residentResourcesCount = rms.residentCount;
 				tp.exclusiveResourcesCount = rms.exclusiveCount;
+				tp.pendingResourcesCount = rms.pendingCount;
+				for (const auto& ts : rms.types)
+				{
+					tp.residentResourcesSize += ts.residentSize;
+					tp.evictedResourcesCount += ts.evictedCount;
+
+					auto& type = tp.types.push_back();
+					type.productType = ts.productType->getName();
+					type.residentSize = ts.residentSize;
+					type.budget = ts.budget;
+					type.residentCount = ts.residentCount;
+					type.evictedCount = ts.evictedCount;
+				}
 				m_targetPerformance.publish(m_targetManagerConnection->getTransport(), tp);
 			}
 
@@ -991,6 +1009,14 @@ bool Application::update()
 				TpsAudio tp;
 				if (m_audioServer)
 					tp.activeSoundChannels = m_audioServer->getActiveSoundChannels();
+				{
+					sound::AudioBlockCacheStatistics bcs;
+					sound::AudioBlockCache::getInstance().getStatistics(bcs);
+					tp.blockCacheHits = bcs.hits;
+					tp.blockCacheMisses = bcs.misses;
+					tp.blockCacheBytesSaved = bcs.bytesSaved;
+					tp.blockCacheSize = bcs.residentSize;
+				}
 				m_targetPerformance.publish(m_targetManagerConnection->getTransport(), tp);
 			}
 		}
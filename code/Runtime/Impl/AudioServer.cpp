@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -17,6 +17,7 @@
 #include "Core/Settings/PropertyString.h"
 #include "Core/Timer/Profiler.h"
 #include "Resource/IResourceManager.h"
+#include "Sound/AudioBlockCache.h"
 #include "Sound/AudioChannel.h"
 #include "Sound/AudioDriverNull.h"
 #include "Sound/AudioDriverWriteOut.h"
@@ -55,6 +56,7 @@ bool AudioServer::create(const PropertyGroup* settings, const SystemApplication&
 	ascd.driverDesc.sampleRate = settings->getProperty< int32_t >(L"Audio.SampleRate", 44100);
 	ascd.driverDesc.bitsPerSample = settings->getProperty< int32_t >(L"Audio.BitsPerSample", 16);
 	ascd.driverDesc.hwChannels = settings->getProperty< int32_t >(L"Audio.HwChannels", 2);
+	ascd.parallel = settings->getProperty< bool >(L"Audio.ParallelMixer", true);
 #	if defined(__IOS__) || defined(__ANDROID__)
 	ascd.driverDesc.frameSamples = 1024;
 #	else
@@ -94,6 +96,9 @@ bool AudioServer::create(const PropertyGroup* settings, const SystemApplication&
 		}
 	}
 
+	// Set budget of shared cache of decoded stream blocks.
+	sound::AudioBlockCache::getInstance().setBudget(uint64_t(settings->getProperty< int32_t >(L"Audio.BlockCacheSize", 8)) * 1024 * 1024);
+
 	// Create surround environment.
 	const float surroundMaxDistance = 25.0f; // settings->getProperty< float >(L"Audio.Surround/MaxDistance", 50.0f);
 	const float surroundInnerRadius = 5.0f; // settings->getProperty< float >(L"Audio.Surround/InnerRadius", 5.0f);
@@ -114,6 +119,7 @@ bool AudioServer::create(const PropertyGroup* settings, const SystemApplication&
 		m_soundPlayer = nullptr;
 		return true;
 	}
+	m_soundPlayer->setAudibilityThreshold(settings->getProperty< float >(L"Audio.AudibilityThreshold", 0.01f));
 
 	return true;
 }
@@ -1,13 +1,20 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 #include "Runtime/Impl/RenderServer.h"
+#include "Core/Settings/PropertyBoolean.h"
+#include "Core/Settings/PropertyGroup.h"
 #include "Core/Thread/Atomic.h"
+#include "Render/IRenderSystem.h"
+#include "Render/ITexture.h"
+#include "Resource/IResourceManager.h"
+#include "Runtime/IEnvironment.h"
+#include "Runtime/IResourceServer.h"
 
 namespace traktor::runtime
 {
@@ -50,4 +57,25 @@ int32_t RenderServer::getThreadFrameQueueCount() const
 	return 2;
 }
 
+void RenderServer::createPlaceholderTexture(IEnvironment* environment)
+{
+	if (!environment->getSettings()->getProperty< bool >(L"Render.TextureStreaming", false))
+		return;
+
+	// Mid-gray until actual texture has been streamed in.
+	const uint32_t value = 0xff808080;
+
+	render::SimpleTextureCreateDesc stcd = {};
+	stcd.width = 1;
+	stcd.height = 1;
+	stcd.mipCount = 1;
+	stcd.format = render::TfR8G8B8A8;
+	stcd.sRGB = false;
+	stcd.immutable = true;
+	stcd.initialData[0].data = &value;
+	stcd.initialData[0].pitch = 4;
+	if ((m_placeholderTexture = m_renderSystem->createSimpleTexture(stcd, T_FILE_LINE_W)) != nullptr)
+		environment->getResource()->getResourceManager()->setPlaceholder(type_of< render::ITexture >(), m_placeholderTexture);
+}
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -20,6 +20,7 @@ class PropertyGroup;
 namespace traktor::render
 {
 
+class ITexture;
 class TextureFactory;
 
 }
@@ -68,6 +69,10 @@ protected:
 	Ref< render::IRenderSystem > m_renderSystem;
 	Ref< render::IRenderView > m_renderView;
 	Ref< render::TextureFactory > m_textureFactory;
+	Ref< render::ITexture > m_placeholderTexture;
+
+	/*! Register placeholder texture, if texture streaming is enabled, so textures are loaded asynchronously. */
+	void createPlaceholderTexture(IEnvironment* environment);
 
 private:
 	std::atomic< double > m_cpuDuration = 0.0;
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -287,6 +287,7 @@ bool RenderServerDefault::create(const PropertyGroup* defaultSettings, PropertyG
 
 void RenderServerDefault::destroy()
 {
+	safeDestroy(m_placeholderTexture);
 	safeClose(m_renderView);
 	safeDestroy(m_renderSystem);
 }
@@ -301,6 +302,8 @@ void RenderServerDefault::createResourceFactories(IEnvironment* environment)
 	m_textureFactory = new render::TextureFactory(m_renderSystem, skipMips);
 
 	resourceManager->addFactory(m_textureFactory);
+
+	createPlaceholderTexture(environment);
 }
 
 int32_t RenderServerDefault::reconfigure(IEnvironment* environment, const PropertyGroup* settings)
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -164,6 +164,7 @@ bool RenderServerEmbedded::create(const PropertyGroup* defaultSettings, Property
 
 void RenderServerEmbedded::destroy()
 {
+	safeDestroy(m_placeholderTexture);
 	safeClose(m_renderView);
 	safeDestroy(m_renderSystem);
 }
@@ -178,6 +179,8 @@ void RenderServerEmbedded::createResourceFactories(IEnvironment* environment)
 	m_textureFactory = new render::TextureFactory(m_renderSystem, skipMips);
 
 	resourceManager->addFactory(m_textureFactory);
+
+	createPlaceholderTexture(environment);
 }
 
 int32_t RenderServerEmbedded::reconfigure(IEnvironment* environment, const PropertyGroup* settings)
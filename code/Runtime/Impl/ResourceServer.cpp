@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -13,6 +13,7 @@
 #include "Core/Misc/SafeDestroy.h"
 #include "Core/Settings/PropertyBoolean.h"
 #include "Core/Settings/PropertyGroup.h"
+#include "Core/Settings/PropertyInteger.h"
 #include "Render/IRenderSystem.h"
 #include "Resource/IResourceFactory.h"
 #include "Resource/ResourceManager.h"
@@ -26,6 +27,23 @@ T_IMPLEMENT_RTTI_CLASS(L"traktor.runtime.ResourceServer", ResourceServer, IResou
 bool ResourceServer::create(const PropertyGroup* settings, db::Database* database)
 {
 	m_resourceManager = new resource::ResourceManager(database, settings->getProperty< bool >(L"Resource.Verbose", false));
+
+	// Set residency budgets, in MiB, keyed by product type name.
+	Ref< const PropertyGroup > budgets = settings->getProperty< PropertyGroup >(L"Resource.Budgets");
+	if (budgets)
+	{
+		for (const auto& budget : budgets->getValues())
+		{
+			const TypeInfo* productType = TypeInfo::find(budget.first.c_str());
+			if (!productType)
+			{
+				log::warning << L"Unable to set resource budget; no such product type \"" << budget.first << L"\"." << Endl;
+				continue;
+			}
+			m_resourceManager->setBudget(*productType, uint64_t(PropertyInteger::get(budget.second)) * 1024 * 1024);
+		}
+	}
+
 	return true;
 }
 
@@ -65,6 +83,11 @@ int32_t ResourceServer::reconfigure(const PropertyGroup* settings)
 	return CrUnaffected;
 }
 
+void ResourceServer::update()
+{
+	m_resourceManager->update();
+}
+
 void ResourceServer::performCleanup()
 {
 	m_resourceManager->unloadUnusedResident();
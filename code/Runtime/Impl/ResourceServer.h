@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -45,6 +45,8 @@ public:
 
 	int32_t reconfigure(const PropertyGroup* settings);
 
+	void update();
+
 	void performCleanup();
 
 	virtual resource::IResourceManager* getResourceManager() override final;
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2023 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -11,7 +11,9 @@
 #include "Core/Serialization/DeepClone.h"
 #include "Core/Serialization/ISerializer.h"
 #include "Core/Serialization/Member.h"
+#include "Core/Serialization/MemberAlignedVector.h"
 #include "Core/Serialization/MemberComplex.h"
+#include "Core/Serialization/MemberComposite.h"
 #include "Net/BidirectionalObjectTransport.h"
 #include "Runtime/Target/TargetPerformance.h"
 
@@ -67,6 +69,26 @@ private:
 	render::RenderViewStatistics& m_ref;
 };
 
+class MemberRenderContextStatistics : public MemberComplex
+{
+public:
+	MemberRenderContextStatistics(const wchar_t* const name, render::RenderContextStatistics& ref)
+	:	MemberComplex(name, true)
+	,	m_ref(ref)
+	{
+	}
+
+	virtual void serialize(ISerializer& s) const override final
+	{
+		s >> Member< uint32_t >(L"frameUsage", m_ref.frameUsage);
+		s >> Member< uint32_t >(L"heapCapacity", m_ref.heapCapacity);
+		s >> Member< uint32_t >(L"pooledSize", m_ref.pooledSize);
+	}
+
+private:
+	render::RenderContextStatistics& m_ref;
+};
+
 	}
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.runtime.TargetPerfSet", TargetPerfSet, ISerializable)
@@ -121,7 +143,7 @@ void TpsMemory::serialize(ISerializer& s)
 	s >> Member< uint32_t >(L"heapObjects", heapObjects);
 }
 
-T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.runtime.TpsRender", 0, TpsRender, TargetPerfSet)
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.runtime.TpsRender", 1, TpsRender, TargetPerfSet)
 
 bool TpsRender::check(const TargetPerfSet& old) const
 {
@@ -132,22 +154,43 @@ void TpsRender::serialize(ISerializer& s)
 {
 	s >> MemberRenderSystemStatistics(L"renderSystemStats", renderSystemStats);
 	s >> MemberRenderViewStatistics(L"renderViewStats", renderViewStats);
+	if (s.getVersion< TpsRender >() >= 1)
+		s >> MemberRenderContextStatistics(L"renderContextStats", renderContextStats);
 }
 
-T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.runtime.TpsResource", 0, TpsResource, TargetPerfSet)
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.runtime.TpsResource", 1, TpsResource, TargetPerfSet)
 
 bool TpsResource::check(const TargetPerfSet& old) const
 {
 	const TpsResource& o = (const TpsResource&)old;
 	return
 		residentResourcesCount != o.residentResourcesCount ||
-		exclusiveResourcesCount != o.exclusiveResourcesCount;
+		exclusiveResourcesCount != o.exclusiveResourcesCount ||
+		pendingResourcesCount != o.pendingResourcesCount ||
+		evictedResourcesCount != o.evictedResourcesCount ||
+		residentResourcesSize != o.residentResourcesSize;
 }
 
 void TpsResource::serialize(ISerializer& s)
 {
 	s >> Member< uint32_t >(L"residentResourcesCount", residentResourcesCount);
 	s >> Member< uint32_t >(L"exclusiveResourcesCount", exclusiveResourcesCount);
+	if (s.getVersion< TpsResource >() >= 1)
+	{
+		s >> Member< uint32_t >(L"pendingResourcesCount", pendingResourcesCount);
+		s >> Member< uint32_t >(L"evictedResourcesCount", evictedResourcesCount);
+		s >> Member< uint64_t >(L"residentResourcesSize", residentResourcesSize);
+		s >> MemberAlignedVector< Type, MemberComposite< Type > >(L"types", types);
+	}
+}
+
+void TpsResource::Type::serialize(ISerializer& s)
+{
+	s >> Member< std::wstring >(L"productType", productType);
+	s >> Member< uint64_t >(L"residentSize", residentSize);
+	s >> Member< uint64_t >(L"budget", budget);
+	s >> Member< uint32_t >(L"residentCount", residentCount);
+	s >> Member< uint32_t >(L"evictedCount", evictedCount);
 }
 
 T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.runtime.TpsPhysics", 0, TpsPhysics, TargetPerfSet)
@@ -170,18 +213,28 @@ void TpsPhysics::serialize(ISerializer& s)
 	s >> Member< uint32_t >(L"queryCount", queryCount);
 }
 
-T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.runtime.TpsAudio", 0, TpsAudio, TargetPerfSet)
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.runtime.TpsAudio", 1, TpsAudio, TargetPerfSet)
 
 bool TpsAudio::check(const TargetPerfSet& old) const
 {
 	const TpsAudio& o = (const TpsAudio&)old;
 	return
-		activeSoundChannels != o.activeSoundChannels;
+		activeSoundChannels != o.activeSoundChannels ||
+		blockCacheHits != o.blockCacheHits ||
+		blockCacheMisses != o.blockCacheMisses ||
+		blockCacheSize != o.blockCacheSize;
 }
 
 void TpsAudio::serialize(ISerializer& s)
 {
 	s >> Member< uint32_t >(L"activeSoundChannels", activeSoundChannels);
+	if (s.getVersion< TpsAudio >() >= 1)
+	{
+		s >> Member< uint64_t >(L"blockCacheHits", blockCacheHits);
+		s >> Member< uint64_t >(L"blockCacheMisses", blockCacheMisses);
+		s >> Member< uint64_t >(L"blockCacheBytesSaved", blockCacheBytesSaved);
+		s >> Member< uint64_t >(L"blockCacheSize", blockCacheSize);
+	}
 }
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.runtime.TargetPerformance", TargetPerformance, Object)
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,8 +8,11 @@
  */
 #pragma once
 
+#include <string>
+#include "Core/Containers/AlignedVector.h"
 #include "Core/Serialization/ISerializable.h"
 #include "Core/Timer/Timer.h"
+#include "Render/Context/RenderContext.h"
 #include "Render/Types.h"
 
 // import/export mechanism.
@@ -82,6 +85,7 @@ class T_DLLCLASS TpsRender : public TargetPerfSet
 public:
 	render::RenderSystemStatistics renderSystemStats;
 	render::RenderViewStatistics renderViewStats;
+	render::RenderContextStatistics renderContextStats;
 
 	virtual bool check(const TargetPerfSet& old) const override final;
 
@@ -93,8 +97,23 @@ class T_DLLCLASS TpsResource : public TargetPerfSet
 	T_RTTI_CLASS;
 
 public:
+	struct Type
+	{
+		std::wstring productType;
+		uint64_t residentSize = 0;
+		uint64_t budget = 0;
+		uint32_t residentCount = 0;
+		uint32_t evictedCount = 0;
+
+		void serialize(ISerializer& s);
+	};
+
 	uint32_t residentResourcesCount = 0;
 	uint32_t exclusiveResourcesCount = 0;
+	uint32_t pendingResourcesCount = 0;
+	uint32_t evictedResourcesCount = 0;
+	uint64_t residentResourcesSize = 0;
+	AlignedVector< Type > types;
 
 	virtual bool check(const TargetPerfSet& old) const override final;
 
@@ -122,6 +141,10 @@ class T_DLLCLASS TpsAudio : public TargetPerfSet
 
 public:
 	uint32_t activeSoundChannels = 0;
+	uint64_t blockCacheHits = 0;
+	uint64_t blockCacheMisses = 0;
+	uint64_t blockCacheBytesSaved = 0;
+	uint64_t blockCacheSize = 0;
 
 	virtual bool check(const TargetPerfSet& old) const override final;
 
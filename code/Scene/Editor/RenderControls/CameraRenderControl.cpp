@@ -108,7 +108,7 @@ bool CameraRenderControl::create(ui::Widget* parent, SceneEditorContext* context
 		return false;
 	}
 
-	m_renderContext = new render::RenderContext(16 * 1024 * 1024);
+	m_renderContext = new render::RenderContext(1 * 1024 * 1024);
 	m_renderGraph = new render::RenderGraph(m_context->getRenderSystem(), m_multiSample);
 
 	m_primitiveRenderer = new render::PrimitiveRenderer();
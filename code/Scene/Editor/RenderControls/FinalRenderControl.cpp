@@ -127,7 +127,7 @@ bool FinalRenderControl::create(ui::Widget* parent, SceneEditorContext* context,
 		}
 	}
 
-	m_renderContext = new render::RenderContext(16 * 1024 * 1024);
+	m_renderContext = new render::RenderContext(1 * 1024 * 1024);
 	m_renderGraph = new render::RenderGraph(m_context->getRenderSystem(), m_multiSample);
 
 	m_screenRenderer = new render::ScreenRenderer();
@@ -125,7 +125,7 @@ bool OrthogonalRenderControl::create(ui::Widget* parent, SceneEditorContext* con
 		return false;
 	}
 
-	m_renderContext = new render::RenderContext(16 * 1024 * 1024);
+	m_renderContext = new render::RenderContext(1 * 1024 * 1024);
 	m_renderGraph = new render::RenderGraph(m_context->getRenderSystem(), m_multiSample);
 
 	m_primitiveRenderer = new render::PrimitiveRenderer();
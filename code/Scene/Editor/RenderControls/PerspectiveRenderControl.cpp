@@ -135,7 +135,7 @@ bool PerspectiveRenderControl::create(ui::Widget* parent, SceneEditorContext* co
 		return false;
 	}
 
-	m_renderContext = new render::RenderContext(16 * 1024 * 1024);
+	m_renderContext = new render::RenderContext(1 * 1024 * 1024);
 	m_renderGraph = new render::RenderGraph(
 		m_context->getRenderSystem(),
 		m_multiSample,
@@ -481,7 +481,7 @@ void SceneEditorContext::buildEntities(bool rebuildWorld)
 		else
 		{
 			// No world created yet (or need to be rebuilt); create new world.
-			world = new world::World(getResourceManager(), getRenderSystem());
+			world = new world::World(getResourceManager(), getRenderSystem(), true);
 
 			// Create new set of world components.
 			for (auto worldComponentData : m_sceneAsset->getWorldComponents())
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -30,7 +30,7 @@ SceneResource::SceneResource()
 
 Ref< Scene > SceneResource::createScene(resource::IResourceManager* resourceManager, render::IRenderSystem* renderSystem, const world::IEntityFactory* entityFactory) const
 {
-	Ref< world::World > world = new world::World(resourceManager, renderSystem);
+	Ref< world::World > world = new world::World(resourceManager, renderSystem, true);
 	Ref< world::EntityBuilder > entityBuilder = new world::EntityBuilder(entityFactory, world);
 
 	// Create world components.
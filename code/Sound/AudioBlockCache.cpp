@@ -0,0 +1,150 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include <cstring>
+#include "Core/Memory/Alloc.h"
+#include "Core/Singleton/SingletonManager.h"
+#include "Core/Thread/Acquire.h"
+#include "Sound/AudioBlockCache.h"
+
+namespace traktor::sound
+{
+	namespace
+	{
+
+const uint64_t c_defaultBudget = 8 * 1024 * 1024;
+
+inline uint64_t blockKey(uint32_t key, uint32_t index)
+{
+	return (uint64_t(key) << 32) | index;
+}
+
+	}
+
+AudioBlockCache::Block::Block(uint32_t channels)
+:	m_channels(channels)
+{
+	T_ASSERT(channels > 0 && channels <= SbcMaxChannelCount);
+	float* data = (float*)Alloc::acquireAlign(getSize(), 16, T_FILE_LINE);
+	std::memset(data, 0, getSize());
+	for (uint32_t i = 0; i < channels; ++i)
+		samples[i] = data + i * BlockSamples;
+}
+
+AudioBlockCache::Block::~Block()
+{
+	Alloc::freeAlign(samples[0]);
+}
+
+AudioBlockCache& AudioBlockCache::getInstance()
+{
+	static AudioBlockCache* s_instance = nullptr;
+	if (!s_instance)
+	{
+		s_instance = new AudioBlockCache();
+		SingletonManager::getInstance().add(s_instance);
+	}
+	return *s_instance;
+}
+
+uint32_t AudioBlockCache::allocateKey()
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+	return m_nextKey++;
+}
+
+void AudioBlockCache::setBudget(uint64_t budget)
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+	m_statistics.budget = budget;
+	evict();
+}
+
+Ref< const AudioBlockCache::Block > AudioBlockCache::get(uint32_t key, uint32_t index)
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+
+	auto it = m_blocks.find(blockKey(key, index));
+	if (it == m_blocks.end())
+		return nullptr;
+
+	const Block* block = it->second.block;
+	it->second.lastUsed = ++m_tick;
+
+	m_statistics.hits++;
+	m_statistics.bytesSaved += uint64_t(block->samplesCount) * block->maxChannel * sizeof(float);
+	return block;
+}
+
+void AudioBlockCache::put(uint32_t key, uint32_t index, const Block* block)
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+
+	m_statistics.misses++;
+	if (block->getSize() > m_statistics.budget)
+		return;
+
+	Entry& entry = m_blocks[blockKey(key, index)];
+	if (entry.block)
+		m_statistics.residentSize -= entry.block->getSize();
+
+	entry.block = block;
+	entry.lastUsed = ++m_tick;
+	m_statistics.residentSize += block->getSize();
+
+	evict();
+}
+
+void AudioBlockCache::purge(uint32_t key)
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+	for (auto it = m_blocks.begin(); it != m_blocks.end(); )
+	{
+		if ((it->first >> 32) == key)
+		{
+			m_statistics.residentSize -= it->second.block->getSize();
+			it = m_blocks.erase(it);
+		}
+		else
+			++it;
+	}
+}
+
+void AudioBlockCache::getStatistics(AudioBlockCacheStatistics& outStatistics) const
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+	outStatistics = m_statistics;
+	outStatistics.blockCount = (uint32_t)m_blocks.size();
+}
+
+void AudioBlockCache::destroy()
+{
+	delete this;
+}
+
+AudioBlockCache::AudioBlockCache()
+{
+	m_statistics.budget = c_defaultBudget;
+}
+
+void AudioBlockCache::evict()
+{
+	while (m_statistics.residentSize > m_statistics.budget && !m_blocks.empty())
+	{
+		auto lru = m_blocks.begin();
+		for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+		{
+			if (it->second.lastUsed < lru->second.lastUsed)
+				lru = it;
+		}
+		m_statistics.residentSize -= lru->second.block->getSize();
+		m_blocks.erase(lru);
+	}
+}
+
+}
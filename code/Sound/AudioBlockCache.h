@@ -0,0 +1,127 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "Core/IRefCount.h"
+#include "Core/Ref.h"
+#include "Core/Containers/SmallMap.h"
+#include "Core/Singleton/ISingleton.h"
+#include "Core/Thread/Semaphore.h"
+#include "Sound/Types.h"
+
+// import/export mechanism.
+#undef T_DLLCLASS
+#if defined(T_SOUND_EXPORT)
+#	define T_DLLCLASS T_DLLEXPORT
+#else
+#	define T_DLLCLASS T_DLLIMPORT
+#endif
+
+namespace traktor::sound
+{
+
+/*! Audio block cache statistics.
+ * \ingroup Sound
+ */
+struct AudioBlockCacheStatistics
+{
+	uint64_t hits = 0;			//!< Number of blocks read from cache.
+	uint64_t misses = 0;		//!< Number of blocks decoded.
+	uint64_t bytesSaved = 0;	//!< Decoded bytes read from cache, ie. not decoded again.
+	uint64_t residentSize = 0;	//!< Size of blocks in cache.
+	uint64_t budget = 0;
+	uint32_t blockCount = 0;
+};
+
+/*! Cache of decoded audio blocks.
+ * \ingroup Sound
+ *
+ * Decoded PCM blocks are shared between all cursors
+ * of a resource, keyed by resource and block index.
+ * Cursors keep a reference to the block they are
+ * reading from thus blocks can be evicted at any time.
+ * Least recently used blocks are evicted when cache
+ * exceed it's budget.
+ */
+class T_DLLCLASS AudioBlockCache : public ISingleton
+{
+public:
+	/*! Number of samples per block. */
+	static constexpr uint32_t BlockSamples = 4096;
+
+	/*! Decoded block of samples, immutable once put into cache. */
+	class T_DLLCLASS Block : public RefCountImpl< IRefCount >
+	{
+	public:
+		float* samples[SbcMaxChannelCount] = { nullptr };
+		uint32_t samplesCount = 0;
+		uint32_t sampleRate = 0;
+		uint32_t maxChannel = 0;
+
+		explicit Block(uint32_t channels);
+
+		virtual ~Block();
+
+		/*! Get size of block in bytes. */
+		uint64_t getSize() const { return uint64_t(BlockSamples) * m_channels * sizeof(float); }
+
+	private:
+		uint32_t m_channels;
+	};
+
+	static AudioBlockCache& getInstance();
+
+	virtual void destroy() override final;
+
+	/*! Allocate unique key for a resource. */
+	uint32_t allocateKey();
+
+	/*! Set maximum size of cached blocks in bytes. */
+	void setBudget(uint64_t budget);
+
+	/*! Get block from cache.
+	 *
+	 * \param key Resource key.
+	 * \param index Block index.
+	 * \return Block, null if not in cache.
+	 */
+	Ref< const Block > get(uint32_t key, uint32_t index);
+
+	/*! Put newly decoded block into cache.
+	 *
+	 * \param key Resource key.
+	 * \param index Block index.
+	 * \param block Decoded block.
+	 */
+	void put(uint32_t key, uint32_t index, const Block* block);
+
+	/*! Remove all blocks of a resource. */
+	void purge(uint32_t key);
+
+	void getStatistics(AudioBlockCacheStatistics& outStatistics) const;
+
+private:
+	struct Entry
+	{
+		Ref< const Block > block;
+		uint64_t lastUsed;
+	};
+
+	mutable Semaphore m_lock;
+	SmallMap< uint64_t, Entry > m_blocks;
+	AudioBlockCacheStatistics m_statistics;
+	uint64_t m_tick = 0;
+	uint32_t m_nextKey = 1;
+
+	AudioBlockCache();
+
+	void evict();
+};
+
+}
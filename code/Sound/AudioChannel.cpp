@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -62,6 +62,7 @@ AudioChannel::AudioChannel(uint32_t id, uint32_t hwSampleRate, uint32_t hwFrameS
 ,	m_playing(false)
 ,	m_allowRepeat(false)
 ,	m_outputSamplesIn(0)
+,	m_mixState(MixState::Idle)
 {
 	const uint32_t outputSamplesCount = hwFrameSamples * c_outputSamplesBlockCount;
 	const uint32_t outputSamplesSize = SbcMaxChannelCount * outputSamplesCount * sizeof(float);
@@ -71,10 +72,16 @@ AudioChannel::AudioChannel(uint32_t id, uint32_t hwSampleRate, uint32_t hwFrameS
 
 	for (uint32_t i = 1; i < SbcMaxChannelCount; ++i)
 		m_outputSamples[i] = m_outputSamples[0] + outputSamplesCount * i;
+
+	const uint32_t filterSamplesCount = alignUp(hwFrameSamples, 4);
+	m_filterSamples[0] = static_cast< float* >(Alloc::acquireAlign(SbcMaxChannelCount * filterSamplesCount * sizeof(float), 16, T_FILE_LINE));
+	for (uint32_t i = 1; i < SbcMaxChannelCount; ++i)
+		m_filterSamples[i] = m_filterSamples[0] + filterSamplesCount * i;
 }
 
 AudioChannel::~AudioChannel()
 {
+	Alloc::freeAlign(m_filterSamples[0]);
 	Alloc::freeAlign(m_outputSamples[0]);
 }
 
@@ -148,7 +155,8 @@ bool AudioChannel::play(
 	handle_t category,
 	float gain,
 	bool repeat,
-	uint32_t repeatFrom
+	uint32_t repeatFrom,
+	float offset
 )
 {
 	if (!buffer)
@@ -165,6 +173,7 @@ bool AudioChannel::play(
 	ss.volume = decibelToLinear(gain);
 	ss.repeat = repeat;
 	ss.repeatFrom = repeatFrom;
+	ss.offset = offset;
 
 	m_allowRepeat = true;
 	m_playing = true;
@@ -199,6 +208,23 @@ bool AudioChannel::getBlock(const IAudioMixer* mixer, AudioBlock& outBlock)
 	const IAudioBuffer* soundBuffer = ss.buffer;
 	T_ASSERT(soundBuffer);
 
+	// Skip samples when starting at an offset.
+	while (ss.offset > 0.0f)
+	{
+		AudioBlock skipBlock = { { 0 }, m_hwFrameSamples, 0, 0 };
+		if (!soundBuffer->getBlock(ss.cursor, mixer, skipBlock))
+		{
+			ss.buffer = nullptr;
+			ss.cursor = nullptr;
+			m_playing = false;
+			return false;
+		}
+		if (!skipBlock.samplesCount || !skipBlock.sampleRate)
+			break;
+		ss.offset -= float(skipBlock.samplesCount) / skipBlock.sampleRate;
+	}
+	ss.offset = 0.0f;
+
 	// Remove old output samples.
 	if (m_outputSamplesIn >= m_hwFrameSamples)
 	{
@@ -268,6 +294,20 @@ bool AudioChannel::getBlock(const IAudioMixer* mixer, AudioBlock& outBlock)
 		const StateFilter& sf = m_stateFilter.read();
 		if (sf.filter)
 		{
+			// Filters modify samples in place; copy shared samples first.
+			if (block.shared)
+			{
+				for (uint32_t i = 0; i < SbcMaxChannelCount; ++i)
+				{
+					if (block.samples[i])
+					{
+						std::memcpy(m_filterSamples[i], block.samples[i], alignUp(block.samplesCount, 4) * sizeof(float));
+						block.samples[i] = m_filterSamples[i];
+					}
+				}
+				block.shared = false;
+			}
+
 			sf.filter->apply(sf.filterInstance, block);
 			T_ASSERT(block.samplesCount <= m_hwFrameSamples);
 		}
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include "Core/Object.h"
 #include "Core/Containers/CircularVector.h"
 #include "Core/Containers/ThreadsafeFifo.h"
@@ -77,6 +78,7 @@ public:
 	 * \param gain Sound gain in dB.
 	 * \param repeat If sound is repeating.
 	 * \param repeatFrom Skip number of samples before repeat.
+	 * \param offset Time, in seconds, into sound where playback starts.
 	 * \return True if sound is playing successfully.
 	 */
 	bool play(
@@ -84,7 +86,8 @@ public:
 		handle_t category,
 		float gain,
 		bool repeat,
-		uint32_t repeatFrom
+		uint32_t repeatFrom,
+		float offset = 0.0f
 	);
 
 	/*! Check if there are a sound playing in this channel. */
@@ -116,6 +119,7 @@ private:
 		float volume = 1.0f;
 		bool repeat = false;
 		uint32_t repeatFrom = 0;
+		float offset = 0.0f;
 	};
 
 	struct StateParameter
@@ -123,6 +127,14 @@ private:
 		CircularVector< std::pair< handle_t, float >, 4 > set;
 	};
 
+	enum class MixState : int32_t
+	{
+		Idle,		//!< No block requested.
+		Queued,		//!< Block requested, not yet claimed by any thread.
+		Running,	//!< Block being generated.
+		Ready		//!< Block ready to be mixed.
+	};
+
 	uint32_t m_id;
 	uint32_t m_hwSampleRate;	//< Hardware sample rate.
 	uint32_t m_hwFrameSamples;	//< Hardware frame size in samples.
@@ -137,7 +149,9 @@ private:
 	StateSound m_stateSound;
 
 	float* m_outputSamples[SbcMaxChannelCount];
+	float* m_filterSamples[SbcMaxChannelCount];	//!< Copy of shared samples, filters modify samples in place.
 	uint32_t m_outputSamplesIn;
+	std::atomic< MixState > m_mixState;
 };
 
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -166,6 +166,7 @@ void AudioClassFactory::createClasses(IRuntimeClassRegistrar* registrar) const
 	classSoundHandle->addMethod("stop", &SoundHandle::stop);
 	classSoundHandle->addMethod("fadeOff", &SoundHandle::fadeOff);
 	classSoundHandle->addMethod("isPlaying", &SoundHandle::isPlaying);
+	classSoundHandle->addMethod("isVirtual", &SoundHandle::isVirtual);
 	classSoundHandle->addMethod("setVolume", &SoundHandle::setVolume);
 	classSoundHandle->addMethod("setPitch", &SoundHandle::setPitch);
 	classSoundHandle->addMethod("setPosition", &SoundHandle::setPosition);
@@ -175,6 +176,7 @@ void AudioClassFactory::createClasses(IRuntimeClassRegistrar* registrar) const
 	auto classSoundPlayer = new AutoRuntimeClass< SoundPlayer >();
 	classSoundPlayer->addMethod< Ref< SoundHandle >, const Sound*, uint32_t >("play", &SoundPlayer::play);
 	classSoundPlayer->addMethod< Ref< SoundHandle >, const Sound*, const Vector4&, uint32_t, bool >("play", &SoundPlayer::play);
+	classSoundPlayer->addMethod("setAudibilityThreshold", &SoundPlayer::setAudibilityThreshold);
 	registrar->registerClass(classSoundPlayer);
 
 	auto classBankBuffer = new AutoRuntimeClass< BankBuffer >();
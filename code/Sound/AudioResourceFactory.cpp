@@ -10,6 +10,7 @@
 #include "Sound/AudioResourceFactory.h"
 #include "Sound/IAudioResource.h"
 #include "Sound/Sound.h"
+#include "Sound/StaticAudioBuffer.h"
 
 namespace traktor::sound
 {
@@ -49,4 +50,15 @@ void AudioResourceFactory::destroy(Object* resource) const
 {
 }
 
+uint64_t AudioResourceFactory::getProductSize(const Object* product) const
+{
+	// Only static buffers are accounted, streamed buffers only hold a small decode buffer.
+	if (auto sound = dynamic_type_cast< const Sound* >(product))
+	{
+		if (auto staticBuffer = dynamic_type_cast< const StaticAudioBuffer* >(sound->getBuffer()))
+			return staticBuffer->getSamplesDataSize();
+	}
+	return 0;
+}
+
 }
@@ -40,6 +40,8 @@ public:
 	virtual Ref< Object > create(resource::IResourceManager* resourceManager, const db::Database* database, const db::Instance* instance, const TypeInfo& productType, const Object* current) const override final;
 
 	virtual void destroy(Object* resource) const override final;
+
+	virtual uint64_t getProductSize(const Object* product) const override final;
 };
 
 }
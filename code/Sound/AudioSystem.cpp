@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -30,6 +30,15 @@
 
 namespace traktor::sound
 {
+	namespace
+	{
+
+const uint32_t c_parallelMinChannels = 8;	//!< Minimum number of channels before blocks are generated in parallel.
+const uint32_t c_channelsPerJob = 4;		//!< Number of channels per job.
+const uint32_t c_channelWorkers = 2;		//!< Number of worker threads generating channel blocks.
+const double c_deadline = 0.5;				//!< Deadline, in fraction of frame duration, of channel blocks being generated by other threads.
+
+	}
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.sound.AudioSystem", AudioSystem, Object)
 
@@ -41,6 +50,8 @@ AudioSystem::AudioSystem(IAudioDriver* driver)
 ,	m_samplesData(0)
 ,	m_time(0.0)
 ,	m_mixerThreadTime(0.0)
+,	m_lateChannels(0)
+,	m_channelJobs(0)
 {
 }
 
@@ -83,6 +94,14 @@ bool AudioSystem::create(const AudioSystemCreateDesc& desc)
 	for (uint32_t i = 0; i < samplesBlockCount; ++i)
 		m_samplesBlocks.push_back(&m_samplesData[i * samplesPerBlock]);
 
+	// Channel blocks are generated on our own workers so mixing isn't queued
+	// behind game jobs or resource loads; generate sequentially if workers cannot be created.
+	if (m_desc.parallel && !m_channelQueue.create(c_channelWorkers, Thread::Above))
+	{
+		log::warning << L"Unable to create channel workers; channel blocks generated sequentially." << Endl;
+		m_desc.parallel = false;
+	}
+
 	// Create mixer and submission threads.
 	m_threadMixer = ThreadManager::getInstance().create([=, this](){ threadMixer(); }, L"Sound mixer", 1);
 	if (!m_threadMixer)
@@ -116,6 +135,7 @@ void AudioSystem::destroy()
 	// Release all channels to ensure submission thread no longer tries to request blocks from channels.
 	{
 		m_channelsLock.wait();
+		waitChannelJobs();
 		m_channels.clear();
 		m_channelsLock.release();
 	}
@@ -128,6 +148,8 @@ void AudioSystem::destroy()
 		m_threadMixer = nullptr;
 	}
 
+	m_channelQueue.destroy();
+
 	// Free mixer and memory resources.
 	m_mixer = nullptr;
 	safeDestroy(m_driver);
@@ -173,6 +195,9 @@ void AudioSystem::suspend()
 		m_threadMixer = nullptr;
 	}
 
+	// Channel jobs might still use mixer.
+	waitChannelJobs();
+
 	// Destroy driver; but keep pointer to driver, as we will re-create it.
 	if (m_driver)
 		m_driver->destroy();
@@ -258,13 +283,16 @@ double AudioSystem::getTime() const
 	return m_time;
 }
 
-void AudioSystem::getThreadPerformances(double& outMixerTime) const
+void AudioSystem::getThreadPerformances(double& outMixerTime, uint32_t& outLateChannels) const
 {
 	outMixerTime = m_mixerThreadTime;
+	outLateChannels = m_lateChannels;
 }
 
 void AudioSystem::threadMixer()
 {
+	Thread* currentThread = ThreadManager::getInstance().getCurrentThread();
+	const double frameDuration = double(m_desc.driverDesc.frameSamples) / m_desc.driverDesc.sampleRate;
 	AudioBlock frameBlock;
 	Timer timerMixer;
 	uint32_t channelsCount;
@@ -278,15 +306,49 @@ void AudioSystem::threadMixer()
 		m_channelsLock.wait();
 		{
 			channelsCount = (uint32_t)m_channels.size();
+
+			// Request new blocks from idle channels; channels which missed
+			// deadline of previous frame are still being generated or are
+			// ready to be mixed.
 			for (uint32_t i = 0; i < channelsCount; ++i)
 			{
+				AudioChannel* channel = m_channels[i];
+				if (channel->m_mixState.load(std::memory_order_acquire) != AudioChannel::MixState::Idle)
+					continue;
+
 				m_requestBlocks[i].samplesCount = m_desc.driverDesc.frameSamples;
 				m_requestBlocks[i].maxChannel = 0;
 				m_requestBlocks[i].category = 0;
-				m_channels[i]->getBlock(m_mixer, m_requestBlocks[i]);
+				channel->m_mixState.store(AudioChannel::MixState::Queued, std::memory_order_release);
+			}
+
+			// Generate blocks in parallel, mixer thread process channels from
+			// the end to reduce contention with jobs.
+			if (m_desc.parallel && channelsCount >= c_parallelMinChannels)
+			{
+				for (uint32_t first = 0; first < channelsCount; first += c_channelsPerJob)
+				{
+					const uint32_t last = std::min(first + c_channelsPerJob, channelsCount);
+					++m_channelJobs;
+					m_channelQueue.add([=, this]() {
+						generateBlocks(first, last, false);
+						--m_channelJobs;
+					});
+				}
+			}
+			generateBlocks(0, channelsCount, true);
+
+			// Wait for blocks being generated by other threads, until deadline.
+			const double deadline = startTime + frameDuration * c_deadline;
+			for (uint32_t i = 0; i < channelsCount; ++i)
+			{
+				while (
+					m_channels[i]->m_mixState.load(std::memory_order_acquire) == AudioChannel::MixState::Running &&
+					timerMixer.getElapsedTime() < deadline
+				)
+					currentThread->yield();
 			}
 		}
-		m_channelsLock.release();
 
 		// Allocate new frame block.
 		float* samples = m_samplesBlocks.front();
@@ -305,40 +367,53 @@ void AudioSystem::threadMixer()
 		// Final combine channels into hardware channels using "combine matrix".
 		for (uint32_t i = 0; i < channelsCount; ++i)
 		{
-			if (!m_requestBlocks[i].maxChannel)
+			AudioChannel* channel = m_channels[i];
+			if (channel->m_mixState.load(std::memory_order_acquire) != AudioChannel::MixState::Ready)
+			{
+				m_lateChannels++;
 				continue;
+			}
 
-			T_ASSERT(m_requestBlocks[i].sampleRate == m_desc.driverDesc.sampleRate);
-			T_ASSERT(m_requestBlocks[i].samplesCount == m_desc.driverDesc.frameSamples);
-
-			const float categoryVolume = getVolume(m_requestBlocks[i].category);
-			const float finalVolume = m_volume * categoryVolume;
-
-			for (uint32_t k = 0; k < m_requestBlocks[i].maxChannel; ++k)
+			if (m_requestBlocks[i].maxChannel)
 			{
-				if (!m_requestBlocks[i].samples[k])
-					continue;
+				T_ASSERT(m_requestBlocks[i].sampleRate == m_desc.driverDesc.sampleRate);
+				T_ASSERT(m_requestBlocks[i].samplesCount == m_desc.driverDesc.frameSamples);
 
-				for (uint32_t j = 0; j < m_desc.driverDesc.hwChannels; ++j)
+				const float categoryVolume = getVolume(m_requestBlocks[i].category);
+				const float finalVolume = m_volume * categoryVolume;
+
+				for (uint32_t k = 0; k < m_requestBlocks[i].maxChannel; ++k)
 				{
-					const float strength = m_desc.cm[j][k] * finalVolume;
-					if (abs(strength) >= FUZZY_EPSILON)
+					if (!m_requestBlocks[i].samples[k])
+						continue;
+
+					for (uint32_t j = 0; j < m_desc.driverDesc.hwChannels; ++j)
 					{
-						m_mixer->addMulConst(
-							frameBlock.samples[j],
-							m_requestBlocks[i].samples[k],
-							m_requestBlocks[i].samplesCount,
-							strength
-						);
+						const float strength = m_desc.cm[j][k] * finalVolume;
+						if (abs(strength) >= FUZZY_EPSILON)
+						{
+							m_mixer->addMulConst(
+								frameBlock.samples[j],
+								m_requestBlocks[i].samples[k],
+								m_requestBlocks[i].samplesCount,
+								strength
+							);
+						}
 					}
-				}
 
-				m_mixer->synchronize();
+					m_mixer->synchronize();
+				}
 			}
+
+			channel->m_mixState.store(AudioChannel::MixState::Idle, std::memory_order_release);
 		}
+		m_channelsLock.release();
 
 		m_time += double(m_desc.driverDesc.frameSamples) / m_desc.driverDesc.sampleRate;
 
+		const double endTime = timerMixer.getElapsedTime();
+		m_mixerThreadTime = (endTime - startTime) * 0.1 + m_mixerThreadTime * 0.9;
+
 		if (m_threadMixer->stopped())
 			break;
 
@@ -348,10 +423,31 @@ void AudioSystem::threadMixer()
 
 		// Move block back into heap.
 		m_samplesBlocks.push_back(frameBlock.samples[0]);
+	}
+}
 
-		const double endTime = timerMixer.getElapsedTime();
-		m_mixerThreadTime = (endTime - startTime) * 0.1 + m_mixerThreadTime * 0.9;
+void AudioSystem::generateBlocks(uint32_t first, uint32_t last, bool reverse)
+{
+	for (uint32_t j = first; j < last; ++j)
+	{
+		const uint32_t i = reverse ? (last - 1 - (j - first)) : j;
+		AudioChannel* channel = m_channels[i];
+
+		// Claim channel, might already have been claimed by another thread.
+		AudioChannel::MixState expected = AudioChannel::MixState::Queued;
+		if (!channel->m_mixState.compare_exchange_strong(expected, AudioChannel::MixState::Running, std::memory_order_acq_rel))
+			continue;
+
+		channel->getBlock(m_mixer, m_requestBlocks[i]);
+		channel->m_mixState.store(AudioChannel::MixState::Ready, std::memory_order_release);
 	}
 }
 
+void AudioSystem::waitChannelJobs()
+{
+	Thread* currentThread = ThreadManager::getInstance().getCurrentThread();
+	while (m_channelJobs > 0)
+		currentThread->yield();
+}
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,12 +8,14 @@
  */
 #pragma once
 
+#include <atomic>
 #include "Core/Object.h"
 #include "Core/RefArray.h"
 #include "Core/Containers/AlignedVector.h"
 #include "Core/Containers/CircularVector.h"
 #include "Core/Containers/SmallMap.h"
 #include "Core/Thread/Event.h"
+#include "Core/Thread/JobQueue.h"
 #include "Core/Thread/Semaphore.h"
 #include "Core/Thread/Thread.h"
 #include "Sound/Types.h"
@@ -40,6 +42,13 @@ class Sound;
  * The AudioSystem class manages mixing sounds
  * from virtual channels and feeding them through the
  * submission thread into the audio driver for playback.
+ *
+ * Channel blocks are generated in parallel on a small
+ * job queue owned by the audio system, with the mixer thread
+ * generating blocks as well. The mixer thread only waits for
+ * blocks being generated by other threads until a deadline;
+ * channels can still be late when the workers are preempted,
+ * a late channel is mixed in the next frame instead.
  */
 class T_DLLCLASS AudioSystem : public Object
 {
@@ -121,9 +130,10 @@ public:
 
 	/*! Query performance of each thread.
 	 *
-	 * \param outMixerTime Last mixer thread duration in seconds.
+	 * \param outMixerTime Last mixer thread duration in seconds, excluding time waiting for driver.
+	 * \param outLateChannels Total number of channel blocks which missed mixer deadline.
 	 */
-	void getThreadPerformances(double& outMixerTime) const;
+	void getThreadPerformances(double& outMixerTime, uint32_t& outLateChannels) const;
 
 private:
 	Ref< IAudioDriver > m_driver;
@@ -140,6 +150,7 @@ private:
 	// \{
 
 	Semaphore m_channelsLock;
+	JobQueue m_channelQueue;
 
 	// \}
 
@@ -153,8 +164,16 @@ private:
 
 	double m_time;
 	double m_mixerThreadTime;
+	std::atomic< uint32_t > m_lateChannels;
+	std::atomic< int32_t > m_channelJobs;
 
 	void threadMixer();
+
+	/*! Generate blocks of queued channels in range. */
+	void generateBlocks(uint32_t first, uint32_t last, bool reverse);
+
+	/*! Wait until no channel job is running. */
+	void waitChannelJobs();
 };
 
 }
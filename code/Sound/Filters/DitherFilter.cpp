@@ -1,11 +1,14 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2023 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
+#include <atomic>
+#include <ctime>
+#include "Core/Math/Random.h"
 #include "Sound/Filters/DitherFilter.h"
 
 namespace traktor::sound
@@ -15,8 +18,16 @@ namespace traktor::sound
 
 struct DitherFilterInstance : public RefCountImpl< IAudioFilterInstance >
 {
+	Random m_random;
+
+	explicit DitherFilterInstance(uint32_t seed)
+	:	m_random(seed)
+	{
+	}
 };
 
+std::atomic< uint32_t > s_seed = uint32_t(clock());
+
 	}
 
 T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.sound.DitherFilter", 0, DitherFilter, IAudioFilter)
@@ -28,14 +39,16 @@ DitherFilter::DitherFilter(uint32_t bitsPerSample)
 
 Ref< IAudioFilterInstance > DitherFilter::createInstance() const
 {
-	return new DitherFilterInstance();
+	return new DitherFilterInstance(s_seed++ * 2654435761U);
 }
 
 void DitherFilter::apply(IAudioFilterInstance* instance, AudioBlock& outBlock) const
 {
+	// Channels are mixed concurrently thus each filter instance has it's own generator.
+	DitherFilterInstance* dfi = static_cast< DitherFilterInstance* >(instance);
 	for (uint32_t i = 0; i < outBlock.samplesCount; ++i)
 	{
-		const float r = (float)((m_random.nextDouble() * 2.0 - 1.0) * m_ditherAmplitude);
+		const float r = (float)((dfi->m_random.nextDouble() * 2.0 - 1.0) * m_ditherAmplitude);
 		for (uint32_t j = 0; j < outBlock.maxChannel; ++j)
 			outBlock.samples[j][i] += r;
 	}
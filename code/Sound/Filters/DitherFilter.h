@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2023 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -9,7 +9,6 @@
 #pragma once
 
 #include "Sound/IAudioFilter.h"
-#include "Core/Math/Random.h"
 
 // import/export mechanism.
 #undef T_DLLCLASS
@@ -40,7 +39,6 @@ public:
 
 private:
 	float m_ditherAmplitude;
-	mutable Random m_random;
 };
 
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -49,6 +49,12 @@ public:
 	virtual Ref< IAudioBufferCursor > createCursor() const = 0;
 
 	virtual bool getBlock(IAudioBufferCursor* cursor, const IAudioMixer* mixer, AudioBlock& outBlock) const = 0;
+
+	/*! Get duration of buffer in seconds.
+	 *
+	 * \return Duration, zero if unknown or infinite.
+	 */
+	virtual double getDuration() const;
 };
 
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -25,33 +25,50 @@ void SoundHandle::stop()
 
 void SoundHandle::fadeOff()
 {
-	if (m_fadeOff)
-		*m_fadeOff = 1.0f;
+	if (m_active)
+		m_fadeOff = 1.0f;
 
 	detach();
 }
 
 bool SoundHandle::isPlaying()
 {
-	return m_channel ? m_channel->isPlaying() : false;
+	if (!m_active)
+		return false;
+
+	// Virtual sounds are playing until player expire them.
+	return m_channel ? m_channel->isPlaying() : true;
+}
+
+bool SoundHandle::isVirtual() const
+{
+	return m_active && m_channel == nullptr;
 }
 
 void SoundHandle::setVolume(float volume)
 {
+	if (!m_active)
+		return;
+
+	m_volume = volume;
 	if (m_channel)
 		m_channel->setVolume(volume);
 }
 
 void SoundHandle::setPitch(float pitch)
 {
+	if (!m_active)
+		return;
+
+	m_pitch = pitch;
 	if (m_channel)
 		m_channel->setPitch(pitch);
 }
 
 void SoundHandle::setPosition(const Vector4& position)
 {
-	if (m_position)
-		*m_position = position.xyz1();
+	if (m_active)
+		m_position = position.xyz1();
 }
 
 void SoundHandle::setParameter(int32_t id, float parameter)
@@ -65,18 +82,10 @@ IAudioBufferCursor* SoundHandle::getCursor()
 	return m_channel ? m_channel->getCursor() : nullptr;
 }
 
-SoundHandle::SoundHandle(AudioChannel* channel, Vector4& position, float& fadeOff)
-:	m_channel(channel)
-,	m_position(&position)
-,	m_fadeOff(&fadeOff)
-{
-}
-
 void SoundHandle::detach()
 {
 	m_channel = nullptr;
-	m_position = 0;
-	m_fadeOff = 0;
+	m_active = false;
 }
 
 }
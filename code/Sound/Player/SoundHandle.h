@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -25,6 +25,15 @@ namespace traktor::sound
 class AudioChannel;
 class IAudioBufferCursor;
 
+/*! Handle to sound played through sound player.
+ * \ingroup Sound
+ *
+ * A sound can either be real, ie. mixed through a physical
+ * channel, or virtual when it's inaudible or there are more
+ * important sounds occupying all channels. Handle keeps it's
+ * state thus sound is restored when it's promoted to a real
+ * channel again.
+ */
 class T_DLLCLASS SoundHandle : public Object
 {
 	T_RTTI_CLASS;
@@ -36,6 +45,9 @@ public:
 
 	bool isPlaying();
 
+	/*! Check if sound is virtual, ie. tracked but not mixed. */
+	bool isVirtual() const;
+
 	void setVolume(float volume);
 
 	void setPitch(float pitch);
@@ -49,11 +61,14 @@ public:
 private:
 	friend class SoundPlayer;
 
-	AudioChannel* m_channel;
-	Vector4* m_position;
-	float* m_fadeOff;
+	AudioChannel* m_channel = nullptr;	//!< Physical channel, null while virtual.
+	Vector4 m_position = Vector4::zero();
+	float m_fadeOff = -1.0f;
+	float m_volume = 1.0f;
+	float m_pitch = 1.0f;
+	bool m_active = true;
 
-	SoundHandle(AudioChannel* channel, Vector4& position, float& fadeOff);
+	SoundHandle() = default;
 
 	void detach();
 };
@@ -1,16 +1,19 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
+#include <algorithm>
+#include <limits>
 #include "Core/Math/Const.h"
 #include "Core/Math/Float.h"
 #include "Core/Thread/Acquire.h"
 #include "Sound/AudioChannel.h"
 #include "Sound/AudioSystem.h"
+#include "Sound/IAudioBuffer.h"
 #include "Sound/Sound.h"
 #include "Sound/Filters/GroupFilter.h"
 #include "Sound/Filters/LowPassFilter.h"
@@ -28,6 +31,10 @@ namespace traktor::sound
 const float c_nearCutOff = 25000.0f;
 const float c_farCutOff = 0.1f;
 const float c_recentTimeOffset = 1.0f / 30.0f;
+const float c_audibilityThreshold = 0.01f;	//!< Default audibility threshold, approximately -40 dB.
+const float c_realBias = 1.25f;				//!< Ranking bias of real voices, prevent voices from flapping between real and virtual.
+const float c_minPromoteTime = 0.1f;		//!< Minimum remaining time of voice in order to be promoted.
+const uint32_t c_maxVoices = 4096;
 
 handle_t s_handleDistance = 0;
 handle_t s_handleVelocity = 0;
@@ -37,6 +44,7 @@ handle_t s_handleVelocity = 0;
 T_IMPLEMENT_RTTI_CLASS(L"traktor.sound.SoundPlayer", SoundPlayer, Object)
 
 SoundPlayer::SoundPlayer()
+:	m_audibilityThreshold(c_audibilityThreshold)
 {
 	s_handleDistance = getParameterHandle(L"Distance");
 	s_handleVelocity = getParameterHandle(L"Velocity");
@@ -51,7 +59,6 @@ bool SoundPlayer::create(AudioSystem* audioSystem, SurroundEnvironment* surround
 	{
 		Channel ch;
 		ch.audioChannel = m_audioSystem->getChannel(i);
-		ch.priority = ~0U;
 		m_channels.push_back(ch);
 	}
 
@@ -63,15 +70,14 @@ void SoundPlayer::destroy()
 {
 	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
 
-	for (auto& channel : m_channels)
+	for (auto& voice : m_voices)
 	{
-		if (channel.handle)
-		{
-			channel.handle->stop();
-			channel.handle = nullptr;
-		}
+		if (voice.channel >= 0)
+			m_channels[voice.channel].audioChannel->stop();
+		voice.handle->detach();
 	}
 
+	m_voices.clear();
 	m_channels.clear();
 	m_surroundEnvironment = nullptr;
 	m_audioSystem = nullptr;
@@ -82,82 +88,18 @@ Ref< SoundHandle > SoundPlayer::play(const Sound* sound, uint32_t priority)
 	if (!sound)
 		return nullptr;
 
-	{
-		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
-
-		const float time = float(m_timer.getElapsedTime());
-
-		// First check if this sound already has been recently played.
-		for (const auto& channel : m_channels)
-		{
-			if (channel.sound == sound && channel.time + c_recentTimeOffset >= time)
-				return nullptr;
-		}
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
 
-		// First try to associate sound with non-playing channel.
-		for (auto& channel : m_channels)
-		{
-			if (!channel.audioChannel->isPlaying())
-			{
-				if (channel.handle)
-					channel.handle->detach();
-
-				channel.position = Vector4::zero();
-				channel.surroundFilter = nullptr;
-				channel.lowPassFilter = nullptr;
-				channel.sound = sound;
-				channel.audioChannel->play(
-					sound->getBuffer(),
-					sound->getCategory(),
-					sound->getGain(),
-					false,
-					0
-				);
-				channel.audioChannel->setFilter(nullptr);
-				channel.audioChannel->setVolume(1.0f);
-				channel.priority = priority;
-				channel.fadeOff = -1.0f;
-				channel.time = time;
-				channel.autoStopFar = false;
-				channel.handle = new SoundHandle(channel.audioChannel, channel.position, channel.fadeOff);
-
-				return channel.handle;
-			}
-		}
+	const float time = float(m_timer.getElapsedTime());
 
-		// Then try to associate sound with lesser priority channel.
-		for (auto& channel : m_channels)
-		{
-			if (priority >= channel.priority)
-			{
-				if (channel.handle)
-					channel.handle->detach();
-
-				channel.position = Vector4::zero();
-				channel.surroundFilter = nullptr;
-				channel.lowPassFilter = nullptr;
-				channel.sound = sound;
-				channel.audioChannel->play(
-					sound->getBuffer(),
-					sound->getCategory(),
-					sound->getGain(),
-					false,
-					0
-				);
-				channel.audioChannel->setFilter(nullptr);
-				channel.audioChannel->setVolume(1.0f);
-				channel.priority = priority;
-				channel.fadeOff = -1.0f;
-				channel.time = time;
-				channel.autoStopFar = false;
-				channel.handle = new SoundHandle(channel.audioChannel, channel.position, channel.fadeOff);
-
-				return channel.handle;
-			}
-		}
+	// First check if this sound already has been recently played.
+	for (const auto& voice : m_voices)
+	{
+		if (voice.sound == sound && voice.time + c_recentTimeOffset >= time)
+			return nullptr;
 	}
 
-	return nullptr;
+	return allocate(sound, Vector4::zero(), priority, false, time);
 }
 
 Ref< SoundHandle > SoundPlayer::play(const Sound* sound, const Vector4& position, uint32_t priority, bool autoStopFar)
@@ -168,144 +110,10 @@ Ref< SoundHandle > SoundPlayer::play(const Sound* sound, const Vector4& position
 	if (!m_surroundEnvironment)
 		return play(sound, priority);
 
-	const float time = float(m_timer.getElapsedTime());
-
-	float maxDistance = sound->getRange();
-	if (maxDistance <= m_surroundEnvironment->getInnerRadius())
-		maxDistance = m_surroundEnvironment->getMaxDistance();
-
-	Scalar distance = Scalar(std::numeric_limits< float >::max());
-	for (const auto& listenerTransform : m_surroundEnvironment->getListenerTransforms())
-	{
-		const Vector4 listenerPosition = listenerTransform.translation().xyz1();
-		const Scalar listenerDistance = (position - listenerPosition).xyz0().length();
-		distance = std::min(distance, listenerDistance);
-	}
-	if (autoStopFar && distance > maxDistance)
-		return nullptr;
-
-	const float k0 = distance / maxDistance;
-	const float k1 = (distance - m_surroundEnvironment->getInnerRadius()) / (maxDistance - m_surroundEnvironment->getInnerRadius());
-
-	// Surround filter.
-	Ref< SurroundFilter > surroundFilter = new SurroundFilter(m_surroundEnvironment, position.xyz1(), maxDistance);
-
-	// Calculate initial cut-off frequency.
-	const float cutOff = lerp(c_nearCutOff, c_farCutOff, clamp(std::sqrt(k0), 0.0f, 1.0f));
-	Ref< LowPassFilter > lowPassFilter = new LowPassFilter(cutOff);
-
-	Ref< GroupFilter > groupFilter = new GroupFilter(lowPassFilter, surroundFilter);
-	{
-		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
-
-		// First check if this sound already has been recently played.
-		//for (const auto& channel : m_channels)
-		//{
-		//	if (channel.sound == sound && channel.time + c_recentTimeOffset >= time)
-		//		return nullptr;
-		//}
-
-		// First try to associate sound with non-playing channel.
-		for (auto& channel : m_channels)
-		{
-			const Scalar channelDistance = (channel.position - distance).xyz0().length();
-			if (!channel.audioChannel->isPlaying())
-			{
-				if (channel.handle)
-					channel.handle->detach();
-
-				channel.position = position.xyz1();
-				channel.surroundFilter = surroundFilter;
-				channel.lowPassFilter = lowPassFilter;
-				channel.sound = sound;
-				channel.audioChannel->play(
-					sound->getBuffer(),
-					sound->getCategory(),
-					sound->getGain(),
-					false,
-					0
-				);
-				channel.audioChannel->setFilter(groupFilter);
-				channel.audioChannel->setVolume(1.0f);
-				channel.priority = priority;
-				channel.fadeOff = -1.0f;
-				channel.time = time;
-				channel.autoStopFar = autoStopFar;
-				channel.handle = new SoundHandle(channel.audioChannel, channel.position, channel.fadeOff);
-
-				return channel.handle;
-			}
-		}
-
-		// Then try to associate sound with lesser priority channel.
-		for (auto& channel : m_channels)
-		{
-			if (priority > channel.priority)
-			{
-				if (channel.handle)
-					channel.handle->detach();
-
-				channel.position = position.xyz1();
-				channel.surroundFilter = surroundFilter;
-				channel.lowPassFilter = lowPassFilter;
-				channel.sound = sound;
-				channel.audioChannel->play(
-					sound->getBuffer(),
-					sound->getCategory(),
-					sound->getGain(),
-					false,
-					0
-				);
-				channel.audioChannel->setFilter(groupFilter);
-				channel.audioChannel->setVolume(1.0f);
-				channel.priority = priority;
-				channel.fadeOff = -1.0f;
-				channel.time = time;
-				channel.autoStopFar = autoStopFar;
-				channel.handle = new SoundHandle(channel.audioChannel, channel.position, channel.fadeOff);
-
-				return channel.handle;
-			}
-		}
-
-		// Then try to associate sound with similar priority channel but further away.
-		for (auto& channel : m_channels)
-		{
-			const Scalar channelDistance = (channel.position - distance).xyz0().length();
-			if (
-				priority == channel.priority &&
-				channel.position.w() > 0.5_simd &&
-				distance < channelDistance
-			)
-			{
-				if (channel.handle)
-					channel.handle->detach();
-
-				channel.position = position.xyz1();
-				channel.surroundFilter = surroundFilter;
-				channel.lowPassFilter = lowPassFilter;
-				channel.sound = sound;
-				channel.audioChannel->play(
-					sound->getBuffer(),
-					sound->getCategory(),
-					sound->getGain(),
-					false,
-					0
-				);
-				channel.audioChannel->setFilter(groupFilter);
-				channel.audioChannel->setVolume(1.0f);
-				channel.priority = priority;
-				channel.fadeOff = -1.0f;
-				channel.time = time;
-				channel.autoStopFar = autoStopFar;
-				channel.handle = new SoundHandle(channel.audioChannel, channel.position, channel.fadeOff);
-
-				return channel.handle;
-			}
-		}
-	}
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
 
-	return nullptr;
+	const float time = float(m_timer.getElapsedTime());
+	return allocate(sound, position.xyz1(), priority, autoStopFar, time);
 }
 
 void SoundPlayer::addListener(const SoundListener* listener)
@@ -324,79 +132,302 @@ void SoundPlayer::update(float dT)
 {
 	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
 
+	const float time = float(m_timer.getElapsedTime());
+
+	// Update listener transforms.
 	if (m_surroundEnvironment)
 	{
-		// Update listener transforms.
 		SurroundEnvironment::listenerTransformVector_t listenerTransforms;
 		for (auto listener : m_listeners)
 			listenerTransforms.push_back(listener->getTransform());
 		m_surroundEnvironment->setListenerTransforms(listenerTransforms);
+	}
+
+	// Release finished voices and evaluate loudness of remaining voices.
+	for (uint32_t i = 0; i < m_voices.size(); )
+	{
+		Voice& voice = m_voices[i];
+		const SoundHandle* handle = voice.handle;
 
-		// Update surround and low pass filters on playing 3d sounds.
-		for (auto& channel : m_channels)
+		bool alive;
+		if (voice.channel >= 0)
 		{
-			// Skip non-playing or non-positional sounds.
-			if (!channel.audioChannel->isPlaying() || channel.position.w() < 0.5f)
-				continue;
+			// Real voices are alive until channel has finished or fade off has completed.
+			alive = m_channels[voice.channel].audioChannel->isPlaying() && (handle->m_active || handle->m_fadeOff > 0.0f);
+		}
+		else if (voice.duration > 0.0f)
+		{
+			// Virtual voices expire when they would have finished playing.
+			alive = handle->m_active && (time - voice.time) < voice.duration;
+		}
+		else
+		{
+			// Unknown duration; keep virtual voice as long as someone else then me have a reference to the handle.
+			alive = handle->m_active && handle->getReferenceCount() > 1;
+		}
 
-			float maxDistance = channel.sound->getRange();
-			if (maxDistance <= m_surroundEnvironment->getInnerRadius())
-				maxDistance = m_surroundEnvironment->getMaxDistance();
+		if (alive && evaluate(voice))
+			++i;
+		else
+			release(i);
+	}
 
-			// Calculate distance from listener; automatically stop sounds which has moved outside max listener distance.
-			Scalar distance = Scalar(std::numeric_limits< float >::max());
-			for (const auto& listenerTransform : listenerTransforms)
-			{
-				const Vector4 listenerPosition = listenerTransform.translation().xyz1();
-				const Scalar listenerDistance = (channel.position - listenerPosition).xyz0().length();
-				distance = std::min(distance, listenerDistance);
-			}
-			if (channel.autoStopFar && distance > maxDistance)
-			{
-				if (channel.handle)
-					channel.handle->detach();
-
-				channel.position = Vector4::zero();
-				channel.sound = nullptr;
-				channel.audioChannel->setFilter(0);
-				channel.audioChannel->stop();
-				continue;
-			}
+	// Rank audible voices; only the most important are mixed through physical channels.
+	m_ranking.resize(0);
+	for (uint32_t i = 0; i < m_voices.size(); ++i)
+	{
+		Voice& voice = m_voices[i];
+		voice.selected = false;
+		if (voice.loudness >= m_audibilityThreshold && (voice.channel >= 0 || voice.handle->m_active))
+			m_ranking.push_back(i);
+	}
+
+	const uint32_t nreal = std::min< uint32_t >((uint32_t)m_ranking.size(), (uint32_t)m_channels.size());
+	if (m_ranking.size() > nreal)
+	{
+		uint32_t* ranking = m_ranking.ptr();
+		std::nth_element(ranking, ranking + nreal, ranking + m_ranking.size(), [&](uint32_t lh, uint32_t rh) {
+			const Voice& vl = m_voices[lh];
+			const Voice& vr = m_voices[rh];
+			return vl.score * (vl.channel >= 0 ? c_realBias : 1.0f) > vr.score * (vr.channel >= 0 ? c_realBias : 1.0f);
+		});
+	}
+	for (uint32_t i = 0; i < nreal; ++i)
+		m_voices[m_ranking[i]].selected = true;
+
+	// Demote real voices which are no longer selected first, so their channels can be reused.
+	for (auto& voice : m_voices)
+	{
+		if (voice.channel >= 0 && !voice.selected)
+			demote(voice);
+	}
+	for (auto& voice : m_voices)
+	{
+		if (voice.channel < 0 && voice.selected)
+			promote(voice, time);
+	}
+
+	// Update filters and fade-off of real voices.
+	for (auto& voice : m_voices)
+	{
+		if (voice.channel < 0)
+			continue;
+
+		SoundHandle* handle = voice.handle;
+		AudioChannel* audioChannel = m_channels[voice.channel].audioChannel;
 
+		if (m_surroundEnvironment && handle->m_position.w() > 0.5_simd)
+		{
 			// Calculate cut-off frequency.
-			const float k0 = clamp< float >(distance / maxDistance, 0.0f, 1.0f);
+			const float k0 = clamp< float >(voice.distance / voice.maxDistance, 0.0f, 1.0f);
 
 			// Set filter parameters.
-			if (channel.surroundFilter)
-				channel.surroundFilter->setSpeakerPosition(channel.position);
-			if (channel.lowPassFilter)
+			if (voice.surroundFilter)
+				voice.surroundFilter->setSpeakerPosition(handle->m_position);
+			if (voice.lowPassFilter)
 			{
 				const float cutOff = lerp(c_nearCutOff, c_farCutOff, std::sqrt(k0));
-				channel.lowPassFilter->setCutOff(cutOff);
+				voice.lowPassFilter->setCutOff(cutOff);
 			}
 
 			// Set automatic sound parameters.
-			channel.audioChannel->setParameter(s_handleDistance, k0);
-			channel.audioChannel->setParameter(s_handleVelocity, 0.0f);
+			audioChannel->setParameter(s_handleDistance, k0);
+			audioChannel->setParameter(s_handleVelocity, 0.0f);
 
 			// Disable repeat if no-one else then me have a reference to the handle.
-			if (!channel.handle || channel.handle->getReferenceCount() <= 1)
-				channel.audioChannel->disableRepeat();
+			if (handle->getReferenceCount() <= 1)
+				audioChannel->disableRepeat();
+		}
+
+		if (handle->m_fadeOff > 0.0f)
+		{
+			handle->m_fadeOff -= std::min(dT, 1.0f / 60.0f);
+			if (handle->m_fadeOff > 0.0f)
+				audioChannel->setVolume(handle->m_volume * handle->m_fadeOff);
+			else
+				audioChannel->stop();
+		}
+	}
+}
+
+void SoundPlayer::setAudibilityThreshold(float threshold)
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+	m_audibilityThreshold = threshold;
+}
+
+void SoundPlayer::getVoiceCounts(uint32_t& outVoices, uint32_t& outVirtualVoices) const
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_lock);
+
+	outVoices = (uint32_t)m_voices.size();
+	outVirtualVoices = 0;
+	for (const auto& voice : m_voices)
+	{
+		if (voice.channel < 0)
+			outVirtualVoices++;
+	}
+}
+
+Ref< SoundHandle > SoundPlayer::allocate(const Sound* sound, const Vector4& position, uint32_t priority, bool autoStopFar, float time)
+{
+	if (!sound->getBuffer() || m_voices.size() >= c_maxVoices)
+		return nullptr;
+
+	float maxDistance = sound->getRange();
+	if (m_surroundEnvironment && maxDistance <= m_surroundEnvironment->getInnerRadius())
+		maxDistance = m_surroundEnvironment->getMaxDistance();
+
+	Ref< SoundHandle > handle = new SoundHandle();
+	handle->m_position = position;
+
+	Voice voice;
+	voice.handle = handle;
+	voice.sound = sound;
+	voice.priority = priority;
+	voice.maxDistance = maxDistance;
+	voice.time = time;
+	voice.duration = float(sound->getBuffer()->getDuration());
+	voice.autoStopFar = autoStopFar;
+	if (!evaluate(voice))
+		return nullptr;
+
+	// Audible voices are promoted immediately, steal channel from least important voice if necessary.
+	if (voice.loudness >= m_audibilityThreshold && !promote(voice, time))
+	{
+		Voice* weakest = nullptr;
+		for (auto& v : m_voices)
+		{
+			if (v.channel >= 0 && (!weakest || v.score < weakest->score))
+				weakest = &v;
+		}
+		if (weakest && weakest->score <= voice.score)
+		{
+			demote(*weakest);
+			promote(voice, time);
 		}
 	}
 
-	// Update fade-off channels.
-	for (auto& channel : m_channels)
+	m_voices.push_back(voice);
+	return handle;
+}
+
+void SoundPlayer::release(uint32_t index)
+{
+	Voice& voice = m_voices[index];
+	if (voice.channel >= 0)
 	{
-		if (!channel.audioChannel->isPlaying() || channel.fadeOff <= 0.0f)
+		Channel& channel = m_channels[voice.channel];
+		channel.audioChannel->setFilter(nullptr);
+		channel.audioChannel->stop();
+		channel.used = false;
+	}
+	voice.handle->detach();
+
+	if (index < m_voices.size() - 1)
+		voice = m_voices.back();
+	m_voices.pop_back();
+}
+
+bool SoundPlayer::evaluate(Voice& voice) const
+{
+	const SoundHandle* handle = voice.handle;
+
+	float attenuation = 1.0f;
+	if (m_surroundEnvironment && handle->m_position.w() > 0.5_simd)
+	{
+		Scalar distance = Scalar(std::numeric_limits< float >::max());
+		for (const auto& listenerTransform : m_surroundEnvironment->getListenerTransforms())
+		{
+			const Vector4 listenerPosition = listenerTransform.translation().xyz1();
+			const Scalar listenerDistance = (handle->m_position - listenerPosition).xyz0().length();
+			distance = std::min(distance, listenerDistance);
+		}
+
+		// Automatically stop sounds which has moved outside max listener distance.
+		if (voice.autoStopFar && distance > voice.maxDistance)
+			return false;
+
+		// Estimate distance attenuation same as surround filter.
+		const float innerRadius = m_surroundEnvironment->getInnerRadius();
+		voice.distance = distance;
+		attenuation = clamp(1.0f - (voice.distance - innerRadius) / voice.maxDistance, 0.0f, 1.0f);
+	}
+	else
+		voice.distance = 0.0f;
+
+	voice.loudness = decibelToLinear(voice.sound->getGain()) * handle->m_volume * attenuation;
+	if (handle->m_fadeOff >= 0.0f)
+		voice.loudness *= handle->m_fadeOff;
+
+	voice.score = (float(voice.priority) + 1.0f) * voice.loudness;
+	return true;
+}
+
+bool SoundPlayer::promote(Voice& voice, float time)
+{
+	SoundHandle* handle = voice.handle;
+
+	// Voices of known duration resume where they would have been, do not promote voices which are about to finish.
+	const float offset = (voice.duration > 0.0f && time > voice.time) ? time - voice.time : 0.0f;
+	if (voice.duration > 0.0f && voice.duration - offset < c_minPromoteTime)
+		return false;
+
+	for (uint32_t i = 0; i < m_channels.size(); ++i)
+	{
+		Channel& channel = m_channels[i];
+		if (channel.used || channel.audioChannel->isPlaying())
 			continue;
 
-		channel.fadeOff -= std::min(dT, 1.0f / 60.0f);
-		if (channel.fadeOff > 0.0f)
-			channel.audioChannel->setVolume(channel.fadeOff);
-		else
-			channel.audioChannel->stop();
+		// Filters of positional voices are created first time voice is promoted.
+		const IAudioFilter* filter = nullptr;
+		if (m_surroundEnvironment && handle->m_position.w() > 0.5_simd)
+		{
+			if (!voice.groupFilter)
+			{
+				voice.surroundFilter = new SurroundFilter(m_surroundEnvironment, handle->m_position, voice.maxDistance);
+				voice.lowPassFilter = new LowPassFilter(c_nearCutOff);
+				voice.groupFilter = new GroupFilter(voice.lowPassFilter, voice.surroundFilter);
+			}
+
+			const float k0 = clamp< float >(voice.distance / voice.maxDistance, 0.0f, 1.0f);
+			voice.surroundFilter->setSpeakerPosition(handle->m_position);
+			voice.lowPassFilter->setCutOff(lerp(c_nearCutOff, c_farCutOff, std::sqrt(k0)));
+			filter = voice.groupFilter;
+		}
+
+		if (!channel.audioChannel->play(
+			voice.sound->getBuffer(),
+			voice.sound->getCategory(),
+			voice.sound->getGain(),
+			false,
+			0,
+			offset
+		))
+			return false;
+
+		channel.audioChannel->setFilter(filter);
+		channel.audioChannel->setVolume(handle->m_fadeOff >= 0.0f ? handle->m_volume * handle->m_fadeOff : handle->m_volume);
+		channel.audioChannel->setPitch(handle->m_pitch);
+		channel.used = true;
+
+		voice.channel = (int32_t)i;
+		handle->m_channel = channel.audioChannel;
+		return true;
 	}
+
+	return false;
+}
+
+void SoundPlayer::demote(Voice& voice)
+{
+	Channel& channel = m_channels[voice.channel];
+	channel.audioChannel->setFilter(nullptr);
+	channel.audioChannel->stop();
+	channel.used = false;
+
+	voice.channel = -1;
+	voice.handle->m_channel = nullptr;
 }
 
 }
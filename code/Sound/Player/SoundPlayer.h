@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -29,6 +29,7 @@ namespace traktor::sound
 
 class AudioChannel;
 class AudioSystem;
+class GroupFilter;
 class LowPassFilter;
 class Sound;
 class SoundHandle;
@@ -38,6 +39,15 @@ class SurroundFilter;
 
 /*! High-level sound player implementation.
  * \ingroup Sound
+ *
+ * Player keep track of an unlimited number of voices, only
+ * the most important audible voices are mixed through physical
+ * channels. Remaining voices are virtual; they are not mixed
+ * thus they have no mixing cost but their playback time keep
+ * advancing. As soon as a virtual voice become audible again
+ * it's promoted to a physical channel, by priority and loudness,
+ * and resumed at the time it would have reached if it had been
+ * mixed; sounds of unknown duration are restarted.
  */
 class T_DLLCLASS SoundPlayer : public Object
 {
@@ -50,8 +60,31 @@ public:
 
 	void destroy();
 
+	/*! Play non-positional sound.
+	 *
+	 * A voice is allocated even if all physical channels
+	 * are busy, in which case the voice is virtual until
+	 * it rank among the most important voices.
+	 *
+	 * \param sound Sound to play.
+	 * \param priority Sound priority.
+	 * \return Sound handle, null only if sound has no buffer, same sound was just played or voice limit is reached.
+	 */
 	Ref< SoundHandle > play(const Sound* sound, uint32_t priority);
 
+	/*! Play positional sound.
+	 *
+	 * A voice is allocated even if all physical channels
+	 * are busy or sound is inaudible, in which case the
+	 * voice is virtual until it rank among the most
+	 * important voices.
+	 *
+	 * \param sound Sound to play.
+	 * \param position Sound position.
+	 * \param priority Sound priority.
+	 * \param autoStopFar Stop sound when it's beyond max distance of all listeners.
+	 * \return Sound handle, null only if sound has no buffer, is beyond max distance when auto stopped or voice limit is reached.
+	 */
 	Ref< SoundHandle > play(const Sound* sound, const Vector4& position, uint32_t priority, bool autoStopFar);
 
 	void addListener(const SoundListener* listener);
@@ -60,19 +93,43 @@ public:
 
 	void update(float dT);
 
+	/*! Set audibility threshold.
+	 *
+	 * \param threshold Linear loudness below which voices are virtual.
+	 */
+	void setAudibilityThreshold(float threshold);
+
+	/*! Get number of voices.
+	 *
+	 * \param outVoices Number of tracked voices, both real and virtual.
+	 * \param outVirtualVoices Number of virtual voices.
+	 */
+	void getVoiceCounts(uint32_t& outVoices, uint32_t& outVirtualVoices) const;
+
 private:
 	struct Channel
 	{
-		Vector4 position;
+		AudioChannel* audioChannel = nullptr;
+		bool used = false;
+	};
+
+	struct Voice
+	{
+		Ref< SoundHandle > handle;
+		Ref< const Sound > sound;
 		Ref< SurroundFilter > surroundFilter;
 		Ref< LowPassFilter > lowPassFilter;
-		Ref< const Sound > sound;
-		AudioChannel* audioChannel;
-		uint32_t priority;
-		float fadeOff;
-		float time;
-		bool autoStopFar;
-		Ref< SoundHandle > handle;
+		Ref< GroupFilter > groupFilter;
+		int32_t channel = -1;		//!< Index of physical channel, -1 if virtual.
+		uint32_t priority = 0;
+		float maxDistance = 0.0f;
+		float time = 0.0f;			//!< Time when voice was started, kept when voice is demoted and promoted.
+		float duration = 0.0f;		//!< Duration of sound, zero if unknown.
+		float distance = 0.0f;		//!< Distance to closest listener.
+		float loudness = 0.0f;
+		float score = 0.0f;
+		bool autoStopFar = false;
+		bool selected = false;
 	};
 
 	mutable Semaphore m_lock;
@@ -80,8 +137,20 @@ private:
 	Ref< SurroundEnvironment > m_surroundEnvironment;
 	RefArray< const SoundListener > m_listeners;
 	AlignedVector< Channel > m_channels;
+	AlignedVector< Voice > m_voices;
+	AlignedVector< uint32_t > m_ranking;
+	float m_audibilityThreshold;
 	Timer m_timer;
+
+	Ref< SoundHandle > allocate(const Sound* sound, const Vector4& position, uint32_t priority, bool autoStopFar, float time);
+
+	void release(uint32_t index);
+
+	bool evaluate(Voice& voice) const;
+
+	bool promote(Voice& voice, float time);
+
+	void demote(Voice& voice);
 };
 
 }
-
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2023 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -83,6 +83,16 @@ bool GraphEvaluator::evaluateBlock(const OutputPin* producerPin, const IAudioMix
 	{
 		if (!producerNode->getBlock(producerCursor, this, mixer, outBlock))
 			return false;
+
+		// Nodes modify samples in place; copy shared samples.
+		if (outBlock.shared)
+		{
+			auto copiedBlock = copyBlock(outBlock);
+			if (!copiedBlock)
+				return false;
+
+			outBlock = *copiedBlock;
+		}
 	}
 	else if (consumerCount >= 2)
 	{
@@ -194,6 +204,7 @@ AudioBlock* GraphEvaluator::copyBlock(const AudioBlock& sourceBlock) const
 	block.sampleRate = sourceBlock.sampleRate;
 	block.maxChannel = sourceBlock.maxChannel;
 	block.category = sourceBlock.category;
+	block.shared = false;
 
 	return &block;
 }
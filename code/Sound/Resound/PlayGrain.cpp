@@ -1,14 +1,19 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
+#include <cstring>
 #include "Core/Math/Const.h"
 #include "Core/Math/MathUtils.h"
 #include "Core/Math/Vector4.h"
+#include "Core/Memory/Alloc.h"
+#include "Core/Misc/Align.h"
+#include "Core/Misc/AutoPtr.h"
+#include "Core/Thread/Acquire.h"
 #include "Sound/IAudioBuffer.h"
 #include "Sound/IAudioFilter.h"
 #include "Sound/IAudioMixer.h"
@@ -26,6 +31,8 @@ struct PlayGrainCursor : public RefCountImpl< IAudioBufferCursor >
 	Ref< IAudioBuffer > m_soundBuffer;
 	Ref< IAudioBufferCursor > m_soundCursor;
 	RefArray< IAudioFilterInstance > m_filterInstances;
+	AutoArrayPtr< float, AllocFreeAlign > m_samples;	//!< Copy of shared samples.
+	uint32_t m_samplesCapacity = 0;
 	bool m_repeat;
 	float m_gain;
 	float m_pitch;
@@ -84,8 +91,13 @@ Ref< IAudioBufferCursor > PlayGrain::createCursor() const
 	playCursor->m_soundBuffer = soundBuffer;
 	playCursor->m_soundCursor = soundCursor;
 	playCursor->m_repeat = m_repeat;
-	playCursor->m_gain = decibelToLinear(m_sound->getGain() + m_gain.random(m_random));
-	playCursor->m_pitch = clamp(m_pitch.random(m_random), 0.5f, 1.5f);
+
+	// Cursors are created from concurrently mixed channels.
+	{
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_randomLock);
+		playCursor->m_gain = decibelToLinear(m_sound->getGain() + m_gain.random(m_random));
+		playCursor->m_pitch = clamp(m_pitch.random(m_random), 0.5f, 1.5f);
+	}
 
 	for (auto filter : m_filters)
 		playCursor->m_filterInstances.push_back(filter ? filter->createInstance() : nullptr);
@@ -135,7 +147,10 @@ bool PlayGrain::getBlock(IAudioBufferCursor* cursor, const IAudioMixer* mixer, A
 
 		playCursor->m_soundBuffer = soundBuffer;
 		playCursor->m_soundCursor = soundCursor;
-		playCursor->m_gain = decibelToLinear(m_sound->getGain() + m_gain.random(m_random));
+		{
+			T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_randomLock);
+			playCursor->m_gain = decibelToLinear(m_sound->getGain() + m_gain.random(m_random));
+		}
 
 		m_sound.consume();
 	}
@@ -164,8 +179,29 @@ bool PlayGrain::getBlock(IAudioBufferCursor* cursor, const IAudioMixer* mixer, A
 			return false;
 	}
 
-	// Apply filter chain.
+	// Filters and gain modify samples in place; copy shared samples first.
 	const uint32_t nfilters = (uint32_t)m_filters.size();
+	if (outBlock.shared && (nfilters > 0 || abs(1.0f - playCursor->m_gain) > FUZZY_EPSILON))
+	{
+		const uint32_t samplesCount = alignUp(outBlock.samplesCount, 4);
+		if (playCursor->m_samplesCapacity < samplesCount)
+		{
+			playCursor->m_samples.reset((float*)Alloc::acquireAlign(SbcMaxChannelCount * samplesCount * sizeof(float), 16, T_FILE_LINE));
+			playCursor->m_samplesCapacity = samplesCount;
+		}
+		for (uint32_t i = 0; i < SbcMaxChannelCount; ++i)
+		{
+			if (outBlock.samples[i])
+			{
+				float* samples = playCursor->m_samples.ptr() + i * playCursor->m_samplesCapacity;
+				std::memcpy(samples, outBlock.samples[i], samplesCount * sizeof(float));
+				outBlock.samples[i] = samples;
+			}
+		}
+		outBlock.shared = false;
+	}
+
+	// Apply filter chain.
 	for (uint32_t i = 0; i < nfilters; ++i)
 	{
 		if (m_filters[i])
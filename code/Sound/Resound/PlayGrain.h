@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -10,6 +10,7 @@
 
 #include "Core/RefArray.h"
 #include "Core/Math/Range.h"
+#include "Core/Thread/Semaphore.h"
 #include "Resource/Proxy.h"
 #include "Sound/Resound/IGrain.h"
 
@@ -59,6 +60,7 @@ private:
 	Range< float > m_gain;
 	Range< float > m_pitch;
 	bool m_repeat;
+	mutable Semaphore m_randomLock;
 	mutable Random m_random;
 };
 
@@ -1,12 +1,13 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
 #include <ctime>
+#include "Core/Thread/Acquire.h"
 #include "Sound/IAudioBuffer.h"
 #include "Sound/Resound/RandomGrain.h"
 
@@ -59,12 +60,17 @@ Ref< IAudioBufferCursor > RandomGrain::createCursor() const
 	if (m_grains.empty())
 		return 0;
 
-	int32_t index = int32_t(m_random.nextFloat() * (m_grains.size() - 1) + 0.5f);
-	if (m_humanize && m_grains.size() >= 2)
+	// Cursors are created from concurrently mixed channels.
+	int32_t index;
 	{
-		while (index == m_last)
-			index = int32_t(m_random.nextFloat() * (m_grains.size() - 1) + 0.5f);
-		m_last = index;
+		T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_randomLock);
+		index = int32_t(m_random.nextFloat() * (m_grains.size() - 1) + 0.5f);
+		if (m_humanize && m_grains.size() >= 2)
+		{
+			while (index == m_last)
+				index = int32_t(m_random.nextFloat() * (m_grains.size() - 1) + 0.5f);
+			m_last = index;
+		}
 	}
 	T_ASSERT(index >= 0);
 	T_ASSERT(index < m_grains.size());
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -10,6 +10,7 @@
 
 #include "Core/RefArray.h"
 #include "Core/Math/Random.h"
+#include "Core/Thread/Semaphore.h"
 #include "Sound/Resound/IGrain.h"
 
 // import/export mechanism.
@@ -49,6 +50,7 @@ public:
 private:
 	RefArray< IGrain > m_grains;
 	bool m_humanize;
+	mutable Semaphore m_randomLock;
 	mutable Random m_random;
 	mutable int32_t m_last;
 };
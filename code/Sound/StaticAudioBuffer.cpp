@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -225,4 +225,9 @@ bool StaticAudioBuffer::getBlock(IAudioBufferCursor* cursor, const IAudioMixer*
 	return true;
 }
 
+double StaticAudioBuffer::getDuration() const
+{
+	return m_sampleRate > 0 ? double(m_samplesCount) / m_sampleRate : 0.0;
+}
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -38,10 +38,15 @@ public:
 
 	int16_t* getSamplesData(uint32_t channel);
 
+	/*! Get size of sample data in bytes. */
+	uint64_t getSamplesDataSize() const { return uint64_t(m_samplesCount) * m_channelsCount * sizeof(int16_t); }
+
 	virtual Ref< IAudioBufferCursor > createCursor() const override final;
 
 	virtual bool getBlock(IAudioBufferCursor* cursor, const IAudioMixer* mixer, AudioBlock& outBlock) const override final;
 
+	virtual double getDuration() const override final;
+
 private:
 	int32_t m_sampleRate = 0;
 	int32_t m_samplesCount = 0;
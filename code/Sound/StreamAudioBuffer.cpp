@@ -1,13 +1,16 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
+#include <algorithm>
+#include <cstring>
 #include "Core/Log/Log.h"
 #include "Core/Misc/SafeDestroy.h"
+#include "Core/Thread/Acquire.h"
 #include "Sound/IStreamDecoder.h"
 #include "Sound/StreamAudioBuffer.h"
 
@@ -16,9 +19,13 @@ namespace traktor::sound
 	namespace
 	{
 
+const double c_maxCachedDuration = 30.0;	//!< Longer streams, such as music, are not cached.
+
 struct StreamAudioBufferCursor : public RefCountImpl< IAudioBufferCursor >
 {
 	uint64_t m_position = 0;
+	uint32_t m_blockIndex = ~0U;
+	Ref< const AudioBlockCache::Block > m_block;
 
 	virtual void setParameter(handle_t id, float parameter)
 	{
@@ -45,14 +52,23 @@ StreamAudioBuffer::~StreamAudioBuffer()
 
 bool StreamAudioBuffer::create(IStreamDecoder* streamDecoder)
 {
-	if ((m_streamDecoder = streamDecoder) != nullptr)
-		return true;
-	else
+	if ((m_streamDecoder = streamDecoder) == nullptr)
 		return false;
+
+	const double duration = m_streamDecoder->getDuration();
+	if (duration > 0.0 && duration <= c_maxCachedDuration)
+		m_cacheKey = AudioBlockCache::getInstance().allocateKey();
+
+	return true;
 }
 
 void StreamAudioBuffer::destroy()
 {
+	if (m_cacheKey != 0)
+	{
+		AudioBlockCache::getInstance().purge(m_cacheKey);
+		m_cacheKey = 0;
+	}
 	safeDestroy(m_streamDecoder);
 }
 
@@ -64,27 +80,123 @@ Ref< IAudioBufferCursor > StreamAudioBuffer::createCursor() const
 bool StreamAudioBuffer::getBlock(IAudioBufferCursor* cursor, const IAudioMixer* mixer, AudioBlock& outBlock) const
 {
 	StreamAudioBufferCursor* ssbc = static_cast< StreamAudioBufferCursor* >(cursor);
-	const uint64_t position = ssbc->m_position;
 
-	if (m_position > position)
+	const uint32_t index = uint32_t(ssbc->m_position / AudioBlockCache::BlockSamples);
+	const uint32_t offset = uint32_t(ssbc->m_position % AudioBlockCache::BlockSamples);
+
+	// Get block from cache, or decode if not cached; cursor keep reference
+	// to block until it's finished reading from it.
+	if (!ssbc->m_block || ssbc->m_blockIndex != index)
+	{
+		if (index >= m_blockCount)
+			return false;
+
+		ssbc->m_block = nullptr;
+		if (m_cacheKey != 0)
+			ssbc->m_block = AudioBlockCache::getInstance().get(m_cacheKey, index);
+		if (!ssbc->m_block)
+			ssbc->m_block = decode(index);
+
+		ssbc->m_blockIndex = index;
+		if (!ssbc->m_block)
+			return false;
+	}
+
+	const AudioBlockCache::Block* block = ssbc->m_block;
+	if (offset >= block->samplesCount)
+		return false;
+
+	// Return samples directly from block; keep number of samples
+	// a multiple of 4 so following reads are aligned.
+	const uint32_t samplesCount = std::min(std::max(outBlock.samplesCount & ~3U, 4U), block->samplesCount - offset);
+	for (uint32_t i = 0; i < SbcMaxChannelCount; ++i)
+		outBlock.samples[i] = block->samples[i] ? block->samples[i] + offset : nullptr;
+	outBlock.samplesCount = samplesCount;
+	outBlock.sampleRate = block->sampleRate;
+	outBlock.maxChannel = block->maxChannel;
+	outBlock.shared = true;
+
+	ssbc->m_position += samplesCount;
+	return true;
+}
+
+double StreamAudioBuffer::getDuration() const
+{
+	return m_streamDecoder ? m_streamDecoder->getDuration() : 0.0;
+}
+
+Ref< const AudioBlockCache::Block > StreamAudioBuffer::decode(uint32_t index) const
+{
+	T_ANONYMOUS_VAR(Acquire< Semaphore >)(m_decoderLock);
+	AudioBlockCache& cache = AudioBlockCache::getInstance();
+
+	// Another cursor might have decoded block while we where waiting.
+	if (m_cacheKey != 0)
+	{
+		Ref< const AudioBlockCache::Block > block = cache.get(m_cacheKey, index);
+		if (block)
+			return block;
+	}
+
+	if (m_decoderBlock > index)
 	{
 		T_DEBUG(L"Rewind stream sound decoder");
 		m_streamDecoder->rewind();
-		m_position = 0;
+		m_decoderBlock = 0;
 	}
 
-	const uint32_t samplesCount = outBlock.samplesCount;
-	while (m_position <= position)
+	// Decode blocks until we reach requested block, blocks skipped
+	// are also put into cache since they most likely will be read soon.
+	Ref< AudioBlockCache::Block > block;
+	while (m_decoderBlock <= index)
 	{
-		outBlock.samplesCount = samplesCount;
-		if (!m_streamDecoder->getBlock(outBlock))
-			return false;
-
-		m_position += outBlock.samplesCount;
+		block = nullptr;
+
+		uint32_t decodedCount = 0;
+		while (decodedCount < AudioBlockCache::BlockSamples)
+		{
+			AudioBlock decoded = { { 0 }, AudioBlockCache::BlockSamples - decodedCount, 0, 0 };
+			if (!m_streamDecoder->getBlock(decoded) || decoded.samplesCount == 0 || decoded.maxChannel == 0)
+				break;
+
+			if (!block)
+			{
+				block = new AudioBlockCache::Block(std::min< uint32_t >(decoded.maxChannel, SbcMaxChannelCount));
+				block->sampleRate = decoded.sampleRate;
+				block->maxChannel = decoded.maxChannel;
+			}
+
+			const uint32_t count = std::min(decoded.samplesCount, AudioBlockCache::BlockSamples - decodedCount);
+			for (uint32_t i = 0; i < SbcMaxChannelCount; ++i)
+			{
+				if (block->samples[i] && decoded.samples[i])
+					std::memcpy(block->samples[i] + decodedCount, decoded.samples[i], count * sizeof(float));
+			}
+			decodedCount += count;
+		}
+
+		// End of stream reached; no more blocks.
+		if (!block)
+		{
+			m_blockCount = m_decoderBlock;
+			return nullptr;
+		}
+
+		block->samplesCount = decodedCount;
+		if (decodedCount < AudioBlockCache::BlockSamples)
+			m_blockCount = m_decoderBlock + 1;
+
+		if (m_cacheKey != 0)
+			cache.put(m_cacheKey, m_decoderBlock, block);
+
+		if (m_decoderBlock++ == index)
+			break;
+
+		if (m_decoderBlock >= m_blockCount)
+			return nullptr;
 	}
 
-	ssbc->m_position += outBlock.samplesCount;
-	return true;
+	return block;
 }
 
 }
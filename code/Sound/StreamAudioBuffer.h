@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,9 @@
  */
 #pragma once
 
+#include <atomic>
+#include "Core/Thread/Semaphore.h"
+#include "Sound/AudioBlockCache.h"
 #include "Sound/IAudioBuffer.h"
 
 // import/export mechanism.
@@ -25,6 +28,10 @@ class IStreamDecoder;
 
 /*! Stream audio buffer.
  * \ingroup Sound
+ *
+ * Stream is decoded in fixed size blocks which are shared,
+ * through the audio block cache, by all cursors thus
+ * multiple channels playing same stream only decode it once.
  */
 class T_DLLCLASS StreamAudioBuffer : public IAudioBuffer
 {
@@ -41,9 +48,16 @@ public:
 
 	virtual bool getBlock(IAudioBufferCursor* cursor, const IAudioMixer* mixer, AudioBlock& outBlock) const override final;
 
+	virtual double getDuration() const override final;
+
 private:
 	Ref< IStreamDecoder > m_streamDecoder;
-	mutable uint64_t m_position = 0;
+	mutable Semaphore m_decoderLock;
+	mutable uint32_t m_decoderBlock = 0;	//!< Index of next block produced by decoder.
+	mutable std::atomic< uint32_t > m_blockCount = ~0U;	//!< Number of blocks in stream, known when end of stream has been reached.
+	uint32_t m_cacheKey = 0;	//!< Key in block cache, zero if stream isn't cached.
+
+	Ref< const AudioBlockCache::Block > decode(uint32_t index) const;
 };
 
 }
@@ -0,0 +1,184 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include <algorithm>
+#include "Core/RefArray.h"
+#include "Core/Io/StringOutputStream.h"
+#include "Sound/AudioBlockCache.h"
+#include "Sound/IStreamDecoder.h"
+#include "Sound/StreamAudioBuffer.h"
+#include "Sound/Test/CaseAudioBlockCache.h"
+
+namespace traktor::sound::test
+{
+	namespace
+	{
+
+const uint32_t c_sampleRate = 48000;
+const uint32_t c_samplesCount = c_sampleRate * 2;
+const uint32_t c_frameSamples = 512;
+const uint32_t c_cursorCount = 16;
+
+/*! Decoder producing sample index as sample value, in small irregular blocks. */
+class CountingDecoder : public IStreamDecoder
+{
+public:
+	uint32_t m_position = 0;
+	uint32_t m_decodedSamples = 0;
+	float m_samples[1000];
+
+	virtual bool create(IStream* stream) override final { return true; }
+
+	virtual void destroy() override final {}
+
+	virtual double getDuration() const override final { return double(c_samplesCount) / c_sampleRate; }
+
+	virtual bool getBlock(AudioBlock& outBlock) override final
+	{
+		const uint32_t count = std::min< uint32_t >(std::min< uint32_t >(outBlock.samplesCount, 1000), c_samplesCount - m_position);
+		if (count == 0)
+			return false;
+
+		for (uint32_t i = 0; i < count; ++i)
+			m_samples[i] = float(m_position + i);
+
+		outBlock.samples[0] = m_samples;
+		outBlock.samplesCount = count;
+		outBlock.sampleRate = c_sampleRate;
+		outBlock.maxChannel = 1;
+
+		m_position += count;
+		m_decodedSamples += count;
+		return true;
+	}
+
+	virtual void rewind() override final { m_position = 0; }
+};
+
+/*! Read entire stream through all cursors, interleaved, verify samples are in order. */
+bool readInterleaved(StreamAudioBuffer* buffer, const RefArray< IAudioBufferCursor >& cursors, const AlignedVector< uint32_t >& offsets)
+{
+	AlignedVector< uint32_t > expected = offsets;
+	AlignedVector< bool > finished;
+	finished.resize(cursors.size(), false);
+
+	for (uint32_t frame = 0; ; ++frame)
+	{
+		bool anyPlaying = false;
+		for (uint32_t i = 0; i < cursors.size(); ++i)
+		{
+			// Cursors start at different frames.
+			if (finished[i] || frame < offsets[i] / c_frameSamples)
+			{
+				anyPlaying |= !finished[i];
+				continue;
+			}
+
+			AudioBlock block = { { 0 }, c_frameSamples, 0, 0 };
+			if (!buffer->getBlock(cursors[i], nullptr, block))
+			{
+				if (expected[i] != c_samplesCount + offsets[i])
+					return false;
+				finished[i] = true;
+				continue;
+			}
+
+			if (!block.shared || !block.samples[0])
+				return false;
+
+			for (uint32_t j = 0; j < block.samplesCount; ++j)
+			{
+				if (block.samples[0][j] != float(expected[i] - offsets[i]))
+					return false;
+				expected[i]++;
+			}
+			anyPlaying = true;
+		}
+		if (!anyPlaying)
+			break;
+	}
+
+	return true;
+}
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.sound.test.CaseAudioBlockCache", 0, CaseAudioBlockCache, traktor::test::Case)
+
+void CaseAudioBlockCache::run()
+{
+	AudioBlockCache& cache = AudioBlockCache::getInstance();
+	cache.setBudget(8 * 1024 * 1024);
+
+	// Many cursors playing same stream, started at different times, only decode stream once.
+	{
+		Ref< CountingDecoder > decoder = new CountingDecoder();
+		Ref< StreamAudioBuffer > buffer = new StreamAudioBuffer();
+		CASE_ASSERT(buffer->create(decoder));
+
+		AudioBlockCacheStatistics before;
+		cache.getStatistics(before);
+
+		RefArray< IAudioBufferCursor > cursors;
+		AlignedVector< uint32_t > offsets;
+		for (uint32_t i = 0; i < c_cursorCount; ++i)
+		{
+			cursors.push_back(buffer->createCursor());
+			offsets.push_back(i * 20 * c_frameSamples);
+		}
+
+		CASE_ASSERT(readInterleaved(buffer, cursors, offsets));
+		CASE_ASSERT_EQUAL(decoder->m_decodedSamples, c_samplesCount);
+
+		AudioBlockCacheStatistics after;
+		cache.getStatistics(after);
+
+		const uint64_t hits = after.hits - before.hits;
+		const uint64_t misses = after.misses - before.misses;
+		CASE_ASSERT(hits > 0);
+
+		StringOutputStream ss;
+		ss << L"Read stream through " << c_cursorCount << L" cursors; decoded " << decoder->m_decodedSamples << L" of " << c_samplesCount * c_cursorCount << L" samples, hit rate " << int32_t(hits * 100 / (hits + misses)) << L"%, " << int32_t((after.bytesSaved - before.bytesSaved) / 1024) << L" KiB saved";
+		succeeded(ss.str());
+
+		buffer->destroy();
+	}
+
+	// Blocks are evicted when over budget; cursors still read correct samples.
+	{
+		const uint64_t blockSize = AudioBlockCache::BlockSamples * sizeof(float);
+		cache.setBudget(blockSize * 4);
+
+		Ref< CountingDecoder > decoder = new CountingDecoder();
+		Ref< StreamAudioBuffer > buffer = new StreamAudioBuffer();
+		CASE_ASSERT(buffer->create(decoder));
+
+		RefArray< IAudioBufferCursor > cursors;
+		AlignedVector< uint32_t > offsets;
+		cursors.push_back(buffer->createCursor());
+		offsets.push_back(0);
+		cursors.push_back(buffer->createCursor());
+		offsets.push_back(c_samplesCount / 2);
+
+		CASE_ASSERT(readInterleaved(buffer, cursors, offsets));
+
+		AudioBlockCacheStatistics statistics;
+		cache.getStatistics(statistics);
+		CASE_ASSERT(statistics.residentSize <= blockSize * 4);
+		CASE_ASSERT(statistics.blockCount <= 4);
+
+		buffer->destroy();
+
+		cache.getStatistics(statistics);
+		CASE_ASSERT_EQUAL(statistics.blockCount, 0);
+	}
+
+	cache.setBudget(8 * 1024 * 1024);
+}
+
+}
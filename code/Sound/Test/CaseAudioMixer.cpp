@@ -0,0 +1,138 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include <atomic>
+#include <cmath>
+#include "Core/Io/StringOutputStream.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/ThreadManager.h"
+#include "Sound/AudioChannel.h"
+#include "Sound/AudioDriverNull.h"
+#include "Sound/AudioSystem.h"
+#include "Sound/IAudioBuffer.h"
+#include "Sound/Test/CaseAudioMixer.h"
+
+namespace traktor::sound::test
+{
+	namespace
+	{
+
+const uint32_t c_sampleRate = 48000;
+const uint32_t c_frameSamples = 512;
+const int32_t c_workIterations = 16;	//!< Synthetic work per sample, emulate decoding and filtering.
+const int32_t c_runTime = 400;			//!< Time, in milliseconds, to run each configuration.
+
+class BenchmarkCursor : public RefCountImpl< IAudioBufferCursor >
+{
+public:
+	alignas(16) float m_samples[c_frameSamples];
+	float m_phase = 0.0f;
+	std::atomic< int32_t > m_blocks = 0;
+
+	virtual void setParameter(handle_t id, float parameter) override final {}
+
+	virtual void disableRepeat() override final {}
+
+	virtual void reset() override final {}
+};
+
+class BenchmarkBuffer : public IAudioBuffer
+{
+public:
+	virtual Ref< IAudioBufferCursor > createCursor() const override final
+	{
+		return new BenchmarkCursor();
+	}
+
+	virtual bool getBlock(IAudioBufferCursor* cursor, const IAudioMixer* mixer, AudioBlock& outBlock) const override final
+	{
+		BenchmarkCursor* bc = static_cast< BenchmarkCursor* >(cursor);
+		for (uint32_t i = 0; i < c_frameSamples; ++i)
+		{
+			float s = 0.0f;
+			for (int32_t j = 1; j <= c_workIterations; ++j)
+				s += std::sin(bc->m_phase * j) / j;
+			bc->m_samples[i] = s * 0.01f;
+			bc->m_phase += 0.01f;
+		}
+		bc->m_blocks++;
+
+		outBlock.samples[0] = bc->m_samples;
+		outBlock.samplesCount = c_frameSamples;
+		outBlock.sampleRate = c_sampleRate;
+		outBlock.maxChannel = 1;
+		return true;
+	}
+};
+
+struct Measurement
+{
+	double mixerTime = 0.0;
+	uint32_t lateChannels = 0;
+	bool allChannelsMixed = false;
+};
+
+Measurement measure(uint32_t channelCount, bool parallel)
+{
+	Measurement m;
+
+	Ref< AudioSystem > audioSystem = new AudioSystem(new AudioDriverNull());
+
+	AudioSystemCreateDesc desc;
+	desc.channels = channelCount;
+	desc.driverDesc.sampleRate = c_sampleRate;
+	desc.driverDesc.bitsPerSample = 16;
+	desc.driverDesc.hwChannels = 2;
+	desc.driverDesc.frameSamples = c_frameSamples;
+	desc.parallel = parallel;
+	if (!audioSystem->create(desc))
+		return m;
+
+	Ref< BenchmarkBuffer > buffer = new BenchmarkBuffer();
+	for (uint32_t i = 0; i < channelCount; ++i)
+		audioSystem->getChannel(i)->play(buffer, 0, 0.0f, false, 0);
+
+	ThreadManager::getInstance().getCurrentThread()->sleep(c_runTime);
+
+	m.allChannelsMixed = true;
+	for (uint32_t i = 0; i < channelCount; ++i)
+	{
+		const BenchmarkCursor* cursor = static_cast< const BenchmarkCursor* >(audioSystem->getChannel(i)->getCursor());
+		m.allChannelsMixed &= (cursor != nullptr && cursor->m_blocks > 0);
+	}
+
+	audioSystem->getThreadPerformances(m.mixerTime, m.lateChannels);
+	audioSystem->destroy();
+	return m;
+}
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.sound.test.CaseAudioMixer", 0, CaseAudioMixer, traktor::test::Case)
+
+void CaseAudioMixer::run()
+{
+	const double frameTime = double(c_frameSamples) / c_sampleRate;
+	const uint32_t channelCounts[] = { 8, 32, 64, 128 };
+
+	for (uint32_t channelCount : channelCounts)
+	{
+		const Measurement sequential = measure(channelCount, false);
+		CASE_ASSERT(sequential.allChannelsMixed);
+		CASE_ASSERT_EQUAL(sequential.lateChannels, 0);
+
+		const Measurement parallel = measure(channelCount, true);
+		CASE_ASSERT(parallel.allChannelsMixed);
+
+		StringOutputStream ss;
+		ss << L"Mix " << channelCount << L" channels; frame " << int32_t(frameTime * 1000000.0) << L" us, sequential " << int32_t(sequential.mixerTime * 1000000.0) << L" us, parallel " << int32_t(parallel.mixerTime * 1000000.0) << L" us (" << parallel.lateChannels << L" late)";
+		succeeded(ss.str());
+	}
+}
+
+}
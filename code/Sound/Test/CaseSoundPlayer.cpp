@@ -0,0 +1,193 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "Core/RefArray.h"
+#include "Core/Io/StringOutputStream.h"
+#include "Core/Math/Transform.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/ThreadManager.h"
+#include "Core/Timer/Timer.h"
+#include "Sound/AudioChannel.h"
+#include "Sound/AudioDriverNull.h"
+#include "Sound/AudioMixer.h"
+#include "Sound/AudioSystem.h"
+#include "Sound/Sound.h"
+#include "Sound/StaticAudioBuffer.h"
+#include "Sound/Filters/SurroundEnvironment.h"
+#include "Sound/Player/SoundHandle.h"
+#include "Sound/Player/SoundListener.h"
+#include "Sound/Player/SoundPlayer.h"
+#include "Sound/Test/CaseSoundPlayer.h"
+
+namespace traktor::sound::test
+{
+	namespace
+	{
+
+const uint32_t c_channelCount = 8;
+const uint32_t c_emitterCount = 2000;
+const uint32_t c_sampleRate = 8000;
+const uint32_t c_updateCount = 100;
+
+	}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.sound.test.CaseSoundPlayer", 0, CaseSoundPlayer, traktor::test::Case)
+
+void CaseSoundPlayer::run()
+{
+	Ref< AudioSystem > audioSystem = new AudioSystem(new AudioDriverNull());
+
+	AudioSystemCreateDesc desc;
+	desc.channels = c_channelCount;
+	desc.driverDesc.sampleRate = 48000;
+	desc.driverDesc.bitsPerSample = 16;
+	desc.driverDesc.hwChannels = 2;
+	desc.driverDesc.frameSamples = 512;
+	CASE_ASSERT(audioSystem->create(desc));
+
+	Ref< SurroundEnvironment > surroundEnvironment = new SurroundEnvironment(25.0f, 5.0f, 4.0f, false);
+
+	Ref< SoundPlayer > soundPlayer = new SoundPlayer();
+	CASE_ASSERT(soundPlayer->create(audioSystem, surroundEnvironment));
+
+	Ref< SoundListener > listener = new SoundListener();
+	soundPlayer->addListener(listener);
+	soundPlayer->update(0.0f);
+
+	// Silent sound, long enough to not expire while test is running.
+	Ref< StaticAudioBuffer > buffer = new StaticAudioBuffer();
+	CASE_ASSERT(buffer->create(c_sampleRate, c_sampleRate * 10, 1));
+	Ref< Sound > sound = new Sound(buffer, 0, 0.0f, 0.0f);
+
+	// Emitters are placed along a line, beginning just outside listener's inner radius.
+	RefArray< SoundHandle > handles;
+	for (uint32_t i = 0; i < c_emitterCount; ++i)
+	{
+		Ref< SoundHandle > handle = soundPlayer->play(sound, Vector4(6.0f + i, 0.0f, 0.0f, 1.0f), 16, false);
+		if (handle)
+			handles.push_back(handle);
+	}
+	CASE_ASSERT_EQUAL(handles.size(), c_emitterCount);
+
+	uint32_t voices = 0, virtualVoices = 0;
+	soundPlayer->getVoiceCounts(voices, virtualVoices);
+	CASE_ASSERT_EQUAL(voices, c_emitterCount);
+	CASE_ASSERT_EQUAL(virtualVoices, c_emitterCount - c_channelCount);
+
+	// Closest emitters should occupy all physical channels.
+	bool closestReal = true;
+	for (uint32_t i = 0; i < c_emitterCount; ++i)
+		closestReal &= (handles[i]->isVirtual() == (i >= c_channelCount));
+	CASE_ASSERT(closestReal);
+
+	// Virtual voices are still playing.
+	bool allPlaying = true;
+	for (auto handle : handles)
+		allPlaying &= handle->isPlaying();
+	CASE_ASSERT(allPlaying);
+
+	// Move listener to other end; voices around listener should be promoted.
+	listener->setTransform(Transform(Vector4(6.0f + c_emitterCount - 1, 0.0f, 0.0f, 1.0f)));
+
+	Timer timer;
+	for (uint32_t i = 0; i < c_updateCount; ++i)
+		soundPlayer->update(1.0f / 60.0f);
+	const double updateTime = timer.getElapsedTime() / c_updateCount;
+
+	bool farthestReal = true;
+	for (uint32_t i = 0; i < c_emitterCount; ++i)
+		farthestReal &= (handles[i]->isVirtual() == (i < c_emitterCount - c_channelCount));
+	CASE_ASSERT(farthestReal);
+
+	// High priority sound should steal a physical channel.
+	Ref< Sound > importantSound = new Sound(buffer, 0, 0.0f, 0.0f);
+	Ref< SoundHandle > important = soundPlayer->play(importantSound, 100);
+	CASE_ASSERT(important != nullptr);
+	CASE_ASSERT(!important->isVirtual());
+
+	soundPlayer->getVoiceCounts(voices, virtualVoices);
+	CASE_ASSERT_EQUAL(voices, c_emitterCount + 1);
+	CASE_ASSERT_EQUAL(virtualVoices, c_emitterCount + 1 - c_channelCount);
+
+	// Stopped voices are released.
+	for (auto handle : handles)
+		handle->stop();
+	important->stop();
+	soundPlayer->update(1.0f / 60.0f);
+
+	soundPlayer->getVoiceCounts(voices, virtualVoices);
+	CASE_ASSERT_EQUAL(voices, 0);
+
+	StringOutputStream ss;
+	ss << L"Update " << c_emitterCount << L" voices on " << c_channelCount << L" channels; " << int32_t(updateTime * 1000000.0) << L" us/frame";
+	succeeded(ss.str());
+
+	soundPlayer->destroy();
+
+	// Virtual voices keep their start time; a one-shot which is demoted and
+	// promoted again still expire when it would have finished playing.
+	{
+		soundPlayer = new SoundPlayer();
+		CASE_ASSERT(soundPlayer->create(audioSystem, surroundEnvironment));
+		soundPlayer->addListener(listener);
+		listener->setTransform(Transform::identity());
+		soundPlayer->update(0.0f);
+
+		Ref< StaticAudioBuffer > shortBuffer = new StaticAudioBuffer();
+		CASE_ASSERT(shortBuffer->create(c_sampleRate, c_sampleRate / 2, 1));
+		Ref< Sound > shortSound = new Sound(shortBuffer, 0, 0.0f, 0.0f);
+
+		Ref< SoundHandle > oneShot = soundPlayer->play(shortSound, Vector4(6.0f, 0.0f, 0.0f, 1.0f), 0, false);
+		CASE_ASSERT(oneShot != nullptr);
+
+		for (int32_t i = 0; i < 2; ++i)
+		{
+			RefArray< SoundHandle > important;
+			for (uint32_t j = 0; j < c_channelCount; ++j)
+				important.push_back(soundPlayer->play(sound, Vector4(6.0f, 0.0f, 0.0f, 1.0f), 100, false));
+			CASE_ASSERT(oneShot->isVirtual());
+
+			ThreadManager::getInstance().getCurrentThread()->sleep(300);
+
+			for (auto handle : important)
+				handle->stop();
+			soundPlayer->update(1.0f / 60.0f);
+		}
+
+		// Sound would have finished 100 ms ago; must not be restarted.
+		CASE_ASSERT(!oneShot->isPlaying());
+
+		soundPlayer->destroy();
+	}
+
+	// Channel started at an offset skip into sound.
+	{
+		Ref< StaticAudioBuffer > ramp = new StaticAudioBuffer();
+		CASE_ASSERT(ramp->create(c_sampleRate, c_sampleRate, 1));
+		int16_t* samples = ramp->getSamplesData(0);
+		for (uint32_t i = 0; i < c_sampleRate; ++i)
+			samples[i] = int16_t(i * 32767 / c_sampleRate);
+
+		AudioChannel channel(0, c_sampleRate, 256);
+		AudioMixer mixer;
+		CASE_ASSERT(channel.play(ramp, 0, 0.0f, false, 0, 0.5f));
+
+		AudioBlock block = { { 0 } };
+		CASE_ASSERT(channel.getBlock(&mixer, block));
+		CASE_ASSERT(block.samples[0] != nullptr);
+		if (block.samples[0] != nullptr)
+		{
+			const float first = block.samples[0][0];
+			CASE_ASSERT(first >= 0.49f && first <= 0.55f);
+		}
+	}
+
+	audioSystem->destroy();
+}
+
+}
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -84,9 +84,11 @@ struct AudioSystemCreateDesc
 	uint32_t channels;									//!< Number of virtual channels.
 	AudioDriverCreateDesc driverDesc;					//!< Driver create description.
 	float cm[SbcMaxChannelCount][SbcMaxChannelCount];	//!< Final combine matrix.
+	bool parallel;										//!< Generate channel blocks in parallel on channel workers.
 
 	AudioSystemCreateDesc()
 	:	channels(0)
+	,	parallel(true)
 	{
 		for (int32_t i = 0; i < SbcMaxChannelCount; ++i)
 			for (int32_t j = 0; j < SbcMaxChannelCount; ++j)
@@ -102,6 +104,7 @@ struct AudioBlock
 	uint32_t sampleRate;				//!< Samples per second.
 	uint32_t maxChannel;				//!< Last channel used, everyone above is considered mute.
 	handle_t category;
+	bool shared;						//!< Samples are shared, must be copied before being modified.
 };
 
 /*! Return handle from parameter name.
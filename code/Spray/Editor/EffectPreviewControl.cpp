@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -145,7 +145,7 @@ bool EffectPreviewControl::create(
 	if (!m_primitiveRenderer->create(resourceManager, renderSystem, 1))
 		return false;
 
-	m_renderContext = new render::RenderContext(16 * 1024 * 1024);
+	m_renderContext = new render::RenderContext(1 * 1024 * 1024);
 	m_renderGraph = new render::RenderGraph(renderSystem, desc.multiSample);
 
 	if ((m_audioSystem = audioSystem) != nullptr)
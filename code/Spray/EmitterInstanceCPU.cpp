@@ -42,6 +42,7 @@ const uint32_t c_maxEmitSingleShot = 400;
 #endif
 
 const uint32_t c_maxAlive = c_maxEmitSingleShot;
+const size_t c_modifierGrainSize = 128;
 
 	}
 
@@ -319,16 +320,19 @@ void EmitterInstanceCPU::updateTask(float deltaTime)
 	const Transform updateTransform = m_emitter->worldSpace() ? m_transform : Transform::identity();
 	const Scalar deltaTimeScalar(deltaTime);
 
-	for (auto modifier : m_emitter->getModifiers())
-	{
-		modifier->update(
-			deltaTimeScalar,
-			updateTransform,
-			m_points,
-			0,
-			m_points.size()
-		);
-	}
+	// Apply all modifiers on chunks of points, modifiers are independent per point.
+	JobManager::getInstance().parallelFor(0, m_points.size(), c_modifierGrainSize, [&](size_t first, size_t last) {
+		for (auto modifier : m_emitter->getModifiers())
+		{
+			modifier->update(
+				deltaTimeScalar,
+				updateTransform,
+				m_points,
+				first,
+				last
+			);
+		}
+	});
 
 	m_renderPoints.resize(0);
 
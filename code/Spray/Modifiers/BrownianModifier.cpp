@@ -1,11 +1,13 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  */
+#include <cstring>
+#include "Core/Math/Random.h"
 #include "Spray/Modifiers/BrownianModifier.h"
 
 namespace traktor::spray
@@ -30,12 +32,21 @@ void BrownianModifier::writeSequence(Vector4*& inoutSequence) const
 
 void BrownianModifier::update(const Scalar& deltaTime, const Transform& transform, pointVector_t& points, size_t first, size_t last) const
 {
+	if (first >= last)
+		return;
+
+	// Ranges are updated concurrently thus each range has it's own generator,
+	// seeded with age of first point so sequence differ between updates.
+	uint32_t age;
+	std::memcpy(&age, &points[first].age, sizeof(age));
+	Random random(uint32_t(first) * 2654435761U ^ age);
+
 	for (size_t i = first; i < last; ++i)
 	{
 		const Vector4 r(
-			m_random.nextFloat() * 2.0f - 1.0f,
-			m_random.nextFloat() * 2.0f - 1.0f,
-			m_random.nextFloat() * 2.0f - 1.0f
+			random.nextFloat() * 2.0f - 1.0f,
+			random.nextFloat() * 2.0f - 1.0f,
+			random.nextFloat() * 2.0f - 1.0f
 		);
 		points[i].velocity += (r * m_factor * deltaTime) * Scalar(points[i].inverseMass);
 	}
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2024 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,7 +8,6 @@
  */
 #pragma once
 
-#include "Core/Math/Random.h"
 #include "Spray/Modifier.h"
 
 namespace traktor::spray
@@ -28,7 +27,6 @@ public:
 
 private:
 	Scalar m_factor;
-	mutable Random m_random;
 };
 
 }
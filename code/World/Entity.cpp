@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2025 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,7 +8,9 @@
  */
 #include "World/Entity.h"
 
+#include <algorithm>
 #include "World/IEntityComponent.h"
+#include "World/World.h"
 
 namespace traktor::world
 {
@@ -79,6 +81,9 @@ void Entity::setTransform(const Transform& transform)
 	for (auto component : m_components)
 		if (component != m_updating)
 			component->setTransform(transform);
+
+	if (m_world)
+		m_world->entityMoved(this);
 }
 
 Transform Entity::getTransform() const
@@ -123,18 +128,21 @@ void Entity::setComponent(IEntityComponent* component)
 	component->setState(m_state, EntityState::All, false);
 	component->setTransform(m_transform);
 
-	// Replace existing component of same type.
-	for (size_t i = 0; i < m_components.size(); ++i)
+	// Replace existing component of same type, replaced component is removed from world.
+	auto it = std::find_if(m_components.begin(), m_components.end(), [&](IEntityComponent* c) {
+		return is_type_of(type_of(c), type_of(component));
+	});
+	if (it != m_components.end())
 	{
-		if (is_type_of(type_of(m_components[i]), type_of(component)))
-		{
-			m_components[i] = component;
-			return;
-		}
+		if (m_world)
+			(*it)->setWorld(nullptr);
+		*it = component;
 	}
+	else
+		m_components.push_back(component);
 
-	// No such component, add last.
-	m_components.push_back(component);
+	if (m_world)
+		component->setWorld(m_world);
 }
 
 IEntityComponent* Entity::getComponent(const TypeInfo& componentType) const
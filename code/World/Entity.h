@@ -15,6 +15,7 @@
 #include "Core/RefArray.h"
 #include "World/WorldTypes.h"
 
+#include <atomic>
 #include <string>
 
 // import/export mechanism.
@@ -165,6 +166,8 @@ public:
 	}
 
 private:
+	friend class WorldEntityIndex;
+
 	World* m_world = nullptr;
 	Guid m_id;
 	std::wstring m_name;
@@ -172,6 +175,9 @@ private:
 	EntityState m_state;
 	RefArray< IEntityComponent > m_components;
 	const IEntityComponent* m_updating = nullptr;
+	uint64_t m_indexCell = 0;
+	bool m_indexed = false;
+	std::atomic< bool > m_indexMoved = false;
 };
 
 }
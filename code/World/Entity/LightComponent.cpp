@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2023 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -9,6 +9,7 @@
 #include "Core/Math/Random.h"
 #include "World/Entity.h"
 #include "World/Entity/LightComponent.h"
+#include "World/World.h"
 
 namespace traktor::world
 {
@@ -38,15 +39,14 @@ LightComponent::LightComponent(
 ,	m_nearRange(nearRange)
 ,	m_farRange(farRange)
 ,	m_radius(radius)
-,	m_flickerAmount(flickerAmount)
-,	m_flickerFilter(flickerFilter)
-,	m_flickerValue(0.0f)
-,	m_flickerCoeff(0.0f)
 {
+	m_flicker.amount = flickerAmount;
+	m_flicker.filter = flickerFilter;
 }
 
 void LightComponent::destroy()
 {
+	setWorld(nullptr);
 }
 
 void LightComponent::setOwner(Entity* owner)
@@ -54,10 +54,36 @@ void LightComponent::setOwner(Entity* owner)
 	m_owner = owner;
 }
 
+void LightComponent::setWorld(World* world)
+{
+	// Move flicker state back into component.
+	if (m_flickerArray)
+	{
+		m_flicker = m_flickerArray->get(m_flickerHandle);
+		m_flickerArray->release(m_flickerHandle);
+		m_flickerArray = nullptr;
+	}
+
+	// Move flicker state into world's storage; all lights are flickered in batch after entities has been updated.
+	WorldComponentStorage* storage = (world != nullptr) ? world->getComponentStorage() : nullptr;
+	if (storage)
+	{
+		m_flickerArray = storage->getArray< Flicker >(
+			type_of< LightComponent >(),
+			[](Flicker* flickers, size_t count, const UpdateParams& update) {
+				Random random(uint32_t(update.totalTime * 1000.0) ^ uint32_t(uintptr_t(flickers) >> 4));
+				for (size_t i = 0; i < count; ++i)
+					updateFlicker(flickers[i], random);
+			}
+		);
+		m_flickerHandle = m_flickerArray->allocate(m_flicker);
+	}
+}
+
 void LightComponent::update(const UpdateParams& update)
 {
-	m_flickerValue = s_random.nextFloat() * (1.0f - m_flickerFilter) + m_flickerValue * m_flickerFilter;
-	m_flickerCoeff = 1.0f - m_flickerValue * m_flickerAmount;
+	if (!m_flickerArray)
+		updateFlicker(m_flicker, s_random);
 }
 
 void LightComponent::setTransform(const Transform& transform)
@@ -74,4 +100,10 @@ Transform LightComponent::getTransform() const
 	return m_owner->getTransform();
 }
 
+void LightComponent::updateFlicker(Flicker& flicker, Random& random)
+{
+	flicker.value = random.nextFloat() * (1.0f - flicker.filter) + flicker.value * flicker.filter;
+	flicker.coeff = 1.0f - flicker.value * flicker.amount;
+}
+
 }
@@ -1,6 +1,6 @@
 /*
  * TRAKTOR
- * Copyright (c) 2022-2023 Anders Pistol.
+ * Copyright (c) 2022-2026 Anders Pistol.
  *
  * This Source Code Form is subject to the terms of the Mozilla Public
  * License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -10,6 +10,7 @@
 
 #include "Resource/Proxy.h"
 #include "World/IEntityComponent.h"
+#include "World/WorldComponentStorage.h"
 
 // import/export mechanism.
 #undef T_DLLCLASS
@@ -19,6 +20,13 @@
 #	define T_DLLCLASS T_DLLIMPORT
 #endif
 
+namespace traktor
+{
+
+class Random;
+
+}
+
 namespace traktor::world
 {
 
@@ -45,6 +53,8 @@ public:
 
 	virtual void setOwner(Entity* owner) override final;
 
+	virtual void setWorld(World* world) override final;
+
 	virtual void update(const UpdateParams& update) override final;
 
 	virtual void setTransform(const Transform& transform) override final;
@@ -77,17 +87,25 @@ public:
 
 	Scalar getRadius() const { return m_radius;  }
 
-	void setFlickerAmount(float flickerAmount) { m_flickerAmount = flickerAmount; }
+	void setFlickerAmount(float flickerAmount) { flicker().amount = flickerAmount; }
 
-	float getFlickerAmount() const { return m_flickerAmount; }
+	float getFlickerAmount() const { return flicker().amount; }
 
-	void setFlickerFilter(float flickerFilter) { m_flickerFilter = flickerFilter; }
+	void setFlickerFilter(float flickerFilter) { flicker().filter = flickerFilter; }
 
-	float getFlickerFilter() const { return m_flickerFilter; }
+	float getFlickerFilter() const { return flicker().filter; }
 
-	Scalar getFlickerCoeff() const { return Scalar(m_flickerCoeff); }
+	Scalar getFlickerCoeff() const { return Scalar(flicker().coeff); }
 
 private:
+	struct Flicker
+	{
+		float amount = 0.0f;
+		float filter = 0.0f;
+		float value = 0.0f;
+		float coeff = 0.0f;
+	};
+
 	Entity* m_owner;
 	LightType m_lightType;
 	Vector4 m_color;
@@ -95,10 +113,15 @@ private:
 	Scalar m_nearRange;
 	Scalar m_farRange;
 	Scalar m_radius;
-	float m_flickerAmount;
-	float m_flickerFilter;
-	float m_flickerValue;
-	float m_flickerCoeff;
+	Flicker m_flicker;	//!< Flicker state, when not stored in world.
+	WorldComponentArray< Flicker >* m_flickerArray = nullptr;
+	uint32_t m_flickerHandle = 0;
+
+	Flicker& flicker() { return m_flickerArray ? m_flickerArray->get(m_flickerHandle) : m_flicker; }
+
+	const Flicker& flicker() const { return m_flickerArray ? m_flickerArray->get(m_flickerHandle) : m_flicker; }
+
+	static void updateFlicker(Flicker& flicker, Random& random);
 };
 
 }
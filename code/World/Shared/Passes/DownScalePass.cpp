@@ -72,6 +72,7 @@ render::RGTexture DownScalePass::setup(
 	Ref< render::RenderPass > rp = new render::RenderPass(L"DownScale");
 	rp->addInput(gbufferTargetSetId);
 	rp->setOutput(downScaleTextureId);
+	rp->setReentrant(true);
 	rp->addBuild(
 		[=, this](const render::RenderGraph& renderGraph, render::RenderContext* renderContext) {
 		render::ITexture* inputTexture = renderGraph.getTargetSet(gbufferTargetSetId)->getColorTexture(0);
@@ -96,6 +96,7 @@ void HiZPass::setup(
 	Ref< render::RenderPass > rp = new render::RenderPass(L"HiZ");
 	rp->addInput(gbufferTargetSetId);
 	rp->setOutput(outputHiZTextureId);
+	rp->setReentrant(true);
 
 	for (int32_t i = 0; i < hiZMipCount; ++i)
 	{
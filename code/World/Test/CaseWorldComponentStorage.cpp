@@ -0,0 +1,253 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "World/Test/CaseWorldComponentStorage.h"
+
+#include "Core/Thread/Atomic.h"
+#include "Resource/IResourceManager.h"
+#include "Resource/ResourceHandle.h"
+#include "World/Entity.h"
+#include "World/IEntityComponent.h"
+#include "World/World.h"
+#include "World/WorldComponentStorage.h"
+
+namespace traktor::world::test
+{
+namespace
+{
+
+typedef WorldComponentArray< int32_t > int_array_t;
+
+/*! Resource manager which doesn't have any resources, world only bind optional resources. */
+class EmptyResourceManager : public resource::IResourceManager
+{
+public:
+	virtual void destroy() override final {}
+
+	virtual void addFactory(const resource::IResourceFactory* factory) override final {}
+
+	virtual void removeFactory(const resource::IResourceFactory* factory) override final {}
+
+	virtual void removeAllFactories() override final {}
+
+	virtual bool load(const resource::ResourceBundle* bundle) override final { return false; }
+
+	virtual Ref< resource::ResourceHandle > bind(const TypeInfo& productType, const Guid& guid) override final { return nullptr; }
+
+	virtual Ref< resource::ResourceHandle > bindAsync(const TypeInfo& productType, const Guid& guid, float priority) override final { return nullptr; }
+
+	virtual void setPlaceholder(const TypeInfo& productType, Object* placeholder) override final {}
+
+	virtual bool wait(float minimumPriority, int32_t timeout) override final { return true; }
+
+	virtual bool reload(const Guid& guid, bool flushedOnly) override final { return false; }
+
+	virtual void reload(const TypeInfo& productType, bool flushedOnly) override final {}
+
+	virtual void unload(const TypeInfo& productType) override final {}
+
+	virtual void unloadUnusedResident() override final {}
+
+	virtual void setBudget(const TypeInfo& productType, uint64_t budget) override final {}
+
+	virtual void update() override final {}
+
+	virtual void getStatistics(resource::ResourceManagerStatistics& outStatistics) const override final {}
+};
+
+/*! Component which keep a counter in world's component storage, counter is incremented by system. */
+class CounterComponent : public IEntityComponent
+{
+	T_RTTI_CLASS;
+
+public:
+	int_array_t* m_array = nullptr;
+	int_array_t::handle_t m_handle = 0;
+
+	virtual void destroy() override final
+	{
+		setWorld(nullptr);
+	}
+
+	virtual void setOwner(Entity* owner) override final {}
+
+	virtual void setWorld(World* world) override final
+	{
+		if (m_array)
+		{
+			m_array->release(m_handle);
+			m_array = nullptr;
+		}
+
+		WorldComponentStorage* storage = (world != nullptr) ? world->getComponentStorage() : nullptr;
+		if (storage)
+		{
+			m_array = storage->getArray< int32_t >(
+				type_of< CounterComponent >(),
+				[](int32_t* counters, size_t count, const UpdateParams& update) {
+					for (size_t i = 0; i < count; ++i)
+					{
+						if (counters[i] > 0)
+							counters[i]++;
+					}
+				}
+			);
+			m_handle = m_array->allocate(1);
+		}
+	}
+
+	virtual void setTransform(const Transform& transform) override final {}
+
+	virtual Aabb3 getBoundingBox() const override final { return Aabb3(); }
+
+	virtual void update(const UpdateParams& update) override final {}
+
+	int32_t counter() const { return m_array ? m_array->get(m_handle) : 0; }
+};
+
+T_IMPLEMENT_RTTI_CLASS(L"traktor.world.test.CounterComponent", CounterComponent, IEntityComponent)
+
+}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.world.test.CaseWorldComponentStorage", 0, CaseWorldComponentStorage, traktor::test::Case)
+
+void CaseWorldComponentStorage::run()
+{
+	// Allocate, release and reuse slots.
+	{
+		int_array_t ca;
+		const int_array_t::handle_t h0 = ca.allocate(10);
+		const int_array_t::handle_t h1 = ca.allocate(11);
+		const int_array_t::handle_t h2 = ca.allocate(12);
+		CASE_ASSERT_EQUAL(ca.size(), 3U);
+		CASE_ASSERT_EQUAL(ca.get(h0), 10);
+		CASE_ASSERT_EQUAL(ca.get(h1), 11);
+		CASE_ASSERT_EQUAL(ca.get(h2), 12);
+
+		// Released slot is reset to default data.
+		ca.release(h1);
+		CASE_ASSERT_EQUAL(ca.size(), 2U);
+		CASE_ASSERT_EQUAL(ca.get(h1), 0);
+
+		// Released slot is reused before array grow.
+		const int_array_t::handle_t h3 = ca.allocate(13);
+		CASE_ASSERT_EQUAL(h3, h1);
+		CASE_ASSERT_EQUAL(ca.get(h3), 13);
+		CASE_ASSERT_EQUAL(ca.size(), 3U);
+	}
+
+	// Slots never move when pages are added.
+	{
+		const uint32_t count = 3 * int_array_t::PageSize + 10;
+
+		int_array_t ca;
+		const int_array_t::handle_t first = ca.allocate(1);
+		const int32_t* firstData = &ca.get(first);
+
+		for (uint32_t i = 1; i < count; ++i)
+			ca.allocate(int32_t(i + 1));
+		CASE_ASSERT_EQUAL(ca.size(), count);
+		CASE_ASSERT(&ca.get(first) == firstData);
+
+		bool allValid = true;
+		for (uint32_t i = 0; i < count; ++i)
+			allValid &= (ca.get(i) == int32_t(i + 1));
+		CASE_ASSERT(allValid);
+
+		// Batched system visit each slot exactly once, batches never cross pages.
+		int32_t pageCrossed = 0;
+		ca.setBatchSize(100);
+		ca.setSystem([&](int32_t* data, size_t n, const UpdateParams& update) {
+			for (size_t i = 0; i < n; ++i)
+				data[i] += 1000;
+			bool withinPage = false;
+			for (uint32_t page = 0; page * int_array_t::PageSize < count; ++page)
+			{
+				const int32_t* pageData = &ca.get(page * int_array_t::PageSize);
+				if (data >= pageData && data + n <= pageData + int_array_t::PageSize)
+					withinPage = true;
+			}
+			if (!withinPage)
+				Atomic::increment(pageCrossed);
+		});
+		ca.update(UpdateParams());
+		CASE_ASSERT_EQUAL(pageCrossed, 0);
+
+		allValid = true;
+		for (uint32_t i = 0; i < count; ++i)
+			allValid &= (ca.get(i) == int32_t(i + 1 + 1000));
+		CASE_ASSERT(allValid);
+	}
+
+	// Components allocate slots when entity is added to world with storage.
+	{
+		EmptyResourceManager resourceManager;
+		Ref< World > world = new World(&resourceManager, nullptr, true);
+
+		Ref< Entity > entity = new Entity(Guid(), L"", Transform::identity());
+		Ref< CounterComponent > component = new CounterComponent();
+		entity->setComponent(component);
+		CASE_ASSERT(component->m_array == nullptr);
+
+		world->addEntity(entity);
+		CASE_ASSERT(component->m_array != nullptr);
+
+		int_array_t* ca = world->getComponentStorage()->getArray< int32_t >(type_of< CounterComponent >());
+		CASE_ASSERT(ca == component->m_array);
+		CASE_ASSERT_EQUAL(ca->size(), 1U);
+
+		// Component set on entity already in world must get a slot immediately.
+		Ref< Entity > entity2 = new Entity(Guid(), L"", Transform::identity());
+		world->addEntity(entity2);
+		Ref< CounterComponent > component2 = new CounterComponent();
+		entity2->setComponent(component2);
+		CASE_ASSERT(component2->m_array == ca);
+		CASE_ASSERT_EQUAL(ca->size(), 2U);
+
+		// System is run from world update.
+		world->update(UpdateParams());
+		CASE_ASSERT_EQUAL(component->counter(), 2);
+		CASE_ASSERT_EQUAL(component2->counter(), 2);
+
+		// Replaced component must release its slot to the new component.
+		Ref< CounterComponent > replacement = new CounterComponent();
+		entity2->setComponent(replacement);
+		CASE_ASSERT(component2->m_array == nullptr);
+		CASE_ASSERT(replacement->m_array == ca);
+		CASE_ASSERT_EQUAL(replacement->counter(), 1);
+		CASE_ASSERT_EQUAL(ca->size(), 2U);
+
+		// Removed entity releases slot.
+		world->removeEntity(entity2);
+		CASE_ASSERT(replacement->m_array == nullptr);
+		CASE_ASSERT_EQUAL(ca->size(), 1U);
+		entity2->destroy();
+
+		// Destroying world releases slots of remaining entities.
+		world->destroy();
+		CASE_ASSERT(component->m_array == nullptr);
+		CASE_ASSERT_EQUAL(ca->size(), 0U);
+	}
+
+	// Components don't allocate slots in worlds without storage.
+	{
+		EmptyResourceManager resourceManager;
+		Ref< World > world = new World(&resourceManager, nullptr, false);
+
+		Ref< Entity > entity = new Entity(Guid(), L"", Transform::identity());
+		world->addEntity(entity);
+		Ref< CounterComponent > component = new CounterComponent();
+		entity->setComponent(component);
+		CASE_ASSERT(component->m_array == nullptr);
+
+		world->update(UpdateParams());
+		world->destroy();
+	}
+}
+
+}
@@ -0,0 +1,276 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "World/Test/CaseWorldEntityIndex.h"
+
+#include "Core/RefArray.h"
+#include "Core/Io/StringOutputStream.h"
+#include "Core/Math/Random.h"
+#include "Core/Thread/Thread.h"
+#include "Core/Thread/ThreadManager.h"
+#include "Core/Timer/Timer.h"
+#include "World/Entity.h"
+#include "World/WorldEntityIndex.h"
+
+#include <algorithm>
+
+namespace traktor::world::test
+{
+namespace
+{
+
+const int32_t c_entityCount = 1000;
+const int32_t c_threadCount = 4;
+const int32_t c_benchmarkQueries = 1000;
+
+Vector4 randomPosition(Random& random, float extent)
+{
+	return Vector4(
+		(random.nextFloat() * 2.0f - 1.0f) * extent,
+		(random.nextFloat() * 2.0f - 1.0f) * extent,
+		(random.nextFloat() * 2.0f - 1.0f) * extent,
+		1.0f
+	);
+}
+
+/*! Compare entities found by index with entities found by testing every entity. */
+template < typename PredicateType >
+bool sameAsBruteForce(const RefArray< Entity >& entities, const RefArray< Entity >& found, const PredicateType& predicate)
+{
+	AlignedVector< const Entity* > expected;
+	for (auto entity : entities)
+	{
+		if (predicate(entity->getTransform().translation().xyz1()))
+			expected.push_back(entity);
+	}
+
+	AlignedVector< const Entity* > actual;
+	for (auto entity : found)
+		actual.push_back(entity);
+
+	std::sort(expected.begin(), expected.end());
+	std::sort(actual.begin(), actual.end());
+	return expected == actual;
+}
+
+/*! Query index with range, box and frustum; compare result with brute force. */
+bool queriesMatch(const WorldEntityIndex& index, const RefArray< Entity >& entities)
+{
+	bool match = true;
+
+	const Vector4 centers[] = { Vector4(0.0f, 0.0f, 0.0f, 1.0f), Vector4(-120.0f, 40.0f, -75.0f, 1.0f), Vector4(90.0f, -160.0f, 30.0f, 1.0f) };
+	const float ranges[] = { 0.5f, 10.0f, 50.0f, 1000.0f };
+	for (const auto& center : centers)
+	{
+		for (float range : ranges)
+		{
+			RefArray< Entity > found;
+			index.queryRange(center, range, found);
+			match &= sameAsBruteForce(entities, found, [&](const Vector4& p) {
+				return (bool)((p - center).xyz0().length2() <= Scalar(range * range));
+			});
+
+			const Aabb3 aabb(center - Vector4(range, range * 0.5f, range, 0.0f), center + Vector4(range, range * 0.5f, range, 0.0f));
+			found.resize(0);
+			index.queryAabb(aabb, found);
+			match &= sameAsBruteForce(entities, found, [&](const Vector4& p) {
+				return aabb.inside(p);
+			});
+		}
+	}
+
+	// Orthogonal frustum along z, x and y in [-50, 50], z in [1, 150].
+	Frustum frustum;
+	frustum.buildOrtho(100.0f, 100.0f, 1.0f, 150.0f);
+	RefArray< Entity > found;
+	index.queryFrustum(frustum, found);
+	match &= sameAsBruteForce(entities, found, [&](const Vector4& p) {
+		return frustum.inside(p) != Frustum::Result::Outside;
+	});
+
+	return match;
+}
+
+}
+
+T_IMPLEMENT_RTTI_FACTORY_CLASS(L"traktor.world.test.CaseWorldEntityIndex", 0, CaseWorldEntityIndex, traktor::test::Case)
+
+void CaseWorldEntityIndex::run()
+{
+	// Lookup by id and name.
+	{
+		WorldEntityIndex index;
+
+		const Guid ids[] = { Guid::create(), Guid::create(), Guid::create() };
+		Ref< Entity > named[] =
+		{
+			new Entity(ids[0], L"A", Transform::identity()),
+			new Entity(ids[1], L"A", Transform::identity()),
+			new Entity(ids[2], L"A", Transform::identity())
+		};
+		Ref< Entity > anonymous = new Entity(Guid(), L"", Transform::identity());
+
+		for (auto entity : named)
+			index.insert(entity);
+		index.insert(anonymous);
+
+		CASE_ASSERT(index.find(ids[0]) == named[0]);
+		CASE_ASSERT(index.find(ids[2]) == named[2]);
+		CASE_ASSERT(index.find(Guid()) == nullptr);
+		CASE_ASSERT(index.find(Guid::create()) == nullptr);
+
+		// Equally named entities are found in insertion order.
+		CASE_ASSERT(index.find(L"A", 0) == named[0]);
+		CASE_ASSERT(index.find(L"A", 2) == named[2]);
+		CASE_ASSERT(index.find(L"A", 3) == nullptr);
+		CASE_ASSERT(index.find(L"A", -1) == nullptr);
+		CASE_ASSERT(index.find(L"", 0) == nullptr);
+
+		RefArray< Entity > all;
+		index.findAll(L"A", all);
+		CASE_ASSERT_EQUAL(all.size(), 3U);
+
+		// Removing entity must keep order of remaining.
+		index.remove(named[1]);
+		CASE_ASSERT(index.find(ids[1]) == nullptr);
+		CASE_ASSERT(index.find(L"A", 1) == named[2]);
+
+		RefArray< Entity > found;
+		index.queryRange(Vector4::origo(), 1.0f, found);
+		CASE_ASSERT_EQUAL(found.size(), 3U);
+
+		index.clear();
+		CASE_ASSERT(index.find(ids[0]) == nullptr);
+		CASE_ASSERT(index.find(L"A", 0) == nullptr);
+	}
+
+	// Range, box and frustum queries; including moved entities.
+	{
+		WorldEntityIndex index(16.0f);
+		Random random(1234);
+
+		RefArray< Entity > entities;
+		for (int32_t i = 0; i < c_entityCount; ++i)
+		{
+			Ref< Entity > entity = new Entity(Guid(), L"", Transform(randomPosition(random, 200.0f)));
+			index.insert(entity);
+			entities.push_back(entity);
+		}
+		CASE_ASSERT(queriesMatch(index, entities));
+
+		// Entity moved to other cell must only be found at new position.
+		Entity* mover = entities[0];
+		const Vector4 from = mover->getTransform().translation();
+		const Vector4 to(from.x() + 100.0f, from.y(), from.z(), 1.0f);
+		mover->setTransform(Transform(to));
+		index.moved(mover);
+		index.moved(mover);
+
+		RefArray< Entity > found;
+		index.queryRange(from, 0.1f, found);
+		CASE_ASSERT(std::find(found.begin(), found.end(), mover) == found.end());
+		found.resize(0);
+		index.queryRange(to, 0.1f, found);
+		CASE_ASSERT(std::find(found.begin(), found.end(), mover) != found.end());
+
+		// Entity removed after being moved must not be re-binned.
+		Ref< Entity > removed = entities[1];
+		removed->setTransform(Transform(randomPosition(random, 200.0f)));
+		index.moved(removed);
+		index.remove(removed);
+		entities.remove(removed);
+		CASE_ASSERT(queriesMatch(index, entities));
+
+		// Entities might be moved concurrently.
+		Thread* threads[c_threadCount] = { nullptr };
+		for (int32_t i = 0; i < c_threadCount; ++i)
+		{
+			threads[i] = ThreadManager::getInstance().create([&, i]() {
+				Random threadRandom(i + 1);
+				for (int32_t j = i; j < (int32_t)entities.size(); j += c_threadCount)
+				{
+					entities[j]->setTransform(Transform(randomPosition(threadRandom, 200.0f)));
+					index.moved(entities[j]);
+				}
+			}, L"Entity index test");
+			threads[i]->start();
+		}
+		for (int32_t i = 0; i < c_threadCount; ++i)
+		{
+			threads[i]->wait();
+			ThreadManager::getInstance().destroy(threads[i]);
+		}
+		CASE_ASSERT(queriesMatch(index, entities));
+
+		index.clear();
+	}
+
+	// Benchmark range queries compared to testing all entities.
+	for (int32_t count : { 10000, 100000 })
+	{
+		WorldEntityIndex index(16.0f);
+		Random random(count);
+		Timer timer;
+
+		RefArray< Entity > entities;
+		entities.reserve(count);
+		for (int32_t i = 0; i < count; ++i)
+		{
+			Vector4 position = randomPosition(random, 2000.0f);
+			position.set(1, Scalar(0.0f));
+			entities.push_back(new Entity(Guid(), L"", Transform(position)));
+		}
+
+		const double insertStart = timer.getElapsedTime();
+		for (auto entity : entities)
+			index.insert(entity);
+		const double insertTime = timer.getElapsedTime() - insertStart;
+
+		AlignedVector< Vector4 > centers;
+		for (int32_t i = 0; i < c_benchmarkQueries; ++i)
+		{
+			Vector4 center = randomPosition(random, 2000.0f);
+			center.set(1, Scalar(0.0f));
+			centers.push_back(center);
+		}
+
+		size_t indexFound = 0;
+		const double indexStart = timer.getElapsedTime();
+		for (const auto& center : centers)
+		{
+			RefArray< Entity > found;
+			index.queryRange(center, 50.0f, found);
+			indexFound += found.size();
+		}
+		const double indexTime = timer.getElapsedTime() - indexStart;
+
+		size_t scanFound = 0;
+		const double scanStart = timer.getElapsedTime();
+		for (const auto& center : centers)
+		{
+			RefArray< Entity > found;
+			for (auto entity : entities)
+			{
+				if ((entity->getTransform().translation() - center).xyz0().length2() <= Scalar(50.0f * 50.0f))
+					found.push_back(entity);
+			}
+			scanFound += found.size();
+		}
+		const double scanTime = timer.getElapsedTime() - scanStart;
+
+		CASE_ASSERT_EQUAL(indexFound, scanFound);
+
+		StringOutputStream ss;
+		ss << L"Index " << count << L" entities; insert " << int32_t(insertTime * 1000000.0) << L" us, range query " << int32_t(indexTime * 1000000.0 / c_benchmarkQueries) << L" us, scan " << int32_t(scanTime * 1000000.0 / c_benchmarkQueries) << L" us";
+		succeeded(ss.str());
+
+		index.clear();
+	}
+}
+
+}
@@ -8,7 +8,6 @@
  */
 #include "World/World.h"
 
-#include "Core/Thread/Job.h"
 #include "Core/Thread/JobManager.h"
 #include "Render/IRenderSystem.h"
 #include "World/Entity.h"
@@ -17,6 +16,7 @@
 #include "World/Entity/IrradianceGridComponent.h"
 #include "World/Entity/RTWorldComponent.h"
 #include "World/IWorldComponent.h"
+#include "World/WorldComponentStorage.h"
 
 #define T_USE_UPDATE_JOBS
 
@@ -25,12 +25,15 @@ namespace traktor::world
 
 T_IMPLEMENT_RTTI_CLASS(L"traktor.world.World", World, Object)
 
-World::World(resource::IResourceManager* resourceManager, render::IRenderSystem* renderSystem)
+World::World(resource::IResourceManager* resourceManager, render::IRenderSystem* renderSystem, bool componentStorage)
 {
+	if (componentStorage)
+		m_componentStorage = new WorldComponentStorage();
+
 	setComponent(new CullingComponent(resourceManager, renderSystem));
 	setComponent(new EventManagerComponent(512));
 	setComponent(new IrradianceGridComponent());
-	if (renderSystem->supportRayTracing())
+	if (renderSystem != nullptr && renderSystem->supportRayTracing())
 		setComponent(new RTWorldComponent(renderSystem));
 }
 
@@ -39,6 +42,7 @@ void World::destroy()
 	T_FATAL_ASSERT(m_deferredAdd.empty());
 	T_FATAL_ASSERT(m_deferredRemove.empty());
 
+	m_entityIndex.clear();
 	for (auto entity : m_entities)
 	{
 		entity->setWorld(nullptr);
@@ -88,7 +92,10 @@ void World::addEntity(Entity* entity)
 	if (m_update)
 		m_deferredAdd.push_back(entity);
 	else
+	{
 		m_entities.push_back(entity);
+		m_entityIndex.insert(entity);
+	}
 	entity->setWorld(this);
 }
 
@@ -101,6 +108,7 @@ void World::removeEntity(Entity* entity)
 	{
 		const bool removed = m_entities.remove(entity);
 		T_FATAL_ASSERT(removed);
+		m_entityIndex.remove(entity);
 	}
 	entity->setWorld(nullptr);
 }
@@ -115,6 +123,10 @@ bool World::haveEntity(const Entity* entity) const
 
 Entity* World::getEntity(const Guid& id) const
 {
+	// Null ids are not indexed.
+	if (id.isNotNull())
+		return m_entityIndex.find(id);
+
 	for (auto entity : m_entities)
 		if (entity->getId() == id)
 			return entity;
@@ -123,6 +135,10 @@ Entity* World::getEntity(const Guid& id) const
 
 Entity* World::getEntity(const std::wstring& name, int32_t index) const
 {
+	// Empty names are not indexed.
+	if (!name.empty())
+		return m_entityIndex.find(name, std::max(index, 0));
+
 	for (auto entity : m_entities)
 	{
 		if (entity->getName() == name)
@@ -137,21 +153,35 @@ Entity* World::getEntity(const std::wstring& name, int32_t index) const
 RefArray< Entity > World::getEntities(const std::wstring& name) const
 {
 	RefArray< Entity > entities;
-	for (auto entity : m_entities)
-		if (entity->getName() == name)
-			entities.push_back(entity);
+	if (!name.empty())
+		m_entityIndex.findAll(name, entities);
+	else
+	{
+		for (auto entity : m_entities)
+			if (entity->getName() == name)
+				entities.push_back(entity);
+	}
 	return entities;
 }
 
 RefArray< Entity > World::getEntitiesWithinRange(const Vector4& position, float range) const
 {
 	RefArray< Entity > entities;
-	for (auto entity : m_entities)
-	{
-		const Scalar distance = (entity->getTransform().translation() - position).xyz0().length();
-		if (distance <= range)
-			entities.push_back(entity);
-	}
+	m_entityIndex.queryRange(position, range, entities);
+	return entities;
+}
+
+RefArray< Entity > World::getEntitiesWithinAabb(const Aabb3& aabb) const
+{
+	RefArray< Entity > entities;
+	m_entityIndex.queryAabb(aabb, entities);
+	return entities;
+}
+
+RefArray< Entity > World::getEntitiesWithinFrustum(const Frustum& frustum) const
+{
+	RefArray< Entity > entities;
+	m_entityIndex.queryFrustum(frustum, entities);
 	return entities;
 }
 
@@ -161,22 +191,22 @@ void World::update(const UpdateParams& update)
 	for (auto component : m_components)
 		component->update(this, update);
 
+	// Run systems which entities depend on, such as animation, before entities are updated.
+	if (m_componentStorage)
+		m_componentStorage->update(update, WorldComponentStorage::Stage::BeforeEntities);
+
 	// Update all entities.
 	m_update = true;
 
 #if defined(T_USE_UPDATE_JOBS)
-	AlignedVector< Job::task_t > jobs;
-	jobs.reserve(m_entities.size());
-
-	for (auto entity : m_entities)
-	{
-		if (entity->getWorld() != nullptr && entity->allowConcurrentUpdate())
-			jobs.push_back([&, entity](){
+	JobManager::getInstance().parallelFor(0, m_entities.size(), 64, [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i)
+		{
+			Entity* entity = m_entities[i];
+			if (entity->getWorld() != nullptr && entity->allowConcurrentUpdate())
 				entity->update(update);
-			});
-	}
-
-	JobManager::getInstance().fork(jobs.c_ptr(), jobs.size());
+		}
+	});
 
 	for (auto entity : m_entities)
 	{
@@ -193,10 +223,16 @@ void World::update(const UpdateParams& update)
 
 	m_update = false;
 
+	// Run systems of component storage, batched over contiguous component data.
+	if (m_componentStorage)
+		m_componentStorage->update(update, WorldComponentStorage::Stage::AfterEntities);
+
 	// Add entities which has been added during entity update.
 	if (!m_deferredAdd.empty())
 	{
 		m_entities.insert(m_entities.end(), m_deferredAdd.begin(), m_deferredAdd.end());
+		for (auto entity : m_deferredAdd)
+			m_entityIndex.insert(entity);
 		m_deferredAdd.resize(0);
 	}
 
@@ -207,9 +243,15 @@ void World::update(const UpdateParams& update)
 		{
 			const bool removed = m_entities.remove(entity);
 			T_FATAL_ASSERT(removed);
+			m_entityIndex.remove(entity);
 		}
 		m_deferredRemove.resize(0);
 	}
 }
 
+void World::entityMoved(Entity* entity)
+{
+	m_entityIndex.moved(entity);
+}
+
 }
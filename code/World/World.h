@@ -10,8 +10,10 @@
 
 #include "Core/Guid.h"
 #include "Core/Object.h"
+#include "Core/Ref.h"
 #include "Core/RefArray.h"
 #include "Core/Math/Vector4.h"
+#include "World/WorldEntityIndex.h"
 
 // import/export mechanism.
 #undef T_DLLCLASS
@@ -40,6 +42,7 @@ namespace traktor::world
 
 class Entity;
 class IWorldComponent;
+class WorldComponentStorage;
 struct UpdateParams;
 
 /*! World container.
@@ -53,7 +56,13 @@ class T_DLLCLASS World : public Object
 	T_RTTI_CLASS;
 
 public:
-	explicit World(resource::IResourceManager* resourceManager, render::IRenderSystem* renderSystem);
+	/*! Create world.
+	 *
+	 * \param resourceManager Resource manager.
+	 * \param renderSystem Render system, null if world is never rendered.
+	 * \param componentStorage Store hot component data in contiguous arrays, see WorldComponentStorage.
+	 */
+	explicit World(resource::IResourceManager* resourceManager, render::IRenderSystem* renderSystem, bool componentStorage = false);
 
 	void destroy();
 
@@ -118,6 +127,15 @@ public:
 	/*! Get all entities within distance. */
 	RefArray< Entity > getEntitiesWithinRange(const Vector4& position, float range) const;
 
+	/*! Get all entities which origin is inside bounding box. */
+	RefArray< Entity > getEntitiesWithinAabb(const Aabb3& aabb) const;
+
+	/*! Get all entities which origin is inside frustum. */
+	RefArray< Entity > getEntitiesWithinFrustum(const Frustum& frustum) const;
+
+	/*! Get data oriented component storage, null if world isn't created with component storage. */
+	WorldComponentStorage* getComponentStorage() const { return m_componentStorage; }
+
 	/*! Update all entities in this world. */
 	void update(const UpdateParams& update);
 
@@ -125,11 +143,17 @@ public:
 	const RefArray< Entity >& getEntities() const { return m_entities; }
 
 private:
+	friend class Entity;
+
 	RefArray< IWorldComponent > m_components;
 	RefArray< Entity > m_entities;
 	RefArray< Entity > m_deferredAdd;
 	RefArray< Entity > m_deferredRemove;
+	WorldEntityIndex m_entityIndex;
+	Ref< WorldComponentStorage > m_componentStorage;
 	bool m_update = false;
+
+	void entityMoved(Entity* entity);
 };
 
 }
@@ -0,0 +1,42 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "World/WorldComponentStorage.h"
+
+namespace traktor::world
+{
+
+T_IMPLEMENT_RTTI_CLASS(L"traktor.world.WorldComponentStorage", WorldComponentStorage, Object)
+
+WorldComponentStorage::~WorldComponentStorage()
+{
+	for (const auto& entry : m_arrays)
+		delete entry.ca;
+	m_arrays.clear();
+}
+
+void WorldComponentStorage::update(const UpdateParams& update, Stage stage)
+{
+	for (const auto& entry : m_arrays)
+	{
+		if (entry.stage == stage)
+			entry.ca->update(update);
+	}
+}
+
+IWorldComponentArray* WorldComponentStorage::find(const TypeInfo& componentType) const
+{
+	for (const auto& entry : m_arrays)
+	{
+		if (entry.componentType == &componentType)
+			return entry.ca;
+	}
+	return nullptr;
+}
+
+}
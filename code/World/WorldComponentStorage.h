@@ -0,0 +1,227 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <new>
+#include "Core/Object.h"
+#include "Core/Containers/AlignedVector.h"
+#include "Core/Memory/Alloc.h"
+#include "Core/Thread/Acquire.h"
+#include "Core/Thread/JobManager.h"
+#include "Core/Thread/SpinLock.h"
+#include "World/WorldTypes.h"
+
+// import/export mechanism.
+#undef T_DLLCLASS
+#if defined(T_WORLD_EXPORT)
+#	define T_DLLCLASS T_DLLEXPORT
+#else
+#	define T_DLLCLASS T_DLLIMPORT
+#endif
+
+namespace traktor::world
+{
+
+/*! Type erased component data array.
+ * \ingroup World
+ */
+class T_DLLCLASS IWorldComponentArray
+{
+public:
+	virtual ~IWorldComponentArray() = default;
+
+	/*! Run system on all slots in array. */
+	virtual void update(const UpdateParams& update) = 0;
+};
+
+/*! Contiguous array of component data.
+ * \ingroup World
+ *
+ * Component data is stored in fixed size pages
+ * thus slots never move once allocated; components
+ * can keep a pointer to their data as long as the
+ * slot is allocated.
+ *
+ * Released slots are reset to default constructed data
+ * and recycled, systems process all slots up to the high
+ * water mark and must handle default data gracefully.
+ */
+template < typename DataType >
+class WorldComponentArray : public IWorldComponentArray
+{
+public:
+	typedef uint32_t handle_t;
+	typedef std::function< void (DataType* data, size_t count, const UpdateParams& update) > system_fn_t;
+
+	static constexpr uint32_t PageSize = 1024;
+	static constexpr uint32_t MaxPages = 1024;
+	static constexpr size_t BatchSize = 256;
+
+	virtual ~WorldComponentArray()
+	{
+		for (uint32_t i = 0; i < MaxPages && m_pages[i] != nullptr; ++i)
+		{
+			for (uint32_t j = 0; j < PageSize; ++j)
+				m_pages[i][j].~DataType();
+			Alloc::freeAlign(m_pages[i]);
+		}
+	}
+
+	/*! Allocate slot, initialized with given data. */
+	handle_t allocate(const DataType& data)
+	{
+		T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_lock);
+
+		handle_t handle;
+		if (!m_free.empty())
+		{
+			handle = m_free.back();
+			m_free.pop_back();
+		}
+		else
+		{
+			handle = m_count++;
+
+			const uint32_t page = handle / PageSize;
+			T_FATAL_ASSERT(page < MaxPages);
+			if (m_pages[page] == nullptr)
+			{
+				DataType* items = (DataType*)Alloc::acquireAlign(PageSize * sizeof(DataType), alignof(DataType) > 16 ? alignof(DataType) : 16, T_FILE_LINE);
+				for (uint32_t j = 0; j < PageSize; ++j)
+					::new (&items[j]) DataType();
+				m_pages[page] = items;
+			}
+		}
+
+		get(handle) = data;
+		return handle;
+	}
+
+	/*! Release slot. */
+	void release(handle_t handle)
+	{
+		T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_lock);
+		get(handle) = DataType();
+		m_free.push_back(handle);
+	}
+
+	/*! Get data of slot. */
+	DataType& get(handle_t handle) { return m_pages[handle / PageSize][handle % PageSize]; }
+
+	/*! Get data of slot. */
+	const DataType& get(handle_t handle) const { return m_pages[handle / PageSize][handle % PageSize]; }
+
+	/*! Get number of live slots. */
+	uint32_t size() const { return m_count - uint32_t(m_free.size()); }
+
+	/*! Set system which is run from world update. */
+	void setSystem(const system_fn_t& system) { m_system = system; }
+
+	/*! Set number of slots per batch, lower for systems with expensive work per slot. */
+	void setBatchSize(size_t batchSize) { m_batchSize = std::max< size_t >(batchSize, 1); }
+
+	/*! Iterate all slots in contiguous batches, in parallel.
+	 *
+	 * \param fn Callback, called with pointer to first item and number of items in batch.
+	 */
+	template < typename FunctionType >
+	void forEach(const FunctionType& fn)
+	{
+		const size_t count = m_count;
+		JobManager::getInstance().parallelFor(0, count, m_batchSize, [&](size_t first, size_t last) {
+			while (first < last)
+			{
+				// Split batch at page boundaries.
+				const size_t page = first / PageSize;
+				const size_t end = std::min< size_t >(last, (page + 1) * PageSize);
+				fn(&m_pages[page][first % PageSize], end - first);
+				first = end;
+			}
+		});
+	}
+
+	virtual void update(const UpdateParams& update) override final
+	{
+		if (m_system)
+			forEach([&](DataType* data, size_t count) { m_system(data, count, update); });
+	}
+
+private:
+	DataType* m_pages[MaxPages] = { nullptr };
+	AlignedVector< handle_t > m_free;
+	uint32_t m_count = 0;
+	size_t m_batchSize = BatchSize;
+	system_fn_t m_system;
+	SpinLock m_lock;
+};
+
+/*! Data oriented component storage.
+ * \ingroup World
+ *
+ * Hot data of entity components are stored in contiguous
+ * arrays per world, one array for each component type.
+ * Components are still owned by entities and keep acting
+ * as a facade to their data; systems attached to the
+ * arrays are run in parallel batches, either before or
+ * after all entities has been updated.
+ */
+class T_DLLCLASS WorldComponentStorage : public Object
+{
+	T_RTTI_CLASS;
+
+public:
+	/*! When systems are run in relation to entity update. */
+	enum class Stage
+	{
+		BeforeEntities,	//!< Before entities are updated, entities see result of system in same update.
+		AfterEntities	//!< After entities has been updated.
+	};
+
+	virtual ~WorldComponentStorage();
+
+	/*! Get array of data for component type, created if not already exist.
+	 *
+	 * \param componentType Type of component owning data.
+	 * \param system System attached to array when it's created, optional.
+	 * \param stage When system is run.
+	 * \return Data array.
+	 */
+	template < typename DataType >
+	WorldComponentArray< DataType >* getArray(const TypeInfo& componentType, const typename WorldComponentArray< DataType >::system_fn_t& system = nullptr, Stage stage = Stage::AfterEntities)
+	{
+		IWorldComponentArray* ca = find(componentType);
+		if (!ca)
+		{
+			auto typedArray = new WorldComponentArray< DataType >();
+			typedArray->setSystem(system);
+			m_arrays.push_back({ &componentType, typedArray, stage });
+			return typedArray;
+		}
+		return static_cast< WorldComponentArray< DataType >* >(ca);
+	}
+
+	/*! Run systems of all arrays in stage. */
+	void update(const UpdateParams& update, Stage stage);
+
+private:
+	struct Entry
+	{
+		const TypeInfo* componentType;
+		IWorldComponentArray* ca;
+		Stage stage;
+	};
+
+	AlignedVector< Entry > m_arrays;
+
+	IWorldComponentArray* find(const TypeInfo& componentType) const;
+};
+
+}
@@ -0,0 +1,320 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#include "World/WorldEntityIndex.h"
+
+#include "Core/Thread/Acquire.h"
+#include "World/Entity.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace traktor::world
+{
+	namespace
+	{
+
+const int32_t c_cellCoordMask = (1 << 21) - 1;
+const Vector4 c_cellCoordMin(-float(1 << 20), -float(1 << 20), -float(1 << 20), 0.0f);
+const Vector4 c_cellCoordMax(float((1 << 20) - 1), float((1 << 20) - 1), float((1 << 20) - 1), 0.0f);
+
+uint64_t packCell(int32_t x, int32_t y, int32_t z)
+{
+	return
+		(uint64_t(x & c_cellCoordMask) << 42) |
+		(uint64_t(y & c_cellCoordMask) << 21) |
+		uint64_t(z & c_cellCoordMask);
+}
+
+int32_t unpackCoord(uint64_t key, int32_t shift)
+{
+	// Sign extend 21 bit coordinate.
+	return int32_t(uint32_t((key >> shift) & c_cellCoordMask) << 11) >> 11;
+}
+
+template < typename ContainerType >
+void eraseEntity(ContainerType& container, Entity* entity)
+{
+	auto it = std::find(container.begin(), container.end(), entity);
+	if (it != container.end())
+		container.erase(it);
+}
+
+	}
+
+WorldEntityIndex::WorldEntityIndex(float cellSize)
+:	m_cellSize(cellSize)
+,	m_invCellSize(1.0f / cellSize)
+{
+}
+
+void WorldEntityIndex::insert(Entity* entity)
+{
+	T_FATAL_ASSERT(!entity->m_indexed);
+
+	// Keep id and name lists in insertion order so first match is same as in world's entity array.
+	if (entity->getId().isNotNull())
+		m_ids[entity->getId()].push_back(entity);
+	if (!entity->getName().empty())
+		m_names[entity->getName()].push_back(entity);
+
+	T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_lock);
+	entity->m_indexed = true;
+	entity->m_indexCell = cellKey(entity->getTransform().translation());
+	bin(entity);
+}
+
+void WorldEntityIndex::remove(Entity* entity)
+{
+	T_FATAL_ASSERT(entity->m_indexed);
+
+	if (entity->getId().isNotNull())
+	{
+		auto it = m_ids.find(entity->getId());
+		if (it != m_ids.end())
+		{
+			eraseEntity(it->second, entity);
+			if (it->second.empty())
+				m_ids.erase(it);
+		}
+	}
+
+	if (!entity->getName().empty())
+	{
+		auto it = m_names.find(entity->getName());
+		if (it != m_names.end())
+		{
+			// Must keep order of remaining entities.
+			eraseEntity(it->second, entity);
+			if (it->second.empty())
+				m_names.erase(it);
+		}
+	}
+
+	T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_lock);
+	if (entity->m_indexMoved)
+	{
+		eraseEntity(m_moved, entity);
+		entity->m_indexMoved = false;
+	}
+	unbin(entity);
+	entity->m_indexed = false;
+}
+
+void WorldEntityIndex::clear()
+{
+	T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_lock);
+	for (auto entity : m_moved)
+		entity->m_indexMoved = false;
+	for (const auto& it : m_cells)
+	{
+		for (auto entity : it.second)
+			entity->m_indexed = false;
+	}
+	m_ids.clear();
+	m_names.clear();
+	m_cells.clear();
+	m_moved.clear();
+}
+
+void WorldEntityIndex::moved(Entity* entity)
+{
+	// Only first move since last flush need to be recorded.
+	if (entity->m_indexMoved.exchange(true))
+		return;
+
+	T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_lock);
+	m_moved.push_back(entity);
+}
+
+Entity* WorldEntityIndex::find(const Guid& id) const
+{
+	auto it = m_ids.find(id);
+	return it != m_ids.end() ? it->second.front() : nullptr;
+}
+
+Entity* WorldEntityIndex::find(const std::wstring& name, int32_t index) const
+{
+	auto it = m_names.find(name);
+	if (it == m_names.end() || index < 0 || index >= int32_t(it->second.size()))
+		return nullptr;
+	return it->second[index];
+}
+
+void WorldEntityIndex::findAll(const std::wstring& name, RefArray< Entity >& outEntities) const
+{
+	auto it = m_names.find(name);
+	if (it != m_names.end())
+	{
+		for (auto entity : it->second)
+			outEntities.push_back(entity);
+	}
+}
+
+void WorldEntityIndex::queryRange(const Vector4& position, float range, RefArray< Entity >& outEntities) const
+{
+	const Vector4 center = position.xyz1();
+	const Scalar range2(range * range);
+	const Aabb3 bounds(center - Vector4(range, range, range, 0.0f), center + Vector4(range, range, range, 0.0f));
+	query(bounds, [&](const Vector4& p) {
+		return (bool)((p - center).xyz0().length2() <= range2);
+	}, outEntities);
+}
+
+void WorldEntityIndex::queryAabb(const Aabb3& aabb, RefArray< Entity >& outEntities) const
+{
+	if (aabb.empty())
+		return;
+
+	query(aabb, [&](const Vector4& p) {
+		return aabb.inside(p);
+	}, outEntities);
+}
+
+void WorldEntityIndex::queryFrustum(const Frustum& frustum, RefArray< Entity >& outEntities) const
+{
+	T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_lock);
+	flush();
+
+	// Frustum might be unbounded so test every occupied cell's bounds.
+	const Vector4 cellSize(m_cellSize, m_cellSize, m_cellSize, 0.0f);
+	for (const auto& it : m_cells)
+	{
+		const Vector4 mn = Vector4(
+			float(unpackCoord(it.first, 42)),
+			float(unpackCoord(it.first, 21)),
+			float(unpackCoord(it.first, 0)),
+			1.0f
+		) * Scalar(m_cellSize);
+		const Aabb3 cellBounds(mn.xyz1(), (mn + cellSize).xyz1());
+
+		const Frustum::Result result = frustum.inside(cellBounds);
+		if (result == Frustum::Result::Outside)
+			continue;
+
+		for (auto entity : it.second)
+		{
+			if (result == Frustum::Result::Inside || frustum.inside(entity->getTransform().translation().xyz1()) != Frustum::Result::Outside)
+				outEntities.push_back(entity);
+		}
+	}
+}
+
+size_t WorldEntityIndex::GuidHash::operator () (const Guid& id) const
+{
+	uint64_t h[2];
+	std::memcpy(h, (const uint8_t*)id, sizeof(h));
+	return size_t(h[0] ^ (h[1] * 0x9e3779b97f4a7c15ull));
+}
+
+uint64_t WorldEntityIndex::cellKey(const Vector4& position) const
+{
+	const Vector4 cell = clamp((position * m_invCellSize).floor(), c_cellCoordMin, c_cellCoordMax);
+	return packCell(
+		int32_t((float)cell.x()),
+		int32_t((float)cell.y()),
+		int32_t((float)cell.z())
+	);
+}
+
+void WorldEntityIndex::cellRange(const Aabb3& aabb, int32_t outMin[3], int32_t outMax[3]) const
+{
+	const Vector4 mn = clamp((aabb.mn * m_invCellSize).floor(), c_cellCoordMin, c_cellCoordMax);
+	const Vector4 mx = clamp((aabb.mx * m_invCellSize).floor(), c_cellCoordMin, c_cellCoordMax);
+	outMin[0] = int32_t((float)mn.x()); outMax[0] = int32_t((float)mx.x());
+	outMin[1] = int32_t((float)mn.y()); outMax[1] = int32_t((float)mx.y());
+	outMin[2] = int32_t((float)mn.z()); outMax[2] = int32_t((float)mx.z());
+}
+
+void WorldEntityIndex::bin(Entity* entity) const
+{
+	m_cells[entity->m_indexCell].push_back(entity);
+}
+
+void WorldEntityIndex::unbin(Entity* entity) const
+{
+	auto it = m_cells.find(entity->m_indexCell);
+	if (it == m_cells.end())
+		return;
+
+	// Order within cell is not important.
+	auto& cell = it->second;
+	auto jt = std::find(cell.begin(), cell.end(), entity);
+	if (jt != cell.end())
+	{
+		*jt = cell.back();
+		cell.pop_back();
+	}
+	if (cell.empty())
+		m_cells.erase(it);
+}
+
+void WorldEntityIndex::flush() const
+{
+	for (auto entity : m_moved)
+	{
+		entity->m_indexMoved = false;
+		if (!entity->m_indexed)
+			continue;
+
+		const uint64_t key = cellKey(entity->getTransform().translation());
+		if (key != entity->m_indexCell)
+		{
+			unbin(entity);
+			entity->m_indexCell = key;
+			bin(entity);
+		}
+	}
+	m_moved.resize(0);
+}
+
+template < typename PredicateType >
+void WorldEntityIndex::query(const Aabb3& bounds, const PredicateType& predicate, RefArray< Entity >& outEntities) const
+{
+	T_ANONYMOUS_VAR(Acquire< SpinLock >)(m_lock);
+	flush();
+
+	int32_t mn[3], mx[3];
+	cellRange(bounds, mn, mx);
+
+	const int64_t rangeCount = int64_t(mx[0] - mn[0] + 1) * int64_t(mx[1] - mn[1] + 1) * int64_t(mx[2] - mn[2] + 1);
+	if (rangeCount > int64_t(m_cells.size()))
+	{
+		// Query cover more cells than are occupied; faster to test all occupied cells.
+		for (const auto& it : m_cells)
+		{
+			for (auto entity : it.second)
+			{
+				if (predicate(entity->getTransform().translation().xyz1()))
+					outEntities.push_back(entity);
+			}
+		}
+		return;
+	}
+
+	for (int32_t z = mn[2]; z <= mx[2]; ++z)
+	{
+		for (int32_t y = mn[1]; y <= mx[1]; ++y)
+		{
+			for (int32_t x = mn[0]; x <= mx[0]; ++x)
+			{
+				auto it = m_cells.find(packCell(x, y, z));
+				if (it == m_cells.end())
+					continue;
+
+				for (auto entity : it->second)
+				{
+					if (predicate(entity->getTransform().translation().xyz1()))
+						outEntities.push_back(entity);
+				}
+			}
+		}
+	}
+}
+
+}
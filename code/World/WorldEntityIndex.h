@@ -0,0 +1,93 @@
+/*
+ * TRAKTOR
+ * Copyright (c) 2026 Anders Pistol.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include "Core/Guid.h"
+#include "Core/RefArray.h"
+#include "Core/Containers/AlignedVector.h"
+#include "Core/Math/Aabb3.h"
+#include "Core/Math/Frustum.h"
+#include "Core/Thread/SpinLock.h"
+
+namespace traktor::world
+{
+
+class Entity;
+
+/*! World entity index.
+ * \ingroup World
+ *
+ * Index entities by id, name and position. Positions
+ * are kept in a hashed grid of entity origins; moved
+ * entities are only marked and re-binned lazily before
+ * next query thus moving entities is safe from concurrent
+ * entity updates.
+ *
+ * Entities with null id or empty name are not
+ * indexed by id or name.
+ */
+class WorldEntityIndex
+{
+public:
+	explicit WorldEntityIndex(float cellSize = 16.0f);
+
+	void insert(Entity* entity);
+
+	void remove(Entity* entity);
+
+	void clear();
+
+	/*! Mark entity as moved, thread safe. */
+	void moved(Entity* entity);
+
+	Entity* find(const Guid& id) const;
+
+	Entity* find(const std::wstring& name, int32_t index) const;
+
+	void findAll(const std::wstring& name, RefArray< Entity >& outEntities) const;
+
+	void queryRange(const Vector4& position, float range, RefArray< Entity >& outEntities) const;
+
+	void queryAabb(const Aabb3& aabb, RefArray< Entity >& outEntities) const;
+
+	void queryFrustum(const Frustum& frustum, RefArray< Entity >& outEntities) const;
+
+private:
+	struct GuidHash
+	{
+		size_t operator () (const Guid& id) const;
+	};
+
+	typedef AlignedVector< Entity* > cell_t;
+
+	float m_cellSize;
+	Scalar m_invCellSize;
+	std::unordered_map< Guid, AlignedVector< Entity* >, GuidHash > m_ids;
+	std::unordered_map< std::wstring, AlignedVector< Entity* > > m_names;
+	mutable std::unordered_map< uint64_t, cell_t > m_cells;
+	mutable AlignedVector< Entity* > m_moved;
+	mutable SpinLock m_lock;
+
+	uint64_t cellKey(const Vector4& position) const;
+
+	void cellRange(const Aabb3& aabb, int32_t outMin[3], int32_t outMax[3]) const;
+
+	void bin(Entity* entity) const;
+
+	void unbin(Entity* entity) const;
+
+	void flush() const;
+
+	template < typename PredicateType >
+	void query(const Aabb3& bounds, const PredicateType& predicate, RefArray< Entity >& outEntities) const;
+};
+
+}